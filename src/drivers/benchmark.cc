@@ -0,0 +1,1212 @@
+/*!
+ * \file benchmark.cc
+ *
+ * This file is a driver for timing IEGenLib operations over the
+ * dependence relations found in the data/ JSON files.
+ *
+ * Benchmarks (first argument):
+ *
+ *   isl   Passes the super affine set of every relation through isl,
+ *         once with the direct constraint conversion (passRelationThruISL)
+ *         and once through the isl string representation, and reports
+ *         the time for both.
+ *
+ *   normalize  Normalizes every relation repeatedly, with the normalize
+ *         cache off and on, and reports the time for both and the
+ *         cache hit rate.
+ *
+ *   simplify  Runs detectUnsatOrFindEqualities on every relation with one
+ *         thread and with one thread per core (at least 2), and reports
+ *         the time for both and whether the results differ. The
+ *         rounds, gists and additions of the one thread runs are
+ *         reported too (see instantiationSetStats).
+ *
+ *   parse  Parses the relation and expected relation strings repeatedly,
+ *         on one thread and on one thread per core (at least 2), and
+ *         reports the parse throughput for both and whether the parsed
+ *         relations differ.
+ *
+ *   arena  Runs superAffineRelation, reverseAffineSubstitution, Inverse
+ *         and Intersect on every relation repeatedly, on the heap and inside an
+ *         ArenaRegion, and reports the time and the allocation counts of
+ *         Terms, Exps and Conjunctions for both (see arenaStats).
+ *
+ *   cleanup  Grows the first conjunction of every relation to 1000 and
+ *         to 4000 constraints, by adding copies of its constraints
+ *         shifted by constants, and times Conjunction::cleanUp on them
+ *         against placing each constraint by scanning the sorted list,
+ *         as cleanUp used to.
+ *
+ *   ufcallmap  Collects the UF calls of every relation and inserts them
+ *         into a UFCallMap and looks them up again, repeatedly. For
+ *         comparison it does the same with a map ordered by the strings
+ *         of the calls, the way UFCallTerm used to compare arguments.
+ *
+ *   compact  Finds the constraints of every conjunction that mention
+ *         each tuple variable, repeatedly, through Exp::dependsOn and by
+ *         linear passes over a CompactConjunction, and reports the time
+ *         for both and the time to build the CompactConjunctions.
+ *
+ *   projection  Projects every tuple variable that is not a UF argument
+ *         out of each conjunction of the super affine relation, the way
+ *         projectOut does, with fmProjectOut and through isl, repeatedly.
+ *         Reports the path fmProjectOut takes and the time of both for
+ *         each relation, and whether the results differ.
+ *
+ *   unsat  Runs detectUnsatOrFindEqualities on every relation with the
+ *         bound propagation filter on and off, and reports how many
+ *         relations are unsat, the fraction of them the filter decides
+ *         without isl, the time of both runs and of the filter alone,
+ *         and whether the answers differ.
+ *
+ *   congruence  Computes the congruence closure of every relation, as
+ *         detectUnsatOrFindEqualities does, repeatedly. Reports its time,
+ *         the classes it merged, the equalities it inferred from bijective
+ *         UFs, and the number of UF calls the super affine set has to
+ *         replace with symbols before and after.
+ *
+ *   copies  Keeps many copies of every relation alive, the way variants
+ *         of one dependence relation are, made with the copy constructor,
+ *         which shares the conjunctions, and by cloning each conjunction,
+ *         as copies used to. Reports the time and the heap bytes in use
+ *         for both.
+ *
+
+>> Build IEGenLib (run in the root directory):
+
+./configure
+make
+
+>> The driver, benchmarkDriver, should be at build/bin/
+
+>> Run the driver (in root directory):
+
+./build/bin/benchmarkDriver isl data/SpMV_CSR/SpMV.json data/ILU0_CSR/ilu0.json
+
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include "iegenlib.h"
+#include <set_relation/UFCallMap.h>
+#include <set_relation/compact_term.h>
+#include <set_relation/fourier_motzkin.h>
+#include <set_relation/bound_propagation.h>
+#include <set_relation/congruence_closure.h>
+#include <set_relation/Visitor.h>
+#include "parser/jsoncons/json.hpp"
+
+using jsoncons::json;
+using namespace iegenlib;
+using namespace std;
+
+//! Number of times each operation is repeated per relation.
+int repeat = 20;
+
+void islBenchmark(string inputFile);
+void normalizeBenchmark(string inputFile);
+void simplifyBenchmark(string inputFile);
+void parseBenchmark(string inputFile);
+void arenaBenchmark(string inputFile);
+void cleanupBenchmark(string inputFile);
+void ufcallmapBenchmark(string inputFile);
+void compactBenchmark(string inputFile);
+void projectionBenchmark(string inputFile);
+void unsatBenchmark(string inputFile);
+void congruenceBenchmark(string inputFile);
+void copiesBenchmark(string inputFile);
+
+// Utility functions
+Relation* readRelation(json &entry);
+double secondsSince(chrono::steady_clock::time_point start);
+Relation* passRelationThruISLString(Relation* r);
+bool sameRelation(Relation* a, Relation* b);
+bool sameAffineSuperset(Relation* a, Relation* b);
+string arenaWorkload(Relation* rel);
+Conjunction* growConjunction(const Conjunction* conj, unsigned int size);
+unsigned int insertionCleanUp(const list<Exp*>& constraints);
+bool sameProjection(const Conjunction* native, Set* viaISL);
+long heapBytesInUse();
+
+//----------------------- MAIN ---------------
+int main(int argc, char **argv)
+{
+  if (argc < 3)
+  {
+    cout<<"\n\nYou need to specify the benchmark and the input JSON files "
+          "(one or more) that contain dependence relations:"
+          "\n./benchmarkDriver isl|normalize|simplify|parse|arena|cleanup|ufcallmap"
+          "|compact|projection|unsat|congruence|copies"
+          " file1.json file2.json"
+          "\n\n";
+    return 1;
+  }
+
+  string bench(argv[1]);
+  for(int arg = 2; arg < argc ; arg++){
+    if (bench == "isl") {
+      islBenchmark(string(argv[arg]));
+    } else if (bench == "normalize") {
+      normalizeBenchmark(string(argv[arg]));
+    } else if (bench == "simplify") {
+      simplifyBenchmark(string(argv[arg]));
+    } else if (bench == "parse") {
+      parseBenchmark(string(argv[arg]));
+    } else if (bench == "arena") {
+      arenaBenchmark(string(argv[arg]));
+    } else if (bench == "cleanup") {
+      cleanupBenchmark(string(argv[arg]));
+    } else if (bench == "ufcallmap") {
+      ufcallmapBenchmark(string(argv[arg]));
+    } else if (bench == "compact") {
+      compactBenchmark(string(argv[arg]));
+    } else if (bench == "projection") {
+      projectionBenchmark(string(argv[arg]));
+    } else if (bench == "unsat") {
+      unsatBenchmark(string(argv[arg]));
+    } else if (bench == "congruence") {
+      congruenceBenchmark(string(argv[arg]));
+    } else if (bench == "copies") {
+      copiesBenchmark(string(argv[arg]));
+    } else {
+      cout<<"\nUnknown benchmark: "<<bench<<"\n";
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+// Reads the relations from inputFile and times passing their super affine
+// sets through isl, directly and through strings.
+void islBenchmark(string inputFile)
+{
+  iegenlib::setCurrEnv();
+  ifstream in(inputFile);
+  json data;
+  in >> data;
+
+  double directTime = 0, stringTime = 0;
+  int relations = 0, mismatches = 0, skipped = 0;
+
+  for(size_t p = 0; p < data.size(); ++p){
+
+    for (size_t i = 0; i < data[p].size(); ++i){
+
+      if( i == 0 ){
+        json ufcs = data[p][i];
+        addUFCs(ufcs);
+      }
+      Relation* rel = readRelation(data[p][i]);
+      if ( !rel ) { skipped++; continue; }
+
+      Relation* supAff = rel->superAffineRelation();
+
+      Relation *direct = NULL, *viaString = NULL;
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for (int r = 0; r < repeat; r++) {
+        delete direct;
+        direct = passRelationThruISL(supAff);
+      }
+      directTime += secondsSince(start);
+
+      start = chrono::steady_clock::now();
+      for (int r = 0; r < repeat; r++) {
+        delete viaString;
+        viaString = passRelationThruISLString(supAff);
+      }
+      stringTime += secondsSince(start);
+
+      if ( !sameRelation(direct, viaString) ) { mismatches++; }
+      relations++;
+
+      delete direct;
+      delete viaString;
+      delete supAff;
+      delete rel;
+    }
+  }
+
+  cout<<inputFile<<": relations = "<<relations
+      <<fixed<<setprecision(4)
+      <<"  direct = "<<directTime<<"s"
+      <<"  string = "<<stringTime<<"s"
+      <<"  speedup = "<<(directTime > 0 ? stringTime/directTime : 0)<<"x"
+      <<"  mismatches = "<<mismatches
+      <<"  skipped = "<<skipped<<"\n";
+
+  // Each input file is a batch, start the next one with a fresh context.
+  resetISLCtx();
+}
+
+// Reads the relations from inputFile and times normalizing each of them
+// repeat times, without and with the normalize cache.
+void normalizeBenchmark(string inputFile)
+{
+  iegenlib::setCurrEnv();
+  ifstream in(inputFile);
+  json data;
+  in >> data;
+
+  double uncachedTime = 0, cachedTime = 0;
+  int relations = 0, mismatches = 0, skipped = 0;
+  clearNormalizeCache();
+
+  for(size_t p = 0; p < data.size(); ++p){
+
+    for (size_t i = 0; i < data[p].size(); ++i){
+
+      if( i == 0 ){
+        json ufcs = data[p][i];
+        addUFCs(ufcs);
+      }
+      Relation* rel = readRelation(data[p][i]);
+      if ( !rel ) { skipped++; continue; }
+
+      Relation *uncached = NULL, *cached = NULL;
+      setNormalizeCacheCapacity(0);
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for (int r = 0; r < repeat; r++) {
+        delete uncached;
+        uncached = new Relation(*rel);
+        uncached->normalize();
+      }
+      uncachedTime += secondsSince(start);
+
+      setNormalizeCacheCapacity(1024);
+      start = chrono::steady_clock::now();
+      for (int r = 0; r < repeat; r++) {
+        delete cached;
+        cached = new Relation(*rel);
+        cached->normalize();
+      }
+      cachedTime += secondsSince(start);
+
+      if ( uncached->toString() != cached->toString() ) { mismatches++; }
+      relations++;
+
+      delete uncached;
+      delete cached;
+      delete rel;
+    }
+  }
+
+  unsigned long hits = normalizeCacheHits(), misses = normalizeCacheMisses();
+  cout<<inputFile<<": relations = "<<relations
+      <<fixed<<setprecision(4)
+      <<"  uncached = "<<uncachedTime<<"s"
+      <<"  cached = "<<cachedTime<<"s"
+      <<"  speedup = "<<(cachedTime > 0 ? uncachedTime/cachedTime : 0)<<"x"
+      <<"  hits = "<<hits<<"/"<<(hits+misses)
+      <<"  mismatches = "<<mismatches
+      <<"  skipped = "<<skipped<<"\n";
+
+  setNormalizeCacheCapacity(0);
+  clearNormalizeCache();
+}
+
+// Reads the relations and rules from inputFile and times
+// detectUnsatOrFindEqualities on one thread and on several.
+void simplifyBenchmark(string inputFile)
+{
+  iegenlib::setCurrEnv();
+  ifstream in(inputFile);
+  json data;
+  in >> data;
+
+  unsigned int threads = max(2u, thread::hardware_concurrency());
+  double serialTime = 0, parallelTime = 0;
+  int relations = 0, mismatches = 0, skipped = 0;
+  InstantiationSetStats serialStats;
+
+  for(size_t p = 0; p < data.size(); ++p){
+
+    for (size_t i = 0; i < data[p].size(); ++i){
+
+      if( i == 0 ){
+        json ufcs = data[p][i];
+        addUFCs(ufcs);
+        json uqCons = data[p][i]["User Defined"];
+        addUniQuantRules(uqCons);
+      }
+      Relation* rel = readRelation(data[p][i]);
+      if ( !rel ) { skipped++; continue; }
+
+      resetInstantiationSetStats();
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      Relation* serial = rel->detectUnsatOrFindEqualities(NULL, 1);
+      serialTime += secondsSince(start);
+      InstantiationSetStats stats = instantiationSetStats();
+      serialStats.rounds += stats.rounds;
+      serialStats.gists += stats.gists;
+      serialStats.additions += stats.additions;
+
+      start = chrono::steady_clock::now();
+      Relation* parallel = rel->detectUnsatOrFindEqualities(NULL, threads);
+      parallelTime += secondsSince(start);
+
+      if ( (serial == NULL) != (parallel == NULL) ||
+           (serial && !sameAffineSuperset(serial, parallel)) ) {
+        mismatches++;
+      }
+      relations++;
+
+      delete serial;
+      delete parallel;
+      delete rel;
+    }
+  }
+
+  cout<<inputFile<<": relations = "<<relations
+      <<fixed<<setprecision(4)
+      <<"  1 thread = "<<serialTime<<"s"
+      <<"  "<<threads<<" threads = "<<parallelTime<<"s"
+      <<"  speedup = "<<(parallelTime > 0 ? serialTime/parallelTime : 0)<<"x"
+      <<"  mismatches = "<<mismatches
+      <<"  skipped = "<<skipped<<"\n";
+  cout<<"  1 thread: rounds = "<<serialStats.rounds
+      <<"  gists = "<<serialStats.gists
+      <<"  additions = "<<serialStats.additions<<"\n";
+
+  resetISLCtx();
+}
+
+// Reads the relation strings from inputFile and times parsing all of them
+// repeat times on one thread and on several.
+void parseBenchmark(string inputFile)
+{
+  iegenlib::setCurrEnv();
+  ifstream in(inputFile);
+  json data;
+  in >> data;
+
+  // The strings, and what they parse to on one thread.
+  vector<string> strs;
+  vector<string> parsed;
+  int skipped = 0;
+  for(size_t p = 0; p < data.size(); ++p){
+
+    for (size_t i = 0; i < data[p].size(); ++i){
+
+      if( i == 0 ){
+        json ufcs = data[p][i];
+        addUFCs(ufcs);
+      }
+      const char* members[] = { "Relation", "Expected" };
+      for (int m = 0; m < 2; m++) {
+        if ( !data[p][i].has_member(members[m]) ) { continue; }
+        string str = data[p][i][members[m]].as<string>();
+        if ( str == "Not Satisfiable" ) { continue; }
+        try {
+          Relation rel(str);
+          strs.push_back(str);
+          parsed.push_back(rel.toString());
+        } catch (parse_exception &e) {
+          skipped++;
+        }
+      }
+    }
+  }
+
+  unsigned int threads = max(2u, thread::hardware_concurrency());
+  size_t parses = strs.size() * repeat;
+  double times[2];
+  atomic<int> mismatches(0);
+  for (int run = 0; run < 2; run++) {
+    atomic<size_t> next(0);
+    auto worker = [&]() {
+      for (size_t n = next++; n < parses; n = next++) {
+        Relation rel(strs[n % strs.size()]);
+        if (run == 1 && rel.toString() != parsed[n % strs.size()]) {
+          mismatches++;
+        }
+      }
+    };
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<thread> pool;
+    for (unsigned int t = 1; run == 1 && t < threads; t++) {
+      pool.push_back(thread(worker));
+    }
+    worker();
+    for (size_t t = 0; t < pool.size(); t++) { pool[t].join(); }
+    times[run] = secondsSince(start);
+  }
+
+  cout<<inputFile<<": strings = "<<strs.size()
+      <<fixed<<setprecision(1)
+      <<"  1 thread = "<<(times[0] > 0 ? parses/times[0] : 0)<<" parses/s"
+      <<"  "<<threads<<" threads = "
+      <<(times[1] > 0 ? parses/times[1] : 0)<<" parses/s"
+      <<setprecision(4)
+      <<"  speedup = "<<(times[1] > 0 ? times[0]/times[1] : 0)<<"x"
+      <<"  mismatches = "<<mismatches
+      <<"  skipped = "<<skipped<<"\n";
+}
+
+// Reads the relations from inputFile and times the operations of
+// arenaWorkload on each of them, allocating from the heap and from an arena.
+void arenaBenchmark(string inputFile)
+{
+  iegenlib::setCurrEnv();
+  ifstream in(inputFile);
+  json data;
+  in >> data;
+
+  double heapTime = 0, arenaTime = 0;
+  int relations = 0, mismatches = 0, skipped = 0;
+  ArenaStats regionStats;
+
+  for(size_t p = 0; p < data.size(); ++p){
+
+    for (size_t i = 0; i < data[p].size(); ++i){
+
+      if( i == 0 ){
+        json ufcs = data[p][i];
+        addUFCs(ufcs);
+      }
+      Relation* rel = readRelation(data[p][i]);
+      if ( !rel ) { skipped++; continue; }
+
+      string heapResult, arenaResult;
+      try {
+        resetArenaStats();
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int r = 0; r < repeat; r++) { heapResult = arenaWorkload(rel); }
+        heapTime += secondsSince(start);
+
+        resetArenaStats();
+        start = chrono::steady_clock::now();
+        for (int r = 0; r < repeat; r++) {
+          ArenaRegion region;
+          arenaResult = arenaWorkload(rel);
+        }
+        arenaTime += secondsSince(start);
+        ArenaStats stats = arenaStats();
+        regionStats.heapAllocations += stats.heapAllocations;
+        regionStats.arenaAllocations += stats.arenaAllocations;
+        regionStats.reused += stats.reused;
+        regionStats.chunks += stats.chunks;
+      } catch (assert_exception &e) {
+        skipped++;
+        delete rel;
+        continue;
+      }
+
+      if ( heapResult != arenaResult ) { mismatches++; }
+      relations++;
+      delete rel;
+    }
+  }
+
+  cout<<inputFile<<": relations = "<<relations
+      <<fixed<<setprecision(4)
+      <<"  heap = "<<heapTime<<"s"
+      <<"  arena = "<<arenaTime<<"s"
+      <<"  speedup = "<<(arenaTime > 0 ? heapTime/arenaTime : 0)<<"x"
+      <<"  mismatches = "<<mismatches
+      <<"  skipped = "<<skipped<<"\n";
+  // Without regions, the same objects each come from the heap, uncounted.
+  cout<<"  heap: allocations = "
+      <<regionStats.heapAllocations + regionStats.arenaAllocations<<"\n";
+  cout<<"  arena: heap allocations = "<<regionStats.heapAllocations
+      <<"  chunks = "<<regionStats.chunks
+      <<"  arena allocations = "<<regionStats.arenaAllocations
+      <<"  reused = "<<regionStats.reused<<"\n";
+
+  resetISLCtx();
+}
+
+// Reads the relations from inputFile and times cleaning up large
+// conjunctions grown from them.
+void cleanupBenchmark(string inputFile)
+{
+  iegenlib::setCurrEnv();
+  ifstream in(inputFile);
+  json data;
+  in >> data;
+
+  const unsigned int sizes[] = {1000, 4000};
+  const int numSizes = sizeof(sizes)/sizeof(sizes[0]);
+  double cleanUpTime[numSizes] = {0}, insertionTime[numSizes] = {0};
+  int relations = 0, mismatches = 0, skipped = 0;
+
+  for(size_t p = 0; p < data.size(); ++p){
+
+    for (size_t i = 0; i < data[p].size(); ++i){
+
+      if( i == 0 ){
+        json ufcs = data[p][i];
+        addUFCs(ufcs);
+      }
+      Relation* rel = readRelation(data[p][i]);
+      if ( !rel || rel->conjunctionBegin() == rel->conjunctionEnd() ) {
+        skipped++;
+        delete rel;
+        continue;
+      }
+
+      for (int s = 0; s < numSizes; s++) {
+        Conjunction* grown = growConjunction(*(rel->conjunctionBegin()),
+                                             sizes[s]);
+        unsigned int kept = 0;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int r = 0; r < repeat; r++) {
+          kept = insertionCleanUp(grown->inequalities());
+        }
+        insertionTime[s] += secondsSince(start);
+
+        start = chrono::steady_clock::now();
+        for (int r = 0; r < repeat; r++) {
+          Conjunction copy(*grown);
+          copy.cleanUp();
+          if (r == 0 && copy.inequalities().size() != kept) { mismatches++; }
+        }
+        cleanUpTime[s] += secondsSince(start);
+        delete grown;
+      }
+      relations++;
+      delete rel;
+    }
+  }
+
+  cout<<inputFile<<": relations = "<<relations
+      <<"  mismatches = "<<mismatches
+      <<"  skipped = "<<skipped<<"\n";
+  for (int s = 0; s < numSizes; s++) {
+    cout<<"  "<<sizes[s]<<" constraints:"<<fixed<<setprecision(4)
+        <<"  insertion = "<<insertionTime[s]<<"s"
+        <<"  cleanUp = "<<cleanUpTime[s]<<"s"
+        <<"  speedup = "
+        <<(cleanUpTime[s] > 0 ? insertionTime[s]/cleanUpTime[s] : 0)
+        <<"x\n";
+  }
+}
+
+// Collects copies of all UF calls in a Set or Relation, nested ones too.
+class VisitorGatherUFCalls : public Visitor {
+  public:
+    ~VisitorGatherUFCalls() {
+      for (size_t i = 0; i < calls.size(); i++) { delete calls[i]; }
+    }
+    void preVisitUFCallTerm(UFCallTerm * t) {
+      calls.push_back(new UFCallTerm(*t));
+    }
+    vector<UFCallTerm*> calls;
+};
+
+// Orders UF calls by their strings, like UFCallTerm::operator< did
+// when it compared the printed argument lists.
+struct UFCallStringLess {
+  bool operator()(const UFCallTerm& a, const UFCallTerm& b) const {
+    return a.toString() < b.toString();
+  }
+};
+
+// Reads the relations from inputFile and times inserting their UF calls
+// into a UFCallMap and finding them again.
+void ufcallmapBenchmark(string inputFile)
+{
+  iegenlib::setCurrEnv();
+  ifstream in(inputFile);
+  json data;
+  in >> data;
+
+  VisitorGatherUFCalls gather;
+  int relations = 0, skipped = 0;
+  for(size_t p = 0; p < data.size(); ++p){
+    for (size_t i = 0; i < data[p].size(); ++i){
+      if( i == 0 ){
+        json ufcs = data[p][i];
+        addUFCs(ufcs);
+      }
+      Relation* rel = readRelation(data[p][i]);
+      if ( !rel ) { skipped++; continue; }
+      rel->acceptVisitor(&gather);
+      relations++;
+      delete rel;
+    }
+  }
+  const vector<UFCallTerm*>& calls = gather.calls;
+
+  int rounds = repeat * 50;
+  size_t mapped = 0, found = 0;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    UFCallMap ufcmap;
+    for (size_t c = 0; c < calls.size(); c++) { ufcmap.insert(calls[c]); }
+    for (size_t c = 0; c < calls.size(); c++) {
+      VarTerm* symbol = ufcmap.find(calls[c]);
+      found += (symbol != NULL);
+      delete symbol;
+    }
+  }
+  double structuralTime = secondsSince(start);
+
+  start = chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    map<UFCallTerm, VarTerm, UFCallStringLess> byString;
+    for (size_t c = 0; c < calls.size(); c++) {
+      UFCallTerm call(*calls[c]);
+      call.setCoefficient(1);
+      byString.insert(make_pair(call, VarTerm(UFCallMap::symUFC(
+                                                  call.toString()))));
+    }
+    for (size_t c = 0; c < calls.size(); c++) {
+      UFCallTerm call(*calls[c]);
+      call.setCoefficient(1);
+      found += (byString.find(call) != byString.end());
+    }
+    mapped = byString.size();
+  }
+  double stringTime = secondsSince(start);
+
+  cout<<inputFile<<": relations = "<<relations
+      <<"  UF calls = "<<calls.size()
+      <<"  distinct = "<<mapped
+      <<fixed<<setprecision(4)
+      <<"  UFCallMap = "<<structuralTime<<"s"
+      <<"  by string = "<<stringTime<<"s"
+      <<"  speedup = "
+      <<(structuralTime > 0 ? stringTime/structuralTime : 0)<<"x"
+      <<"  skipped = "<<skipped<<"\n";
+  if (found != 2 * calls.size() * rounds) { cout<<"  lookups failed\n"; }
+}
+
+// Reads the relations from inputFile and times scans of their
+// conjunctions on the Term classes and on CompactConjunctions.
+void compactBenchmark(string inputFile)
+{
+  iegenlib::setCurrEnv();
+  ifstream in(inputFile);
+  json data;
+  in >> data;
+
+  vector<Conjunction*> conjs;
+  vector<int> inArities;
+  int relations = 0, skipped = 0;
+  for(size_t p = 0; p < data.size(); ++p){
+    for (size_t i = 0; i < data[p].size(); ++i){
+      if( i == 0 ){
+        json ufcs = data[p][i];
+        addUFCs(ufcs);
+      }
+      Relation* rel = readRelation(data[p][i]);
+      if ( !rel ) { skipped++; continue; }
+      for (ConstConjunctionIterator c = rel->conjunctionBegin();
+           c != rel->conjunctionEnd(); c++) {
+        conjs.push_back((*c)->clone());
+        inArities.push_back(rel->inArity());
+      }
+      relations++;
+      delete rel;
+    }
+  }
+
+  int rounds = repeat * 50;
+  size_t termMentions = 0, compactMentions = 0;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    for (size_t c = 0; c < conjs.size(); c++) {
+      list<Exp*> constraints = conjs[c]->equalities();
+      constraints.insert(constraints.end(),
+                         conjs[c]->inequalities().begin(),
+                         conjs[c]->inequalities().end());
+      for (int loc = 0; loc < conjs[c]->arity(); loc++) {
+        TupleVarTerm tv(loc);
+        for (list<Exp*>::const_iterator e = constraints.begin();
+             e != constraints.end(); e++) {
+          termMentions += (*e)->dependsOn(tv);
+        }
+      }
+    }
+  }
+  double termTime = secondsSince(start);
+
+  start = chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    for (size_t c = 0; c < conjs.size(); c++) {
+      CompactTermTable table;
+      CompactConjunction compact(*conjs[c], table);
+    }
+  }
+  double buildTime = secondsSince(start);
+
+  CompactTermTable table;
+  vector<CompactConjunction> compacts;
+  for (size_t c = 0; c < conjs.size(); c++) {
+    compacts.push_back(CompactConjunction(*conjs[c], table));
+  }
+  start = chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    for (size_t c = 0; c < conjs.size(); c++) {
+      for (int loc = 0; loc < conjs[c]->arity(); loc++) {
+        for (unsigned int k = 0; k < compacts[c].numConstraints(); k++) {
+          compactMentions += compacts[c].mentionsTupleVar(k, loc);
+        }
+      }
+    }
+  }
+  double compactTime = secondsSince(start);
+
+  cout<<inputFile<<": relations = "<<relations
+      <<"  conjunctions = "<<conjs.size()
+      <<fixed<<setprecision(4)
+      <<"  terms = "<<termTime<<"s"
+      <<"  compact = "<<compactTime<<"s"
+      <<"  speedup = "
+      <<(compactTime > 0 ? termTime/compactTime : 0)<<"x"
+      <<"  building compact = "<<buildTime<<"s"
+      <<"  skipped = "<<skipped<<"\n";
+  if (termMentions != compactMentions) { cout<<"  results differ\n"; }
+  for (size_t c = 0; c < conjs.size(); c++) { delete conjs[c]; }
+}
+
+// Reads the relations from inputFile and times projecting their tuple
+// variables out natively and through isl.
+void projectionBenchmark(string inputFile)
+{
+  iegenlib::setCurrEnv();
+  ifstream in(inputFile);
+  json data;
+  in >> data;
+
+  double totalNative = 0, totalISL = 0;
+  int relations = 0, nativeRelations = 0, mismatches = 0, skipped = 0;
+  cout<<inputFile<<":\n";
+
+  for(size_t p = 0; p < data.size(); ++p){
+
+    for (size_t i = 0; i < data[p].size(); ++i){
+
+      if( i == 0 ){
+        json ufcs = data[p][i];
+        addUFCs(ufcs);
+      }
+      Relation* rel = readRelation(data[p][i]);
+      if ( !rel ) { skipped++; continue; }
+
+      std::set<int> tvars;
+      for (int tv = 0; tv < rel->arity(); tv++) {
+        if (!rel->isUFCallParam(tv)) { tvars.insert(tv); }
+      }
+      if (tvars.empty()) { skipped++; delete rel; continue; }
+
+      UFCallMap ufcmap;
+      Relation* supAff = rel->superAffineRelation(&ufcmap, false);
+
+      ProjectionPath path = Projection_Native;
+      double nativeTime = 0, islTime = 0;
+      for (ConstConjunctionIterator c = supAff->conjunctionBegin();
+           c != supAff->conjunctionEnd(); c++) {
+        Conjunction* native = NULL;
+        ProjectionPath conjPath = Projection_Native;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int r = 0; r < repeat; r++) {
+          delete native;
+          native = NULL;
+          conjPath = fmProjectOut(**c, tvars, &native);
+        }
+        nativeTime += secondsSince(start);
+        if (path == Projection_Native) { path = conjPath; }
+
+        Conjunction* cc = new Conjunction(**c);
+        cc->setInArity(0);
+        Set* cs = new Set(cc->arity());
+        cs->addConjunction(cc);
+        Set* viaISL = NULL;
+        start = chrono::steady_clock::now();
+        for (int r = 0; r < repeat; r++) {
+          delete viaISL;
+          viaISL = islSetProjectOut(cs, tvars);
+        }
+        islTime += secondsSince(start);
+
+        if (conjPath == Projection_Native &&
+            !sameProjection(native, viaISL)) {
+          mismatches++;
+        }
+        delete native;
+        delete viaISL;
+        delete cs;
+      }
+
+      cout<<"  relation "<<relations<<": "<<projectionPathName(path)
+          <<fixed<<setprecision(6)
+          <<"  native = "<<nativeTime<<"s"
+          <<"  isl = "<<islTime<<"s\n";
+      totalNative += nativeTime;
+      totalISL += islTime;
+      relations++;
+      if (path == Projection_Native) { nativeRelations++; }
+
+      delete supAff;
+      delete rel;
+    }
+  }
+
+  cout<<"  relations = "<<relations
+      <<"  native = "<<nativeRelations
+      <<fixed<<setprecision(4)
+      <<"  native time = "<<totalNative<<"s"
+      <<"  isl time = "<<totalISL<<"s"
+      <<"  mismatches = "<<mismatches
+      <<"  skipped = "<<skipped<<"\n";
+
+  resetISLCtx();
+}
+
+// Reads the relations and rules from inputFile and times
+// detectUnsatOrFindEqualities with and without the bound propagation
+// filter, counting the relations the filter decides.
+void unsatBenchmark(string inputFile)
+{
+  iegenlib::setCurrEnv();
+  ifstream in(inputFile);
+  json data;
+  in >> data;
+
+  double filterTime = 0, withTime = 0, withoutTime = 0;
+  int relations = 0, unsat = 0, mismatches = 0, skipped = 0;
+  unsigned long decided = 0;
+
+  for(size_t p = 0; p < data.size(); ++p){
+
+    for (size_t i = 0; i < data[p].size(); ++i){
+
+      if( i == 0 ){
+        json ufcs = data[p][i];
+        addUFCs(ufcs);
+        json uqCons = data[p][i]["User Defined"];
+        addUniQuantRules(uqCons);
+      }
+      Relation* rel = readRelation(data[p][i]);
+      if ( !rel ) { skipped++; continue; }
+
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for (int r = 0; r < repeat; r++) {
+        Relation* bounded = rel->boundDomainRange();
+        boundsProveUnsat(*bounded);
+        delete bounded;
+      }
+      filterTime += secondsSince(start) / repeat;
+
+      setBoundsUnsatFilter(true);
+      resetInstantiationSetStats();
+      start = chrono::steady_clock::now();
+      Relation* with = rel->detectUnsatOrFindEqualities(NULL, 1);
+      withTime += secondsSince(start);
+      decided += instantiationSetStats().boundsUnsat;
+
+      setBoundsUnsatFilter(false);
+      start = chrono::steady_clock::now();
+      Relation* without = rel->detectUnsatOrFindEqualities(NULL, 1);
+      withoutTime += secondsSince(start);
+      setBoundsUnsatFilter(true);
+
+      if ( (with == NULL) != (without == NULL) ) { mismatches++; }
+      if ( !without ) { unsat++; }
+      relations++;
+
+      delete with;
+      delete without;
+      delete rel;
+    }
+  }
+
+  cout<<inputFile<<": relations = "<<relations
+      <<"  unsat = "<<unsat
+      <<"  decided without isl = "<<decided
+      <<fixed<<setprecision(1)
+      <<" ("<<(relations ? 100.0*decided/relations : 0)<<"% of relations, "
+      <<(unsat ? 100.0*decided/unsat : 0)<<"% of unsat)\n"
+      <<setprecision(4)
+      <<"  filter = "<<filterTime<<"s"
+      <<"  with filter = "<<withTime<<"s"
+      <<"  without = "<<withoutTime<<"s"
+      <<"  mismatches = "<<mismatches
+      <<"  skipped = "<<skipped<<"\n";
+
+  resetISLCtx();
+}
+
+// Reads the relations from inputFile and times their congruence closure,
+// counting the UF calls it makes congruent.
+void congruenceBenchmark(string inputFile)
+{
+  iegenlib::setCurrEnv();
+  ifstream in(inputFile);
+  json data;
+  in >> data;
+
+  double closureTime = 0;
+  int relations = 0, closed = 0, skipped = 0;
+  unsigned long merges = 0, inferences = 0, callsBefore = 0, callsAfter = 0;
+
+  for(size_t p = 0; p < data.size(); ++p){
+
+    for (size_t i = 0; i < data[p].size(); ++i){
+
+      if( i == 0 ){
+        json ufcs = data[p][i];
+        addUFCs(ufcs);
+      }
+      Relation* rel = readRelation(data[p][i]);
+      if ( !rel ) { skipped++; continue; }
+
+      Set* eqSet = new Set( relationStr2SetStr(rel->prettyPrintString(),
+                                          rel->inArity(), rel->outArity()) );
+      Set* closedSet = NULL;
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for (int r = 0; r < repeat; r++) {
+        delete closedSet;
+        closedSet = congruenceClosure(*eqSet);
+      }
+      closureTime += secondsSince(start) / repeat;
+
+      unsigned int relationMerges = 0;
+      for (ConstConjunctionIterator c = eqSet->conjunctionBegin();
+           c != eqSet->conjunctionEnd(); c++) {
+        CongruenceClosure closure(**c);
+        relationMerges += closure.merges();
+        inferences += closure.bijectiveInferences();
+      }
+      merges += relationMerges;
+
+      UFCallMap before, after;
+      Set* supAff = eqSet->superAffineSet(&before);
+      delete supAff;
+      supAff = closedSet->superAffineSet(&after);
+      delete supAff;
+      callsBefore += before.size();
+      callsAfter += after.size();
+      if (after.size() < before.size()) { closed++; }
+      relations++;
+
+      delete closedSet;
+      delete eqSet;
+      delete rel;
+    }
+  }
+
+  cout<<inputFile<<": relations = "<<relations
+      <<"  with fewer UF calls = "<<closed
+      <<"  UF calls = "<<callsBefore<<" -> "<<callsAfter
+      <<"  merges = "<<merges
+      <<"  bijective inferences = "<<inferences
+      <<fixed<<setprecision(6)
+      <<"  closure time = "<<closureTime<<"s"
+      <<"  skipped = "<<skipped<<"\n";
+
+  resetISLCtx();
+}
+
+// Reads the relations from inputFile and compares keeping copies of them
+// that share their conjunctions against copies that clone them.
+void copiesBenchmark(string inputFile)
+{
+  iegenlib::setCurrEnv();
+  ifstream in(inputFile);
+  json data;
+  in >> data;
+
+  const int variants = 64;
+  double sharedTime = 0, clonedTime = 0;
+  long sharedBytes = 0, clonedBytes = 0;
+  int relations = 0, mismatches = 0, skipped = 0;
+
+  for(size_t p = 0; p < data.size(); ++p){
+
+    for (size_t i = 0; i < data[p].size(); ++i){
+
+      if( i == 0 ){
+        json ufcs = data[p][i];
+        addUFCs(ufcs);
+      }
+      Relation* rel = readRelation(data[p][i]);
+      if ( !rel ) { skipped++; continue; }
+      rel->cleanUp();
+
+      vector<Relation*> copies;
+      long before = heapBytesInUse();
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for (int v = 0; v < variants; v++) {
+        copies.push_back(new Relation(*rel));
+      }
+      sharedTime += secondsSince(start);
+      sharedBytes += heapBytesInUse() - before;
+      string shared = copies.back()->toString();
+      for (int v = 0; v < variants; v++) { delete copies[v]; }
+      copies.clear();
+
+      before = heapBytesInUse();
+      start = chrono::steady_clock::now();
+      for (int v = 0; v < variants; v++) {
+        Relation* copy = new Relation(rel->inArity(), rel->outArity());
+        for (ConstConjunctionIterator c = rel->conjunctionBegin();
+             c != rel->conjunctionEnd(); c++) {
+          copy->addConjunction(new Conjunction(**c));
+        }
+        copy->cleanUp();
+        copies.push_back(copy);
+      }
+      clonedTime += secondsSince(start);
+      clonedBytes += heapBytesInUse() - before;
+      if ( copies.back()->toString() != shared ) { mismatches++; }
+      for (int v = 0; v < variants; v++) { delete copies[v]; }
+
+      relations++;
+      delete rel;
+    }
+  }
+
+  cout<<inputFile<<": relations = "<<relations
+      <<"  copies of each = "<<variants
+      <<fixed<<setprecision(4)
+      <<"  shared = "<<sharedTime<<"s "<<sharedBytes/1024<<"KB"
+      <<"  cloned = "<<clonedTime<<"s "<<clonedBytes/1024<<"KB"
+      <<"  speedup = "<<(sharedTime > 0 ? clonedTime/sharedTime : 0)<<"x"
+      <<"  mismatches = "<<mismatches
+      <<"  skipped = "<<skipped<<"\n";
+
+  resetISLCtx();
+}
+
+// Returns the relation of a JSON entry, or NULL if the entry does not
+// have one we can parse.
+Relation* readRelation(json &entry)
+{
+  if ( !entry.has_member("Relation") ) { return NULL; }
+  try {
+    return new Relation(entry["Relation"].as<string>());
+  } catch (parse_exception &e) {
+    return NULL;
+  }
+}
+
+double secondsSince(chrono::steady_clock::time_point start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now()-start).count();
+}
+
+// The string route passRelationThruISL used before the direct conversion.
+Relation* passRelationThruISLString(Relation* r)
+{
+  string rstr = r->toISLString();
+  string islStr = passRelationStrThruISL(rstr);
+  string corrected = revertISLTupDeclToOrig( rstr, islStr,
+                                             r->inArity(), r->outArity());
+  return new Relation(corrected);
+}
+
+// True if the native projection, NULL for none, and the one through isl
+// have the same points.
+bool sameProjection(const Conjunction* native, Set* viaISL)
+{
+  ISLCtxScope scope;
+  ISLSet islSet( isl_set_read_from_str(scope.ctx(),
+                                       viaISL->toISLString().c_str()) );
+  if (!native) { return isl_set_is_empty(islSet.get()) == isl_bool_true; }
+  Set nativeSet(native->arity());
+  nativeSet.addConjunction(native->clone());
+  ISLSet nativeISL( isl_set_read_from_str(scope.ctx(),
+                                          nativeSet.toISLString().c_str()) );
+  return isl_set_is_equal(nativeISL.get(), islSet.get()) == isl_bool_true;
+}
+
+bool sameRelation(Relation* a, Relation* b)
+{
+  ISLCtxScope scope;
+  ISLMap aISL( isl_map_read_from_str(scope.ctx(), a->toISLString().c_str()) );
+  ISLMap bISL( isl_map_read_from_str(scope.ctx(), b->toISLString().c_str()) );
+  return isl_map_is_equal(aISL.get(), bISL.get()) == isl_bool_true;
+}
+
+// The operations timed by the arena benchmark, returns their results
+// as one string.
+string arenaWorkload(Relation* rel)
+{
+  UFCallMap ufcmap;
+  Relation* supAff = rel->superAffineRelation(&ufcmap);
+  Relation* back = supAff->reverseAffineSubstitution(&ufcmap);
+  Relation* inverse = rel->Inverse();
+  Relation* twice = inverse->Inverse();
+  Relation* both = back->Intersect(twice);
+  string result = supAff->toString() + "\n" + both->toString();
+  delete supAff;
+  delete back;
+  delete inverse;
+  delete twice;
+  delete both;
+  return result;
+}
+
+// Compares relations with UF calls, isl cannot read those.
+bool sameAffineSuperset(Relation* a, Relation* b)
+{
+  UFCallMap ufcmap;
+  Relation* supAffA = a->superAffineRelation(&ufcmap);
+  Relation* supAffB = b->superAffineRelation(&ufcmap);
+  bool same = sameRelation(supAffA, supAffB);
+  delete supAffA;
+  delete supAffB;
+  return same;
+}
+
+// Returns a conjunction with at least size inequalities: those of conj
+// and its equalities, each shifted by 0, 1, 2, ...
+Conjunction* growConjunction(const Conjunction* conj, unsigned int size)
+{
+  Conjunction* grown = new Conjunction(conj->getTupleDecl());
+  list<Exp*> constraints = conj->equalities();
+  constraints.insert(constraints.end(), conj->inequalities().begin(),
+                     conj->inequalities().end());
+  for (int shift = 0; grown->inequalities().size() < size; shift++) {
+    for (list<Exp*>::const_iterator i = constraints.begin();
+         i != constraints.end(); i++) {
+      Exp* shifted = (*i)->clone();
+      shifted->addTerm(new Term(shift));
+      grown->addInequality(shifted);
+    }
+  }
+  return grown;
+}
+
+// Copies the constraints into a sorted list without duplicates the way
+// cleanUp used to, scanning from the front for the place of each one.
+// Returns the number of distinct constraints.
+unsigned int insertionCleanUp(const list<Exp*>& constraints)
+{
+  list<Exp*> sorted;
+  for (list<Exp*>::const_iterator i = constraints.begin();
+       i != constraints.end(); i++) {
+    Exp* exp = (*i)->clone();
+    list<Exp*>::iterator j = sorted.begin();
+    while (j != sorted.end() && **j < *exp) { j++; }
+    if (j != sorted.end() && **j == *exp) {
+      delete exp;
+    } else {
+      sorted.insert(j, exp);
+    }
+  }
+  unsigned int distinct = sorted.size();
+  for (list<Exp*>::iterator j = sorted.begin(); j != sorted.end(); j++) {
+    delete *j;
+  }
+  return distinct;
+}
+
+// Bytes of heap in use, or 0 where malloc cannot tell.
+long heapBytesInUse()
+{
+#ifdef __GLIBC__
+  return mallinfo2().uordblks;
+#else
+  return 0;
+#endif
+}
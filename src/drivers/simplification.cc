@@ -22,10 +22,19 @@ g++ -O3 -o simplifyDriver src/drivers/simplification.cc
 
 ./simplifyDriver data/SOME_EXAMPLE/SOME_EXAMPLE.json
 
+>> Several files can be simplified in parallel, each on its own thread and
+   with its own environment (-j 0 uses one thread per core). The output is
+   printed in the order the files were given:
+
+./simplifyDriver -j 4 data/A/A.json data/B/B.json data/C/C.json
+
 */
 
 
 #include <iostream>
+#include <sstream>
+#include <thread>
+#include <atomic>
 #include "iegenlib.h"
 //#include "src/set_relation/Visitor.h"
 #include "parser/jsoncons/json.hpp"
@@ -42,12 +51,13 @@ using namespace std;
 //! If you wish not to see the output, change the value: verbose = false;
 bool verbose=true;
 
-void simplify(string inputFile);
+void simplify(string inputFile, ostream& out);
+void simplifyInParallel(const vector<string>& inputFiles, unsigned int threads);
 
 // Utility function
 bool printRelation(string msg, Relation *rel);
 void EXPECT_EQ(string a, string b);
-void EXPECT_EQ(Relation *a, Relation *b);
+void EXPECT_EQ(Relation *a, Relation *b, ostream& out);
 int str2int(string str);
 
 
@@ -57,15 +67,28 @@ int main(int argc, char **argv)
 
 //CSR_Gauss_Seidel_Example();
 
-  if (argc == 1)
+  // Parsing command line arguments.
+  unsigned int threads = 1;
+  vector<string> inputFiles;
+  for(int arg = 1; arg < argc ; arg++){
+    if( string(argv[arg]) == "-j" && arg + 1 < argc ){
+      threads = str2int(argv[++arg]);
+    } else {
+      inputFiles.push_back(string(argv[arg]));
+    }
+  }
+
+  if (inputFiles.empty())
   {
     cout<<"\n\nYou need to specify the input JSON files (one or more) that contain dependence relations:"
-          "\n./simplifyDriver file1.json file2.json\n\n";
-  } else if (argc >= 2){
-    // Parsing command line arguments and reading given files.
-    for(int arg = 1; arg < argc ; arg++){
-      simplify(string(argv[arg]));
+          "\n./simplifyDriver [-j threads] file1.json file2.json\n\n";
+  } else if (threads == 1){
+    // Reading given files.
+    for(size_t f = 0; f < inputFiles.size() ; f++){
+      simplify(inputFiles[f], cout);
     }
+  } else {
+    simplifyInParallel(inputFiles, threads);
   }
 
     return 0;
@@ -73,7 +96,7 @@ int main(int argc, char **argv)
 
 // Reads information from a JSON file (inputFile), and applies
 // the simplification algorithm to the sets found in the file. 
-void simplify(string inputFile)
+void simplify(string inputFile, ostream& out)
 {
 
   int unSatFound = 0, maySatFound = 0;
@@ -88,7 +111,7 @@ void simplify(string inputFile)
 
  for(size_t p = 0; p < data.size(); ++p){    // Dependence relations (DR) found in the file
 
-  cout<<"\n\n"<<data[p][0]["Name"].as<string>()<<"\n\n";
+  out<<"\n\n"<<data[p][0]["Name"].as<string>()<<"\n\n";
 
   for (size_t i = 0; i < data[p].size(); ++i){// Conjunctions found for one DR in the file
 
@@ -122,9 +145,9 @@ void simplify(string inputFile)
       ex_rel = new Relation(expected_str);
     }
 
-    cout<<"\n>>> Relation No. "<<i<<": "<<rel->toISLString();
+    out<<"\n>>> Relation No. "<<i<<": "<<rel->toISLString();
 
-    EXPECT_EQ( result , ex_rel);
+    EXPECT_EQ( result , ex_rel, out);
 
     if( !result ) unSatFound++;
     else          maySatFound++;
@@ -133,24 +156,24 @@ void simplify(string inputFile)
 
  } // End of p loop
 
-  cout<<"\n\n UnSat found = "<<unSatFound<<"\n MaySat found = "<<maySatFound<<"\n\n";
+  out<<"\n\n UnSat found = "<<unSatFound<<"\n MaySat found = "<<maySatFound<<"\n\n";
   
 
 }
 
-void EXPECT_EQ(Relation *result, Relation *expected){
+void EXPECT_EQ(Relation *result, Relation *expected, ostream& out){
 
     if( result == NULL && expected == NULL ){
-        cout<<"\n\nResult MATCH Expected: Not Satisfiable.\n\n";
+        out<<"\n\nResult MATCH Expected: Not Satisfiable.\n\n";
     }
 
     else if( result != NULL && expected == NULL ){
-        cout<<"\n\nResult DOES NOT MATCH Expected:\n"
+        out<<"\n\nResult DOES NOT MATCH Expected:\n"
               "Expected: Not Satisfiable\nResult:\n"<<result->toISLString()<<"\n\n";
     }
 
     else if( result == NULL && expected != NULL ){
-        cout<<"\n\nResult DOES NOT MATCH Expected:\n"
+        out<<"\n\nResult DOES NOT MATCH Expected:\n"
               "Expected:\n"<<expected->toISLString()<<"\nResult: Not Satisfiable\n\n";
     }
 
@@ -166,10 +189,10 @@ void EXPECT_EQ(Relation *result, Relation *expected){
 
       //if( result->toISLString() == expected->toISLString() ){
       if( isl_map_plain_is_equal( resISL , expISL ) ){
-        cout<<"\n\nResult MATCH Expected: Which is:\n"<<result->toISLString()<<"\n\n";
+        out<<"\n\nResult MATCH Expected: Which is:\n"<<result->toISLString()<<"\n\n";
       }
       else {
-        cout<<"\n\nResult DOES NOT MATCH Expected:\n"
+        out<<"\n\nResult DOES NOT MATCH Expected:\n"
             "Expected:\n"<<expected->toISLString()<<
              "\nResult:\n"<<result->toISLString()<<"\n\n";
       }
@@ -179,6 +202,32 @@ void EXPECT_EQ(Relation *result, Relation *expected){
 
 
 
+// Simplifies the inputFiles on threads threads (0: one per core). Every
+// thread works in its own environment and buffers the output of a file,
+// which is printed once all files are done.
+void simplifyInParallel(const vector<string>& inputFiles, unsigned int threads)
+{
+  if (threads == 0) { threads = thread::hardware_concurrency(); }
+  vector<string> outputs(inputFiles.size());
+  atomic<unsigned int> next(0);
+  auto worker = [&]() {
+    for (unsigned int f = next++; f < inputFiles.size(); f = next++) {
+      Environment env;
+      EnvironmentScope scope(env);
+      ostringstream out;
+      simplify(inputFiles[f], out);
+      outputs[f] = out.str();
+    }
+  };
+  vector<thread> pool;
+  for (unsigned int t = 0; t < threads && t < inputFiles.size(); t++) {
+    pool.push_back(thread(worker));
+  }
+  for (size_t t = 0; t < pool.size(); t++) { pool[t].join(); }
+
+  for (size_t f = 0; f < outputs.size(); f++) { cout<<outputs[f]; }
+}
+
 void EXPECT_EQ(string a, string b){
 
     if( a != b ){
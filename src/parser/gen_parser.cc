@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2013 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,17 +45,17 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.2"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -61,154 +66,225 @@
 
 
 
-/* Copy the first part of user declarations.  */
-#line 18 "parser/parser.y" /* yacc.c:339  */
+/* First part of user prologue.  */
+#line 22 "parser/parser.y"
 
-   extern int yylex ();
    #include <parser/parser.h>
    #include <iostream>
    #include <list>
    #include <stack>
-   #define YYERROR_VERBOSE
    #define YYDEBUG 1
 
-   //Required for yyerror below
-   void yyerror(const char*);
-   extern char *yytext;
-   extern int yylineno;
-
    using namespace iegenlib;
 
 
-#line 84 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:339  */
+#line 82 "parser/gen_parser.cc"
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "gen_parser.hh".  */
-#ifndef YY_YY_HOME_KING_TOOLS_BRANCH_ISLUPDATE_SRC_PARSER_GEN_PARSER_HH_INCLUDED
-# define YY_YY_HOME_KING_TOOLS_BRANCH_ISLUPDATE_SRC_PARSER_GEN_PARSER_HH_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    LBRACE = 258,
-    RBRACE = 259,
-    LBRACKET = 260,
-    RBRACKET = 261,
-    LPAREN = 262,
-    RPAREN = 263,
-    COMMA = 264,
-    COLON = 265,
-    LT = 266,
-    LTE = 267,
-    GT = 268,
-    GTE = 269,
-    SEMI = 270,
-    OR = 271,
-    UNION = 272,
-    INVERSE = 273,
-    EXISTS = 274,
-    EQ = 275,
-    ARROW = 276,
-    ID = 277,
-    INT = 278,
-    INVALID_ID = 279,
-    PLUS = 280,
-    DASH = 281,
-    STAR = 282,
-    UMINUS = 283,
-    AND = 284,
-    WAND = 285
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE YYSTYPE;
-union YYSTYPE
+#include "gen_parser.hh"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-#line 36 "parser/parser.y" /* yacc.c:355  */
-
-   std::string*                           sval;
-   int                                    ival;
-   iegenlib::TupleDecl*                   tdecl;
-   iegenlib::Environment*                 env;
-   iegenlib::Set*                         set;
-   iegenlib::Relation*                    relation;
-   iegenlib::Conjunction*                 conj;
-   std::list<iegenlib::Conjunction*>*     conjlist;
-   iegenlib::Exp*                         exp;
-   std::list<iegenlib::Exp*>*             explist;
-   std::list<std::string>*                symlist;
-   std::list<std::string>*                existslist;
-
-#line 170 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:355  */
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "$end"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_LBRACE = 3,                     /* LBRACE  */
+  YYSYMBOL_RBRACE = 4,                     /* RBRACE  */
+  YYSYMBOL_LBRACKET = 5,                   /* LBRACKET  */
+  YYSYMBOL_RBRACKET = 6,                   /* RBRACKET  */
+  YYSYMBOL_LPAREN = 7,                     /* LPAREN  */
+  YYSYMBOL_RPAREN = 8,                     /* RPAREN  */
+  YYSYMBOL_COMMA = 9,                      /* COMMA  */
+  YYSYMBOL_COLON = 10,                     /* COLON  */
+  YYSYMBOL_LT = 11,                        /* LT  */
+  YYSYMBOL_LTE = 12,                       /* LTE  */
+  YYSYMBOL_GT = 13,                        /* GT  */
+  YYSYMBOL_GTE = 14,                       /* GTE  */
+  YYSYMBOL_SEMI = 15,                      /* SEMI  */
+  YYSYMBOL_OR = 16,                        /* OR  */
+  YYSYMBOL_UNION = 17,                     /* UNION  */
+  YYSYMBOL_INVERSE = 18,                   /* INVERSE  */
+  YYSYMBOL_EXISTS = 19,                    /* EXISTS  */
+  YYSYMBOL_EQ = 20,                        /* EQ  */
+  YYSYMBOL_ARROW = 21,                     /* ARROW  */
+  YYSYMBOL_ID = 22,                        /* ID  */
+  YYSYMBOL_INT = 23,                       /* INT  */
+  YYSYMBOL_INVALID_ID = 24,                /* INVALID_ID  */
+  YYSYMBOL_PLUS = 25,                      /* PLUS  */
+  YYSYMBOL_DASH = 26,                      /* DASH  */
+  YYSYMBOL_STAR = 27,                      /* STAR  */
+  YYSYMBOL_UMINUS = 28,                    /* UMINUS  */
+  YYSYMBOL_AND = 29,                       /* AND  */
+  YYSYMBOL_WAND = 30,                      /* WAND  */
+  YYSYMBOL_YYACCEPT = 31,                  /* $accept  */
+  YYSYMBOL_Start = 32,                     /* Start  */
+  YYSYMBOL_environment = 33,               /* environment  */
+  YYSYMBOL_omega_set = 34,                 /* omega_set  */
+  YYSYMBOL_isl_set = 35,                   /* isl_set  */
+  YYSYMBOL_omega_relation = 36,            /* omega_relation  */
+  YYSYMBOL_isl_relation = 37,              /* isl_relation  */
+  YYSYMBOL_conjunct_list = 38,             /* conjunct_list  */
+  YYSYMBOL_single_conjunct = 39,           /* single_conjunct  */
+  YYSYMBOL_rel_conjunct_list = 40,         /* rel_conjunct_list  */
+  YYSYMBOL_rel_single_conjunct = 41,       /* rel_single_conjunct  */
+  YYSYMBOL_semi_conjunct_list = 42,        /* semi_conjunct_list  */
+  YYSYMBOL_semi_conjunct = 43,             /* semi_conjunct  */
+  YYSYMBOL_semi_rel_conjunct_list = 44,    /* semi_rel_conjunct_list  */
+  YYSYMBOL_semi_rel_conjunct = 45,         /* semi_rel_conjunct  */
+  YYSYMBOL_in_symbolic = 46,               /* in_symbolic  */
+  YYSYMBOL_symbol_list = 47,               /* symbol_list  */
+  YYSYMBOL_tuple_decl_with_brackets = 48,  /* tuple_decl_with_brackets  */
+  YYSYMBOL_tuple_decl = 49,                /* tuple_decl  */
+  YYSYMBOL_tuple_elem = 50,                /* tuple_elem  */
+  YYSYMBOL_variable_id = 51,               /* variable_id  */
+  YYSYMBOL_optional_constraints = 52,      /* optional_constraints  */
+  YYSYMBOL_constraint_list = 53,           /* constraint_list  */
+  YYSYMBOL_constraint = 54,                /* constraint  */
+  YYSYMBOL_constraint_eq = 55,             /* constraint_eq  */
+  YYSYMBOL_constraint_lt = 56,             /* constraint_lt  */
+  YYSYMBOL_constraint_lte = 57,            /* constraint_lte  */
+  YYSYMBOL_constraint_gt = 58,             /* constraint_gt  */
+  YYSYMBOL_constraint_gte = 59,            /* constraint_gte  */
+  YYSYMBOL_constraint_range = 60,          /* constraint_range  */
+  YYSYMBOL_constraint_range_lte_lt = 61,   /* constraint_range_lte_lt  */
+  YYSYMBOL_constraint_range_lt_lte = 62,   /* constraint_range_lt_lte  */
+  YYSYMBOL_constraint_range_lte_lte = 63,  /* constraint_range_lte_lte  */
+  YYSYMBOL_constraint_range_lt_lt = 64,    /* constraint_range_lt_lt  */
+  YYSYMBOL_expression = 65,                /* expression  */
+  YYSYMBOL_expression_tuple = 66,          /* expression_tuple  */
+  YYSYMBOL_expression_int = 67,            /* expression_int  */
+  YYSYMBOL_expression_unop = 68,           /* expression_unop  */
+  YYSYMBOL_expression_binop = 69,          /* expression_binop  */
+  YYSYMBOL_expression_int_mult = 70,       /* expression_int_mult  */
+  YYSYMBOL_expression_simple = 71,         /* expression_simple  */
+  YYSYMBOL_expression_id = 72,             /* expression_id  */
+  YYSYMBOL_expression_func = 73,           /* expression_func  */
+  YYSYMBOL_expression_list = 74            /* expression_list  */
 };
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
 
-extern YYSTYPE yylval;
 
-int yyparse (void);
+/* Unqualified %code blocks.  */
+#line 56 "parser/parser.y"
 
-#endif /* !YY_YY_HOME_KING_TOOLS_BRANCH_ISLUPDATE_SRC_PARSER_GEN_PARSER_HH_INCLUDED  */
+   //Defined in gen_scanner.cc
+   int yylex(YYSTYPE* lvalp, void* scanner);
+   char* yyget_text(void* scanner);
+   int yyget_lineno(void* scanner);
 
-/* Copy the second part of user declarations.  */
+   //Required for yyerror below
+   void yyerror(iegenlib::parser::ParseState* state, void* scanner,
+                const char*);
 
-#line 185 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:358  */
+#line 202 "parser/gen_parser.cc"
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
 #else
 typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -216,15 +292,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -238,47 +327,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -291,8 +376,22 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -357,8 +456,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -367,17 +465,17 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -390,11 +488,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -406,12 +504,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -434,17 +532,20 @@ union yyalloc
 /* YYNSTATES -- Number of states.  */
 #define YYNSTATES  156
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   285
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -478,31 +579,38 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,   149,   149,   152,   155,   158,   161,   164,   168,   176,
-     189,   206,   221,   238,   246,   252,   272,   280,   286,   309,
-     315,   323,   344,   350,   358,   380,   388,   392,   394,   402,
-     409,   415,   419,   422,   430,   434,   441,   447,   453,   458,
-     461,   471,   475,   478,   485,   491,   497,   504,   510,   516,
-     519,   522,   525,   528,   531,   539,   548,   556,   565,   573,
-     576,   579,   582,   585,   604,   623,   641,   661,   664,   667,
-     670,   673,   676,   679,   700,   707,   713,   719,   726,   732,
-     738,   744,   747,   750,   753,   768,   782,   796,   806,   812
+       0,   166,   166,   169,   172,   175,   178,   181,   185,   193,
+     206,   223,   238,   255,   263,   269,   289,   297,   303,   326,
+     332,   340,   361,   367,   375,   397,   405,   409,   411,   419,
+     426,   432,   436,   439,   447,   451,   458,   464,   470,   475,
+     478,   488,   492,   495,   502,   508,   514,   521,   527,   533,
+     536,   539,   542,   545,   548,   556,   565,   573,   582,   590,
+     593,   596,   599,   602,   621,   640,   658,   678,   681,   684,
+     687,   690,   693,   696,   717,   724,   730,   736,   743,   749,
+     755,   761,   764,   767,   770,   785,   799,   813,   823,   829
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "LBRACE", "RBRACE", "LBRACKET",
-  "RBRACKET", "LPAREN", "RPAREN", "COMMA", "COLON", "LT", "LTE", "GT",
-  "GTE", "SEMI", "OR", "UNION", "INVERSE", "EXISTS", "EQ", "ARROW", "ID",
-  "INT", "INVALID_ID", "PLUS", "DASH", "STAR", "UMINUS", "AND", "WAND",
-  "$accept", "Start", "environment", "omega_set", "isl_set",
+  "\"$end\"", "error", "\"invalid token\"", "LBRACE", "RBRACE",
+  "LBRACKET", "RBRACKET", "LPAREN", "RPAREN", "COMMA", "COLON", "LT",
+  "LTE", "GT", "GTE", "SEMI", "OR", "UNION", "INVERSE", "EXISTS", "EQ",
+  "ARROW", "ID", "INT", "INVALID_ID", "PLUS", "DASH", "STAR", "UMINUS",
+  "AND", "WAND", "$accept", "Start", "environment", "omega_set", "isl_set",
   "omega_relation", "isl_relation", "conjunct_list", "single_conjunct",
   "rel_conjunct_list", "rel_single_conjunct", "semi_conjunct_list",
   "semi_conjunct", "semi_rel_conjunct_list", "semi_rel_conjunct",
@@ -516,32 +624,26 @@ static const char *const yytname[] =
   "expression_binop", "expression_int_mult", "expression_simple",
   "expression_id", "expression_func", "expression_list", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -57
+#define YYPACT_NINF (-57)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-57)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -84
+#define YYTABLE_NINF (-84)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int8 yypact[] =
 {
        9,   -57,    -9,    10,    19,   -57,   -57,   -57,   -57,   -57,
@@ -562,10 +664,10 @@ static const yytype_int8 yypact[] =
       13,    13,    13,    13,   123,   -57
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
 {
        0,     7,     0,     0,     0,     2,     3,     5,     4,     6,
        0,    28,     0,     0,     1,    31,     9,    13,    11,    16,
@@ -585,7 +687,7 @@ static const yytype_uint8 yydefact[] =
       66,    64,    63,    65,     0,    86
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
      -57,   -57,   -57,   -57,   -57,   -57,   -57,   -57,   109,   -57,
@@ -595,19 +697,19 @@ static const yytype_int8 yypgoto[] =
      -53,   -57,   -57,    37
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,     4,     5,     6,     7,     8,     9,    16,    17,    18,
+       0,     4,     5,     6,     7,     8,     9,    16,    17,    18,
       19,    51,    52,    54,    55,    10,    12,    53,    35,    36,
       61,    42,    62,    63,    64,    65,    66,    67,    68,    69,
       70,    71,    72,    73,    74,    75,    76,    77,    78,    79,
       80,    81,    82,    97
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
       26,    96,    92,    57,   101,    99,   100,    37,   103,    40,
@@ -644,9 +746,9 @@ static const yytype_int16 yycheck[] =
       23,    91,    15,    94,    15,    20,    27,    -1,    50,   102
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     1,     5,    22,    32,    33,    34,    35,    36,    37,
       46,    22,    47,     7,     0,     3,    38,    39,    40,    41,
@@ -666,8 +768,8 @@ static const yytype_uint8 yystos[] =
       65,    65,    65,    65,    23,     6
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
        0,    31,    32,    32,    32,    32,    32,    32,    33,    34,
       35,    36,    37,    38,    38,    39,    40,    40,    41,    42,
@@ -680,8 +782,8 @@ static const yytype_uint8 yyr1[] =
       70,    71,    71,    71,    72,    73,    73,    73,    74,    74
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
        0,     2,     1,     1,     1,     1,     1,     1,     8,     2,
        6,     2,     6,     1,     3,     4,     1,     3,     6,     3,
@@ -695,39 +797,39 @@ static const yytype_uint8 yyr2[] =
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (state, scanner, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 
 /* Enable debugging if requested.  */
@@ -744,55 +846,54 @@ do {                                            \
     YYFPRINTF Args;                             \
 } while (0)
 
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value); \
+                  Kind, Value, state, scanner); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, iegenlib::parser::ParseState* state, void* scanner)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (state);
+  YY_USE (scanner);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, iegenlib::parser::ParseState* state, void* scanner)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, state, scanner);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -801,7 +902,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -824,21 +925,21 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, iegenlib::parser::ParseState* state, void* scanner)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                                              );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], state, scanner);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -846,15 +947,15 @@ yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, Rule, state, scanner); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -877,28 +978,76 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yystrlen (const char *yystr)
 {
-  YYSIZE_T yylen;
+  YYPTRDIFF_T yylen;
   for (yylen = 0; yystr[yylen]; yylen++)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
 static char *
@@ -912,10 +1061,10 @@ yystpcpy (char *yydest, const char *yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -923,14 +1072,13 @@ yystpcpy (char *yydest, const char *yysrc)
    backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
    null, do not copy; instead, return the length of what the result
    would have been.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yytnamerr (char *yyres, const char *yystr)
 {
   if (*yystr == '"')
     {
-      YYSIZE_T yyn = 0;
+      YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
         switch (*++yyp)
           {
@@ -941,7 +1089,10 @@ yytnamerr (char *yyres, const char *yystr)
           case '\\':
             if (*++yyp != '\\')
               goto do_not_strip_quotes;
-            /* Fall through.  */
+            else
+              goto append;
+
+          append:
           default:
             if (yyres)
               yyres[yyn] = *yyp;
@@ -956,36 +1107,20 @@ yytnamerr (char *yyres, const char *yystr)
     do_not_strip_quotes: ;
     }
 
-  if (! yyres)
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
     return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
 }
-# endif
+#endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
 static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
 {
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
+  /* Actual size of YYARG. */
   int yycount = 0;
-
   /* There are many possibilities here to consider:
      - If this state is a consistent state with a default action, then
        the only way this function was invoked is if the default action
@@ -1009,63 +1144,78 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
        one exception: it will still contain any token that will not be
        accepted due to an error action in a later state.
   */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
     }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
 
   switch (yycount)
     {
-# define YYCASE_(N, S)                      \
+#define YYCASE_(N, S)                       \
       case N:                               \
         yyformat = S;                       \
-      break
+        break
+    default: /* Avoid compiler warnings. */
       YYCASE_(0, YY_("syntax error"));
       YYCASE_(1, YY_("syntax error, unexpected %s"));
       YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
       YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
       YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
       YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
+#undef YYCASE_
     }
 
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
   {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
   }
 
   if (*yymsg_alloc < yysize)
@@ -1074,7 +1224,7 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
       if (! (yysize <= *yymsg_alloc
              && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
         *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      return -1;
     }
 
   /* Avoid sprintf, as that infringes on the user's name space.
@@ -1086,305 +1236,307 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
     while ((*yyp = *yyformat) != '\0')
       if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
         {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
           yyformat += 2;
         }
       else
         {
-          yyp++;
-          yyformat++;
+          ++yyp;
+          ++yyformat;
         }
   }
   return 0;
 }
-#endif /* YYERROR_VERBOSE */
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, iegenlib::parser::ParseState* state, void* scanner)
 {
-  YYUSE (yyvaluep);
+  YY_USE (yyvaluep);
+  YY_USE (state);
+  YY_USE (scanner);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  switch (yytype)
+  switch (yykind)
     {
-          case 22: /* ID  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).sval));}
-#line 1121 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_ID: /* ID  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).sval));}
+#line 1274 "parser/gen_parser.cc"
         break;
 
-    case 23: /* INT  */
-#line 138 "parser/parser.y" /* yacc.c:1257  */
-      {}
-#line 1127 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_INT: /* INT  */
+#line 156 "parser/parser.y"
+            {}
+#line 1280 "parser/gen_parser.cc"
         break;
 
-    case 24: /* INVALID_ID  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).sval));}
-#line 1133 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_INVALID_ID: /* INVALID_ID  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).sval));}
+#line 1286 "parser/gen_parser.cc"
         break;
 
-    case 33: /* environment  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).env));}
-#line 1139 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_environment: /* environment  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).env));}
+#line 1292 "parser/gen_parser.cc"
         break;
 
-    case 34: /* omega_set  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).set));}
-#line 1145 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_omega_set: /* omega_set  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).set));}
+#line 1298 "parser/gen_parser.cc"
         break;
 
-    case 35: /* isl_set  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).set));}
-#line 1151 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_isl_set: /* isl_set  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).set));}
+#line 1304 "parser/gen_parser.cc"
         break;
 
-    case 36: /* omega_relation  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).relation));}
-#line 1157 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_omega_relation: /* omega_relation  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).relation));}
+#line 1310 "parser/gen_parser.cc"
         break;
 
-    case 37: /* isl_relation  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).relation));}
-#line 1163 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_isl_relation: /* isl_relation  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).relation));}
+#line 1316 "parser/gen_parser.cc"
         break;
 
-    case 38: /* conjunct_list  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).conjlist));}
-#line 1169 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_conjunct_list: /* conjunct_list  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).conjlist));}
+#line 1322 "parser/gen_parser.cc"
         break;
 
-    case 39: /* single_conjunct  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).conj));}
-#line 1175 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_single_conjunct: /* single_conjunct  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).conj));}
+#line 1328 "parser/gen_parser.cc"
         break;
 
-    case 40: /* rel_conjunct_list  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).conjlist));}
-#line 1181 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_rel_conjunct_list: /* rel_conjunct_list  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).conjlist));}
+#line 1334 "parser/gen_parser.cc"
         break;
 
-    case 41: /* rel_single_conjunct  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).conj));}
-#line 1187 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_rel_single_conjunct: /* rel_single_conjunct  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).conj));}
+#line 1340 "parser/gen_parser.cc"
         break;
 
-    case 42: /* semi_conjunct_list  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).conjlist));}
-#line 1193 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_semi_conjunct_list: /* semi_conjunct_list  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).conjlist));}
+#line 1346 "parser/gen_parser.cc"
         break;
 
-    case 43: /* semi_conjunct  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).conj));}
-#line 1199 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_semi_conjunct: /* semi_conjunct  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).conj));}
+#line 1352 "parser/gen_parser.cc"
         break;
 
-    case 44: /* semi_rel_conjunct_list  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).conjlist));}
-#line 1205 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_semi_rel_conjunct_list: /* semi_rel_conjunct_list  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).conjlist));}
+#line 1358 "parser/gen_parser.cc"
         break;
 
-    case 45: /* semi_rel_conjunct  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).conj));}
-#line 1211 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_semi_rel_conjunct: /* semi_rel_conjunct  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).conj));}
+#line 1364 "parser/gen_parser.cc"
         break;
 
-    case 46: /* in_symbolic  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).symlist));}
-#line 1217 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_in_symbolic: /* in_symbolic  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).symlist));}
+#line 1370 "parser/gen_parser.cc"
         break;
 
-    case 47: /* symbol_list  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).symlist));}
-#line 1223 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_symbol_list: /* symbol_list  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).symlist));}
+#line 1376 "parser/gen_parser.cc"
         break;
 
-    case 48: /* tuple_decl_with_brackets  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).tdecl));}
-#line 1229 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_tuple_decl_with_brackets: /* tuple_decl_with_brackets  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).tdecl));}
+#line 1382 "parser/gen_parser.cc"
         break;
 
-    case 49: /* tuple_decl  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).tdecl));}
-#line 1235 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_tuple_decl: /* tuple_decl  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).tdecl));}
+#line 1388 "parser/gen_parser.cc"
         break;
 
-    case 50: /* tuple_elem  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).tdecl));}
-#line 1241 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_tuple_elem: /* tuple_elem  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).tdecl));}
+#line 1394 "parser/gen_parser.cc"
         break;
 
-    case 51: /* variable_id  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).sval));}
-#line 1247 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_variable_id: /* variable_id  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).sval));}
+#line 1400 "parser/gen_parser.cc"
         break;
 
-    case 52: /* optional_constraints  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).explist));}
-#line 1253 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_optional_constraints: /* optional_constraints  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).explist));}
+#line 1406 "parser/gen_parser.cc"
         break;
 
-    case 53: /* constraint_list  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).explist));}
-#line 1259 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_constraint_list: /* constraint_list  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).explist));}
+#line 1412 "parser/gen_parser.cc"
         break;
 
-    case 54: /* constraint  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).exp));}
-#line 1265 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_constraint: /* constraint  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).exp));}
+#line 1418 "parser/gen_parser.cc"
         break;
 
-    case 55: /* constraint_eq  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).exp));}
-#line 1271 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_constraint_eq: /* constraint_eq  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).exp));}
+#line 1424 "parser/gen_parser.cc"
         break;
 
-    case 56: /* constraint_lt  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).exp));}
-#line 1277 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_constraint_lt: /* constraint_lt  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).exp));}
+#line 1430 "parser/gen_parser.cc"
         break;
 
-    case 57: /* constraint_lte  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).exp));}
-#line 1283 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_constraint_lte: /* constraint_lte  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).exp));}
+#line 1436 "parser/gen_parser.cc"
         break;
 
-    case 58: /* constraint_gt  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).exp));}
-#line 1289 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_constraint_gt: /* constraint_gt  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).exp));}
+#line 1442 "parser/gen_parser.cc"
         break;
 
-    case 59: /* constraint_gte  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).exp));}
-#line 1295 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_constraint_gte: /* constraint_gte  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).exp));}
+#line 1448 "parser/gen_parser.cc"
         break;
 
-    case 60: /* constraint_range  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).explist));}
-#line 1301 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_constraint_range: /* constraint_range  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).explist));}
+#line 1454 "parser/gen_parser.cc"
         break;
 
-    case 61: /* constraint_range_lte_lt  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).explist));}
-#line 1307 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_constraint_range_lte_lt: /* constraint_range_lte_lt  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).explist));}
+#line 1460 "parser/gen_parser.cc"
         break;
 
-    case 62: /* constraint_range_lt_lte  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).explist));}
-#line 1313 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_constraint_range_lt_lte: /* constraint_range_lt_lte  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).explist));}
+#line 1466 "parser/gen_parser.cc"
         break;
 
-    case 63: /* constraint_range_lte_lte  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).explist));}
-#line 1319 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_constraint_range_lte_lte: /* constraint_range_lte_lte  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).explist));}
+#line 1472 "parser/gen_parser.cc"
         break;
 
-    case 64: /* constraint_range_lt_lt  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).explist));}
-#line 1325 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_constraint_range_lt_lt: /* constraint_range_lt_lt  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).explist));}
+#line 1478 "parser/gen_parser.cc"
         break;
 
-    case 65: /* expression  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).exp));}
-#line 1331 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_expression: /* expression  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).exp));}
+#line 1484 "parser/gen_parser.cc"
         break;
 
-    case 66: /* expression_tuple  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).exp));}
-#line 1337 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_expression_tuple: /* expression_tuple  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).exp));}
+#line 1490 "parser/gen_parser.cc"
         break;
 
-    case 67: /* expression_int  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).exp));}
-#line 1343 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_expression_int: /* expression_int  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).exp));}
+#line 1496 "parser/gen_parser.cc"
         break;
 
-    case 68: /* expression_unop  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).exp));}
-#line 1349 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_expression_unop: /* expression_unop  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).exp));}
+#line 1502 "parser/gen_parser.cc"
         break;
 
-    case 69: /* expression_binop  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).exp));}
-#line 1355 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_expression_binop: /* expression_binop  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).exp));}
+#line 1508 "parser/gen_parser.cc"
         break;
 
-    case 70: /* expression_int_mult  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).exp));}
-#line 1361 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_expression_int_mult: /* expression_int_mult  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).exp));}
+#line 1514 "parser/gen_parser.cc"
         break;
 
-    case 71: /* expression_simple  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).exp));}
-#line 1367 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_expression_simple: /* expression_simple  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).exp));}
+#line 1520 "parser/gen_parser.cc"
         break;
 
-    case 72: /* expression_id  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).exp));}
-#line 1373 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_expression_id: /* expression_id  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).exp));}
+#line 1526 "parser/gen_parser.cc"
         break;
 
-    case 73: /* expression_func  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).exp));}
-#line 1379 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_expression_func: /* expression_func  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).exp));}
+#line 1532 "parser/gen_parser.cc"
         break;
 
-    case 74: /* expression_list  */
-#line 139 "parser/parser.y" /* yacc.c:1257  */
-      {delete (((*yyvaluep).explist));}
-#line 1385 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1257  */
+    case YYSYMBOL_expression_list: /* expression_list  */
+#line 157 "parser/parser.y"
+            {delete (((*yyvaluep).explist));}
+#line 1538 "parser/gen_parser.cc"
         break;
 
-
       default:
         break;
     }
@@ -1394,13 +1546,6 @@ yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
 
 
 
-/* The lookahead symbol.  */
-int yychar;
-
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-/* Number of syntax errors so far.  */
-int yynerrs;
 
 
 /*----------.
@@ -1408,45 +1553,54 @@ int yynerrs;
 `----------*/
 
 int
-yyparse (void)
+yyparse (iegenlib::parser::ParseState* state, void* scanner)
 {
-    int yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+/* Lookahead token kind.  */
+int yychar;
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1454,71 +1608,75 @@ yyparse (void)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
 
         /* Each stack pointer address is followed by the size of the
            data in use in that stack, in bytes.  This used to be a
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
                     &yystacksize);
-
         yyss = yyss1;
         yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
@@ -1526,30 +1684,31 @@ yyparse (void)
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1560,18 +1719,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = yylex ();
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, scanner);
     }
 
-  if (yychar <= YYEOF)
+  if (yychar <= END)
     {
-      yychar = yytoken = YYEOF;
+      yychar = END;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1599,15 +1769,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1622,7 +1790,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1642,56 +1810,56 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 150 "parser/parser.y" /* yacc.c:1646  */
-    {parser::set_parse_env_result((yyvsp[0].env));}
-#line 1649 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 2: /* Start: environment  */
+#line 167 "parser/parser.y"
+         {state->envResult = (yyvsp[0].env);}
+#line 1817 "parser/gen_parser.cc"
     break;
 
-  case 3:
-#line 153 "parser/parser.y" /* yacc.c:1646  */
-    {parser::set_parse_set_result((yyvsp[0].set));}
-#line 1655 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 3: /* Start: omega_set  */
+#line 170 "parser/parser.y"
+         {state->setResult = (yyvsp[0].set);}
+#line 1823 "parser/gen_parser.cc"
     break;
 
-  case 4:
-#line 156 "parser/parser.y" /* yacc.c:1646  */
-    {parser::set_parse_relation_result((yyvsp[0].relation)); }
-#line 1661 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 4: /* Start: omega_relation  */
+#line 173 "parser/parser.y"
+         {state->relationResult = (yyvsp[0].relation);}
+#line 1829 "parser/gen_parser.cc"
     break;
 
-  case 5:
-#line 159 "parser/parser.y" /* yacc.c:1646  */
-    {parser::set_parse_set_result((yyvsp[0].set));}
-#line 1667 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 5: /* Start: isl_set  */
+#line 176 "parser/parser.y"
+         {state->setResult = (yyvsp[0].set);}
+#line 1835 "parser/gen_parser.cc"
     break;
 
-  case 6:
-#line 162 "parser/parser.y" /* yacc.c:1646  */
-    {parser::set_parse_relation_result((yyvsp[0].relation));}
-#line 1673 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 6: /* Start: isl_relation  */
+#line 179 "parser/parser.y"
+         {state->relationResult = (yyvsp[0].relation);}
+#line 1841 "parser/gen_parser.cc"
     break;
 
-  case 7:
-#line 165 "parser/parser.y" /* yacc.c:1646  */
-    {yyclearin;}
-#line 1679 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 7: /* Start: error  */
+#line 182 "parser/parser.y"
+         {yyclearin;}
+#line 1847 "parser/gen_parser.cc"
     break;
 
-  case 8:
-#line 169 "parser/parser.y" /* yacc.c:1646  */
-    { Environment* env = new Environment();
+  case 8: /* environment: ID LPAREN RPAREN EQ INVERSE ID LPAREN RPAREN  */
+#line 186 "parser/parser.y"
+         { Environment* env = new Environment();
            env->setInverse(*(yyvsp[-7].sval),*(yyvsp[-2].sval));
            delete (yyvsp[-7].sval);
            delete (yyvsp[-2].sval);
            (yyval.env) = env;
          }
-#line 1690 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 1858 "parser/gen_parser.cc"
     break;
 
-  case 9:
-#line 177 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 9: /* omega_set: in_symbolic conjunct_list  */
+#line 194 "parser/parser.y"
+         {
             std::list<Conjunction*>::iterator it=(yyvsp[0].conjlist)->begin();
             std::list<Conjunction*>::iterator end=(yyvsp[0].conjlist)->end();
             Set* set = new Set((*it)->arity());
@@ -1702,12 +1870,12 @@ yyreduce:
             delete (yyvsp[0].conjlist);
             delete (yyvsp[-1].symlist);
          }
-#line 1706 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 1874 "parser/gen_parser.cc"
     break;
 
-  case 10:
-#line 190 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 10: /* isl_set: in_symbolic LBRACE semi_conjunct SEMI semi_conjunct_list RBRACE  */
+#line 207 "parser/parser.y"
+         {
             Set* set = new Set((yyvsp[-3].conj)->arity());
             set->addConjunction((yyvsp[-3].conj));
 
@@ -1720,12 +1888,12 @@ yyreduce:
             delete (yyvsp[-1].conjlist);
             delete (yyvsp[-5].symlist);
          }
-#line 1724 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 1892 "parser/gen_parser.cc"
     break;
 
-  case 11:
-#line 207 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 11: /* omega_relation: in_symbolic rel_conjunct_list  */
+#line 224 "parser/parser.y"
+         {
             std::list<Conjunction*>::iterator it=(yyvsp[0].conjlist)->begin();
             std::list<Conjunction*>::iterator end=(yyvsp[0].conjlist)->end();
             int inarity = (*it)->inarity();
@@ -1738,12 +1906,12 @@ yyreduce:
             delete (yyvsp[0].conjlist);
             delete (yyvsp[-1].symlist);
          }
-#line 1742 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 1910 "parser/gen_parser.cc"
     break;
 
-  case 12:
-#line 222 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 12: /* isl_relation: in_symbolic LBRACE semi_rel_conjunct SEMI semi_rel_conjunct_list RBRACE  */
+#line 239 "parser/parser.y"
+         {
             int inarity = (yyvsp[-3].conj)->inarity();
             int outarity = (yyvsp[-3].conj)->arity()-inarity;
             Relation* relation = new Relation(inarity,outarity);
@@ -1758,32 +1926,32 @@ yyreduce:
             delete (yyvsp[-1].conjlist);
             delete (yyvsp[-5].symlist);
          }
-#line 1762 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 1930 "parser/gen_parser.cc"
     break;
 
-  case 13:
-#line 239 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 13: /* conjunct_list: single_conjunct  */
+#line 256 "parser/parser.y"
+         {
             std::list<Conjunction*>* conlist=
                new std::list<Conjunction*>();
             conlist->push_back((yyvsp[0].conj));
             (yyval.conjlist) = conlist;
          }
-#line 1773 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 1941 "parser/gen_parser.cc"
     break;
 
-  case 14:
-#line 247 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 14: /* conjunct_list: conjunct_list UNION single_conjunct  */
+#line 264 "parser/parser.y"
+         {
             (yyvsp[-2].conjlist)->push_back((yyvsp[0].conj));
             (yyval.conjlist)=(yyvsp[-2].conjlist);
          }
-#line 1782 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 1950 "parser/gen_parser.cc"
     break;
 
-  case 15:
-#line 253 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 15: /* single_conjunct: LBRACE tuple_decl_with_brackets optional_constraints RBRACE  */
+#line 270 "parser/parser.y"
+         {
             Conjunction* conj = new Conjunction((yyvsp[-2].tdecl)->size());
             conj->setTupleDecl( *((yyvsp[-2].tdecl)) );
             delete (yyvsp[-2].tdecl);
@@ -1801,32 +1969,32 @@ yyreduce:
             (yyval.conj) = conj;
             delete (yyvsp[-1].explist);
          }
-#line 1805 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 1973 "parser/gen_parser.cc"
     break;
 
-  case 16:
-#line 273 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 16: /* rel_conjunct_list: rel_single_conjunct  */
+#line 290 "parser/parser.y"
+         {
             std::list<Conjunction*>* conlist=
                new std::list<Conjunction*>();
             conlist->push_back((yyvsp[0].conj));
             (yyval.conjlist) = conlist;
          }
-#line 1816 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 1984 "parser/gen_parser.cc"
     break;
 
-  case 17:
-#line 281 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 17: /* rel_conjunct_list: rel_conjunct_list UNION rel_single_conjunct  */
+#line 298 "parser/parser.y"
+         {
             (yyvsp[-2].conjlist)->push_back((yyvsp[0].conj));
             (yyval.conjlist)=(yyvsp[-2].conjlist);
          }
-#line 1825 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 1993 "parser/gen_parser.cc"
     break;
 
-  case 18:
-#line 287 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 18: /* rel_single_conjunct: LBRACE tuple_decl_with_brackets ARROW tuple_decl_with_brackets optional_constraints RBRACE  */
+#line 304 "parser/parser.y"
+         {
             int arity = (yyvsp[-4].tdecl)->size() + (yyvsp[-2].tdecl)->size(), inarity = (yyvsp[-4].tdecl)->size();
             Conjunction* conj = new Conjunction(arity, inarity);
             conj->setTupleDecl( *((yyvsp[-4].tdecl)), *((yyvsp[-2].tdecl)) );
@@ -1847,32 +2015,32 @@ yyreduce:
 
             delete (yyvsp[-1].explist);
          }
-#line 1851 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2019 "parser/gen_parser.cc"
     break;
 
-  case 19:
-#line 310 "parser/parser.y" /* yacc.c:1646  */
-    { 
+  case 19: /* semi_conjunct_list: semi_conjunct SEMI semi_conjunct_list  */
+#line 327 "parser/parser.y"
+         { 
             (yyvsp[0].conjlist)->push_back((yyvsp[-2].conj)); 
             (yyval.conjlist) = (yyvsp[0].conjlist); 
          }
-#line 1860 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2028 "parser/gen_parser.cc"
     break;
 
-  case 20:
-#line 316 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 20: /* semi_conjunct_list: semi_conjunct  */
+#line 333 "parser/parser.y"
+         {
             std::list<Conjunction*>* conlist = 
                new std::list<Conjunction*>();
             conlist->push_back((yyvsp[0].conj));
             (yyval.conjlist) = conlist;
          }
-#line 1871 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2039 "parser/gen_parser.cc"
     break;
 
-  case 21:
-#line 324 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 21: /* semi_conjunct: tuple_decl_with_brackets optional_constraints  */
+#line 341 "parser/parser.y"
+         {
             Conjunction* conj = new Conjunction((yyvsp[-1].tdecl)->size());
             conj->setTupleDecl(*((yyvsp[-1].tdecl)));
             delete (yyvsp[-1].tdecl);
@@ -1891,32 +2059,32 @@ yyreduce:
             delete (yyvsp[0].explist);
 
          }
-#line 1895 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2063 "parser/gen_parser.cc"
     break;
 
-  case 22:
-#line 345 "parser/parser.y" /* yacc.c:1646  */
-    { 
+  case 22: /* semi_rel_conjunct_list: semi_rel_conjunct SEMI semi_rel_conjunct_list  */
+#line 362 "parser/parser.y"
+         { 
             (yyvsp[0].conjlist)->push_back((yyvsp[-2].conj)); 
             (yyval.conjlist) = (yyvsp[0].conjlist); 
          }
-#line 1904 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2072 "parser/gen_parser.cc"
     break;
 
-  case 23:
-#line 351 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 23: /* semi_rel_conjunct_list: semi_rel_conjunct  */
+#line 368 "parser/parser.y"
+         {
             std::list<Conjunction*>* conlist = 
                new std::list<Conjunction*>();
             conlist->push_back((yyvsp[0].conj));
             (yyval.conjlist) = conlist;
          }
-#line 1915 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2083 "parser/gen_parser.cc"
     break;
 
-  case 24:
-#line 359 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 24: /* semi_rel_conjunct: tuple_decl_with_brackets ARROW tuple_decl_with_brackets optional_constraints  */
+#line 376 "parser/parser.y"
+         {
             int arity = (yyvsp[-3].tdecl)->size() + (yyvsp[-1].tdecl)->size(), inarity = (yyvsp[-1].tdecl)->size();
             Conjunction* conj = new Conjunction(arity, inarity);
             conj->setTupleDecl(*((yyvsp[-3].tdecl)),*((yyvsp[-1].tdecl)));
@@ -1937,134 +2105,134 @@ yyreduce:
             delete (yyvsp[0].explist);
 
          }
-#line 1941 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2109 "parser/gen_parser.cc"
     break;
 
-  case 25:
-#line 381 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 25: /* semi_rel_conjunct: tuple_decl_with_brackets ARROW error  */
+#line 398 "parser/parser.y"
+      {
             delete (yyvsp[-2].tdecl);
             (yyval.conj) =  new Conjunction(0,0);
             yyclearin;
       }
-#line 1951 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2119 "parser/gen_parser.cc"
     break;
 
-  case 26:
-#line 389 "parser/parser.y" /* yacc.c:1646  */
-    {(yyval.symlist) = (yyvsp[-2].symlist);}
-#line 1957 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 26: /* in_symbolic: LBRACKET symbol_list RBRACKET ARROW  */
+#line 406 "parser/parser.y"
+         {(yyval.symlist) = (yyvsp[-2].symlist);}
+#line 2125 "parser/gen_parser.cc"
     break;
 
-  case 27:
-#line 392 "parser/parser.y" /* yacc.c:1646  */
-    {(yyval.symlist) = new std::list<std::string>();}
-#line 1963 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 27: /* in_symbolic: %empty  */
+#line 409 "parser/parser.y"
+         {(yyval.symlist) = new std::list<std::string>();}
+#line 2131 "parser/gen_parser.cc"
     break;
 
-  case 28:
-#line 395 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 28: /* symbol_list: ID  */
+#line 412 "parser/parser.y"
+         {
             std::list<std::string>* symbols = new std::list<std::string>();
             symbols->push_back(*(yyvsp[0].sval));
             (yyval.symlist) = symbols;
             delete (yyvsp[0].sval);
          }
-#line 1974 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2142 "parser/gen_parser.cc"
     break;
 
-  case 29:
-#line 403 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 29: /* symbol_list: ID COMMA symbol_list  */
+#line 420 "parser/parser.y"
+         {
             (yyvsp[0].symlist)->push_back(*(yyvsp[-2].sval));
             (yyval.symlist) = (yyvsp[0].symlist);
             delete (yyvsp[-2].sval);
          }
-#line 1984 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2152 "parser/gen_parser.cc"
     break;
 
-  case 30:
-#line 410 "parser/parser.y" /* yacc.c:1646  */
-    { 
+  case 30: /* tuple_decl_with_brackets: LBRACKET RBRACKET  */
+#line 427 "parser/parser.y"
+         { 
             (yyval.tdecl) = new TupleDecl();
          }
-#line 1992 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2160 "parser/gen_parser.cc"
     break;
 
-  case 31:
-#line 415 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 31: /* tuple_decl_with_brackets: %empty  */
+#line 432 "parser/parser.y"
+         {
             (yyval.tdecl) = new TupleDecl();
          }
-#line 2000 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2168 "parser/gen_parser.cc"
     break;
 
-  case 32:
-#line 420 "parser/parser.y" /* yacc.c:1646  */
-    { (yyval.tdecl)= (yyvsp[-1].tdecl); }
-#line 2006 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 32: /* tuple_decl_with_brackets: LBRACKET tuple_decl RBRACKET  */
+#line 437 "parser/parser.y"
+         { (yyval.tdecl)= (yyvsp[-1].tdecl); }
+#line 2174 "parser/gen_parser.cc"
     break;
 
-  case 33:
-#line 423 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 33: /* tuple_decl_with_brackets: LBRACKET tuple_decl error  */
+#line 440 "parser/parser.y"
+         {
             delete (yyvsp[-1].tdecl);
             (yyval.tdecl) = new TupleDecl(0);
             yyclearin;
          }
-#line 2016 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2184 "parser/gen_parser.cc"
     break;
 
-  case 34:
-#line 431 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 34: /* tuple_decl: tuple_elem  */
+#line 448 "parser/parser.y"
+         {
             (yyval.tdecl) = (yyvsp[0].tdecl);
          }
-#line 2024 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2192 "parser/gen_parser.cc"
     break;
 
-  case 35:
-#line 435 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 35: /* tuple_decl: tuple_decl COMMA tuple_elem  */
+#line 452 "parser/parser.y"
+         {
             (yyval.tdecl) = (yyvsp[-2].tdecl);
             (yyval.tdecl)->concat(*(yyvsp[0].tdecl));
             delete (yyvsp[0].tdecl);
          }
-#line 2034 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2202 "parser/gen_parser.cc"
     break;
 
-  case 36:
-#line 442 "parser/parser.y" /* yacc.c:1646  */
-    { (yyval.tdecl) = new TupleDecl(1);
+  case 36: /* tuple_elem: variable_id  */
+#line 459 "parser/parser.y"
+         { (yyval.tdecl) = new TupleDecl(1);
            (yyval.tdecl)->setTupleElem(0, *(yyvsp[0].sval));
            delete (yyvsp[0].sval);
          }
-#line 2043 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2211 "parser/gen_parser.cc"
     break;
 
-  case 37:
-#line 448 "parser/parser.y" /* yacc.c:1646  */
-    { (yyval.tdecl) = new TupleDecl(1);
+  case 37: /* tuple_elem: INT  */
+#line 465 "parser/parser.y"
+         { (yyval.tdecl) = new TupleDecl(1);
            (yyval.tdecl)->setTupleElem(0, (yyvsp[0].ival));
          }
-#line 2051 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2219 "parser/gen_parser.cc"
     break;
 
-  case 38:
-#line 454 "parser/parser.y" /* yacc.c:1646  */
-    {(yyval.sval) = (yyvsp[0].sval);}
-#line 2057 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 38: /* variable_id: ID  */
+#line 471 "parser/parser.y"
+         {(yyval.sval) = (yyvsp[0].sval);}
+#line 2225 "parser/gen_parser.cc"
     break;
 
-  case 39:
-#line 459 "parser/parser.y" /* yacc.c:1646  */
-    {(yyval.explist) = (yyvsp[0].explist);}
-#line 2063 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 39: /* optional_constraints: COLON constraint_list  */
+#line 476 "parser/parser.y"
+         {(yyval.explist) = (yyvsp[0].explist);}
+#line 2231 "parser/gen_parser.cc"
     break;
 
-  case 40:
-#line 462 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 40: /* optional_constraints: COLON constraint_list error  */
+#line 479 "parser/parser.y"
+         {
             for (std::list<Exp*>::iterator it=(yyvsp[-1].explist)->begin(); it!=(yyvsp[-1].explist)->end(); ++it)
             { delete *it; }
 
@@ -2072,191 +2240,191 @@ yyreduce:
             (yyval.explist) = new std::list<Exp*>();
             yyclearin;
          }
-#line 2076 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2244 "parser/gen_parser.cc"
     break;
 
-  case 41:
-#line 472 "parser/parser.y" /* yacc.c:1646  */
-    {(yyval.explist) = new std::list<Exp*>();}
-#line 2082 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 41: /* optional_constraints: COLON  */
+#line 489 "parser/parser.y"
+         {(yyval.explist) = new std::list<Exp*>();}
+#line 2250 "parser/gen_parser.cc"
     break;
 
-  case 42:
-#line 475 "parser/parser.y" /* yacc.c:1646  */
-    {(yyval.explist) = new std::list<Exp*>();}
-#line 2088 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 42: /* optional_constraints: %empty  */
+#line 492 "parser/parser.y"
+         {(yyval.explist) = new std::list<Exp*>();}
+#line 2256 "parser/gen_parser.cc"
     break;
 
-  case 43:
-#line 479 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 43: /* constraint_list: constraint  */
+#line 496 "parser/parser.y"
+         {
             std::list<Exp*>* clist = new std::list<Exp*>();
             clist->push_back((yyvsp[0].exp));
             (yyval.explist) = clist;
          }
-#line 2098 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2266 "parser/gen_parser.cc"
     break;
 
-  case 44:
-#line 486 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 44: /* constraint_list: constraint_list AND constraint  */
+#line 503 "parser/parser.y"
+         {
             (yyvsp[-2].explist)->push_back((yyvsp[0].exp));
             (yyval.explist) = (yyvsp[-2].explist);
          }
-#line 2107 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2275 "parser/gen_parser.cc"
     break;
 
-  case 45:
-#line 492 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 45: /* constraint_list: constraint_list WAND constraint  */
+#line 509 "parser/parser.y"
+         {
             (yyvsp[-2].explist)->push_back((yyvsp[0].exp));
             (yyval.explist) = (yyvsp[-2].explist);
          }
-#line 2116 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2284 "parser/gen_parser.cc"
     break;
 
-  case 46:
-#line 498 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 46: /* constraint_list: constraint_range  */
+#line 515 "parser/parser.y"
+         {
             std::list<Exp*>* clist = new std::list<Exp*>();
             clist->splice(clist->end(), *((yyvsp[0].explist)) );
             (yyval.explist) = clist;
          }
-#line 2126 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2294 "parser/gen_parser.cc"
     break;
 
-  case 47:
-#line 505 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 47: /* constraint_list: constraint_list AND constraint_range  */
+#line 522 "parser/parser.y"
+         {
             (yyvsp[-2].explist)->splice ((yyvsp[-2].explist)->end(), *((yyvsp[0].explist)) );
             (yyval.explist) = (yyvsp[-2].explist);
          }
-#line 2135 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2303 "parser/gen_parser.cc"
     break;
 
-  case 48:
-#line 511 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 48: /* constraint_list: constraint_list WAND constraint_range  */
+#line 528 "parser/parser.y"
+         {
             (yyvsp[-2].explist)->splice ((yyvsp[-2].explist)->end(), *((yyvsp[0].explist)) );
             (yyval.explist) = (yyvsp[-2].explist);
          }
-#line 2144 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2312 "parser/gen_parser.cc"
     break;
 
-  case 49:
-#line 517 "parser/parser.y" /* yacc.c:1646  */
-    {(yyval.exp) = (yyvsp[0].exp);}
-#line 2150 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 49: /* constraint: constraint_eq  */
+#line 534 "parser/parser.y"
+         {(yyval.exp) = (yyvsp[0].exp);}
+#line 2318 "parser/gen_parser.cc"
     break;
 
-  case 50:
-#line 520 "parser/parser.y" /* yacc.c:1646  */
-    {(yyval.exp) = (yyvsp[0].exp);}
-#line 2156 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 50: /* constraint: constraint_gt  */
+#line 537 "parser/parser.y"
+         {(yyval.exp) = (yyvsp[0].exp);}
+#line 2324 "parser/gen_parser.cc"
     break;
 
-  case 51:
-#line 523 "parser/parser.y" /* yacc.c:1646  */
-    {(yyval.exp) = (yyvsp[0].exp);}
-#line 2162 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 51: /* constraint: constraint_gte  */
+#line 540 "parser/parser.y"
+         {(yyval.exp) = (yyvsp[0].exp);}
+#line 2330 "parser/gen_parser.cc"
     break;
 
-  case 52:
-#line 526 "parser/parser.y" /* yacc.c:1646  */
-    {(yyval.exp) = (yyvsp[0].exp);}
-#line 2168 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 52: /* constraint: constraint_lt  */
+#line 543 "parser/parser.y"
+         {(yyval.exp) = (yyvsp[0].exp);}
+#line 2336 "parser/gen_parser.cc"
     break;
 
-  case 53:
-#line 529 "parser/parser.y" /* yacc.c:1646  */
-    {(yyval.exp) = (yyvsp[0].exp);}
-#line 2174 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 53: /* constraint: constraint_lte  */
+#line 546 "parser/parser.y"
+         {(yyval.exp) = (yyvsp[0].exp);}
+#line 2342 "parser/gen_parser.cc"
     break;
 
-  case 54:
-#line 532 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 54: /* constraint_eq: expression EQ expression  */
+#line 549 "parser/parser.y"
+         {
             (yyvsp[-2].exp)->setEquality();
             (yyvsp[0].exp)->multiplyBy(-1);
             (yyvsp[-2].exp)->addExp((yyvsp[0].exp));
             (yyval.exp) = (yyvsp[-2].exp);
          }
-#line 2185 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2353 "parser/gen_parser.cc"
     break;
 
-  case 55:
-#line 540 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 55: /* constraint_lt: expression LT expression  */
+#line 557 "parser/parser.y"
+         {
             (yyvsp[0].exp)->setInequality();
             (yyvsp[-2].exp)->addTerm(new Term(1));
             (yyvsp[-2].exp)->multiplyBy(-1);
             (yyvsp[0].exp)->addExp((yyvsp[-2].exp));
             (yyval.exp) = (yyvsp[0].exp);
          }
-#line 2197 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2365 "parser/gen_parser.cc"
     break;
 
-  case 56:
-#line 549 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 56: /* constraint_lte: expression LTE expression  */
+#line 566 "parser/parser.y"
+         {
             (yyvsp[0].exp)->setInequality();
             (yyvsp[-2].exp)->multiplyBy(-1);
             (yyvsp[0].exp)->addExp((yyvsp[-2].exp));
             (yyval.exp) = (yyvsp[0].exp);
          }
-#line 2208 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2376 "parser/gen_parser.cc"
     break;
 
-  case 57:
-#line 557 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 57: /* constraint_gt: expression GT expression  */
+#line 574 "parser/parser.y"
+         {
             (yyvsp[-2].exp)->setInequality();
             (yyvsp[0].exp)->addTerm(new Term(1));
             (yyvsp[0].exp)->multiplyBy(-1);
             (yyvsp[-2].exp)->addExp((yyvsp[0].exp));
             (yyval.exp) = (yyvsp[-2].exp);
          }
-#line 2220 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2388 "parser/gen_parser.cc"
     break;
 
-  case 58:
-#line 566 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 58: /* constraint_gte: expression GTE expression  */
+#line 583 "parser/parser.y"
+         {
             (yyvsp[-2].exp)->setInequality();
             (yyvsp[0].exp)->multiplyBy(-1);
             (yyvsp[-2].exp)->addExp((yyvsp[0].exp));
             (yyval.exp) = (yyvsp[-2].exp);
          }
-#line 2231 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2399 "parser/gen_parser.cc"
     break;
 
-  case 59:
-#line 574 "parser/parser.y" /* yacc.c:1646  */
-    {(yyval.explist) = (yyvsp[0].explist);}
-#line 2237 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 59: /* constraint_range: constraint_range_lte_lt  */
+#line 591 "parser/parser.y"
+         {(yyval.explist) = (yyvsp[0].explist);}
+#line 2405 "parser/gen_parser.cc"
     break;
 
-  case 60:
-#line 577 "parser/parser.y" /* yacc.c:1646  */
-    {(yyval.explist) = (yyvsp[0].explist);}
-#line 2243 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 60: /* constraint_range: constraint_range_lt_lte  */
+#line 594 "parser/parser.y"
+         {(yyval.explist) = (yyvsp[0].explist);}
+#line 2411 "parser/gen_parser.cc"
     break;
 
-  case 61:
-#line 580 "parser/parser.y" /* yacc.c:1646  */
-    {(yyval.explist) = (yyvsp[0].explist);}
-#line 2249 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 61: /* constraint_range: constraint_range_lte_lte  */
+#line 597 "parser/parser.y"
+         {(yyval.explist) = (yyvsp[0].explist);}
+#line 2417 "parser/gen_parser.cc"
     break;
 
-  case 62:
-#line 583 "parser/parser.y" /* yacc.c:1646  */
-    {(yyval.explist) = (yyvsp[0].explist);}
-#line 2255 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 62: /* constraint_range: constraint_range_lt_lt  */
+#line 600 "parser/parser.y"
+         {(yyval.explist) = (yyvsp[0].explist);}
+#line 2423 "parser/gen_parser.cc"
     break;
 
-  case 63:
-#line 586 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 63: /* constraint_range_lte_lt: expression LTE expression LT expression  */
+#line 603 "parser/parser.y"
+         {
             Exp* tExp = (yyvsp[-2].exp)->clone();
 
             (yyvsp[-2].exp)->setInequality();
@@ -2273,12 +2441,12 @@ yyreduce:
             clist->push_back((yyvsp[0].exp));
             (yyval.explist) = clist;
          }
-#line 2277 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2445 "parser/gen_parser.cc"
     break;
 
-  case 64:
-#line 605 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 64: /* constraint_range_lt_lte: expression LT expression LTE expression  */
+#line 622 "parser/parser.y"
+         {
             Exp* tExp = (yyvsp[-2].exp)->clone();
 
             (yyvsp[-2].exp)->setInequality();
@@ -2295,12 +2463,12 @@ yyreduce:
             clist->push_back((yyvsp[0].exp));
             (yyval.explist) = clist;
          }
-#line 2299 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2467 "parser/gen_parser.cc"
     break;
 
-  case 65:
-#line 624 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 65: /* constraint_range_lte_lte: expression LTE expression LTE expression  */
+#line 641 "parser/parser.y"
+         {
             Exp* tExp = (yyvsp[-2].exp)->clone();
 
             (yyvsp[-2].exp)->setInequality();
@@ -2316,12 +2484,12 @@ yyreduce:
             clist->push_back((yyvsp[0].exp));
             (yyval.explist) = clist;
          }
-#line 2320 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2488 "parser/gen_parser.cc"
     break;
 
-  case 66:
-#line 642 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 66: /* constraint_range_lt_lt: expression LT expression LT expression  */
+#line 659 "parser/parser.y"
+         {
             Exp* tExp = (yyvsp[-2].exp)->clone();
 
             (yyvsp[-2].exp)->setInequality();
@@ -2339,48 +2507,48 @@ yyreduce:
             clist->push_back((yyvsp[0].exp));
             (yyval.explist) = clist;
          }
-#line 2343 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2511 "parser/gen_parser.cc"
     break;
 
-  case 67:
-#line 662 "parser/parser.y" /* yacc.c:1646  */
-    { (yyval.exp) = (yyvsp[0].exp); }
-#line 2349 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 67: /* expression: expression_int  */
+#line 679 "parser/parser.y"
+         { (yyval.exp) = (yyvsp[0].exp); }
+#line 2517 "parser/gen_parser.cc"
     break;
 
-  case 68:
-#line 665 "parser/parser.y" /* yacc.c:1646  */
-    { (yyval.exp) = (yyvsp[0].exp); }
-#line 2355 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 68: /* expression: expression_simple  */
+#line 682 "parser/parser.y"
+         { (yyval.exp) = (yyvsp[0].exp); }
+#line 2523 "parser/gen_parser.cc"
     break;
 
-  case 69:
-#line 668 "parser/parser.y" /* yacc.c:1646  */
-    { (yyval.exp) = (yyvsp[0].exp); }
-#line 2361 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 69: /* expression: expression_unop  */
+#line 685 "parser/parser.y"
+         { (yyval.exp) = (yyvsp[0].exp); }
+#line 2529 "parser/gen_parser.cc"
     break;
 
-  case 70:
-#line 671 "parser/parser.y" /* yacc.c:1646  */
-    { (yyval.exp) = (yyvsp[0].exp); }
-#line 2367 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 70: /* expression: expression_binop  */
+#line 688 "parser/parser.y"
+         { (yyval.exp) = (yyvsp[0].exp); }
+#line 2535 "parser/gen_parser.cc"
     break;
 
-  case 71:
-#line 674 "parser/parser.y" /* yacc.c:1646  */
-    { (yyval.exp) = (yyvsp[0].exp); }
-#line 2373 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 71: /* expression: expression_int_mult  */
+#line 691 "parser/parser.y"
+         { (yyval.exp) = (yyvsp[0].exp); }
+#line 2541 "parser/gen_parser.cc"
     break;
 
-  case 72:
-#line 677 "parser/parser.y" /* yacc.c:1646  */
-    { (yyval.exp) = (yyvsp[0].exp); }
-#line 2379 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 72: /* expression: expression_tuple  */
+#line 694 "parser/parser.y"
+         { (yyval.exp) = (yyvsp[0].exp); }
+#line 2547 "parser/gen_parser.cc"
     break;
 
-  case 73:
-#line 680 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 73: /* expression_tuple: LPAREN expression_list RPAREN  */
+#line 697 "parser/parser.y"
+         {
             // If there is only one expression then just pass
             // that up, otherwise create a TupleExpTerm and put that
             // in an Exp.
@@ -2399,106 +2567,106 @@ yyreduce:
             }
             delete (yyvsp[-1].explist);
          }
-#line 2403 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2571 "parser/gen_parser.cc"
     break;
 
-  case 74:
-#line 701 "parser/parser.y" /* yacc.c:1646  */
-    { 
+  case 74: /* expression_int: INT  */
+#line 718 "parser/parser.y"
+         { 
             Exp* exp = new Exp();
             exp->addTerm(new Term((yyvsp[0].ival)));
             (yyval.exp) = exp; 
          }
-#line 2413 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2581 "parser/gen_parser.cc"
     break;
 
-  case 75:
-#line 708 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 75: /* expression_unop: DASH expression  */
+#line 725 "parser/parser.y"
+         {
             (yyvsp[0].exp)->multiplyBy(-1);
             (yyval.exp) = (yyvsp[0].exp);
          }
-#line 2422 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2590 "parser/gen_parser.cc"
     break;
 
-  case 76:
-#line 714 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 76: /* expression_binop: expression PLUS expression  */
+#line 731 "parser/parser.y"
+         {
             (yyvsp[-2].exp)->addExp((yyvsp[0].exp));
             (yyval.exp) = (yyvsp[-2].exp);
          }
-#line 2431 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2599 "parser/gen_parser.cc"
     break;
 
-  case 77:
-#line 720 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 77: /* expression_binop: expression DASH expression  */
+#line 737 "parser/parser.y"
+         {
             (yyvsp[0].exp)->multiplyBy(-1);
             (yyvsp[-2].exp)->addExp((yyvsp[0].exp));
             (yyval.exp) = (yyvsp[-2].exp);
          }
-#line 2441 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2609 "parser/gen_parser.cc"
     break;
 
-  case 78:
-#line 727 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 78: /* expression_int_mult: INT expression_simple  */
+#line 744 "parser/parser.y"
+         {
             (yyvsp[0].exp)->multiplyBy((yyvsp[-1].ival));
             (yyval.exp) = (yyvsp[0].exp);
          }
-#line 2450 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2618 "parser/gen_parser.cc"
     break;
 
-  case 79:
-#line 733 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 79: /* expression_int_mult: INT STAR expression_simple  */
+#line 750 "parser/parser.y"
+         {
             (yyvsp[0].exp)->multiplyBy((yyvsp[-2].ival));
             (yyval.exp) = (yyvsp[0].exp);
          }
-#line 2459 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2627 "parser/gen_parser.cc"
     break;
 
-  case 80:
-#line 739 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 80: /* expression_int_mult: expression_simple STAR INT  */
+#line 756 "parser/parser.y"
+         {
             (yyvsp[-2].exp)->multiplyBy((yyvsp[0].ival));
             (yyval.exp) = (yyvsp[-2].exp);
          }
-#line 2468 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2636 "parser/gen_parser.cc"
     break;
 
-  case 81:
-#line 745 "parser/parser.y" /* yacc.c:1646  */
-    { (yyval.exp) = (yyvsp[0].exp); }
-#line 2474 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 81: /* expression_simple: expression_id  */
+#line 762 "parser/parser.y"
+         { (yyval.exp) = (yyvsp[0].exp); }
+#line 2642 "parser/gen_parser.cc"
     break;
 
-  case 82:
-#line 748 "parser/parser.y" /* yacc.c:1646  */
-    { (yyval.exp) = (yyvsp[0].exp); }
-#line 2480 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 82: /* expression_simple: expression_func  */
+#line 765 "parser/parser.y"
+         { (yyval.exp) = (yyvsp[0].exp); }
+#line 2648 "parser/gen_parser.cc"
     break;
 
-  case 83:
-#line 751 "parser/parser.y" /* yacc.c:1646  */
-    { (yyval.exp) = (yyvsp[0].exp); }
-#line 2486 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+  case 83: /* expression_simple: expression_tuple  */
+#line 768 "parser/parser.y"
+         { (yyval.exp) = (yyvsp[0].exp); }
+#line 2654 "parser/gen_parser.cc"
     break;
 
-  case 84:
-#line 754 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 84: /* expression_id: ID  */
+#line 771 "parser/parser.y"
+         {
             Exp* exp = new Exp();
             exp->addTerm(new VarTerm(*(yyvsp[0].sval)));
             (yyval.exp) = exp;
             delete (yyvsp[0].sval);
          }
-#line 2497 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2665 "parser/gen_parser.cc"
     break;
 
-  case 85:
-#line 769 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 85: /* expression_func: variable_id LPAREN expression_list RPAREN  */
+#line 786 "parser/parser.y"
+         {
             UFCallTerm* uf_call = new UFCallTerm(*(yyvsp[-3].sval), (yyvsp[-1].explist)->size());
             unsigned int count = 0;
             for (std::list<Exp*>::iterator i=(yyvsp[-1].explist)->begin(); i != (yyvsp[-1].explist)->end(); ++i) {
@@ -2510,12 +2678,12 @@ yyreduce:
             delete (yyvsp[-3].sval);
             delete (yyvsp[-1].explist);
          }
-#line 2514 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2682 "parser/gen_parser.cc"
     break;
 
-  case 86:
-#line 783 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 86: /* expression_func: variable_id LPAREN expression_list RPAREN LBRACKET INT RBRACKET  */
+#line 800 "parser/parser.y"
+         {
             UFCallTerm* uf_call = new UFCallTerm(*(yyvsp[-6].sval), (yyvsp[-4].explist)->size(), (yyvsp[-1].ival));
             unsigned int count = 0;
             for (std::list<Exp*>::iterator i=(yyvsp[-4].explist)->begin(); i != (yyvsp[-4].explist)->end(); ++i) {
@@ -2527,12 +2695,12 @@ yyreduce:
             delete (yyvsp[-4].explist);
             delete (yyvsp[-6].sval);
          }
-#line 2531 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2699 "parser/gen_parser.cc"
     break;
 
-  case 87:
-#line 797 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 87: /* expression_func: variable_id LPAREN expression_list error  */
+#line 814 "parser/parser.y"
+         {
             for (std::list<Exp*>::iterator it=(yyvsp[-1].explist)->begin(); it!=(yyvsp[-1].explist)->end(); ++it)
             { delete *it; }
             (yyval.exp) = new Exp();
@@ -2540,30 +2708,31 @@ yyreduce:
             delete (yyvsp[-1].explist);
             yyclearin;
          }
-#line 2544 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2712 "parser/gen_parser.cc"
     break;
 
-  case 88:
-#line 807 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 88: /* expression_list: expression_list COMMA expression  */
+#line 824 "parser/parser.y"
+         {
             (yyvsp[-2].explist)->push_back((yyvsp[0].exp));
             (yyval.explist) = (yyvsp[-2].explist);
          }
-#line 2553 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2721 "parser/gen_parser.cc"
     break;
 
-  case 89:
-#line 813 "parser/parser.y" /* yacc.c:1646  */
-    {
+  case 89: /* expression_list: expression  */
+#line 830 "parser/parser.y"
+         {
             std::list<Exp*>* exp_list = new std::list<Exp*>();
             exp_list->push_back((yyvsp[0].exp));
             (yyval.explist) = exp_list;
          }
-#line 2563 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2731 "parser/gen_parser.cc"
     break;
 
 
-#line 2567 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.cc" /* yacc.c:1646  */
+#line 2735 "parser/gen_parser.cc"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -2577,25 +2746,23 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -2606,65 +2773,59 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
       {
+        yypcontext_t yyctx
+          = {yyssp, yytoken};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
         if (yysyntax_error_status == 0)
           yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        else if (yysyntax_error_status == -1)
           {
             if (yymsg != yymsgbuf)
               YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
               {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
               }
             else
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
               }
           }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+        yyerror (state, scanner, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
          error, discard it.  */
 
-      if (yychar <= YYEOF)
+      if (yychar <= END)
         {
           /* Return failure if at end of input.  */
-          if (yychar == YYEOF)
+          if (yychar == END)
             YYABORT;
         }
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval);
+                      yytoken, &yylval, state, scanner);
           yychar = YYEMPTY;
         }
     }
@@ -2678,12 +2839,11 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
-
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -2700,13 +2860,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2720,7 +2881,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, state, scanner);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2732,7 +2893,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2743,33 +2904,37 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (state, scanner, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
-yyreturn:
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval);
+                  yytoken, &yylval, state, scanner);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -2778,38 +2943,39 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, state, scanner);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
   return yyresult;
 }
-#line 820 "parser/parser.y" /* yacc.c:1906  */
+
+#line 837 "parser/parser.y"
 
 
 
 /*! yyerror is called when an error occurs in parsing. It prints localion of the
 error as well as why the error occured to standard error. When an error occurs
-we set the parse_error;
+we set the error of the parse state;
+@param ParseState pointer of the parse
+@param scanner of the parse
 @param const char pointer
 */
 #include <iostream>
 #include <typeinfo>
 #include <sstream>
-void yyerror (const char *s)
+void yyerror (iegenlib::parser::ParseState* state, void* scanner,
+              const char *s)
 {
    std::stringstream EM;
-   EM << s << " at '" << yytext << "', line " << yylineno << std::endl;
-   //sets the parse error flag to true
-   parser::set_parse_error(EM.str());
-   parser::clearAll();
-   yyclearin;
+   EM << s << " at '" << yyget_text(scanner) << "', line "
+      << yyget_lineno(scanner) << std::endl;
+   //sets the parse error flag, the scanner gets end of input from then on
+   state->setError(EM.str());
 }
 
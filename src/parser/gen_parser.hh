@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2013 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -30,8 +31,12 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
-#ifndef YY_YY_HOME_KING_TOOLS_BRANCH_ISLUPDATE_SRC_PARSER_GEN_PARSER_HH_INCLUDED
-# define YY_YY_HOME_KING_TOOLS_BRANCH_ISLUPDATE_SRC_PARSER_GEN_PARSER_HH_INCLUDED
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_PARSER_GEN_PARSER_HH_INCLUDED
+# define YY_YY_PARSER_GEN_PARSER_HH_INCLUDED
 /* Debug traces.  */
 #ifndef YYDEBUG
 # define YYDEBUG 0
@@ -39,49 +44,59 @@
 #if YYDEBUG
 extern int yydebug;
 #endif
+/* "%code requires" blocks.  */
+#line 18 "parser/parser.y"
+
+   namespace iegenlib{ namespace parser{ struct ParseState; }}
 
-/* Token type.  */
+#line 53 "parser/gen_parser.hh"
+
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    LBRACE = 258,
-    RBRACE = 259,
-    LBRACKET = 260,
-    RBRACKET = 261,
-    LPAREN = 262,
-    RPAREN = 263,
-    COMMA = 264,
-    COLON = 265,
-    LT = 266,
-    LTE = 267,
-    GT = 268,
-    GTE = 269,
-    SEMI = 270,
-    OR = 271,
-    UNION = 272,
-    INVERSE = 273,
-    EXISTS = 274,
-    EQ = 275,
-    ARROW = 276,
-    ID = 277,
-    INT = 278,
-    INVALID_ID = 279,
-    PLUS = 280,
-    DASH = 281,
-    STAR = 282,
-    UMINUS = 283,
-    AND = 284,
-    WAND = 285
+    YYEMPTY = -2,
+    END = 0,                       /* "$end"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    LBRACE = 258,                  /* LBRACE  */
+    RBRACE = 259,                  /* RBRACE  */
+    LBRACKET = 260,                /* LBRACKET  */
+    RBRACKET = 261,                /* RBRACKET  */
+    LPAREN = 262,                  /* LPAREN  */
+    RPAREN = 263,                  /* RPAREN  */
+    COMMA = 264,                   /* COMMA  */
+    COLON = 265,                   /* COLON  */
+    LT = 266,                      /* LT  */
+    LTE = 267,                     /* LTE  */
+    GT = 268,                      /* GT  */
+    GTE = 269,                     /* GTE  */
+    SEMI = 270,                    /* SEMI  */
+    OR = 271,                      /* OR  */
+    UNION = 272,                   /* UNION  */
+    INVERSE = 273,                 /* INVERSE  */
+    EXISTS = 274,                  /* EXISTS  */
+    EQ = 275,                      /* EQ  */
+    ARROW = 276,                   /* ARROW  */
+    ID = 277,                      /* ID  */
+    INT = 278,                     /* INT  */
+    INVALID_ID = 279,              /* INVALID_ID  */
+    PLUS = 280,                    /* PLUS  */
+    DASH = 281,                    /* DASH  */
+    STAR = 282,                    /* STAR  */
+    UMINUS = 283,                  /* UMINUS  */
+    AND = 284,                     /* AND  */
+    WAND = 285                     /* WAND  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE YYSTYPE;
 union YYSTYPE
 {
-#line 36 "parser/parser.y" /* yacc.c:1909  */
+#line 41 "parser/parser.y"
 
    std::string*                           sval;
    int                                    ival;
@@ -96,15 +111,18 @@ union YYSTYPE
    std::list<std::string>*                symlist;
    std::list<std::string>*                existslist;
 
-#line 100 "/home/king/tools/branch/islUpdate/src/parser/gen_parser.hh" /* yacc.c:1909  */
+#line 115 "parser/gen_parser.hh"
+
 };
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
 
-extern YYSTYPE yylval;
 
-int yyparse (void);
 
-#endif /* !YY_YY_HOME_KING_TOOLS_BRANCH_ISLUPDATE_SRC_PARSER_GEN_PARSER_HH_INCLUDED  */
+int yyparse (iegenlib::parser::ParseState* state, void* scanner);
+
+
+#endif /* !YY_YY_PARSER_GEN_PARSER_HH_INCLUDED  */
@@ -16,55 +16,59 @@
 */
 
 #include <parser/parser.h>
+#include "gen_parser.hh"
 
-
-// The yyparse() routine will be defined in the c++ file generated by flex.
-// gen_parser.cc
-extern int yyparse();
-
-using namespace std;
+// The reentrant scanner is defined in the c++ file generated by flex,
+// gen_scanner.cc.
+int yylex_init_extra(iegenlib::parser::ParseState* state, void** scanner);
+int yylex_destroy(void* scanner);
 
 namespace iegenlib{ namespace parser{
 
-   /*! a string of input buffer */
-   string input_buffer;
+   ParseState::ParseState(const std::string& str) :
+      input(str), pos(0), error(false),
+      envResult(NULL), setResult(NULL), relationResult(NULL) {}
 
-   /*! the integer of our input position */
-   unsigned int input_pos;
-
-   /*! boolean flag set when an error occurs in the parser */
-   bool parse_error;
+   ParseState::~ParseState() {
+      delete envResult;
+      delete setResult;
+      delete relationResult;
+   }
 
-   /// error message for when an error occurs in the parser
-   string error_message;
-   /*! This is used for the actual parsing of the string we pass in we return
-   each char of the string
-   @return int the value of each char of our string */
-   int string_get_next_char() {
-      int retchar = 0;
+   void ParseState::setError(const std::string& message) {
+      error = true;
+      errorMessage = message;
+   }
 
+   int ParseState::nextChar() {
       //If we are not at the end of the input string buffer
-      if (input_pos<input_buffer.length() && !parse_error) {
+      if (pos < input.length() && !error) {
          //Return the next char in the string
-         retchar = input_buffer[input_pos];
-         input_pos += 1;
-      } else {
-         //Otherwise return EOF
-         retchar = EOF;
+         return input[pos++];
       }
-
-      return retchar;
+      //Otherwise return EOF
+      return EOF;
    }
 
-   /*! Environment pointer parse_env_result. */
-   Environment* parse_env_result;
+   /*! runs the parser over the input of state
+   @throws parse_exception if the input could not be parsed */
+   static void run(ParseState& state) {
+      void* scanner;
+      yylex_init_extra(&state, &scanner);
+      try {
+         yyparse(&state, scanner);
+      } catch (...) {
+         yylex_destroy(scanner);
+         throw;
+      }
+      yylex_destroy(scanner);
 
-   /*! Relation pointer parse_relation_result. */
-   Relation* parse_relation_result;
+      //if the error flag is set throw an exception
+      if (state.error) {
+         throw parse_exception(state.errorMessage);
+      }
+   }
 
-   /*! Set pointer parse_set_result. */
-   Set* parse_set_result;
-   
    /*! parser_env passes a string representation of an environment 
    to the parser and an Environment gets created.
    @param string env string that is to be parsed
@@ -72,175 +76,44 @@ namespace iegenlib{ namespace parser{
    @return Environment pointer when parsing is successful
    */
    Environment* parse_env(std::string env_string) {
-      //reset all fields
-      parser::parse_env_result=NULL;
-      parser::parse_relation_result=NULL;
-      parser::parse_set_result=NULL;
-      parse_error = false;
-      input_buffer.clear();
-
-      //Set the input buffer to the given env string
-      input_buffer=env_string;
-
-      //Set the starting position at the first character
-      input_pos=0;
-
-      //Run the parser
-      yyparse();
-
-      //if the error flag is set throw an exception
-      if(parse_error==true){
-         throw parse_exception(error_message);
-      }
-
-      //if a relation is returned from yyparse return null
-      if(parse_env_result == NULL){
-         return NULL;
-      }
-
-      return parse_env_result;
+      ParseState state(env_string);
+      run(state);
+
+      //if something else than an environment was parsed it is deleted
+      //with the state and we return null
+      Environment* result = state.envResult;
+      state.envResult = NULL;
+      return result;
    }
 
-   /*! getter for the parse_env_result
-   @return Environment* parse_env_result */
-   // FIXME: not sure why the other getters do copies.
-   // Should change them to be consistent with this one.
-   // NOT sure this is even used.
-   Environment* get_parse_env_result() {
-      return (parse_env_result);
-   }
-
-   /*! setter for the parse_env_result
-   @param Environment parse_env_result */
-   void set_parse_env_result(Environment* e) {
-      parser::parse_env_result=e;
-   }   
-   
-
    /*!parser_set passes a string representation of a set to the parser and a
    ParseSet gets created.
    @param string set string that is to be parsed
    @return Null pointer if error occurs or a relation is returned
    @return Set pointer when parsing is successful
    */
-   Set* parse_set(string set_string)  {
-      //reset all fields
-      parser::parse_env_result=NULL;
-      parser::parse_relation_result=NULL;
-      parser::parse_set_result=NULL;
-      parse_error = false;
-      input_buffer.clear();
-
-      //Set the input buffer to the given set string
-      input_buffer=set_string;
-
-      //Set the starting position at the first character
-      input_pos=0;
-
-      //Run the parser
-      yyparse();
-
-      //if the error flag is set throw an exception
-      if(parse_error==true){
-         throw parse_exception(error_message);
-      }
+   Set* parse_set(std::string set_string)  {
+      ParseState state(set_string);
+      run(state);
 
       //if a relation is returned from yyparse return null
-      if(parse_set_result == NULL){
-         return NULL;
-      }
-
-      return parse_set_result;
-   }
-
-   /*! getter for the parse_set_result
-   @return Set parse_set_result */
-   Set get_parse_set_result() {
-      return (*parse_set_result);
+      Set* result = state.setResult;
+      state.setResult = NULL;
+      return result;
    }
 
-   /*! setter for the parse_set_result
-   @param Set parse_set_result */
-   void set_parse_set_result(Set* s) {
-      parser::parse_set_result=s;
-   }
-
-
    /*! passes a relation string into the parser and creates the Relation
    @param string relation string that is to be parsed
    @return Null pointer if error occurs or a set is returned
    @return Relation pointer when parsing is successful */
-   Relation* parse_relation(string relation_string) {
-      //reset all fields
-      parser::parse_env_result=NULL;
-      parser::parse_relation_result=NULL;
-      parser::parse_set_result=NULL;
-      parse_error = false;
-      input_buffer.clear();
-
-      //Set the input buffer to the given relation string
-      input_buffer = relation_string;
-
-      //Set the starting position at the first character
-      input_pos=0;
-
-      //Run the parser
-      yyparse();
-
-      //if error flag is set then throw an exception
-      if(parse_error==true){
-        throw parse_exception(error_message);
-      }
+   Relation* parse_relation(std::string relation_string) {
+      ParseState state(relation_string);
+      run(state);
 
       //if a set is returned from yyparse return null
-      if(parse_relation_result==NULL){
-         return NULL;
-      }
-
-      return parse_relation_result;
-   }
-
-   /*! getter for the parse_relation_result
-    * the getter can only be called a single time
-    * the code that calls it gets a copy of the object
-    * and we delete our copy
-   @return Relation parse_relation_result */
-   Relation get_parse_relation_result() {
-      Relation retval = (*parse_relation_result);
-      delete parse_relation_result;
-      return retval;
-   }
-
-   /*! setter for the parse_relation_result
-   @param Relation parse_relation_result */
-   void set_parse_relation_result(Relation* s) {
-      parser::parse_relation_result=s;
-   }
-
-   /*! sets the parse_error flag to true */
-   void set_parse_error(string error){
-      parse_error = true;
-      error_message = error;
-   }
-
-   /*! getter for the parse_error flag
-   @return bool parse_error */
-   bool get_parse_error(){
-      return parse_error;
-   }
-
-   /*! clearAll frees (if needed) and resets the parse_relation_result and the
-   parse_set_result so no data is left in those variables*/
-   void clearAll(){
-      if(parse_relation_result!=NULL){
-         delete parse_relation_result;
-      }
-      if(parse_set_result!=NULL){
-         delete parse_set_result;
-      }
-      parser::parse_relation_result=NULL;
-      parser::parse_set_result=NULL;
-      input_buffer.clear();
+      Relation* result = state.relationResult;
+      state.relationResult = NULL;
+      return result;
    }
 
 }}//end namespace iegenlib::parser
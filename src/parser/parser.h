@@ -30,11 +30,48 @@
 
 /*!
     The parser namespace hides the set and relation lexer and parser
-    functions and associated global variables.
+    functions. All the state of one parse is in a ParseState that lives
+    for the duration of the parse_* call, so the parser is reentrant and
+    any number of threads can parse at the same time.
 */
 namespace iegenlib { namespace parser{
-   //! Used by lexer to obtain each character of input string being parsed.
-   int string_get_next_char();
+   /*! Everything one call to the parser works on: the input and the
+   position in it, the error flag and message, and the result. It is the
+   extra data of the parse's flex scanner. Results still owned by the
+   state are deleted with it. */
+   struct ParseState {
+      ParseState(const std::string& str);
+      ~ParseState();
+
+      /*! sets the error flag and message; the scanner gets end of
+      input from then on */
+      void setError(const std::string& message);
+
+      /*! This is used by the scanner for the actual parsing of the string,
+      we return each char of the string
+      @return int the value of each char of our string, EOF at the end of
+      it or after an error */
+      int nextChar();
+
+      //! string being parsed
+      std::string input;
+      //! position of the next character to return
+      unsigned int pos;
+
+      //! set when an error occurs in the parser
+      bool error;
+      //! error message for when an error occurs in the parser
+      std::string errorMessage;
+
+      //! result of the parse, the one the input describes is non-NULL
+      Environment* envResult;
+      Set* setResult;
+      Relation* relationResult;
+
+   private:
+      ParseState(const ParseState&);
+      ParseState& operator=(const ParseState&);
+   };
 
    /*!parser_env passes a string representation of an environment 
    to the parser and an Environment gets created.
@@ -44,10 +81,6 @@ namespace iegenlib { namespace parser{
    */
    Environment* parse_env(std::string env_string);
 
-   /*! setter for the parse_env_result
-   @param Environment parse_env_result */
-   void set_parse_env_result(Environment* env);
-
    /*!parser_set passes a string representation of a set to the parser and a
    Set gets created.
    @param string set string that is to be parsed
@@ -56,31 +89,12 @@ namespace iegenlib { namespace parser{
    */
    Set* parse_set(std::string set_string);
 
-   /*! setter for the parse_set_result
-   @param Set parse_set_result */
-   void set_parse_set_result(Set* s);
-
    /*! passes a relation string into the parser and creates the Relation
    @param string relation string that is to be parsed
    @return Null pointer if error occurs or a set is returned
    @return Relation pointer when parsing is successful */
    Relation* parse_relation(std::string relation_string);
 
-   /*! setter for the parse_relation_result
-   @param Relation parse_relation_result */
-   void set_parse_relation_result(Relation* s);
-
-   /*! sets the parse_error flag to true */
-   void set_parse_error(std::string err);
-
-   /*! getter for the parse_error flag
-   @return bool parse_error */
-   bool get_parse_error();
-
-   /*! clearAll frees (if needed) and resets the parse_relation_result and the
-   parse_set_result so no data is left in those variables*/
-   void clearAll();
-
 }}//end namespace iegenlib::parser
 
 #endif
@@ -15,24 +15,29 @@
 */
 
 
+%code requires {
+   namespace iegenlib{ namespace parser{ struct ParseState; }}
+}
+
 %{
-   extern int yylex ();
    #include <parser/parser.h>
    #include <iostream>
    #include <list>
    #include <stack>
-   #define YYERROR_VERBOSE
    #define YYDEBUG 1
 
-   //Required for yyerror below
-   void yyerror(const char*);
-   extern char *yytext;
-   extern int yylineno;
-
    using namespace iegenlib;
 
 %}
 
+//The parser is pure: everything one parse works on is in state and in
+//the reentrant flex scanner, which parse_set and friends in parser.cc
+//create for every call.
+%define api.pure full
+%define parse.error verbose
+%parse-param {iegenlib::parser::ParseState* state} {void* scanner}
+%lex-param {void* scanner}
+
 %union {
    std::string*                           sval;
    int                                    ival;
@@ -48,7 +53,20 @@
    std::list<std::string>*                existslist;
 };
 
+%code {
+   //Defined in gen_scanner.cc
+   int yylex(YYSTYPE* lvalp, void* scanner);
+   char* yyget_text(void* scanner);
+   int yyget_lineno(void* scanner);
+
+   //Required for yyerror below
+   void yyerror(iegenlib::parser::ParseState* state, void* scanner,
+                const char*);
+}
+
 //tokens
+//end of input keeps the name older bisons gave it in error messages
+%token END 0 "$end"
 %token LBRACE RBRACE
 %token LBRACKET RBRACKET
 %token LPAREN RPAREN
@@ -141,25 +159,24 @@
 
 %%
    //the start of the grammar can either take a set or relation
-   //set makes a call to set_parse_set_result in parser.cc setting the
-   //parsed set. relation makes a call to set_parse_relation_result in
-   //parser.cc setting the parsed relation
+   //the parsed set or relation is stored in the parse state for
+   //parse_set or parse_relation in parser.cc to return
 
    Start : 
         environment
-         {parser::set_parse_env_result($1);}
+         {state->envResult = $1;}
    
       | omega_set
-         {parser::set_parse_set_result($1);}
+         {state->setResult = $1;}
       
       | omega_relation
-         {parser::set_parse_relation_result($1); }
+         {state->relationResult = $1;}
 
       | isl_set
-         {parser::set_parse_set_result($1);}
+         {state->setResult = $1;}
 
       | isl_relation
-         {parser::set_parse_relation_result($1);}
+         {state->relationResult = $1;}
 
       | error
          {yyclearin;}
@@ -822,19 +839,21 @@
 
 /*! yyerror is called when an error occurs in parsing. It prints localion of the
 error as well as why the error occured to standard error. When an error occurs
-we set the parse_error;
+we set the error of the parse state;
+@param ParseState pointer of the parse
+@param scanner of the parse
 @param const char pointer
 */
 #include <iostream>
 #include <typeinfo>
 #include <sstream>
-void yyerror (const char *s)
+void yyerror (iegenlib::parser::ParseState* state, void* scanner,
+              const char *s)
 {
    std::stringstream EM;
-   EM << s << " at '" << yytext << "', line " << yylineno << std::endl;
-   //sets the parse error flag to true
-   parser::set_parse_error(EM.str());
-   parser::clearAll();
-   yyclearin;
+   EM << s << " at '" << yyget_text(scanner) << "', line "
+      << yyget_lineno(scanner) << std::endl;
+   //sets the parse error flag, the scanner gets end of input from then on
+   state->setError(EM.str());
 }
 
@@ -18,6 +18,8 @@
 #include <string>
 #include <parser/parser.h>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 using namespace iegenlib;
 
@@ -489,3 +491,69 @@ TEST(Parser, ConstraintRange) {
    delete s1;
 }
 
+
+// A failed parse leaves nothing behind that affects the next one.
+TEST(Parser, ParseAfterError) {
+   EXPECT_THROW(parser::parse_relation("{[v]->[1,w] : w = v + 7"),
+                parse_exception);
+   Set* s = parser::parse_set("{[i,j] : 0 <= i AND i < N and j = f(i)}");
+   EXPECT_EQ("{ [i, j] : __tv1 - f(__tv0) = 0 && __tv0 >= 0 "
+             "&& -__tv0 + N - 1 >= 0 }", s->toString());
+   delete s;
+}
+
+// Syntax errors say where they are, and name the end of input $end.
+TEST(Parser, ErrorMessage) {
+   std::string message;
+   try {
+      parser::parse_set("{[i] : i < }");
+   } catch (parse_exception &e) {
+      message = e.what();
+   }
+   EXPECT_EQ(0u, message.find("syntax error, unexpected RBRACE"));
+   EXPECT_NE(std::string::npos, message.find(" at '}', line 1"));
+
+   message.clear();
+   try {
+      parser::parse_set("{[i] : i < 10");
+   } catch (parse_exception &e) {
+      message = e.what();
+   }
+   EXPECT_EQ(0u, message.find("syntax error, unexpected $end"));
+}
+
+// Threads parsing at the same time get the same results as one thread.
+TEST(Parser, Threads) {
+   const char* relations[] = {
+      "{[i] -> [j] : 0 <= i < N and rowptr(i) <= j < rowptr(i+1)}",
+      "{[k] -> [i,j] : (i,j) = tau_inv(k) }",
+      "{[v]->[1,w] : w = v + 7 and v >= 0}",
+      "{[x] -> [y] : x*8=0 && y = x}"
+   };
+   const int num = sizeof(relations)/sizeof(relations[0]);
+   std::string expected[num];
+   for (int i = 0; i < num; i++) {
+      Relation* r = parser::parse_relation(relations[i]);
+      expected[i] = r->toString();
+      delete r;
+   }
+
+   std::vector<std::string> found[4];
+   std::vector<std::thread> threads;
+   for (int t = 0; t < 4; t++) {
+      threads.push_back(std::thread([&relations, &found, num, t]() {
+         for (int i = 0; i < 25*num; i++) {
+            Relation* r = parser::parse_relation(relations[i % num]);
+            found[t].push_back(r->toString());
+            delete r;
+         }
+      }));
+   }
+   for (unsigned int t = 0; t < threads.size(); t++) { threads[t].join(); }
+   for (int t = 0; t < 4; t++) {
+      ASSERT_EQ( 25u*num, found[t].size() );
+      for (unsigned int i = 0; i < found[t].size(); i++) {
+         EXPECT_EQ( expected[i % num], found[t][i] );
+      }
+   }
+}
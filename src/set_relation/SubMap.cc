@@ -19,13 +19,21 @@
 
 namespace iegenlib{
 
+std::size_t SubMap::FactorHash::operator()(const Term* t) const {
+    return t->factorHash();
+}
+
+bool SubMap::FactorEqual::operator()(const Term* a, const Term* b) const {
+    return a->factorMatches(*b);
+}
+
 SubMap::SubMap() {
     mIter = mTerm2ExpMap.begin();
 }
 
 //! Delete all of the terms and expressions we are storing.
 SubMap::~SubMap() {
-    std::map<Term*,Exp*>::iterator iter;
+    TermExpMap::iterator iter;
     for (iter=mTerm2ExpMap.begin(); iter!=mTerm2ExpMap.end(); iter++) {
         delete iter->first;
         delete iter->second;
@@ -35,8 +43,11 @@ SubMap::~SubMap() {
 //! Use this to insert a term, expression pairing into the SubMap.
 //! SubMap takes ownership of expression.
 void SubMap::insertPair( Term* factor, Exp* e ) {
-    mTerm2ExpMap[factor] = e;
-    // FIXME: do we want to check for duplicate factors here?
+    // The first expression for a factor is the one subExp returns.
+    if (not mTerm2ExpMap.insert(std::make_pair(factor, e)).second) {
+        delete factor;
+        delete e;
+    }
 }
 
 //! Starts iteration over the substitution map.
@@ -61,28 +72,19 @@ Term* SubMap::next() {
 //! matches something in the SubMap.
 //! SubMap still owns expression.  If substitution map doesn't
 //! know about the factor sent in then NULL is returned.
-Exp* SubMap::subExp(Term* factor) const {
-    Exp* retval = NULL;
-
-    // This is where we loop to see if our factor matches any of
-    // the keys in searchTermToSubExp.
-    std::map<Term*,Exp*>::const_iterator miter;
-    for (miter = mTerm2ExpMap.begin(); miter != mTerm2ExpMap.end(); miter++) {
-        Term* searchptr = miter->first;
-        if (factor->factorMatches(*searchptr)) {
-            retval = miter->second;
-            break;  // going to return first expression for a matching term
-        }
-    }
-    return retval;
-
+Exp* SubMap::subExp(const Term* factor) const {
+    if (mTerm2ExpMap.empty()) { return NULL; }
+    // The key is only hashed and compared, never changed.
+    TermExpMap::const_iterator miter
+        = mTerm2ExpMap.find(const_cast<Term*>(factor));
+    return miter == mTerm2ExpMap.end() ? NULL : miter->second;
 }
         
 //! Returns a string representation of the class instance for debugging.
 std::string SubMap::toString() const {
     std::stringstream ss;
     ss << "SubMap:" << std::endl;
-    std::map<Term*,Exp*>::const_iterator iter;
+    TermExpMap::const_iterator iter;
     for (iter=mTerm2ExpMap.begin(); iter!=mTerm2ExpMap.end(); iter++) {
         ss << "\tterm = " << iter->first->toString() 
            << ", exp = " << iter->second->toString() << std::endl;
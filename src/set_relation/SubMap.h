@@ -15,8 +15,8 @@
 #ifndef SUBMAP_H_
 #define SUBMAP_H_
 
-#include <map>
 #include <string>
+#include <unordered_map>
 
 namespace iegenlib{
 
@@ -29,6 +29,9 @@ class Exp;
  * This class contains a mapping of factors (Terms) to expressions
  * that should replace those factors.  Needed so that the appropriate
  * cleanup of these terms and expressions occur.
+ *
+ * The map is hashed on the factor of each term, so looking up a term
+ * takes constant time however many substitutions there are.
  */
 class SubMap {
 public:
@@ -38,8 +41,16 @@ public:
     //! Use this to insert a term, expression pairing into the SubMap.
     //! SubMap takes ownership of term and expression.
     //! Term has to be a pointer because need polymorphism.
-    //! Changes term to have a coefficient of 1.
+    //! The coefficient of the term is ignored.
+    //! If the map already has a term with the same factor, the
+    //! earlier pairing is kept and factor and e are deleted.
     void insertPair( Term* factor, Exp* e );
+
+    //! Number of pairings in the map.
+    unsigned int size() const { return mTerm2ExpMap.size(); }
+
+    //! Indicates whether the map has no pairings.
+    bool empty() const { return mTerm2ExpMap.empty(); }
     
     //! Starts iteration over the substitution map.
     void startIter();
@@ -55,14 +66,27 @@ public:
     //! matches something in the SubMap.
     //! SubMap still owns expression.  If substitution map doesn't
     //! know about the factor sent in then NULL is returned.
-    Exp* subExp(Term* factor) const;
+    Exp* subExp(const Term* factor) const;
     
      //! Returns a string representation of the class instance for debugging.
     std::string toString() const;        
         
 private:
-    std::map<Term*,Exp*>                     mTerm2ExpMap;
-    std::map<Term*,Exp*>::const_iterator     mIter; 
+    SubMap(const SubMap&);
+    SubMap& operator=(const SubMap&);
+
+    //! Hashes a term on its factor.
+    struct FactorHash {
+        std::size_t operator()(const Term* t) const;
+    };
+    //! Two terms are the same key when their factors match.
+    struct FactorEqual {
+        bool operator()(const Term* a, const Term* b) const;
+    };
+    typedef std::unordered_map<Term*,Exp*,FactorHash,FactorEqual> TermExpMap;
+
+    TermExpMap                     mTerm2ExpMap;
+    TermExpMap::const_iterator     mIter; 
 };
 
 }
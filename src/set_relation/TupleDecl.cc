@@ -25,7 +25,7 @@ TupleDecl::TupleDecl(int size) : mSize(size) {
     for (int i=0; i<size; i++) {
         mIsConst.push_back(false);
         mConstVal.push_back(0);
-        mVarString.push_back(sDefaultTupleVarName(i));
+        mVarString.push_back(sDefaultTupleVarSymbol(i));
     }
 }
 
@@ -41,12 +41,25 @@ std::string TupleDecl::sDefaultTupleVarName(unsigned int loc) {
     return var.str();
 }
 
+Symbol TupleDecl::sDefaultTupleVarSymbol(unsigned int loc) {
+    static const unsigned int numCached = 32;
+    static const std::vector<Symbol> cached = [] {
+        std::vector<Symbol> symbols;
+        for (unsigned int i=0; i<numCached; i++) {
+            symbols.push_back(sDefaultTupleVarName(i));
+        }
+        return symbols;
+    }();
+    if (loc < numCached) { return cached[loc]; }
+    return sDefaultTupleVarName(loc);
+}
+
 //! If a tuple declaration has not been provided then this
 //! is the default tuple declaration.
 TupleDecl TupleDecl::sDefaultTupleDecl(unsigned int arity) {
     TupleDecl genericTupleDecl(arity);
     for (unsigned int i=0; i<arity; i++) {
-        genericTupleDecl.setTupleElem(i,sDefaultTupleVarName(i));
+        genericTupleDecl.mVarString[i] = sDefaultTupleVarSymbol(i);
     }
     return genericTupleDecl; 
 }
@@ -56,6 +69,23 @@ TupleDecl::TupleDecl( const TupleDecl& other ) {
     *this = other;
 }
 
+TupleDecl::TupleDecl( TupleDecl&& other ) : mSize(0) {
+    *this = std::move(other);
+}
+
+TupleDecl& TupleDecl::operator=( TupleDecl&& other ) {
+    if (this == &other) { return *this; }
+    mSize = other.mSize;
+    mIsConst = std::move(other.mIsConst);
+    mConstVal = std::move(other.mConstVal);
+    mVarString = std::move(other.mVarString);
+    other.mSize = 0;
+    other.mIsConst.clear();
+    other.mConstVal.clear();
+    other.mVarString.clear();
+    return *this;
+}
+
 //! Assignment operator.
 TupleDecl& TupleDecl::operator=( const TupleDecl& other) {
     mSize = other.mSize;
@@ -73,7 +103,7 @@ TupleDecl& TupleDecl::operator=( const TupleDecl& other) {
     return *this;
 }
 
-/*! Less than operator.
+/*! Three-way comparison, used by operator< and operator==.
 **      Compare two TupleDecl in the following order:
 **          1. by size: the number of elements
 **          2. by constant values
@@ -83,35 +113,38 @@ TupleDecl& TupleDecl::operator=( const TupleDecl& other) {
 **          (mConstVal) is sorted.
 ** @param other, object to be compared
 */
-bool TupleDecl::operator<( const TupleDecl& other) const {
+int TupleDecl::compare( const TupleDecl& other) const {
     // first compare sizes
-    if (mSize < other.mSize) { return true; }
-    if (other.mSize < mSize) { return false; }
+    if (mSize < other.mSize) { return -1; }
+    if (other.mSize < mSize) { return 1; }
     // then compare our elements
     for (unsigned int i=0; i < other.mIsConst.size(); i++) {
         //if both are not const, then we have nothing to compare
         if (!mIsConst[i] && !other.mIsConst[i]) { continue; }
 
         //if we are const and other is not, we're greater
-        if (mIsConst[i] && !other.mIsConst[i]) { return false; }
+        if (mIsConst[i] && !other.mIsConst[i]) { return 1; }
         //if other is const and we are not, other's greater
-        if (other.mIsConst[i] && !mIsConst[i]) { return true; }
+        if (other.mIsConst[i] && !mIsConst[i]) { return -1; }
         
         //compare values
-        if (mConstVal[i] < other.mConstVal[i]) { return true; }
-        if (other.mConstVal[i] < mConstVal[i]) { return false; }
+        if (mConstVal[i] < other.mConstVal[i]) { return -1; }
+        if (other.mConstVal[i] < mConstVal[i]) { return 1; }
     }
-    //all our elements are equal, so we're not less than other
-    return false;
+    //all our elements are equal
+    return 0;
 }
 
-/*! Equality operator.
-**      Compare two TupleDecl for equality.
-**      This operator assumes operator<(TupleDecl) is well defined.
-** @param other, object to be compared
-*/
-bool TupleDecl::operator==( const TupleDecl& other) const {
-    return !((*this < other) || (other < *this));
+//! Hash of the size and the constant elements.
+std::size_t TupleDecl::hash() const {
+    std::size_t seed = mSize;
+    for (unsigned int i=0; i < mIsConst.size(); i++) {
+        if (mIsConst[i]) {
+            hashCombine(seed, i);
+            hashCombine(seed, std::hash<int>()(mConstVal[i]));
+        }
+    }
+    return seed;
 }
 
 //! Concatenate the input tuple declarations and return the result.
@@ -126,9 +159,9 @@ TupleDecl& TupleDecl::concat(const TupleDecl& other) {
     for (unsigned int j=0; j<other.mSize; j++) {
         this->mIsConst.push_back(other.mIsConst[j]);
         this->mConstVal.push_back(other.mConstVal[j]);
-        if (other.mVarString[j]==sDefaultTupleVarName(j)) {
+        if (other.mVarString[j]==sDefaultTupleVarSymbol(j)) {
             // stick with default name for new location
-            this->mVarString.push_back(sDefaultTupleVarName(j+mSize));
+            this->mVarString.push_back(sDefaultTupleVarSymbol(j+mSize));
         } else {
             // copy over the tuple variable name
             this->mVarString.push_back(other.mVarString[j]);
@@ -220,8 +253,8 @@ int TupleDecl::elemConstVal(unsigned int elem_loc) const {
     return mConstVal[elem_loc];
 }
 
-std::string TupleDecl::elemVarString(unsigned int elem_loc) const {
-    return mVarString[elem_loc];
+const std::string& TupleDecl::elemVarString(unsigned int elem_loc) const {
+    return mVarString[elem_loc].str();
 }
 
 //! Returns an appropriate term for this tuple element.
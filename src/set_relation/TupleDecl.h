@@ -26,6 +26,7 @@
 #include <iostream>
 
 #include "environment.h"
+#include "symbol.h"
 #include <util/util.h>
 
 namespace iegenlib{
@@ -60,12 +61,27 @@ public:
     
     //! Assignment operator.
     TupleDecl& operator=( const TupleDecl& other);
+
+    //! Move constructor, leaves other empty.
+    TupleDecl( TupleDecl&& other );
+
+    //! Move assignment, leaves other empty.
+    TupleDecl& operator=( TupleDecl&& other );
     
+    //! Three-way comparison in the order of operator<
+    //! (negative, 0 or positive).
+    int compare( const TupleDecl& other) const;
+
     //! Less than operator.
-    bool operator<( const TupleDecl& other) const;
+    bool operator<( const TupleDecl& other) const
+        { return compare(other) < 0; }
     
     //! Equality operator.
-    bool operator==( const TupleDecl& other) const;
+    bool operator==( const TupleDecl& other) const
+        { return compare(other) == 0; }
+
+    //! Hash consistent with operator==, so variable names are left out.
+    std::size_t hash() const;
 
     //! Concatenate the other tuple declarations
     //! to this set of tuple declarations and return reference to self.
@@ -97,7 +113,7 @@ public:
     std::string elemToString(unsigned int elem_loc, bool generic=false) const;
     bool elemIsConst(unsigned int elem_loc) const;
     int elemConstVal(unsigned int elem_loc) const;
-    std::string elemVarString(unsigned int elem_loc) const;
+    const std::string& elemVarString(unsigned int elem_loc) const;
     unsigned int getSize(){ return mSize; }
 
     //! Returns an appropriate term for this tuple element.
@@ -110,10 +126,14 @@ public:
         
         
 private:
+    //! sDefaultTupleVarName interned, without a table lookup for the
+    //! first few locations.
+    static Symbol sDefaultTupleVarSymbol(unsigned int loc);
+
     unsigned int mSize;
     std::vector<bool>   mIsConst;
     std::vector<int>    mConstVal;
-    std::vector<std::string>    mVarString;
+    std::vector<Symbol>    mVarString;
 };
 
 }
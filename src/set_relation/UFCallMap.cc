@@ -16,14 +16,29 @@
 #include "set_relation.h"
 #include <util/util.h>
 #include <iostream>
+#include <algorithm>
 
 namespace iegenlib{
 
+UFCallMap::~UFCallMap() {
+    for (unsigned int i = 0; i < mCalls.size(); i++) { delete mCalls[i]; }
+}
+
 //! Assignment operator.
 UFCallMap& UFCallMap::operator=( const UFCallMap& other) {
-
-    mUFC2VarParam = other.mUFC2VarParam;
-    mVarParam2UFC = other.mVarParam2UFC;
+    if (this == &other) { return *this; }
+
+    for (unsigned int i = 0; i < mCalls.size(); i++) { delete mCalls[i]; }
+    mCalls.clear();
+    mCallIds.clear();
+    for (unsigned int i = 0; i < other.mCalls.size(); i++) {
+        mCalls.push_back(new UFCallTerm(*other.mCalls[i]));
+        mCallIds[mCalls.back()] = i;
+    }
+    mSymbols = other.mSymbols;
+    mSymbolIds = other.mSymbolIds;
+    mSymbolList = other.mSymbolList;
+    mSymbolListValid = other.mSymbolListValid;
 
     return *this;
 }
@@ -60,7 +75,7 @@ string UFCallMap::symUFC( std::string ufcName )
 
 /*! Use this to insert a UFCallTerm to map.
 **  The function creates an VarTerm representing the UFC then,
-**  adds (ufc,vt) to mUFC2VarParam & adds (vt,str) to mVarParam2UFC
+**  gives the pair the next id unless it is already in the map.
 **  The class does not own the object pointed by ufc,
 **  and it is left unchanged.
 **
@@ -69,6 +84,11 @@ string UFCallMap::symUFC( std::string ufcName )
 */
 VarTerm UFCallMap::insert( UFCallTerm *ufc )
 {
+    int id = idOf(*ufc);
+    if (id >= 0) {
+        return VarTerm( 1 , mSymbols[id] );
+    }
+
     UFCallTerm* ufcterm = new UFCallTerm (*ufc);
     ufcterm->setCoefficient(1);
     std::string symCons;
@@ -77,20 +97,22 @@ VarTerm UFCallMap::insert( UFCallTerm *ufc )
     } else{
        symCons = ufcterm->toString();
     }
-
     symCons = UFCallMap::symUFC(symCons);
-    VarTerm vt( 1 , symCons );
 
-    if( find(&vt) ){
-        return vt;
+    // Another UFC already prints as this symbolic constant.
+    if( idOf(symCons) >= 0 ){
+        delete ufcterm;
+        return VarTerm( 1 , symCons );
     }
 
-    mUFC2VarParam.insert ( std::pair<UFCallTerm,VarTerm>(*ufcterm,vt) );
-    mVarParam2UFC.insert ( std::pair<VarTerm,UFCallTerm>(vt,*ufcterm) );
+    id = mCalls.size();
+    mCalls.push_back(ufcterm);
+    mSymbols.push_back(symCons);
+    mCallIds[ufcterm] = id;
+    mSymbolIds[symCons] = id;
+    mSymbolListValid = false;
 
-    delete ufcterm;
-
-    return vt;
+    return VarTerm( 1 , symCons );
 }
 
 /*! Searches for ufcterm in the map. If ufcterm exists, it returns a pointer 
@@ -103,20 +125,11 @@ VarTerm UFCallMap::insert( UFCallTerm *ufc )
 */
 VarTerm* UFCallMap::find( UFCallTerm* ufc )
 {
-    VarTerm* result;
-    UFCallTerm* ufcterm = new UFCallTerm(*ufc);
-    ufcterm->setCoefficient(1);
-    std::map<UFCallTerm,VarTerm>::iterator it;
-    
-    it = mUFC2VarParam.find(*ufcterm);
-    if (it == mUFC2VarParam.end()){
-        result = new VarTerm(  (insert(ufcterm)).symbol() );
-    } else {
-        result = new VarTerm(it->second);
+    int id = idOf(*ufc);
+    if (id < 0) {
+        return new VarTerm( insert(ufc) );
     }
-
-    delete ufcterm;
-    return result;
+    return new VarTerm( 1 , mSymbols[id] );
 }
 
 /*! Searches for a VarTerm in the map. If VarTerm exists in the map,
@@ -129,18 +142,44 @@ VarTerm* UFCallMap::find( UFCallTerm* ufc )
 */
 UFCallTerm* UFCallMap::find( VarTerm* vt )
 {
-    VarTerm* sym = new VarTerm(*vt);
-    sym->setCoefficient(1);
-    std::map<VarTerm,UFCallTerm>::iterator it;
-
-    it = mVarParam2UFC.find(*sym);
-    if (it == mVarParam2UFC.end()){
+    int id = idOf(vt->symbol());
+    if (id < 0) {
         return NULL;
     }
-    delete sym;
+    return new UFCallTerm(*mCalls[id]);
+}
+
+int UFCallMap::idOf( const UFCallTerm& ufc ) const
+{
+    std::unordered_map<const UFCallTerm*, int, CallHash, CallEqual>
+        ::const_iterator it = mCallIds.find(&ufc);
+    return it == mCallIds.end() ? -1 : it->second;
+}
+
+int UFCallMap::idOf( const std::string& symbol ) const
+{
+    std::unordered_map<std::string, int>::const_iterator it
+        = mSymbolIds.find(symbol);
+    return it == mSymbolIds.end() ? -1 : it->second;
+}
+
+namespace {
+
+//! Orders ids by the UFCs they stand for.
+struct IdLess {
+    IdLess(const std::vector<UFCallTerm*>& calls) : mCalls(calls) {}
+    bool operator()(int a, int b) const { return *mCalls[a] < *mCalls[b]; }
+    const std::vector<UFCallTerm*>& mCalls;
+};
 
-    UFCallTerm* result = new UFCallTerm(it->second) ;
-    return result;
+}
+
+std::vector<int> UFCallMap::sortedIds() const
+{
+    std::vector<int> ids(mCalls.size());
+    for (unsigned int i = 0; i < ids.size(); i++) { ids[i] = i; }
+    std::sort(ids.begin(), ids.end(), IdLess(mCalls));
+    return ids;
 }
 
 // prints the content of the map into a string, and returns it
@@ -148,10 +187,10 @@ std::string UFCallMap::toString()
 {
     std::stringstream ss;
     ss << "UFCallMap:" << std::endl;
-    std::map<UFCallTerm,VarTerm>::iterator it;
-    for (it=mUFC2VarParam.begin(); it!=mUFC2VarParam.end(); it++) {
-        ss << "\tUFC = " << it->first.toString() 
-           << "  ,  sym = " << it->second.toString() << std::endl;
+    std::vector<int> ids = sortedIds();
+    for (unsigned int i = 0; i < ids.size(); i++) {
+        ss << "\tUFC = " << mCalls[ids[i]]->toString() 
+           << "  ,  sym = " << mSymbols[ids[i]] << std::endl;
     }
     return ss.str();
 }
@@ -159,15 +198,19 @@ std::string UFCallMap::toString()
 
 // Outputs list of variable terms created for UFCs, 
 // used in rule instantiation functionality.
-std::string UFCallMap::varTermStrList()
+const std::string& UFCallMap::varTermStrList()
 {
-    std::stringstream ss;
-    std::map<UFCallTerm,VarTerm>::iterator it;
-    for (it=mUFC2VarParam.begin(); it!=mUFC2VarParam.end(); it++) {
-        if( it != mUFC2VarParam.begin() ) ss << ", ";
-        ss << it->second.toString();
+    if (!mSymbolListValid) {
+        std::stringstream ss;
+        std::vector<int> ids = sortedIds();
+        for (unsigned int i = 0; i < ids.size(); i++) {
+            if( i > 0 ) ss << ", ";
+            ss << mSymbols[ids[i]];
+        }
+        mSymbolList = ss.str();
+        mSymbolListValid = true;
     }
-    return ss.str();
+    return mSymbolList;
 }
 
 }  // end of namespace iegenlib
@@ -17,8 +17,9 @@
 
 #include "expression.h"
 #include "TupleDecl.h"
-#include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace iegenlib{
 
@@ -32,6 +33,10 @@ class Set;
  * UFCallTerms and VarTerms are stored with coefficient = 1, however there is no
  * need to set coefficient when inserting a UFCallTerm or searching for
  * UFCallTerm or VarTerm in the map using find functions.
+ *
+ * Each distinct UFC gets a dense id, in the order they are inserted.
+ * The calls and symbol names are stored once per id, and hash indexes
+ * on both map them back to their id.
  */
 class UFCallMap {
 private:
@@ -39,15 +44,15 @@ private:
     bool tDecl;
 
 public:
-    UFCallMap(){ tDecl = false;}
-    UFCallMap(TupleDecl aTupleDecl){ tDecl = true; tupleDecl = aTupleDecl;}
-    ~UFCallMap(){
-               mUFC2VarParam.clear();
-               mVarParam2UFC.clear();
-    }
+    UFCallMap() : tDecl(false), mSymbolListValid(false) {}
+    UFCallMap(TupleDecl aTupleDecl)
+        : tupleDecl(aTupleDecl), tDecl(true), mSymbolListValid(false) {}
+    ~UFCallMap();
 
     //! Copy constructor.
-    UFCallMap( const UFCallMap& other ){ *this = other; }
+    UFCallMap( const UFCallMap& other ) : tDecl(false),
+                                          mSymbolListValid(false)
+        { *this = other; }
 
     //! Assignment operator.
     UFCallMap& operator=( const UFCallMap& other );
@@ -59,7 +64,7 @@ public:
 
     /*! Use this to insert a UFCallTerm to map.
     **  The function creates an VarTerm representing the UFC then,
-    **  adds (ufc,vt) to mUFC2VarParam & adds (vt,str) to mVarParam2UFC
+    **  gives the pair the next id unless it is already in the map.
     **  The class does not own the object pointed by ufcterm,
     **  and it is left unchanged.
     **
@@ -69,9 +74,9 @@ public:
     VarTerm insert( UFCallTerm *ufc);
 
     /*! Searches for ufcterm in the map. If ufcterm exists, it returns
-    **  a pointer to equ. VarTerm, otherwise returns NULL.
+    **  a pointer to equ. VarTerm, otherwise it inserts ufcterm first.
     **  The class does not own the object pointed by ufcterm,
-    **  and it is left unchanged.
+    **  and it is left unchanged. The caller deletes the returned VarTerm.
     **
     **  NOTE: The function ignores coefficient of the UFCallTerm.
     **        So, -2*row(i)  is considered as just row(i)
@@ -81,23 +86,56 @@ public:
     /*! Searches for a VarTerm in the map. If VarTerm exists in the map,
     **  it returns the pointer to equ. UFC, otherwise returns NULL. 
     **  The class does not own the object pointed by symbol,
-    **  and it is left unchanged.
+    **  and it is left unchanged. The caller deletes the returned UFC.
     **
     **  NOTE: The function ignores coefficient of the VarTerm.
     **        So, -2*row_i_  is considered as just row_i_
     */
     UFCallTerm* find( VarTerm* symbol );
 
+    //! Id of the UFC, ignoring its coefficient, or -1 if not in the map.
+    int idOf( const UFCallTerm& ufc ) const;
+    //! Id of the UFC with the given symbolic constant, or -1.
+    int idOf( const std::string& symbol ) const;
+
+    //! Number of UFCs in the map, their ids are 0 to size()-1.
+    int size() const { return mCalls.size(); }
+    //! The UFC with the given id, with coefficient 1.
+    const UFCallTerm& call( int id ) const { return *mCalls[id]; }
+    //! The symbolic constant of the UFC with the given id.
+    const std::string& symbol( int id ) const { return mSymbols[id]; }
+
     //! prints the content of the map into a string, and returns it
     std::string toString();
 
     //! Outputs list of variable terms created for UFCs, 
     //  used in rule instantiation functionality.
-    std::string varTermStrList();
+    //  The list is kept until the next insertion.
+    const std::string& varTermStrList();
 
 private:
-    std::map<UFCallTerm,VarTerm> mUFC2VarParam;
-    std::map<VarTerm,UFCallTerm> mVarParam2UFC;
+    //! Hashes a UFC on its factor, i.e. ignoring the coefficient.
+    struct CallHash {
+        std::size_t operator()(const UFCallTerm* t) const
+            { return t->factorHash(); }
+    };
+    //! Two UFCs are the same key when their factors match.
+    struct CallEqual {
+        bool operator()(const UFCallTerm* a, const UFCallTerm* b) const
+            { return a->factorMatches(*b); }
+    };
+
+    //! Ids in the order of the UFCs, which is the order toString and
+    //! varTermStrList list them in.
+    std::vector<int> sortedIds() const;
+
+    std::vector<UFCallTerm*> mCalls;
+    std::vector<std::string> mSymbols;
+    std::unordered_map<const UFCallTerm*, int, CallHash, CallEqual> mCallIds;
+    std::unordered_map<std::string, int> mSymbolIds;
+
+    std::string mSymbolList;
+    bool mSymbolListValid;
 };
 
 }
@@ -82,3 +82,38 @@ TEST(UFCallMapTest, UFCallMap) {
     delete r_ufcall;
     delete symCons;
 }
+
+#pragma mark UFCallMapIds
+// Each distinct UFC gets the next id, whatever its coefficient, and the
+// symbol list is in the order of the UFCs.
+TEST(UFCallMapTest, UFCallMapIds) {
+    UFCallTerm* calls[3];
+    const char* names[3] = {"row", "col", "row"};
+    int coeffs[3] = {1, 1, -2};
+    for (int i = 0; i < 3; i++) {
+        Exp* arg = new Exp();
+        arg->addTerm(new TupleVarTerm(0));
+        calls[i] = new UFCallTerm(coeffs[i], names[i], 1);
+        calls[i]->setParamExp(0, arg);
+    }
+
+    iegenlib::UFCallMap map;
+    EXPECT_EQ( -1, map.idOf(*calls[0]) );
+    map.insert(calls[0]);
+    map.insert(calls[1]);
+    map.insert(calls[2]);
+    EXPECT_EQ( 2, map.size() );
+    EXPECT_EQ( 0, map.idOf(*calls[0]) );
+    EXPECT_EQ( 1, map.idOf(*calls[1]) );
+    EXPECT_EQ( 0, map.idOf(*calls[2]) );
+    EXPECT_EQ( 1, map.idOf("col___tv0_") );
+    EXPECT_EQ( "row___tv0_", map.symbol(0) );
+    EXPECT_EQ( "col(__tv0)", map.call(1).toString() );
+    EXPECT_EQ( "col___tv0_, row___tv0_", map.varTermStrList() );
+
+    iegenlib::UFCallMap copy(map);
+    EXPECT_EQ( 1, copy.idOf(*calls[1]) );
+    EXPECT_EQ( map.toString(), copy.toString() );
+
+    for (int i = 0; i < 3; i++) { delete calls[i]; }
+}
@@ -0,0 +1,308 @@
+/*!
+ * \file arena.cc
+ *
+ * \brief Implementation of region based pool allocation.
+ *
+ * Objects carry no header. Arena chunks are 64KB and aligned to 64KB, and
+ * a two level map from chunk addresses to arenas, filled in as arenas get
+ * chunks, tells delete whether a block came from an arena and which one.
+ * Anything not in the map came from the heap. While no region is alive
+ * anywhere, new only reads a count of the live regions before going to
+ * the heap, and heap allocations are not counted. Likewise delete only
+ * reads a count of the arenas left while there are none.
+ * Arenas hand out blocks in multiples of 16 bytes and keep one free list
+ * per block size.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "arena.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace iegenlib{
+
+namespace {
+
+//! Block sizes are multiples of this.
+const std::size_t kGranularity = 16;
+//! Larger objects always come from the heap.
+const std::size_t kMaxBlock = 512;
+const std::size_t kNumClasses = kMaxBlock / kGranularity;
+const unsigned int kChunkBits = 16;
+const std::size_t kChunkSize = std::size_t(1) << kChunkBits;
+
+std::atomic<unsigned long> theHeapAllocations(0);
+std::atomic<unsigned long> theArenaAllocations(0);
+std::atomic<unsigned long> theReused(0);
+std::atomic<unsigned long> theChunks(0);
+
+//! Number of regions alive on all threads.
+std::atomic<unsigned int> theRegions(0);
+//! Number of arenas not yet deleted, which can outlive their regions.
+std::atomic<unsigned int> theArenas(0);
+
+//! Arena of the innermost region alive on this thread, if any.
+thread_local Arena* theCurrentArena = NULL;
+
+/*! Arena of each chunk, by the chunk's address. Chunk numbers of 48 bit
+**  addresses have 32 bits, the high half picks a leaf and the low half an
+**  entry in it. Leaves are added as chunks need them and kept.
+*/
+const unsigned int kLeafBits = 16;
+const std::size_t kLeafSize = std::size_t(1) << kLeafBits;
+struct ChunkLeaf {
+    std::atomic<Arena*> arenas[kLeafSize];
+};
+std::atomic<ChunkLeaf*> theChunkMap[std::size_t(1) << 16];
+
+//! False if the address is beyond what the map covers.
+bool chunkIndex(const void* ptr, std::size_t& leaf, std::size_t& entry) {
+    std::uintptr_t chunk = reinterpret_cast<std::uintptr_t>(ptr)
+                               >> kChunkBits;
+    if ((chunk >> (2 * kLeafBits)) != 0) { return false; }
+    leaf = chunk >> kLeafBits;
+    entry = chunk & (kLeafSize - 1);
+    return true;
+}
+
+//! The arena ptr came from, NULL for the heap.
+Arena* chunkArena(const void* ptr) {
+    std::size_t leaf, entry;
+    if (!chunkIndex(ptr, leaf, entry)) { return NULL; }
+    ChunkLeaf* l = theChunkMap[leaf].load(std::memory_order_acquire);
+    if (l == NULL) { return NULL; }
+    return l->arenas[entry].load(std::memory_order_acquire);
+}
+
+//! Records that chunk belongs to arena, or to nobody for NULL. False if
+//! the chunk is beyond what the map covers.
+bool setChunkArena(const void* chunk, Arena* arena) {
+    std::size_t leaf, entry;
+    if (!chunkIndex(chunk, leaf, entry)) { return false; }
+    ChunkLeaf* l = theChunkMap[leaf].load(std::memory_order_acquire);
+    if (l == NULL) {
+        ChunkLeaf* fresh = new ChunkLeaf();
+        if (theChunkMap[leaf].compare_exchange_strong(l, fresh,
+                std::memory_order_acq_rel)) {
+            l = fresh;
+        } else {
+            delete fresh;
+        }
+    }
+    l->arenas[entry].store(arena, std::memory_order_release);
+    return true;
+}
+
+}
+
+/*!
+ * \class Arena
+ *
+ * \brief Chunks and free lists behind an ArenaRegion.
+ *
+ * Only the thread of the region allocates, so its free lists need no
+ * locking. Blocks deleted on other threads go on a lock free stack that
+ * the owner takes over when it runs out of blocks of a size. The region
+ * and every live block each hold a reference, and whoever drops the last
+ * one deletes the arena.
+ */
+class Arena {
+public:
+    Arena() : mNext(NULL), mEnd(NULL), mRemoteFree(NULL), mRefs(1),
+              mAllocations(0), mReused(0) {
+        for (std::size_t i = 0; i < kNumClasses; i++) { mFree[i] = NULL; }
+        theArenas.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ~Arena() {
+        for (std::size_t i = 0; i < mChunks.size(); i++) {
+            setChunkArena(mChunks[i], NULL);
+            free(mChunks[i]);
+        }
+        theArenas.fetch_sub(1, std::memory_order_release);
+    }
+
+    //! Returns a block of size bytes, or NULL if that is too large for
+    //! the arena or no chunk could be had. Owner thread only.
+    void* allocate(std::size_t size) {
+        if (size > kMaxBlock) { return NULL; }
+        std::size_t sizeClass = sizeClassOf(size);
+
+        if (mFree[sizeClass] == NULL
+            && mRemoteFree.load(std::memory_order_relaxed) != NULL) {
+            takeRemoteFree();
+        }
+        void* block = mFree[sizeClass];
+        if (block) {
+            mFree[sizeClass] = mFree[sizeClass]->next;
+            mReused++;
+        } else {
+            std::size_t bytes = (sizeClass + 1) * kGranularity;
+            if (mNext == NULL || (std::size_t)(mEnd - mNext) < bytes) {
+                if (!addChunk()) { return NULL; }
+            }
+            block = mNext;
+            mNext += bytes;
+        }
+        mRefs.fetch_add(1, std::memory_order_relaxed);
+        mAllocations++;
+        return block;
+    }
+
+    //! Puts the block of an object of size bytes back on a free list.
+    //! Returns true if the arena should now be deleted.
+    bool release(void* ptr, std::size_t size) {
+        FreeBlock* block = static_cast<FreeBlock*>(ptr);
+        block->sizeClass = sizeClassOf(size);
+        if (mOwner == &theThreadTag) {
+            block->next = mFree[block->sizeClass];
+            mFree[block->sizeClass] = block;
+        } else {
+            block->next = mRemoteFree.load(std::memory_order_relaxed);
+            while (!mRemoteFree.compare_exchange_weak(block->next, block,
+                        std::memory_order_release,
+                        std::memory_order_relaxed)) {}
+        }
+        return unref();
+    }
+
+    //! Called by the region when it ends, on the owner thread. Returns
+    //! true if the arena should be deleted now, otherwise the last
+    //! release will say so.
+    bool close() {
+        theArenaAllocations.fetch_add(mAllocations);
+        theReused.fetch_add(mReused);
+        theChunks.fetch_add(mChunks.size());
+        return unref();
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+        std::size_t sizeClass;
+    };
+
+    static std::size_t sizeClassOf(std::size_t size) {
+        return (size + kGranularity - 1) / kGranularity - 1;
+    }
+
+    //! Starts carving from a new chunk, aligned to its size so that
+    //! chunkArena finds it. False if there is none.
+    bool addChunk() {
+        void* chunk = NULL;
+        if (posix_memalign(&chunk, kChunkSize, kChunkSize) != 0) {
+            return false;
+        }
+        if (!setChunkArena(chunk, this)) {
+            free(chunk);
+            return false;
+        }
+        mChunks.push_back(static_cast<char*>(chunk));
+        mNext = static_cast<char*>(chunk);
+        mEnd = mNext + kChunkSize;
+        return true;
+    }
+
+    bool unref() {
+        return mRefs.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    //! Moves the blocks other threads released onto our free lists.
+    void takeRemoteFree() {
+        FreeBlock* block = mRemoteFree.exchange(NULL,
+                                                std::memory_order_acquire);
+        while (block) {
+            FreeBlock* next = block->next;
+            block->next = mFree[block->sizeClass];
+            mFree[block->sizeClass] = block;
+            block = next;
+        }
+    }
+
+    //! Tells the owner thread apart from the others.
+    static thread_local char theThreadTag;
+    const char* const mOwner = &theThreadTag;
+
+    std::vector<char*> mChunks;
+    char* mNext;
+    char* mEnd;
+    FreeBlock* mFree[kNumClasses];
+    std::atomic<FreeBlock*> mRemoteFree;
+    std::atomic<unsigned long> mRefs;
+    unsigned long mAllocations;
+    unsigned long mReused;
+};
+
+thread_local char Arena::theThreadTag;
+
+/******************************** ArenaRegion ********************************/
+
+ArenaRegion::ArenaRegion() : mArena(new Arena()),
+                             mPrevious(theCurrentArena) {
+    theCurrentArena = mArena;
+    theRegions.fetch_add(1, std::memory_order_relaxed);
+}
+
+ArenaRegion::~ArenaRegion() {
+    theRegions.fetch_sub(1, std::memory_order_relaxed);
+    theCurrentArena = mPrevious;
+    if (mArena->close()) { delete mArena; }
+}
+
+/******************************* ArenaAllocated ******************************/
+
+void* ArenaAllocated::operator new(std::size_t size) {
+    // Only look for this thread's region while there is one somewhere.
+    // Without one, this is all new adds to the heap's own work.
+    if (theRegions.load(std::memory_order_relaxed) != 0) {
+        if (theCurrentArena != NULL) {
+            void* block = theCurrentArena->allocate(size);
+            if (block) { return block; }
+        }
+        theHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    return ::operator new(size);
+}
+
+void ArenaAllocated::operator delete(void* ptr, std::size_t size) {
+    if (ptr == NULL) { return; }
+    // Without arenas, every object came from the heap.
+    if (theArenas.load(std::memory_order_acquire) == 0) {
+        ::operator delete(ptr);
+        return;
+    }
+    Arena* arena = chunkArena(ptr);
+    if (arena == NULL) {
+        ::operator delete(ptr);
+    } else if (arena->release(ptr, size)) {
+        delete arena;
+    }
+}
+
+/********************************* Statistics ********************************/
+
+ArenaStats arenaStats() {
+    ArenaStats stats;
+    stats.heapAllocations = theHeapAllocations.load();
+    stats.arenaAllocations = theArenaAllocations.load();
+    stats.reused = theReused.load();
+    stats.chunks = theChunks.load();
+    return stats;
+}
+
+void resetArenaStats() {
+    theHeapAllocations = 0;
+    theArenaAllocations = 0;
+    theReused = 0;
+    theChunks = 0;
+}
+
+}// iegenlib namespace
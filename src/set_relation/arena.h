@@ -0,0 +1,100 @@
+/*!
+ * \file arena.h
+ *
+ * \brief Region based pool allocation of Terms, Exps and Conjunctions.
+ *
+ * Operations like Compose and superAffineSet create and delete thousands
+ * of small Term and Exp objects. While an ArenaRegion is alive on a
+ * thread, those objects are carved out of large chunks owned by the
+ * region's arena instead of coming one by one from the heap. Deleting
+ * one puts its block on a free list for the next object of that size,
+ * and the chunks are released in bulk when the region ends.
+ *
+ *   Relation* result;
+ *   {
+ *       ArenaRegion region;
+ *       Relation* tmp = r1->Compose(r2);
+ *       ...
+ *       result = new Relation(*tmp);  // or keep tmp itself
+ *       delete tmp;
+ *   }
+ *
+ * Objects that outlive their region stay valid: an arena only gives its
+ * chunks back once the region has ended and its last object is deleted.
+ * Copying results out after the region ends lets the chunks go sooner.
+ * Objects may be deleted on any thread. Regions nest, each with its own
+ * arena.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#ifndef ARENA_H_
+#define ARENA_H_
+
+#include <cstddef>
+
+namespace iegenlib{
+
+class Arena;
+
+/*!
+ * \class ArenaRegion
+ *
+ * \brief While alive, Terms, Exps and Conjunctions allocated on this
+ *        thread come from the region's arena.
+ */
+class ArenaRegion {
+public:
+    ArenaRegion();
+    ~ArenaRegion();
+
+private:
+    ArenaRegion(const ArenaRegion&);
+    ArenaRegion& operator=(const ArenaRegion&);
+
+    Arena* mArena;
+    Arena* mPrevious;
+};
+
+/*!
+ * \class ArenaAllocated
+ *
+ * \brief Base of the classes that are allocated from the current
+ *        ArenaRegion when there is one and from the heap otherwise.
+ */
+class ArenaAllocated {
+public:
+    static void* operator new(std::size_t size);
+    //! size is the size of the object's dynamic type, which the classes'
+    //! virtual destructors guarantee.
+    static void operator delete(void* ptr, std::size_t size);
+};
+
+//! Counts of allocations of ArenaAllocated objects.
+struct ArenaStats {
+    ArenaStats() : heapAllocations(0), arenaAllocations(0), reused(0),
+                   chunks(0) {}
+    //! Objects allocated from the heap while some thread had a region
+    //! alive. Those allocated while none did are not counted.
+    unsigned long heapAllocations;
+    //! Objects allocated from an arena.
+    unsigned long arenaAllocations;
+    //! Arena allocations that reused the block of a deleted object.
+    unsigned long reused;
+    //! Chunks arenas allocated from the heap.
+    unsigned long chunks;
+};
+
+//! Counts since the last resetArenaStats, over all threads. The counts
+//! of an arena are added when its region ends.
+ArenaStats arenaStats();
+
+void resetArenaStats();
+
+}// iegenlib namespace
+
+#endif
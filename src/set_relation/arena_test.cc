@@ -0,0 +1,118 @@
+/*!
+ * \file arena_test.cc
+ *
+ * \brief Tests for region based pool allocation.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "arena.h"
+#include "expression.h"
+#include "set_relation.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+using iegenlib::ArenaRegion;
+using iegenlib::ArenaStats;
+using iegenlib::arenaStats;
+using iegenlib::resetArenaStats;
+using iegenlib::Term;
+using iegenlib::VarTerm;
+using iegenlib::TupleVarTerm;
+using iegenlib::Exp;
+using iegenlib::Relation;
+
+#pragma mark ArenaRegionAllocations
+// Objects come from the arena inside a region and from the heap outside,
+// and deleted blocks are reused. Heap allocations are only counted while
+// a region is alive.
+TEST(ArenaTest, RegionAllocations) {
+    resetArenaStats();
+    Exp* outside = new Exp();
+    EXPECT_EQ( 0u, arenaStats().heapAllocations );
+    {
+        ArenaRegion region;
+        // Another thread, without a region of its own, uses the heap.
+        Exp* elsewhere = NULL;
+        std::thread([&elsewhere]() { elsewhere = new Exp(); }).join();
+        EXPECT_EQ( 1u, arenaStats().heapAllocations );
+        delete elsewhere;
+        for (int i = 0; i < 100; i++) {
+            Exp* e = new Exp();
+            e->addTerm(new TupleVarTerm(i));
+            e->addTerm(new VarTerm(2, "N"));
+            delete e;
+        }
+        // An object from outside the region is deleted inside it.
+        delete outside;
+    }
+    ArenaStats stats = arenaStats();
+    EXPECT_EQ( 1u, stats.heapAllocations );
+    EXPECT_EQ( 300u, stats.arenaAllocations );
+    EXPECT_EQ( 297u, stats.reused );
+    EXPECT_EQ( 1u, stats.chunks );
+}
+
+#pragma mark ArenaRegionOutlive
+// Results that outlive their region, or are deleted on another thread,
+// stay usable.
+TEST(ArenaTest, RegionOutlive) {
+    Exp* kept;
+    Exp* copy;
+    {
+        ArenaRegion outer;
+        kept = new Exp();
+        kept->addTerm(new VarTerm(3, "M"));
+        {
+            ArenaRegion inner;
+            Exp* tmp = new Exp(*kept);
+            tmp->addTerm(new Term(4));
+            copy = tmp;
+        }
+        kept->addTerm(new Term(1));
+    }
+    EXPECT_EQ( "3 M + 1", kept->toString() );
+    EXPECT_EQ( "3 M + 4", copy->toString() );
+    delete kept;
+
+    std::thread other([copy]() { delete copy; });
+    other.join();
+}
+
+#pragma mark ArenaRegionSameResults
+// Operations in a region give the same results as on the heap.
+TEST(ArenaTest, RegionSameResults) {
+    iegenlib::setCurrEnv();
+    const char* ufs[] = {"col", "rowptr", "perm"};
+    for (int i = 0; i < 3; i++) {
+        iegenlib::appendCurrEnv(ufs[i], new iegenlib::Set("{[i]:0<=i<N}"),
+            new iegenlib::Set("{[j]:0<=j<N}"), false,
+            iegenlib::Monotonic_NONE);
+    }
+    Relation* r1 = new Relation("{[i,j] -> [k] : k = col(j) && "
+                                "rowptr(i) <= j < rowptr(i+1) && 0 <= i < N}");
+    Relation* r2 = new Relation("{[k] -> [p] : p = perm(k) && 0 <= k < N}");
+    Relation* expected = r2->Compose(r1);
+
+    Relation* result;
+    {
+        ArenaRegion region;
+        Relation* tmp = r2->Compose(r1);
+        Relation* supAff = tmp->superAffineRelation();
+        delete supAff;
+        result = new Relation(*tmp);
+        delete tmp;
+    }
+    EXPECT_EQ( expected->toString(), result->toString() );
+
+    delete r1;
+    delete r2;
+    delete expected;
+    delete result;
+    iegenlib::setCurrEnv();
+}
@@ -0,0 +1,316 @@
+/*!
+ * \file bound_propagation.cc
+ *
+ * \brief Interval and difference constraint propagation over conjunctions,
+ *        see bound_propagation.h.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "bound_propagation.h"
+#include "compact_term.h"
+#include "set_relation.h"
+#include "symbol.h"
+
+#include <atomic>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace iegenlib{
+
+namespace {
+
+typedef long long Value;
+
+//! Bounds and constants past this magnitude are left infinite, and
+//! coefficients past kMaxCoeff make us give up, so that a row summed over
+//! bounds cannot overflow.
+const Value kMaxBound = Value(1) << 32;
+const Value kMaxCoeff = Value(1) << 16;
+
+//! Most passes of interval propagation over the rows. Bounds creeping
+//! towards each other one step at a time are left to the difference
+//! constraints.
+const unsigned int kMaxRounds = 16;
+
+std::atomic<bool> theBoundsUnsatFilter(true);
+
+Value absValue(Value a) { return a < 0 ? -a : a; }
+
+Value gcd(Value a, Value b) {
+    a = absValue(a);
+    b = absValue(b);
+    while (b != 0) {
+        Value t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+//! Rounds a/b down, for b > 0.
+Value floorDiv(Value a, Value b) {
+    Value q = a / b;
+    if (a % b != 0 && a < 0) { q--; }
+    return q;
+}
+
+//! Rounds a/b up, for b > 0.
+Value ceilDiv(Value a, Value b) { return -floorDiv(-a, b); }
+
+//! sum coeff*var + constant >= 0, with one term per variable.
+struct LinearRow {
+    Value constant;
+    std::vector<std::pair<unsigned int, Value> > terms;
+};
+
+//! Lower and upper bounds of each variable, where known.
+struct Box {
+    std::vector<bool> hasLo, hasHi;
+    std::vector<Value> lo, hi;
+
+    explicit Box(size_t n) : hasLo(n, false), hasHi(n, false),
+                             lo(n, 0), hi(n, 0) {}
+
+    // Each returns true if the bound got tighter.
+    bool raiseLo(unsigned int v, Value b) {
+        if (absValue(b) > kMaxBound || (hasLo[v] && lo[v] >= b)) {
+            return false;
+        }
+        hasLo[v] = true;
+        lo[v] = b;
+        return true;
+    }
+    bool lowerHi(unsigned int v, Value b) {
+        if (absValue(b) > kMaxBound || (hasHi[v] && hi[v] <= b)) {
+            return false;
+        }
+        hasHi[v] = true;
+        hi[v] = b;
+        return true;
+    }
+    bool crossed(unsigned int v) const {
+        return hasLo[v] && hasHi[v] && lo[v] > hi[v];
+    }
+};
+
+// Tightens the bounds of the variables of row against the others. Sets
+// empty if the row cannot be satisfied within the box. Returns true if
+// some bound got tighter.
+bool propagateRow(const LinearRow& row, Box& box, bool& empty) {
+    // Largest value of the row over the box, leaving out the terms
+    // without a bound in the direction that matters.
+    Value max = row.constant;
+    unsigned int unbounded = 0, unboundedTerm = 0;
+    std::vector<Value> contribution(row.terms.size(), 0);
+    for (unsigned int t = 0; t < row.terms.size(); t++) {
+        unsigned int v = row.terms[t].first;
+        Value a = row.terms[t].second;
+        if (a > 0 ? box.hasHi[v] : box.hasLo[v]) {
+            contribution[t] = a * (a > 0 ? box.hi[v] : box.lo[v]);
+            max += contribution[t];
+        } else {
+            unbounded++;
+            unboundedTerm = t;
+        }
+    }
+    if (unbounded == 0 && max < 0) {
+        empty = true;
+        return false;
+    }
+    if (unbounded > 1) { return false; }
+
+    // a*v >= -(max of the other terms)
+    bool changed = false;
+    for (unsigned int t = 0; t < row.terms.size(); t++) {
+        if (unbounded == 1 && t != unboundedTerm) { continue; }
+        unsigned int v = row.terms[t].first;
+        Value a = row.terms[t].second;
+        Value rest = max - contribution[t];
+        if (a > 0) { changed = box.raiseLo(v, ceilDiv(-rest, a)) || changed; }
+        else { changed = box.lowerHi(v, floorDiv(rest, -a)) || changed; }
+        if (box.crossed(v)) {
+            empty = true;
+            return false;
+        }
+    }
+    return changed;
+}
+
+//! An edge from -> to of weight w is the constraint to - from <= w.
+struct Edge {
+    unsigned int from, to;
+    Value weight;
+};
+
+// True if the difference constraints among the rows, and the bounds in
+// box as differences against an extra zero variable, have a negative
+// cycle.
+bool negativeCycle(const std::vector<LinearRow>& rows, const Box& box) {
+    size_t zero = box.lo.size();
+    std::vector<Edge> edges;
+    for (size_t r = 0; r < rows.size(); r++) {
+        const LinearRow& row = rows[r];
+        if (row.terms.size() != 2 ||
+            row.terms[0].second != -row.terms[1].second) {
+            continue;
+        }
+        // a*x - a*y + c >= 0 is y - x <= floor(c/a) for a > 0.
+        Value a = absValue(row.terms[0].second);
+        unsigned int x = row.terms[0].first, y = row.terms[1].first;
+        if (row.terms[0].second < 0) { std::swap(x, y); }
+        Edge e = { x, y, floorDiv(row.constant, a) };
+        edges.push_back(e);
+    }
+    if (edges.empty()) { return false; }
+    for (unsigned int v = 0; v < zero; v++) {
+        if (box.hasHi[v]) {
+            Edge e = { static_cast<unsigned int>(zero), v, box.hi[v] };
+            edges.push_back(e);
+        }
+        if (box.hasLo[v]) {
+            Edge e = { v, static_cast<unsigned int>(zero), -box.lo[v] };
+            edges.push_back(e);
+        }
+    }
+
+    // Bellman-Ford from a source with a 0 edge to every variable: still
+    // relaxing after as many passes as there are variables means a
+    // negative cycle.
+    std::vector<Value> dist(zero + 1, 0);
+    for (size_t pass = 0; pass <= zero + 1; pass++) {
+        bool relaxed = false;
+        for (size_t i = 0; i < edges.size(); i++) {
+            const Edge& e = edges[i];
+            if (dist[e.from] + e.weight < dist[e.to]) {
+                dist[e.to] = dist[e.from] + e.weight;
+                relaxed = true;
+            }
+        }
+        if (!relaxed) { return false; }
+    }
+    return true;
+}
+
+}
+
+bool boundsProveUnsat(const Conjunction& conj) {
+    TupleDecl tdecl = conj.getTupleDecl();
+    int arity = tdecl.size();
+
+    // Tuple variables first, symbolic constants with their names are the
+    // same variable.
+    std::map<unsigned int, unsigned int> symbolVars;
+    for (int i = 0; i < arity; i++) {
+        if (!tdecl.elemIsConst(i)) {
+            symbolVars.insert(std::make_pair(
+                Symbol(tdecl.elemVarString(i)).id(), i));
+        }
+    }
+    unsigned int numVars = arity;
+    std::map<unsigned int, unsigned int> factorVars;
+
+    CompactTermTable table;
+    CompactConjunction compact(conj, table);
+    std::vector<LinearRow> rows;
+    for (unsigned int c = 0; c < compact.numConstraints(); c++) {
+        std::map<unsigned int, Value> coeffs;
+        Value constant = 0;
+        for (const CompactTerm* t = compact.begin(c);
+                t != compact.end(c); t++) {
+            unsigned int v;
+            if (t->isConst()) {
+                constant += t->coeff;
+                continue;
+            } else if (t->isTupleVar()) {
+                v = t->payload;
+            } else if (t->isSymConst()) {
+                std::map<unsigned int, unsigned int>::iterator i =
+                    symbolVars.insert(std::make_pair(t->payload,
+                                                     numVars)).first;
+                if (i->second == numVars) { numVars++; }
+                v = i->second;
+            } else {
+                std::map<unsigned int, unsigned int>::iterator i =
+                    factorVars.insert(std::make_pair(t->payload,
+                                                     numVars)).first;
+                if (i->second == numVars) { numVars++; }
+                v = i->second;
+            }
+            coeffs[v] += t->coeff;
+        }
+
+        LinearRow row;
+        row.constant = constant;
+        Value g = 0;
+        for (std::map<unsigned int, Value>::const_iterator
+                i = coeffs.begin(); i != coeffs.end(); i++) {
+            if (i->second == 0) { continue; }
+            if (absValue(i->second) > kMaxCoeff) { return false; }
+            row.terms.push_back(*i);
+            g = gcd(g, i->second);
+        }
+        if (absValue(constant) > kMaxBound) { return false; }
+
+        if (row.terms.empty()) {
+            if (compact.isEquality(c) ? constant != 0 : constant < 0) {
+                return true;
+            }
+            continue;
+        }
+        // Only integer points: divide by the gcd, rounding the constant of
+        // an inequality down. An equality needs the gcd to divide it.
+        if (compact.isEquality(c) && constant % g != 0) { return true; }
+        row.constant = floorDiv(constant, g);
+        for (size_t t = 0; t < row.terms.size(); t++) {
+            row.terms[t].second /= g;
+        }
+        rows.push_back(row);
+        if (compact.isEquality(c)) {
+            row.constant = -row.constant;
+            for (size_t t = 0; t < row.terms.size(); t++) {
+                row.terms[t].second = -row.terms[t].second;
+            }
+            rows.push_back(row);
+        }
+    }
+
+    Box box(numVars);
+    for (int i = 0; i < arity; i++) {
+        if (tdecl.elemIsConst(i)) {
+            box.raiseLo(i, tdecl.elemConstVal(i));
+            box.lowerHi(i, tdecl.elemConstVal(i));
+        }
+    }
+
+    bool changed = true;
+    for (unsigned int round = 0; changed && round < kMaxRounds; round++) {
+        changed = false;
+        for (size_t r = 0; r < rows.size(); r++) {
+            bool empty = false;
+            changed = propagateRow(rows[r], box, empty) || changed;
+            if (empty) { return true; }
+        }
+    }
+
+    return negativeCycle(rows, box);
+}
+
+bool boundsProveUnsat(const SparseConstraints& sc) {
+    for (ConstConjunctionIterator i = sc.conjunctionBegin();
+            i != sc.conjunctionEnd(); i++) {
+        if (!boundsProveUnsat(**i)) { return false; }
+    }
+    return true;
+}
+
+void setBoundsUnsatFilter(bool enabled) { theBoundsUnsatFilter = enabled; }
+
+bool boundsUnsatFilter() { return theBoundsUnsatFilter; }
+
+}// iegenlib namespace
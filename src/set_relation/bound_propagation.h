@@ -0,0 +1,61 @@
+/*!
+ * \file bound_propagation.h
+ *
+ * \brief Cheap proofs that a conjunction has no integer points, without
+ *        going through isl.
+ *
+ * Many dependence relations are unsatisfiable for reasons that need no
+ * instantiation of the universally quantified rules, i = ip together with
+ * i < ip for example. boundsProveUnsat looks for such reasons with two
+ * passes over the equalities and inequalities of a conjunction:
+ *
+ *  - interval propagation, which tightens a lower and an upper bound on
+ *    every variable from each constraint in turn until nothing changes or
+ *    a bound crosses the other, and
+ *  - a negative cycle search in the graph of difference constraints,
+ *    x - y <= c, including the bounds found by the first pass as
+ *    constraints against zero.
+ *
+ * UF calls and tuple expressions are opaque variables, one per distinct
+ * call, so the bounds that Set::boundDomainRange adds from the domain and
+ * range of each UF are all that is known about them. Both passes are sound
+ * over the integers: a conjunction they prove unsat has no points, one they
+ * cannot prove unsat may still have none.
+ *
+ * detectUnsatOrFindEqualities runs the filter first, when it is on
+ * (setBoundsUnsatFilter), and answers unsat without isl when every
+ * conjunction of the bounded set is proven unsat. The filter is on by
+ * default.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#ifndef BOUND_PROPAGATION_H_
+#define BOUND_PROPAGATION_H_
+
+namespace iegenlib{
+
+class Conjunction;
+class SparseConstraints;
+
+//! True if bound propagation shows that conj has no integer points.
+bool boundsProveUnsat(const Conjunction& conj);
+
+//! True if bound propagation shows that no conjunction of sc has integer
+//! points, and so for an sc without conjunctions, which is FALSE. UF
+//! calls are only bounded by the constraints already in sc.
+bool boundsProveUnsat(const SparseConstraints& sc);
+
+//! Turns the filter in detectUnsatOrFindEqualities on or off.
+void setBoundsUnsatFilter(bool enabled);
+
+//! True if detectUnsatOrFindEqualities runs the filter first.
+bool boundsUnsatFilter();
+
+}// iegenlib namespace
+
+#endif
@@ -0,0 +1,145 @@
+/*!
+ * \file bound_propagation_test.cc
+ *
+ * \brief Tests for proving conjunctions unsat without isl.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "bound_propagation.h"
+#include "set_relation.h"
+#include "environment.h"
+
+#include <gtest/gtest.h>
+
+using iegenlib::Relation;
+using iegenlib::Set;
+using iegenlib::boundsProveUnsat;
+
+#pragma mark BoundPropagationIntervals
+// Bounds that cross each other, directly or through other variables.
+TEST(BoundPropagationTest, Intervals) {
+    const char* unsat[] = {
+        "{[i] : 0 <= i && i < 0}",
+        "[n] -> {[i,j] : 0 <= i && i < n && n <= 0}",
+        "{[i,j] : 0 <= i && i < 5 && j = 2i && 10 < j}",
+        "{[i,j] : 0 <= i && i <= 3 && 0 <= j && j <= 3 && i + j >= 7}",
+        // no integer i with 2i = 1
+        "{[i] : 2i = 1}",
+    };
+    for (int t = 0; t < 5; t++) {
+        Set* s = new Set(unsat[t]);
+        EXPECT_TRUE( boundsProveUnsat(*s) ) << unsat[t];
+        delete s;
+    }
+
+    const char* mayBeSat[] = {
+        "{[i] : 0 <= i && i <= 0}",
+        "[n] -> {[i,j] : 0 <= i && i < n && i < j && j < n}",
+        "{[i,j] : 0 <= i && i <= 3 && 0 <= j && j <= 3 && i + j >= 6}",
+    };
+    for (int t = 0; t < 3; t++) {
+        Set* s = new Set(mayBeSat[t]);
+        EXPECT_FALSE( boundsProveUnsat(*s) ) << mayBeSat[t];
+        delete s;
+    }
+}
+
+#pragma mark BoundPropagationDifferences
+// Cycles of difference constraints need no bounds at all.
+TEST(BoundPropagationTest, Differences) {
+    Relation* r = new Relation("[n] -> {[i,k] -> [ip,kp] : i = ip"
+                               " && i < ip && 0 <= k && k < n}");
+    EXPECT_TRUE( boundsProveUnsat(*r) );
+    delete r;
+
+    Set* s = new Set("[n] -> {[i,j,k] : i < j && j < k && k <= i + 1}");
+    EXPECT_TRUE( boundsProveUnsat(*s) );
+    delete s;
+
+    s = new Set("[n] -> {[i,j,k] : i < j && j < k && k <= i + 2}");
+    EXPECT_FALSE( boundsProveUnsat(*s) );
+    delete s;
+}
+
+#pragma mark BoundPropagationUFCalls
+// UF calls are opaque, only bounded by the domains and ranges that
+// boundDomainRange adds.
+TEST(BoundPropagationTest, UFCalls) {
+    iegenlib::setCurrEnv();
+    iegenlib::appendCurrEnv("rowptr",
+        new Set("{[i]:0<=i &&i<m}"),
+        new Set("{[j]:0<=j &&j<nnz}"), false, iegenlib::Monotonic_Increasing);
+
+    // The same call on both sides.
+    Set* s = new Set("[m] -> {[i,k] : rowptr(i) <= k && k < rowptr(i)}");
+    EXPECT_TRUE( boundsProveUnsat(*s) );
+    delete s;
+
+    // Different calls, only a rule relates them.
+    s = new Set("[m] -> {[i,ip,k] : rowptr(i) <= k && k < rowptr(ip)"
+                " && ip <= i}");
+    EXPECT_FALSE( boundsProveUnsat(*s) );
+    delete s;
+
+    // rowptr's range is nonnegative.
+    s = new Set("[m] -> {[i] : rowptr(i) < 0}");
+    EXPECT_FALSE( boundsProveUnsat(*s) );
+    Set* bounded = s->boundDomainRange();
+    EXPECT_TRUE( boundsProveUnsat(*bounded) );
+    delete bounded;
+    delete s;
+}
+
+#pragma mark BoundPropagationDetectUnsat
+// detectUnsatOrFindEqualities answers unsat from the filter, and counts
+// the calls it answered.
+TEST(BoundPropagationTest, DetectUnsat) {
+    iegenlib::setCurrEnv();
+    Relation* r = new Relation("[n] -> {[i,k] -> [ip,kp] : i = ip"
+                               " && i < ip && 0 <= k && k < n}");
+    Relation* mayBeSat = new Relation("[n] -> {[i] -> [ip] : i < ip"
+                                      " && 0 <= i && ip < n}");
+
+    iegenlib::resetInstantiationSetStats();
+    EXPECT_TRUE( r->detectUnsatOrFindEqualities() == NULL );
+    Relation* result = mayBeSat->detectUnsatOrFindEqualities();
+    EXPECT_TRUE( result != NULL );
+    delete result;
+    iegenlib::InstantiationSetStats stats = iegenlib::instantiationSetStats();
+    EXPECT_EQ( 2u, stats.calls );
+    EXPECT_EQ( 1u, stats.boundsUnsat );
+
+    // Without the filter isl finds it unsat too.
+    iegenlib::setBoundsUnsatFilter(false);
+    iegenlib::resetInstantiationSetStats();
+    EXPECT_TRUE( r->detectUnsatOrFindEqualities() == NULL );
+    stats = iegenlib::instantiationSetStats();
+    EXPECT_EQ( 1u, stats.calls );
+    EXPECT_EQ( 0u, stats.boundsUnsat );
+    iegenlib::setBoundsUnsatFilter(true);
+
+    delete r;
+    delete mayBeSat;
+}
+
+#pragma mark BoundPropagationFalse
+// Without conjunctions a Set or Relation is FALSE, which the filter
+// answers before anything looks at its conjunctions.
+TEST(BoundPropagationTest, False) {
+    iegenlib::setCurrEnv();
+    Set* s = new Set("{[i] : 1 = 0}");
+    ASSERT_TRUE( s->conjunctionBegin() == s->conjunctionEnd() );
+    EXPECT_TRUE( boundsProveUnsat(*s) );
+    EXPECT_TRUE( s->detectUnsatOrFindEqualities() == NULL );
+    delete s;
+
+    Relation* r = new Relation("{[i] -> [ip] : 1 = 0}");
+    ASSERT_TRUE( r->conjunctionBegin() == r->conjunctionEnd() );
+    EXPECT_TRUE( r->detectUnsatOrFindEqualities() == NULL );
+    delete r;
+}
@@ -0,0 +1,186 @@
+/*!
+ * \file compact_term.cc
+ *
+ * \brief Implementation of the flat, tagged encoding of Terms.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "compact_term.h"
+#include "expression.h"
+#include "set_relation.h"
+
+#include <algorithm>
+
+namespace iegenlib{
+
+namespace {
+
+void collectTupleVars(const Term* t, std::vector<int>& locations);
+
+//! Appends the locations of the tuple variables in e to locations.
+void collectTupleVars(const Exp* e, std::vector<int>& locations) {
+    if (e == NULL) { return; }
+    const std::vector<Term*>& terms = e->terms();
+    for (unsigned int i = 0; i < terms.size(); i++) {
+        collectTupleVars(terms[i], locations);
+    }
+}
+
+//! Appends the locations of the tuple variables in t to locations.
+void collectTupleVars(const Term* t, std::vector<int>& locations) {
+    if (const UFCallTerm* call = dynamic_cast<const UFCallTerm*>(t)) {
+        for (unsigned int i = 0; i < call->numArgs(); i++) {
+            collectTupleVars(call->getParamExp(i), locations);
+        }
+    } else if (const TupleExpTerm* tuple
+                   = dynamic_cast<const TupleExpTerm*>(t)) {
+        for (unsigned int i = 0; i < tuple->size(); i++) {
+            collectTupleVars(tuple->getExpElem(i), locations);
+        }
+    } else if (const TupleVarTerm* tv = dynamic_cast<const TupleVarTerm*>(t)) {
+        locations.push_back(tv->tvloc());
+    }
+}
+
+}
+
+/***************************** CompactTermTable *****************************/
+
+std::size_t CompactTermTable::FactorHash::operator()(const Term* t) const {
+    return t->factorHash();
+}
+
+bool CompactTermTable::FactorEqual::operator()(const Term* a,
+                                               const Term* b) const {
+    return a->factorMatches(*b);
+}
+
+unsigned int CompactTermTable::factorId(const Term& t) {
+    std::unordered_map<const Term*, unsigned int, FactorHash,
+                       FactorEqual>::const_iterator it = mFactorIds.find(&t);
+    if (it != mFactorIds.end()) { return it->second; }
+
+    unsigned int begin = mFactorTupleVars.size();
+    collectTupleVars(&t, mFactorTupleVars);
+    std::sort(mFactorTupleVars.begin() + begin, mFactorTupleVars.end());
+    mFactorTupleVars.erase(std::unique(mFactorTupleVars.begin() + begin,
+                                       mFactorTupleVars.end()),
+                           mFactorTupleVars.end());
+    mFactorTupleVarsBegin.push_back(mFactorTupleVars.size());
+
+    unsigned int id = mFactors.size();
+    mFactors.push_back(&t);
+    mFactorIds[&t] = id;
+    return id;
+}
+
+CompactTerm CompactTermTable::compact(const Term& t) {
+    CompactTerm result;
+    result.coeff = t.coefficient();
+    result.kind = CompactTerm::ConstVal;
+    result.payload = 0;
+    if (t.isUFCall()) {
+        result.kind = CompactTerm::UFCall;
+        result.payload = factorId(t);
+    } else if (t.isTupleExp()) {
+        result.kind = CompactTerm::TupleExp;
+        result.payload = factorId(t);
+    } else if (const TupleVarTerm* tv
+                   = dynamic_cast<const TupleVarTerm*>(&t)) {
+        result.kind = CompactTerm::TupleVar;
+        result.payload = tv->tvloc();
+    } else if (const VarTerm* var = dynamic_cast<const VarTerm*>(&t)) {
+        result.kind = CompactTerm::SymConst;
+        result.payload = var->internedSymbol().id();
+    }
+    return result;
+}
+
+void CompactTermTable::compact(const Exp& e, std::vector<CompactTerm>& out) {
+    const std::vector<Term*>& terms = e.terms();
+    for (unsigned int i = 0; i < terms.size(); i++) {
+        out.push_back(compact(*terms[i]));
+    }
+}
+
+Term* CompactTermTable::expand(const CompactTerm& t) const {
+    switch (t.kind) {
+        case CompactTerm::TupleVar:
+            return new TupleVarTerm(t.coeff, t.payload);
+        case CompactTerm::SymConst:
+            return new VarTerm(t.coeff, Symbol::fromId(t.payload));
+        case CompactTerm::UFCall:
+        case CompactTerm::TupleExp: {
+            Term* term = mFactors[t.payload]->clone();
+            term->setCoefficient(t.coeff);
+            return term;
+        }
+        default:
+            return new Term(t.coeff);
+    }
+}
+
+Exp* CompactTermTable::expand(const CompactTerm* begin,
+                              const CompactTerm* end) const {
+    Exp* e = new Exp();
+    for (const CompactTerm* t = begin; t != end; t++) {
+        e->addTerm(expand(*t));
+    }
+    return e;
+}
+
+/**************************** CompactConjunction ****************************/
+
+CompactConjunction::CompactConjunction(const Conjunction& conj,
+                                       CompactTermTable& table)
+    : mTable(table), mNumEqualities(conj.equalities().size()) {
+    mBegin.reserve(conj.equalities().size()
+                   + conj.inequalities().size() + 1);
+    mBegin.push_back(0);
+    for (std::list<Exp*>::const_iterator i = conj.equalities().begin();
+            i != conj.equalities().end(); i++) {
+        table.compact(**i, mTerms);
+        mBegin.push_back(mTerms.size());
+    }
+    for (std::list<Exp*>::const_iterator i = conj.inequalities().begin();
+            i != conj.inequalities().end(); i++) {
+        table.compact(**i, mTerms);
+        mBegin.push_back(mTerms.size());
+    }
+}
+
+bool CompactConjunction::mentionsTupleVar(unsigned int c, int loc) const {
+    for (const CompactTerm* t = begin(c); t != end(c); t++) {
+        if (t->isTupleVar() && (int)t->payload == loc) { return true; }
+        if (t->hasFactor()) {
+            if (std::binary_search(mTable.factorTupleVarsBegin(t->payload),
+                                   mTable.factorTupleVarsEnd(t->payload),
+                                   loc)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+Conjunction* CompactConjunction::toConjunction(const TupleDecl& tdecl,
+                                               int inArity) const {
+    Conjunction* conj = new Conjunction(tdecl);
+    conj->setInArity(inArity);
+    for (unsigned int c = 0; c < numConstraints(); c++) {
+        Exp* e = mTable.expand(begin(c), end(c));
+        if (isEquality(c)) {
+            conj->addEquality(e);
+        } else {
+            conj->addInequality(e);
+        }
+    }
+    return conj;
+}
+
+}// iegenlib namespace
@@ -0,0 +1,171 @@
+/*!
+ * \file compact_term.h
+ *
+ * \brief Flat, tagged encoding of Terms and Conjunctions for scans.
+ *
+ * A Term is a heap object with a vtable, and its name or arguments live
+ * in further heap objects, so scanning the constraints of a Conjunction
+ * chases pointers for every term. A CompactTerm is three words: the
+ * coefficient, the kind of term and a payload. The payload is the tuple
+ * location of a tuple variable, the Symbol id of a symbolic constant, or
+ * the id a CompactTermTable gave the factor of a UF call or tuple
+ * expression. A CompactConjunction keeps all terms of all constraints in
+ * one array, so passes over it are linear:
+ *
+ *   CompactTermTable table;
+ *   CompactConjunction compact(*conj, table);
+ *   for (unsigned int c = 0; c < compact.numConstraints(); c++) {
+ *       for (const CompactTerm* t = compact.begin(c);
+ *            t != compact.end(c); t++) { ... }
+ *   }
+ *   Exp* e = table.expand(compact.begin(0), compact.end(0));
+ *
+ * Converting back gives new Terms and Exps equal to the originals. A
+ * table is meant for one operation: it refers to the UF calls and tuple
+ * expressions it was given instead of copying them, so they must outlive
+ * it, and it is not safe to share between threads.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#ifndef COMPACT_TERM_H_
+#define COMPACT_TERM_H_
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace iegenlib{
+
+class Term;
+class Exp;
+class Conjunction;
+class TupleDecl;
+
+/*!
+ * \struct CompactTerm
+ *
+ * \brief Coefficient, kind and payload of a Term, by value.
+ */
+struct CompactTerm {
+    typedef enum {ConstVal, TupleVar, SymConst, UFCall, TupleExp} termkind;
+
+    int coeff;
+    unsigned char kind;
+    //! Tuple location, Symbol id or factor id depending on kind, 0 for
+    //! a constant.
+    unsigned int payload;
+
+    bool isConst() const { return kind == ConstVal; }
+    bool isTupleVar() const { return kind == TupleVar; }
+    bool isSymConst() const { return kind == SymConst; }
+    //! True for UF calls and tuple expressions, whose payload is a
+    //! factor id.
+    bool hasFactor() const { return kind == UFCall || kind == TupleExp; }
+
+    //! Same kind and payload, the compact Term::factorMatches.
+    bool factorMatches(const CompactTerm& other) const
+        { return kind == other.kind && payload == other.payload; }
+};
+
+/*!
+ * \class CompactTermTable
+ *
+ * \brief Gives UF call and tuple expression factors dense ids and
+ *        converts between Terms and CompactTerms.
+ */
+class CompactTermTable {
+public:
+    CompactTermTable() : mFactorTupleVarsBegin(1, 0) {}
+
+    //! Returns the compact form of t, giving its factor an id if needed.
+    CompactTerm compact(const Term& t);
+
+    //! Appends the compact form of each term of e to out.
+    void compact(const Exp& e, std::vector<CompactTerm>& out);
+
+    //! Returns a new Term equal to the one t was made from, caller owns it.
+    Term* expand(const CompactTerm& t) const;
+
+    //! Returns a new Exp, of the Expression kind, with the terms in
+    //! [begin,end). Caller owns it.
+    Exp* expand(const CompactTerm* begin, const CompactTerm* end) const;
+
+    //! Number of factors with an id.
+    unsigned int numFactors() const { return mFactors.size(); }
+
+    //! The first term given to the table with the factor of this id.
+    const Term& factor(unsigned int id) const { return *mFactors[id]; }
+
+    //! The sorted tuple locations used anywhere inside the factor with
+    //! the given id are [factorTupleVarsBegin(id), factorTupleVarsEnd(id)).
+    const int* factorTupleVarsBegin(unsigned int id) const
+        { return mFactorTupleVars.data() + mFactorTupleVarsBegin[id]; }
+    const int* factorTupleVarsEnd(unsigned int id) const
+        { return mFactorTupleVars.data() + mFactorTupleVarsBegin[id + 1]; }
+
+private:
+    CompactTermTable(const CompactTermTable&);
+    CompactTermTable& operator=(const CompactTermTable&);
+
+    unsigned int factorId(const Term& t);
+
+    struct FactorHash {
+        std::size_t operator()(const Term* t) const;
+    };
+    struct FactorEqual {
+        bool operator()(const Term* a, const Term* b) const;
+    };
+
+    std::vector<const Term*> mFactors;
+    //! Tuple locations of all factors, factor i's from
+    //! mFactorTupleVarsBegin[i] to mFactorTupleVarsBegin[i+1].
+    std::vector<int> mFactorTupleVars;
+    std::vector<unsigned int> mFactorTupleVarsBegin;
+    std::unordered_map<const Term*, unsigned int, FactorHash, FactorEqual>
+        mFactorIds;
+};
+
+/*!
+ * \class CompactConjunction
+ *
+ * \brief The constraints of a Conjunction as CompactTerms in one array,
+ *        equalities first.
+ */
+class CompactConjunction {
+public:
+    CompactConjunction(const Conjunction& conj, CompactTermTable& table);
+
+    unsigned int numConstraints() const { return mBegin.size() - 1; }
+    unsigned int numEqualities() const { return mNumEqualities; }
+    bool isEquality(unsigned int c) const { return c < mNumEqualities; }
+
+    //! The terms of constraint c, in the order of its Exp.
+    const CompactTerm* begin(unsigned int c) const
+        { return mTerms.data() + mBegin[c]; }
+    const CompactTerm* end(unsigned int c) const
+        { return mTerms.data() + mBegin[c + 1]; }
+
+    //! True if tuple variable loc shows up in constraint c, at the top
+    //! level or inside a UF call or tuple expression.
+    bool mentionsTupleVar(unsigned int c, int loc) const;
+
+    //! Returns a new Conjunction with these constraints and the given
+    //! tuple declaration and in arity. Caller owns it.
+    Conjunction* toConjunction(const TupleDecl& tdecl, int inArity) const;
+
+private:
+    const CompactTermTable& mTable;
+    std::vector<CompactTerm> mTerms;
+    //! Constraint c is mTerms[mBegin[c], mBegin[c+1]).
+    std::vector<unsigned int> mBegin;
+    unsigned int mNumEqualities;
+};
+
+}// iegenlib namespace
+
+#endif
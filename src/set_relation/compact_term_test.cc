@@ -0,0 +1,110 @@
+/*!
+ * \file compact_term_test.cc
+ *
+ * \brief Tests for the flat, tagged encoding of Terms and Conjunctions.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "compact_term.h"
+#include "expression.h"
+#include "set_relation.h"
+
+#include <gtest/gtest.h>
+
+using iegenlib::Term;
+using iegenlib::TupleVarTerm;
+using iegenlib::VarTerm;
+using iegenlib::UFCallTerm;
+using iegenlib::Exp;
+using iegenlib::Conjunction;
+using iegenlib::Relation;
+using iegenlib::CompactTerm;
+using iegenlib::CompactTermTable;
+using iegenlib::CompactConjunction;
+
+#pragma mark CompactTermRoundTrip
+// Terms of every kind convert to CompactTerms and back to equal Terms,
+// and UF calls with the same factor share an id.
+TEST(CompactTermTest, RoundTrip) {
+    CompactTermTable table;
+
+    Term c(7);
+    TupleVarTerm tv(-2, 3);
+    VarTerm n(4, "N");
+    UFCallTerm f(1, "f", 1);
+    Exp* arg = new Exp();
+    arg->addTerm(new TupleVarTerm(1));
+    arg->addTerm(new VarTerm("M"));
+    f.setParamExp(0, arg);
+    UFCallTerm* g = new UFCallTerm(f);
+    g->setCoefficient(5);
+
+    CompactTerm cc = table.compact(c);
+    CompactTerm ctv = table.compact(tv);
+    CompactTerm cn = table.compact(n);
+    CompactTerm cf = table.compact(f);
+    CompactTerm cg = table.compact(*g);
+
+    EXPECT_TRUE( cc.isConst() );
+    EXPECT_EQ( 7, cc.coeff );
+    EXPECT_TRUE( ctv.isTupleVar() );
+    EXPECT_EQ( 3u, ctv.payload );
+    EXPECT_TRUE( cn.isSymConst() );
+    EXPECT_EQ( n.internedSymbol().id(), cn.payload );
+    EXPECT_TRUE( cf.hasFactor() );
+    EXPECT_TRUE( cf.factorMatches(cg) );
+    EXPECT_EQ( 5, cg.coeff );
+    EXPECT_EQ( 1u, table.numFactors() );
+    // f(__tv1 + M) uses tuple variable 1 only.
+    EXPECT_EQ( 1, table.factorTupleVarsEnd(cf.payload)
+                  - table.factorTupleVarsBegin(cf.payload) );
+    EXPECT_EQ( 1, *table.factorTupleVarsBegin(cf.payload) );
+
+    const Term* originals[] = {&c, &tv, &n, &f, g};
+    CompactTerm compacts[] = {cc, ctv, cn, cf, cg};
+    for (int i = 0; i < 5; i++) {
+        Term* back = table.expand(compacts[i]);
+        EXPECT_EQ( originals[i]->toString(), back->toString() );
+        EXPECT_TRUE( *originals[i] == *back );
+        delete back;
+    }
+    delete g;
+}
+
+#pragma mark CompactConjunctionRoundTrip
+// A conjunction converts to one array of terms and back to an equal
+// conjunction, and tuple variables are found inside UF calls.
+TEST(CompactTermTest, ConjunctionRoundTrip) {
+    iegenlib::setCurrEnv();
+    Relation r("{[i,j] -> [k] : k = col(j) && rowptr(i) <= j "
+               "&& j < rowptr(i+1) && 0 <= i < N}");
+    const Conjunction* conj = *r.conjunctionBegin();
+
+    CompactTermTable table;
+    CompactConjunction compact(*conj, table);
+    EXPECT_EQ( conj->equalities().size(), compact.numEqualities() );
+    EXPECT_EQ( conj->equalities().size() + conj->inequalities().size(),
+               compact.numConstraints() );
+    // col, rowptr(i) and rowptr(i+1)
+    EXPECT_EQ( 3u, table.numFactors() );
+
+    // k = col(j) mentions j and k but not i.
+    EXPECT_TRUE( compact.isEquality(0) );
+    EXPECT_TRUE( compact.mentionsTupleVar(0, 1) );
+    EXPECT_TRUE( compact.mentionsTupleVar(0, 2) );
+    EXPECT_FALSE( compact.mentionsTupleVar(0, 0) );
+
+    Conjunction* back = compact.toConjunction(conj->getTupleDecl(),
+                                              conj->inarity());
+    EXPECT_EQ( conj->toString(), back->toString() );
+    EXPECT_TRUE( *conj == *back );
+    delete back;
+
+    EXPECT_TRUE( r.isFunction() );
+    EXPECT_FALSE( r.isFunctionInverse() );
+}
@@ -0,0 +1,374 @@
+/*!
+ * \file congruence_closure.cc
+ *
+ * \brief Congruence closure of conjunction equalities, see
+ *        congruence_closure.h.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "congruence_closure.h"
+#include "environment.h"
+#include "expression.h"
+#include "set_relation.h"
+#include "symbol.h"
+#include <util/UnionFindUniverse.h>
+
+#include <algorithm>
+
+namespace iegenlib{
+
+CongruenceClosure::CongruenceClosure(const Conjunction& conj)
+    : mConj(conj), mCompact(conj, mTable), mClasses(NULL), mMerges(0) {
+    TupleDecl tdecl = conj.getTupleDecl();
+    int arity = tdecl.size();
+
+    // Tuple variables are the first nodes, symbolic constants with their
+    // names are the same node.
+    for (int i = 0; i < arity; i++) {
+        CompactTerm tv = { 1, CompactTerm::TupleVar,
+                           static_cast<unsigned int>(i) };
+        node(tv);
+        if (!tdecl.elemIsConst(i)) {
+            mNodes.insert(std::make_pair(std::make_pair(
+                (unsigned char)CompactTerm::SymConst,
+                Symbol(tdecl.elemVarString(i)).id()), i));
+        }
+    }
+    for (unsigned int c = 0; c < mCompact.numConstraints(); c++) {
+        for (const CompactTerm* t = mCompact.begin(c);
+                t != mCompact.end(c); t++) {
+            if (!t->isConst()) { node(*t); }
+        }
+    }
+    // UF calls nested in arguments get factor ids, and nodes, as their
+    // callers are looked at.
+    for (unsigned int f = 0; f < mTable.numFactors(); f++) {
+        const UFCallTerm* call
+            = dynamic_cast<const UFCallTerm*>(&mTable.factor(f));
+        if (!call) { continue; }
+        std::vector<std::vector<CompactTerm> > args(call->numArgs());
+        for (unsigned int a = 0; a < call->numArgs(); a++) {
+            mTable.compact(*call->getParamExp(a), args[a]);
+            for (size_t t = 0; t < args[a].size(); t++) {
+                if (!args[a][t].isConst()) { node(args[a][t]); }
+            }
+        }
+        mArgs[mFactorNodes[f]].swap(args);
+    }
+
+    unsigned int numNodes = mAtoms.size();
+    mClasses = new OA::UnionFindUniverse(numNodes);
+    mUses.resize(numNodes);
+    mHasConstant.resize(numNodes, false);
+    mConstants.resize(numNodes, 0);
+    mBijective.resize(numNodes);
+    mDepths.resize(numNodes, 0);
+    for (unsigned int n = 0; n < numNodes; n++) {
+        mBest.push_back(n);
+        depth(n);
+    }
+    for (int i = 0; i < arity; i++) {
+        if (tdecl.elemIsConst(i)) { setConstant(i, tdecl.elemConstVal(i)); }
+    }
+
+    for (unsigned int n = 0; n < numNodes; n++) {
+        if (mAtoms[n].kind != CompactTerm::UFCall) { continue; }
+        std::vector<unsigned int> args;
+        for (size_t a = 0; a < mArgs[n].size(); a++) {
+            for (size_t t = 0; t < mArgs[n][a].size(); t++) {
+                if (!mArgs[n][a][t].isConst()) {
+                    args.push_back(mNodes[std::make_pair(
+                        mArgs[n][a][t].kind, mArgs[n][a][t].payload)]);
+                }
+            }
+        }
+        std::sort(args.begin(), args.end());
+        args.erase(std::unique(args.begin(), args.end()), args.end());
+        for (size_t a = 0; a < args.size(); a++) {
+            mUses[args[a]].push_back(n);
+        }
+        sign(n);
+
+        const UFCallTerm& call = static_cast<const UFCallTerm&>(
+            mTable.factor(mAtoms[n].payload));
+        if (!call.isIndexed() && queryBijectiveCurrEnv(call.nameSymbol())) {
+            mBijective[n][call.nameSymbol().id()] = n;
+        }
+    }
+
+    // a*x - a*y = 0 merges x and y, a*x + c = 0 gives x's class a
+    // constant.
+    for (unsigned int c = 0; c < mCompact.numEqualities(); c++) {
+        long long constant = 0;
+        std::vector<CompactTerm> vars;
+        for (const CompactTerm* t = mCompact.begin(c);
+                t != mCompact.end(c); t++) {
+            if (t->isConst()) { constant += t->coeff; }
+            else { vars.push_back(*t); }
+        }
+        if (vars.size() == 2 && constant == 0
+                && vars[0].coeff == -vars[1].coeff) {
+            mPending.push_back(std::make_pair(node(vars[0]),
+                                              node(vars[1])));
+        } else if (vars.size() == 1 && constant % vars[0].coeff == 0) {
+            setConstant(node(vars[0]), -constant / vars[0].coeff);
+        }
+    }
+    while (!mPending.empty()) {
+        std::pair<unsigned int, unsigned int> p = mPending.back();
+        mPending.pop_back();
+        merge(p.first, p.second);
+    }
+}
+
+CongruenceClosure::~CongruenceClosure() {
+    delete mClasses;
+}
+
+// Node of a variable or factor, registering it the first time.
+unsigned int CongruenceClosure::node(const CompactTerm& t) {
+    std::pair<std::map<std::pair<unsigned char, unsigned int>,
+                       unsigned int>::iterator, bool> inserted
+        = mNodes.insert(std::make_pair(std::make_pair(t.kind, t.payload),
+                                       (unsigned int)mAtoms.size()));
+    if (inserted.second) {
+        CompactTerm atom = t;
+        atom.coeff = 1;
+        mAtoms.push_back(atom);
+        mArgs.push_back(std::vector<std::vector<CompactTerm> >());
+        if (t.hasFactor()) {
+            if (mFactorNodes.size() <= t.payload) {
+                mFactorNodes.resize(t.payload + 1);
+            }
+            mFactorNodes[t.payload] = inserted.first->second;
+        }
+    }
+    return inserted.first->second;
+}
+
+// Nesting depth of UF calls in n, 0 for variables. Arguments are always
+// shallower than their call, so representatives picked by depth cannot
+// contain the calls they stand in for.
+unsigned int CongruenceClosure::depth(unsigned int n) {
+    if (mAtoms[n].kind == CompactTerm::UFCall && mDepths[n] == 0) {
+        unsigned int d = 0;
+        for (size_t a = 0; a < mArgs[n].size(); a++) {
+            for (size_t t = 0; t < mArgs[n][a].size(); t++) {
+                if (!mArgs[n][a][t].isConst()) {
+                    d = std::max(d, depth(node(mArgs[n][a][t])));
+                }
+            }
+        }
+        mDepths[n] = d + 1;
+    } else if (mAtoms[n].kind == CompactTerm::TupleExp) {
+        mDepths[n] = 1;
+    }
+    return mDepths[n];
+}
+
+unsigned int CongruenceClosure::find(unsigned int n) const {
+    return mClasses->Find(n);
+}
+
+void CongruenceClosure::merge(unsigned int a, unsigned int b) {
+    unsigned int ra = find(a), rb = find(b);
+    if (ra == rb) { return; }
+    // rb is renamed, its calls are signed again.
+    if (mUses[ra].size() < mUses[rb].size()) { std::swap(ra, rb); }
+    mClasses->Union(ra, rb);
+    mMerges++;
+
+    unsigned int best = mBest[rb];
+    if (mDepths[best] < mDepths[mBest[ra]] ||
+        (mDepths[best] == mDepths[mBest[ra]] && best < mBest[ra])) {
+        mBest[ra] = best;
+    }
+
+    for (std::map<unsigned int, unsigned int>::const_iterator
+            i = mBijective[rb].begin(); i != mBijective[rb].end(); i++) {
+        std::map<unsigned int, unsigned int>::iterator same
+            = mBijective[ra].find(i->first);
+        if (same == mBijective[ra].end()) {
+            mBijective[ra].insert(*i);
+        } else {
+            inferArguments(same->second, i->second);
+        }
+    }
+    mBijective[rb].clear();
+
+    std::vector<unsigned int> renamed;
+    renamed.swap(mUses[rb]);
+    mUses[ra].insert(mUses[ra].end(), renamed.begin(), renamed.end());
+    if (mHasConstant[rb] && !mHasConstant[ra]) {
+        // Every call using the class now sees the constant.
+        mHasConstant[ra] = true;
+        mConstants[ra] = mConstants[rb];
+        renamed = mUses[ra];
+    }
+    for (size_t u = 0; u < renamed.size(); u++) { sign(renamed[u]); }
+}
+
+void CongruenceClosure::setConstant(unsigned int n, long long value) {
+    unsigned int r = find(n);
+    // Two different constants make the conjunction empty, which is left
+    // for isl to find.
+    if (mHasConstant[r]) { return; }
+    mHasConstant[r] = true;
+    mConstants[r] = value;
+    for (size_t u = 0; u < mUses[r].size(); u++) { sign(mUses[r][u]); }
+}
+
+// Files call under the signature of its name and arguments, with every
+// variable replaced by its class, or the constant of its class. A call
+// with the same signature already filed is congruent to it.
+void CongruenceClosure::sign(unsigned int call) {
+    const UFCallTerm& term = static_cast<const UFCallTerm&>(
+        mTable.factor(mAtoms[call].payload));
+    std::vector<long long> signature;
+    signature.push_back(term.nameSymbol().id());
+    signature.push_back(term.isIndexed() ? term.tupleIndex() : -1);
+    signature.push_back(mArgs[call].size());
+    for (size_t a = 0; a < mArgs[call].size(); a++) {
+        long long constant = 0;
+        std::map<unsigned int, long long> coeffs;
+        for (size_t t = 0; t < mArgs[call][a].size(); t++) {
+            const CompactTerm& arg = mArgs[call][a][t];
+            if (arg.isConst()) {
+                constant += arg.coeff;
+                continue;
+            }
+            unsigned int r = find(mNodes[std::make_pair(arg.kind,
+                                                        arg.payload)]);
+            if (mHasConstant[r]) { constant += arg.coeff * mConstants[r]; }
+            else { coeffs[r] += arg.coeff; }
+        }
+        signature.push_back(constant);
+        for (std::map<unsigned int, long long>::const_iterator
+                i = coeffs.begin(); i != coeffs.end(); i++) {
+            if (i->second == 0) { continue; }
+            signature.push_back(i->first);
+            signature.push_back(i->second);
+        }
+        // Ends the argument, no class is named -1.
+        signature.push_back(-1);
+    }
+
+    std::pair<std::map<std::vector<long long>, unsigned int>::iterator,
+              bool> filed
+        = mSignatures.insert(std::make_pair(signature, call));
+    if (!filed.second && find(filed.first->second) != find(call)) {
+        mPending.push_back(std::make_pair(call, filed.first->second));
+    }
+}
+
+// Equal calls to a bijective UF have equal arguments, merges the ones that
+// are single variables.
+void CongruenceClosure::inferArguments(unsigned int call,
+                                       unsigned int other) {
+    mInferred.push_back(std::make_pair(call, other));
+    for (size_t a = 0; a < mArgs[call].size(); a++) {
+        const std::vector<CompactTerm>& x = mArgs[call][a];
+        const std::vector<CompactTerm>& y = mArgs[other][a];
+        if (x.size() == 1 && y.size() == 1 && !x[0].isConst()
+                && !y[0].isConst() && x[0].coeff == y[0].coeff) {
+            mPending.push_back(std::make_pair(node(x[0]), node(y[0])));
+        }
+    }
+}
+
+// Adds sign times t to e, with UF calls canonical.
+void CongruenceClosure::addArgument(Exp* e, const CompactTerm& t,
+                                    int sign) const {
+    if (t.kind == CompactTerm::UFCall) {
+        e->addTerm(canonicalCall(mFactorNodes[t.payload], sign * t.coeff));
+    } else {
+        CompactTerm signedTerm = t;
+        signedTerm.coeff *= sign;
+        e->addTerm(mTable.expand(signedTerm));
+    }
+}
+
+// Representative of n's class, times coeff, for a UF call argument.
+Term* CongruenceClosure::canonicalTerm(unsigned int n, int coeff) const {
+    unsigned int r = find(n);
+    if (mHasConstant[r]) { return new Term(coeff * mConstants[r]); }
+    const CompactTerm& best = mAtoms[mBest[r]];
+    if (best.kind == CompactTerm::UFCall) {
+        return canonicalCall(mBest[r], coeff);
+    }
+    CompactTerm term = best;
+    term.coeff = coeff;
+    return mTable.expand(term);
+}
+
+// The UF call node call, times coeff, with canonical arguments.
+Term* CongruenceClosure::canonicalCall(unsigned int call, int coeff) const {
+    const UFCallTerm& term = static_cast<const UFCallTerm&>(
+        mTable.factor(mAtoms[call].payload));
+    UFCallTerm* result = new UFCallTerm(coeff, term.nameSymbol(),
+        term.numArgs(), term.isIndexed() ? term.tupleIndex() : -1);
+    for (size_t a = 0; a < mArgs[call].size(); a++) {
+        Exp* arg = new Exp();
+        for (size_t t = 0; t < mArgs[call][a].size(); t++) {
+            const CompactTerm& x = mArgs[call][a][t];
+            if (x.isConst()) { arg->addTerm(new Term(x.coeff)); }
+            else {
+                std::map<std::pair<unsigned char, unsigned int>,
+                         unsigned int>::const_iterator n
+                    = mNodes.find(std::make_pair(x.kind, x.payload));
+                arg->addTerm(canonicalTerm(n->second, x.coeff));
+            }
+        }
+        result->setParamExp(a, arg);
+    }
+    return result;
+}
+
+Conjunction* CongruenceClosure::canonical() const {
+    Conjunction* result = new Conjunction(mConj.getTupleDecl());
+    result->setInArity(mConj.inarity());
+    // Variables and calls outside of arguments stay, the equalities
+    // between them are what justify the representatives.
+    for (unsigned int c = 0; c < mCompact.numConstraints(); c++) {
+        Exp* e = new Exp();
+        for (const CompactTerm* t = mCompact.begin(c);
+                t != mCompact.end(c); t++) {
+            addArgument(e, *t, 1);
+        }
+        if (mCompact.isEquality(c)) { result->addEquality(e); }
+        else { result->addInequality(e); }
+    }
+    for (size_t i = 0; i < mInferred.size(); i++) {
+        unsigned int x = mInferred[i].first, y = mInferred[i].second;
+        for (size_t a = 0; a < mArgs[x].size(); a++) {
+            Exp* e = new Exp();
+            for (size_t t = 0; t < mArgs[x][a].size(); t++) {
+                addArgument(e, mArgs[x][a][t], 1);
+            }
+            for (size_t t = 0; t < mArgs[y][a].size(); t++) {
+                addArgument(e, mArgs[y][a][t], -1);
+            }
+            result->addEquality(e);
+        }
+    }
+    return result;
+}
+
+Set* congruenceClosure(const Set& s) {
+    // No conjunctions is FALSE, while a new Set holds a TRUE one.
+    if (s.conjunctionBegin() == s.conjunctionEnd()) { return new Set(s); }
+    Set* result = new Set(s.arity());
+    for (ConstConjunctionIterator i = s.conjunctionBegin();
+            i != s.conjunctionEnd(); i++) {
+        CongruenceClosure closure(**i);
+        result->addConjunction(closure.canonical());
+    }
+    return result;
+}
+
+}// iegenlib namespace
@@ -0,0 +1,129 @@
+/*!
+ * \file congruence_closure.h
+ *
+ * \brief Equality classes of the variables and UF calls of a conjunction,
+ *        closed under congruence.
+ *
+ * The equalities of a conjunction between two variables or UF calls, such
+ * as i = ip or col(k) = j, put them in one class. Classes are then closed
+ * under congruence: f(a) and f(b) are in one class once the arguments a
+ * and b are, so i = ip makes col(i) = col(ip) without any rule
+ * instantiation. For a UF the environment declares bijective the converse
+ * holds as well, and f(a) = f(b) makes a = b.
+ *
+ * canonical() rewrites the conjunction so that the arguments of each UF
+ * call use one representative of each class, which leaves congruent calls
+ * as the same term:
+ *
+ *   CongruenceClosure closure(*conj);
+ *   Conjunction* smaller = closure.canonical();
+ *
+ * The classes live in an OA::UnionFindUniverse, and each class keeps the
+ * UF calls that use it as an argument, so merging two classes only looks
+ * again at the calls of the class that is renamed, the one with fewer.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#ifndef CONGRUENCE_CLOSURE_H_
+#define CONGRUENCE_CLOSURE_H_
+
+#include "compact_term.h"
+
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace OA {
+class UnionFindUniverse;
+}
+
+namespace iegenlib{
+
+class Conjunction;
+class Exp;
+class Set;
+class Term;
+
+/*!
+ * \class CongruenceClosure
+ *
+ * \brief Congruence closure of the equalities of one Conjunction.
+ */
+class CongruenceClosure {
+public:
+    //! Closes the equalities of conj, which must outlive this.
+    explicit CongruenceClosure(const Conjunction& conj);
+    ~CongruenceClosure();
+
+    //! Number of times two classes were merged, by an equality, a
+    //! congruence or a bijective UF.
+    unsigned int merges() const { return mMerges; }
+
+    //! Number of pairs of calls to a bijective UF found equal, each of
+    //! which makes their arguments equal.
+    unsigned int bijectiveInferences() const { return mInferred.size(); }
+
+    //! Returns a new Conjunction with the same points as the closed one,
+    //! with the UF call arguments rewritten to class representatives and
+    //! the argument equalities found from bijective UFs added. Caller
+    //! owns it.
+    Conjunction* canonical() const;
+
+private:
+    CongruenceClosure(const CongruenceClosure&);
+    CongruenceClosure& operator=(const CongruenceClosure&);
+
+    unsigned int node(const CompactTerm& t);
+    unsigned int depth(unsigned int n);
+    unsigned int find(unsigned int n) const;
+    void merge(unsigned int a, unsigned int b);
+    void setConstant(unsigned int n, long long value);
+    void sign(unsigned int call);
+    void inferArguments(unsigned int call, unsigned int other);
+    void addArgument(Exp* e, const CompactTerm& t, int sign) const;
+    Term* canonicalTerm(unsigned int n, int coeff) const;
+    Term* canonicalCall(unsigned int call, int coeff) const;
+
+    const Conjunction& mConj;
+    CompactTermTable mTable;
+    CompactConjunction mCompact;
+
+    //! The variable or factor of each node, with a coefficient of 1.
+    std::vector<CompactTerm> mAtoms;
+    std::map<std::pair<unsigned char, unsigned int>, unsigned int> mNodes;
+    //! Node of each factor id.
+    std::vector<unsigned int> mFactorNodes;
+    //! Arguments of each UF call node, empty for other nodes.
+    std::vector<std::vector<std::vector<CompactTerm> > > mArgs;
+    std::vector<unsigned int> mDepths;
+
+    OA::UnionFindUniverse* mClasses;
+    // Indexed by the name of a class.
+    //! UF calls with a member of the class in an argument.
+    std::vector<std::vector<unsigned int> > mUses;
+    //! Member that stands for the class in UF call arguments.
+    std::vector<unsigned int> mBest;
+    std::vector<bool> mHasConstant;
+    std::vector<long long> mConstants;
+    //! A call to each bijective UF in the class, by UF name id.
+    std::vector<std::map<unsigned int, unsigned int> > mBijective;
+
+    //! UF call by the signature of its name and class arguments.
+    std::map<std::vector<long long>, unsigned int> mSignatures;
+    std::vector<std::pair<unsigned int, unsigned int> > mPending;
+    std::vector<std::pair<unsigned int, unsigned int> > mInferred;
+    unsigned int mMerges;
+};
+
+//! Returns a new Set with each conjunction of s replaced by its
+//! CongruenceClosure::canonical(). Caller owns it.
+Set* congruenceClosure(const Set& s);
+
+}// iegenlib namespace
+
+#endif
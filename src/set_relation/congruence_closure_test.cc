@@ -0,0 +1,116 @@
+/*!
+ * \file congruence_closure_test.cc
+ *
+ * \brief Tests for the congruence closure of conjunction equalities.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "congruence_closure.h"
+#include "environment.h"
+#include "set_relation.h"
+
+#include <gtest/gtest.h>
+
+using iegenlib::CongruenceClosure;
+using iegenlib::Conjunction;
+using iegenlib::Relation;
+using iegenlib::Set;
+
+// The canonical form of s, as a string.
+static std::string canonicalString(const Set* s) {
+    Set* c = iegenlib::congruenceClosure(*s);
+    std::string str = c->toString();
+    delete c;
+    return str;
+}
+
+#pragma mark CongruenceClosureCongruence
+// Equal arguments make equal calls, nested ones too.
+TEST(CongruenceClosureTest, Congruence) {
+    iegenlib::setCurrEnv();
+    Set* s = new Set("[n] -> {[i,ip,k] : i = ip && col(i) < k"
+                     " && k <= col(ip) && 0 <= row(col(ip))}");
+    CongruenceClosure closure(**s->conjunctionBegin());
+    EXPECT_EQ( 2u, closure.merges() );
+    EXPECT_EQ( "{ [i, ip, k] : __tv0 - __tv1 = 0 && row(col(__tv0)) >= 0"
+               " && -__tv2 + col(__tv0) >= 0"
+               " && __tv2 - col(__tv0) - 1 >= 0 }", canonicalString(s) );
+    delete s;
+
+    // Through a chain of calls, and with a constant. g(k) < g(i) and
+    // h(j, 2) < h(0, 2) are both -1 >= 0 after.
+    s = new Set("{[i,j,k] : j = f(i) && k = f(j) && i = j"
+                " && g(k) < g(i) && h(j, 2) < h(0, 2) && i = 0}");
+    EXPECT_EQ( "{ [i, j, k] : __tv0 = 0 && __tv0 - __tv1 = 0"
+               " && __tv1 - f(0) = 0 && __tv2 - f(0) = 0 && -1 >= 0 }",
+               canonicalString(s) );
+    delete s;
+}
+
+#pragma mark CongruenceClosureBijective
+// Equal calls of a bijective UF have equal arguments.
+TEST(CongruenceClosureTest, Bijective) {
+    iegenlib::setCurrEnv();
+    iegenlib::appendCurrEnv("sigma",
+        new Set("{[i]:0<=i &&i<n}"),
+        new Set("{[j]:0<=j &&j<n}"), true, iegenlib::Monotonic_NONE);
+    iegenlib::appendCurrEnv("col",
+        new Set("{[i]:0<=i &&i<n}"),
+        new Set("{[j]:0<=j &&j<n}"), false, iegenlib::Monotonic_NONE);
+
+    Set* s = new Set("[n] -> {[i,ip,k] : sigma(i) = sigma(ip)"
+                     " && col(i) < k && k < col(ip)}");
+    CongruenceClosure closure(**s->conjunctionBegin());
+    EXPECT_EQ( 1u, closure.bijectiveInferences() );
+    EXPECT_EQ( "{ [i, ip, k] : __tv0 - __tv1 = 0"
+               " && -__tv2 + col(__tv0) - 1 >= 0"
+               " && __tv2 - col(__tv0) - 1 >= 0 }", canonicalString(s) );
+    delete s;
+
+    // Not for other UFs.
+    s = new Set("[n] -> {[i,ip] : col(i) = col(ip) && i < ip}");
+    CongruenceClosure notBijective(**s->conjunctionBegin());
+    EXPECT_EQ( 0u, notBijective.bijectiveInferences() );
+    EXPECT_EQ( "{ [i, ip] : col(__tv0) - col(__tv1) = 0"
+               " && -__tv0 + __tv1 - 1 >= 0 }", canonicalString(s) );
+    delete s;
+
+    // Expression arguments become equalities.
+    s = new Set("[n] -> {[i,ip] : sigma(i + 1) = sigma(2ip)}");
+    EXPECT_EQ( "{ [i, ip] : sigma(2 __tv1) - sigma(__tv0 + 1) = 0"
+               " && __tv0 - 2 __tv1 + 1 = 0 }", canonicalString(s) );
+    delete s;
+}
+
+#pragma mark CongruenceClosureUnchanged
+// Without equalities between variables or calls nothing changes.
+TEST(CongruenceClosureTest, Unchanged) {
+    iegenlib::setCurrEnv();
+    Relation* r = new Relation("[n] -> {[i,k] -> [ip,kp] : i < ip"
+                               " && rowptr(i) <= k && k < rowptr(i + 1)"
+                               " && kp = k + 1 && f(g(i)) < n}");
+    CongruenceClosure closure(**r->conjunctionBegin());
+    EXPECT_EQ( 0u, closure.merges() );
+    Conjunction* c = closure.canonical();
+    EXPECT_EQ( (*r->conjunctionBegin())->toString(), c->toString() );
+    delete c;
+    delete r;
+}
+
+#pragma mark CongruenceClosureFalse
+// A Set without conjunctions stays FALSE.
+TEST(CongruenceClosureTest, False) {
+    iegenlib::setCurrEnv();
+    Set* s = new Set("{[i] : 1 = 0}");
+    ASSERT_TRUE( s->conjunctionBegin() == s->conjunctionEnd() );
+    Set* c = iegenlib::congruenceClosure(*s);
+    EXPECT_TRUE( c->conjunctionBegin() == c->conjunctionEnd() );
+    EXPECT_EQ( s->toString(), c->toString() );
+    delete c;
+    delete s;
+}
@@ -210,3 +210,185 @@ TEST(detectUnsatOrFindEqualitiesTest, detectUnsatOrFindEqualitiesTEST){
   }
 }
 
+
+
+#pragma mark ruleInstantiationPruningTEST
+// Rules on UFs the constraints do not mention, expressions that are not
+// arguments of related UFs, and trivial instantiations are skipped.
+TEST(detectUnsatOrFindEqualitiesTest, ruleInstantiationPruningTEST){
+
+  iegenlib::setCurrEnv();
+  iegenlib::appendCurrEnv("rowptr",
+     new Set("{[i]:0<=i &&i<m}"), 
+     new Set("{[j]:0<=j &&j<nnz}"), false, iegenlib::Monotonic_Increasing);
+  iegenlib::appendCurrEnv("colidx",
+     new Set("{[i]:0<=i &&i<nnz}"), 
+     new Set("{[j]:0<=j &&j<m}"), false, iegenlib::Monotonic_NONE);
+  iegenlib::appendCurrEnv("g",
+     new Set("{[i]:0<=i &&i<m}"), 
+     new Set("{[j]:0<=j &&j<m}"), false, iegenlib::Monotonic_Nondecreasing);
+  // Forall e1, 0 <= e1 => 0 <= rowptr(e1)
+  currentEnv.addUniQuantRule( new UniQuantRule(std::string("DomainRange"),
+            std::string("[e1]"), std::string("0 <= e1"),
+            std::string("0 <= rowptr(e1)") ) );
+
+  Set *s = new Set("{[i,k]: rowptr(i) <= k && k < rowptr(i+1) "
+                   "&& 0 <= colidx(k)}");
+  std::map<Exp, std::set<std::string> > instExps;
+  Exp *e = new Exp();
+  e->addTerm(new TupleVarTerm(1, 0));             // i
+  instExps[*e].insert("rowptr");
+  e->addTerm(new Term(1));                        // i + 1
+  instExps[*e].insert("rowptr");
+  delete e;
+  e = new Exp();
+  e->addTerm(new TupleVarTerm(1, 1));             // k
+  instExps[*e].insert("colidx");
+  delete e;
+
+  UFCallMap *ufcmap = new UFCallMap();
+  iegenlib::resetRuleInstantiationStats();
+  std::set<std::pair <std::string,std::string>> instantiations;
+  instantiations = ruleInstantiation(instExps, NULL, s->getTupleDecl(),
+                                     ufcmap);
+  iegenlib::RuleInstantiationStats stats =
+    iegenlib::ruleInstantiationStats();
+
+  // The rule on g is not instantiated, the two monotonicity rules of
+  // rowptr are instantiated with pairs from {i, i+1} and the domain rule
+  // with each of them.
+  EXPECT_EQ( 3u, stats.rules );
+  EXPECT_EQ( 1u, stats.rulesPruned );
+  EXPECT_EQ( 10u, stats.tuples );
+  EXPECT_EQ( 11u, stats.tuplesPruned );
+  // e.g. __tv0 < __tv0 => rowptr(__tv0) < rowptr(__tv0)
+  EXPECT_LE( 1u, stats.trivialPruned );
+  EXPECT_GE( stats.tuples - stats.trivialPruned, instantiations.size() );
+  for (std::set<std::pair <std::string,std::string>>::iterator
+       it=instantiations.begin(); it!=instantiations.end(); it++){
+    EXPECT_NE( std::string("false"), (*it).first );
+    EXPECT_NE( std::string("true"), (*it).second );
+  }
+
+  // Without the UF names every rule is instantiated with every pair.
+  iegenlib::resetRuleInstantiationStats();
+  std::set<Exp> plainExps;
+  for (std::map<Exp, std::set<std::string> >::iterator
+       it=instExps.begin(); it!=instExps.end(); it++){
+    plainExps.insert(it->first);
+  }
+  ruleInstantiation(plainExps, NULL, s->getTupleDecl(), ufcmap);
+  stats = iegenlib::ruleInstantiationStats();
+  EXPECT_EQ( 4u, stats.rules );
+  EXPECT_EQ( 0u, stats.rulesPruned );
+  EXPECT_EQ( 0u, stats.tuplesPruned );
+
+  delete s;
+  delete ufcmap;
+}
+
+
+#pragma mark detectUnsatOrFindEqualitiesThreadsTEST
+// Checking the instantiations on several threads finds the same results
+// for any number of threads, here also the same as on one thread.
+TEST(detectUnsatOrFindEqualitiesTest, detectUnsatOrFindEqualitiesThreadsTEST){
+
+  iegenlib::setCurrEnv();
+  iegenlib::appendCurrEnv("colidx",
+        new Set("{[i]:0<=i &&i<nnz}"), 
+        new Set("{[j]:0<=j &&j<m}"), false, iegenlib::Monotonic_NONE);
+  iegenlib::appendCurrEnv("rowptr",
+        new Set("{[i]:0<=i &&i<m}"), 
+        new Set("{[j]:0<=j &&j<nnz}"), false, iegenlib::Monotonic_Increasing);
+  iegenlib::appendCurrEnv("diagptr",
+        new Set("{[i]:0<=i &&i<m}"), 
+        new Set("{[j]:0<=j &&j<nnz}"), false, iegenlib::Monotonic_Increasing);
+  // Forall e1,e2,  e1 = e2 => rowptr(e1) <= diagptr(e2)
+  currentEnv.addUniQuantRule( new UniQuantRule(
+        std::string("CoMonotonicity"), std::string("[e1,e2]"), 
+        std::string("e1 = e2"), std::string("rowptr(e1) <= diagptr(e2)") ) );
+  // Forall e1,e2,  e1 < e2 => diagptr(e1) < rowptr(e2)
+  currentEnv.addUniQuantRule( new UniQuantRule(
+        std::string("CoMonotonicity"), std::string("[e1,e2]"), 
+        std::string("e1 < e2"), std::string("diagptr(e1) < rowptr(e2)") ) );
+
+  // UnSat
+  Relation *r1 = new Relation("[m] -> {[i,k] -> [ip,kp]: i < ip"
+                  " && 0 <= i && i < m && 0 <= ip && ip < m"
+                  " && rowptr(i) <= k && k < diagptr(i)"
+                  " && rowptr(ip) <= kp && kp < diagptr(ip) && k = kp }");
+  // MaySat, with the new equality i = colidx(kp)
+  Set *s2 = new Set("[m] -> {[i,k,j1,j2,ip,kp,j1p,j2p]: ip < i"
+                  " && 0 <= i && i < m && 0 <= ip && ip < m"
+                  " && rowptr(i) <= k && k < diagptr(i)"
+                  " && rowptr(ip) <= kp && kp < diagptr(ip)"
+                  " && k < j1 && j1 < rowptr(1+i)"
+                  " && kp < j1p && j1p < rowptr(1+ip)"
+                  " && diagptr(colidx(k)) < j2 && j2 < rowptr(1+colidx(k))"
+                  " && diagptr(colidx(kp)) < j2p && j2p < rowptr(1+colidx(kp))"
+                  " && colidx(j1) = colidx(j2) && colidx(j1p) = colidx(j2p)"
+                  " && j1 = j2p }");
+
+  Relation *r1_result = r1->detectUnsatOrFindEqualities(NULL, 4);
+  EXPECT_TRUE( r1_result == NULL );
+
+  Set *serial = s2->detectUnsatOrFindEqualities(NULL, 1);
+  Set *parallel = s2->detectUnsatOrFindEqualities(NULL, 4);
+  Set *parallel2 = s2->detectUnsatOrFindEqualities(NULL, 2);
+  ASSERT_TRUE( serial != NULL );
+  ASSERT_TRUE( parallel != NULL );
+  ASSERT_TRUE( parallel2 != NULL );
+  EXPECT_EQ( serial->toISLString(), parallel->toISLString() );
+  EXPECT_EQ( parallel->toISLString(), parallel2->toISLString() );
+
+  delete r1;
+  delete s2;
+  delete serial;
+  delete parallel;
+  delete parallel2;
+}
+
+#pragma mark instantiationSetStatsTEST
+// The work list in instantiationSet reports what it did.
+TEST(detectUnsatOrFindEqualitiesTest, instantiationSetStatsTEST){
+
+  iegenlib::setCurrEnv();
+  iegenlib::appendCurrEnv("rowptr",
+        new Set("{[i]:0<=i &&i<m}"), 
+        new Set("{[j]:0<=j &&j<nnz}"), false, iegenlib::Monotonic_Increasing);
+  iegenlib::appendCurrEnv("diagptr",
+        new Set("{[i]:0<=i &&i<m}"), 
+        new Set("{[j]:0<=j &&j<nnz}"), false, iegenlib::Monotonic_Increasing);
+  // Forall e1,e2,  e1 = e2 => rowptr(e1) <= diagptr(e2)
+  currentEnv.addUniQuantRule( new UniQuantRule(
+        std::string("CoMonotonicity"), std::string("[e1,e2]"), 
+        std::string("e1 = e2"), std::string("rowptr(e1) <= diagptr(e2)") ) );
+  // Forall e1,e2,  e1 < e2 => diagptr(e1) < rowptr(e2)
+  currentEnv.addUniQuantRule( new UniQuantRule(
+        std::string("CoMonotonicity"), std::string("[e1,e2]"), 
+        std::string("e1 < e2"), std::string("diagptr(e1) < rowptr(e2)") ) );
+
+  // UnSat
+  Relation *r1 = new Relation("[m] -> {[i,k] -> [ip,kp]: i < ip"
+                  " && 0 <= i && i < m && 0 <= ip && ip < m"
+                  " && rowptr(i) <= k && k < diagptr(i)"
+                  " && rowptr(ip) <= kp && kp < diagptr(ip) && k = kp }");
+
+  iegenlib::resetInstantiationSetStats();
+  Relation *r1_result = r1->detectUnsatOrFindEqualities(NULL, 1);
+  EXPECT_TRUE( r1_result == NULL );
+
+  iegenlib::InstantiationSetStats stats = iegenlib::instantiationSetStats();
+  EXPECT_LE( 1u, stats.rounds );
+  EXPECT_LE( 1u, stats.additions );
+  // Every addition needs at least one gist to be found.
+  EXPECT_LE( stats.additions, stats.gists );
+
+  iegenlib::resetInstantiationSetStats();
+  stats = iegenlib::instantiationSetStats();
+  EXPECT_EQ( 0u, stats.rounds );
+  EXPECT_EQ( 0u, stats.gists );
+  EXPECT_EQ( 0u, stats.additions );
+
+  delete r1;
+}
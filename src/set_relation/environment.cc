@@ -17,21 +17,41 @@
 
 #include "environment.h"
 #include "set_relation.h"
+#include <atomic>
 
 namespace iegenlib{
 
+//! Last version handed out to an environment, see Environment::touch
+static std::atomic<unsigned long> lastEnvVersion(0);
+
 Environment currentEnv;
 
+//! Environment of the innermost EnvironmentScope on the thread, if any.
+static thread_local Environment* theScopedEnv = NULL;
+
+Environment& getCurrEnv() {
+    return theScopedEnv ? *theScopedEnv : currentEnv;
+}
+
+EnvironmentScope::EnvironmentScope(Environment& env)
+    : mPrevious(theScopedEnv) {
+    theScopedEnv = &env;
+}
+
+EnvironmentScope::~EnvironmentScope() {
+    theScopedEnv = mPrevious;
+}
+
 //! Resets the current environment to empty.
 void setCurrEnv() {
-    currentEnv.reset();
+    getCurrEnv().reset();
 }
 
 //! Resets the current environment to empty and then accepts new UninterpFunc
 //! declaration into new environment.
 void setCurrEnv(std::string funcName, Set* domain, Set* range,
                 bool bijective, MonotonicType monoType) {
-    currentEnv.reset();
+    getCurrEnv().reset();
     appendCurrEnv(funcName, domain, range, bijective, monoType);
 }
 
@@ -58,7 +78,7 @@ void appendCurrEnv(std::string funcName, Set* domain, Set* range,
                                            bijective, monoType);
   // create new environment
   Environment* env = new Environment(ufunc);
-  currentEnv.append(env);
+  getCurrEnv().append(env);
 
 /* Adding quantified rules for functional consistency and monotonicity */
   if( domain->getArity() == 1 && range->getArity() == 1 ){
@@ -73,7 +93,7 @@ void appendCurrEnv(std::string funcName, Set* domain, Set* range,
     leftSide = ( "e1 = e2" );
     rightSide = ( funcName + "(e1) = " + funcName + "(e2)" );
     uqRule = new UniQuantRule(type, tupleDecl, leftSide, rightSide);
-    currentEnv.addUniQuantRule( uqRule );
+    getCurrEnv().addUniQuantRule( uqRule );
 */
     // 3.1.2 Adding Monotonicity rules based on:
     //   If UF monotonically strictly increasing then:
@@ -85,7 +105,7 @@ void appendCurrEnv(std::string funcName, Set* domain, Set* range,
       leftSide = ( "e1 < e2" );
       rightSide = ( funcName + "(e1) < " + funcName + "(e2)" );
       uqRule = new UniQuantRule(type, tupleDecl, leftSide, rightSide);
-      currentEnv.addUniQuantRule( uqRule );
+      getCurrEnv().addUniQuantRule( uqRule );
 /*
       // forall e1, e2 : UF(e1) = UF(e2) => e1 = e2
       type = ("Monotonicity");
@@ -93,7 +113,7 @@ void appendCurrEnv(std::string funcName, Set* domain, Set* range,
       leftSide = ( funcName + "(e1) = " + funcName + "(e2)" );
       rightSide = ( "e1 = e2" );
       uqRule = new UniQuantRule(type, tupleDecl, leftSide, rightSide);
-      currentEnv.addUniQuantRule( uqRule );
+      getCurrEnv().addUniQuantRule( uqRule );
 */
       // forall e1, e2 : UF(e1) < UF(e2) => e1 < e2
       type = ("Monotonicity");
@@ -101,7 +121,7 @@ void appendCurrEnv(std::string funcName, Set* domain, Set* range,
       leftSide = ( funcName + "(e1) < " + funcName + "(e2)" );
       rightSide = ( "e1 < e2" );
       uqRule = new UniQuantRule(type, tupleDecl, leftSide, rightSide);
-      currentEnv.addUniQuantRule( uqRule );
+      getCurrEnv().addUniQuantRule( uqRule );
 /*
       // forall e1, e2 : UF(e1) <= UF(e2) => e1 <= e2
       type = ("Monotonicity");
@@ -109,7 +129,7 @@ void appendCurrEnv(std::string funcName, Set* domain, Set* range,
       leftSide = ( funcName + "(e1) <= " + funcName + "(e2)" );
       rightSide = ( "e1 <= e2" );
       uqRule = new UniQuantRule(type, tupleDecl, leftSide, rightSide);
-      currentEnv.addUniQuantRule( uqRule );
+      getCurrEnv().addUniQuantRule( uqRule );
 */
     //   If UF monotonically increasing then:
     } else  if ( Monotonic_Nondecreasing == monoType ){
@@ -120,7 +140,7 @@ void appendCurrEnv(std::string funcName, Set* domain, Set* range,
       leftSide = ( "e1 < e2" );
       rightSide = ( funcName + "(e1) <= " + funcName + "(e2)" );
       uqRule = new UniQuantRule(type, tupleDecl, leftSide, rightSide);
-      currentEnv.addUniQuantRule( uqRule );
+      getCurrEnv().addUniQuantRule( uqRule );
   
     // If UF monotonically strictly decreasing then
     } else if ( Monotonic_Decreasing == monoType ){
@@ -131,7 +151,7 @@ void appendCurrEnv(std::string funcName, Set* domain, Set* range,
       leftSide = ( "e1 < e2" );
       rightSide = ( funcName + "(e1) > " + funcName + "(e2)" );
       uqRule = new UniQuantRule(type, tupleDecl, leftSide, rightSide);
-      currentEnv.addUniQuantRule( uqRule );
+      getCurrEnv().addUniQuantRule( uqRule );
 /*
       // forall e1, e2 : UF(e1) = UF(e2) => e1 = e2
       type = ("Monotonicity");
@@ -139,7 +159,7 @@ void appendCurrEnv(std::string funcName, Set* domain, Set* range,
       leftSide = ( funcName + "(e1) = " + funcName + "(e2)" );
       rightSide = ( "e1 = e2" ); 
       uqRule = new UniQuantRule(type, tupleDecl, leftSide, rightSide);
-      currentEnv.addUniQuantRule( uqRule );
+      getCurrEnv().addUniQuantRule( uqRule );
 */
       // forall e1, e2 : UF(e1) < UF(e2) => e1 > e2
       type = ("Monotonicity");
@@ -147,7 +167,7 @@ void appendCurrEnv(std::string funcName, Set* domain, Set* range,
       leftSide = ( funcName + "(e1) < " + funcName + "(e2)" );
       rightSide = ( "e1 > e2" );
       uqRule = new UniQuantRule(type, tupleDecl, leftSide, rightSide);
-      currentEnv.addUniQuantRule( uqRule );
+      getCurrEnv().addUniQuantRule( uqRule );
 /*
       // forall e1, e2 : UF(e1) <= UF(e2) => e1 >= e2
       type = ("Monotonicity");
@@ -155,7 +175,7 @@ void appendCurrEnv(std::string funcName, Set* domain, Set* range,
       leftSide = ( funcName + "(e1) <= " + funcName + "(e2)" );
       rightSide = ( "e1 >= e2" );
       uqRule = new UniQuantRule(type, tupleDecl, leftSide, rightSide);
-      currentEnv.addUniQuantRule( uqRule );
+      getCurrEnv().addUniQuantRule( uqRule );
 */
       // If UF monotonically decreasing then:
     } else  if ( Monotonic_Nonincreasing == monoType ){
@@ -166,7 +186,7 @@ void appendCurrEnv(std::string funcName, Set* domain, Set* range,
       leftSide = ( "e1 < e2" );
       rightSide = ( funcName + "(e1) >= " + funcName + "(e2)" );
       uqRule = new UniQuantRule(type, tupleDecl, leftSide, rightSide);
-      currentEnv.addUniQuantRule( uqRule );
+      getCurrEnv().addUniQuantRule( uqRule );
     }
   }
 /////////////////////////////////////////////////////////////////
@@ -175,18 +195,22 @@ void appendCurrEnv(std::string funcName, Set* domain, Set* range,
 void appendCurrEnv(std::string str) {
     // parse the environment
     Environment* env = parser::parse_env(str);
-    currentEnv.append(env);
+    getCurrEnv().append(env);
 }
 */
 
-std::string queryInverseCurrEnv(const std::string funcName){
-    return currentEnv.funcInverse(funcName);
+const std::string& queryInverseCurrEnv(const Symbol& funcName){
+    return getCurrEnv().funcInverse(funcName);
+}
+
+Symbol queryInverseSymbolCurrEnv(const Symbol& funcName){
+    return getCurrEnv().funcInverseSymbol(funcName);
 }
 
 //! search this environment for a function domain
 //! returned Set is a clone
-Set* queryDomainCurrEnv(const std::string funcName) {
-    Set* retval = currentEnv.funcDomain(funcName);
+Set* queryDomainCurrEnv(const Symbol& funcName) {
+    Set* retval = getCurrEnv().funcDomain(funcName);
     if (retval==NULL) {
         std::stringstream ss;
         ss << "queryDomainCurrEnv: the function " << funcName;
@@ -198,8 +222,8 @@ Set* queryDomainCurrEnv(const std::string funcName) {
 
 //! search this environment for a function range
 //! returned Set is a clone
-Set* queryRangeCurrEnv(const std::string funcName) {
-    Set* retval = currentEnv.funcRange(funcName);
+Set* queryRangeCurrEnv(const Symbol& funcName) {
+    Set* retval = getCurrEnv().funcRange(funcName);
     if (retval==NULL) {
         std::stringstream ss;
         ss << "queryRangeCurrEnv: the function " << funcName;
@@ -210,14 +234,18 @@ Set* queryRangeCurrEnv(const std::string funcName) {
 }
 
 //! search this environment for a function monotonicity type
-MonotonicType queryMonoTypeEnv(const std::string funcName) {
-    return currentEnv.funcMonoType(funcName);
+MonotonicType queryMonoTypeEnv(const Symbol& funcName) {
+    return getCurrEnv().funcMonoType(funcName);
+}
+
+bool queryBijectiveCurrEnv(const Symbol& funcName) {
+    return getCurrEnv().funcBijective(funcName);
 }
 
 
 
 //! search this environment for a function's range arity
-unsigned int queryRangeArityCurrEnv(const std::string funcName) {
+unsigned int queryRangeArityCurrEnv(const Symbol& funcName) {
     Set* range = queryRangeCurrEnv(funcName);
     unsigned int retval = range->arity();
     delete range;
@@ -225,7 +253,7 @@ unsigned int queryRangeArityCurrEnv(const std::string funcName) {
 }
 
 //! search this environment for a function's range arity
-unsigned int queryDomainArityCurrEnv(const std::string funcName) {
+unsigned int queryDomainArityCurrEnv(const Symbol& funcName) {
     Set* domain = queryDomainCurrEnv(funcName);
     unsigned int retval = domain->arity();
     delete domain;
@@ -234,18 +262,23 @@ unsigned int queryDomainArityCurrEnv(const std::string funcName) {
 
 //! add an universially quantified Rule to environment
 void addUniQuantRule(UniQuantRule *uqRule){
-    currentEnv.addUniQuantRule(uqRule);
+    getCurrEnv().addUniQuantRule(uqRule);
 }
 
 // Return the number of available universially quantified Rules
 int queryNoUniQuantRules(){
-  return currentEnv.getNoUniQuantRules();
+  return getCurrEnv().getNoUniQuantRules();
 }
 
 // Returns the universially quantified Rule No. idx stored in the enviroment
 //! The environment still owns returned object (user should not delete it)
 UniQuantRule* queryUniQuantRuleEnv(int idx){
-  return currentEnv.getUniQuantRule(idx);
+  return getCurrEnv().getUniQuantRule(idx);
+}
+
+// Returns the version of the current environment
+unsigned long queryVersionCurrEnv(){
+  return getCurrEnv().version();
 }
 
 //! Get an UniQuantRule representing Domain and Range of an UF Symbol
@@ -291,9 +324,10 @@ UniQuantRule* getUQRForFuncDomainRange(std::string func){
 
 
 void Environment::append(Environment *other){
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
     mInverseMap.insert(other->mInverseMap.begin(),other->mInverseMap.end());
     // Need to do a deep copy of the UninterpFunc objects
-    for (std::map<std::string, UninterpFunc*>::iterator     
+    for (std::unordered_map<Symbol, UninterpFunc*>::iterator     
             it=other->mUninterpFuncMap.begin(); 
             it!=other->mUninterpFuncMap.end(); it++) {
         // checking for duplicates
@@ -304,11 +338,13 @@ void Environment::append(Environment *other){
         mUninterpFuncMap[it->first] = new UninterpFunc(*(it->second));
     }
     delete other;   
+    touch();
 }
 
 
 //! Construct an Environment 
 Environment::Environment(UninterpFunc* symfunc){
+    touch();
     // If we don't already know about this function.
     if (mUninterpFuncMap.find(symfunc->getName())==mUninterpFuncMap.end()) {
         mUninterpFuncMap[symfunc->getName()] = symfunc;
@@ -338,16 +374,22 @@ Environment::Environment(UninterpFunc* symfunc){
 
 //! Assignment operator for Environment.
 Environment& Environment::operator=(const Environment& other) {
-    for (std::map<std::string, std::string>::const_iterator     
+    if (this == &other) { return *this; }
+    std::lock(mMutex, other.mMutex);
+    std::lock_guard<std::recursive_mutex> lock(mMutex, std::adopt_lock);
+    std::lock_guard<std::recursive_mutex> otherLock(other.mMutex,
+                                                    std::adopt_lock);
+    for (std::unordered_map<Symbol, Symbol>::const_iterator     
             it=other.mInverseMap.begin(); it!=other.mInverseMap.end(); it++) {
         mInverseMap[it->first] = it->second;
     }
+    touch();
     return *this;
 }
 
 Environment::~Environment() {
     // delete all UninterpFunc declarations
-    for (std::map<std::string, UninterpFunc*>::iterator     
+    for (std::unordered_map<Symbol, UninterpFunc*>::iterator     
             it=mUninterpFuncMap.begin(); it!=mUninterpFuncMap.end(); it++) {
         delete it->second;
     }
@@ -358,64 +400,106 @@ Environment::~Environment() {
 
 // Reset the Environment to empty
 void Environment::reset(){
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
     // delete all UninterpFunc declarations
-    for (std::map<std::string, UninterpFunc*>::iterator     
+    for (std::unordered_map<Symbol, UninterpFunc*>::iterator     
             it=mUninterpFuncMap.begin(); it!=mUninterpFuncMap.end(); it++) {
         delete it->second;
     }
     mUninterpFuncMap.clear();
     // delete all UninterpFunc declarations
     mInverseMap.clear();
+    // delete all universally quantified rules
+    for (unsigned int i = 0; i < uniQuantRules.size(); i++) {
+        delete uniQuantRules[i];
+    }
+    uniQuantRules.clear();
+    touch();
 }
 
 // Define the inverse for the given function.
-void Environment::setInverse(std::string funcName, std::string inverseName) {
+void Environment::setInverse(const Symbol& funcName,
+                             const Symbol& inverseName) {
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
     mInverseMap[funcName] = inverseName;
     mInverseMap[inverseName] = funcName;
+    touch();
+}
+
+void Environment::touch() {
+    mVersion = ++lastEnvVersion;
+}
+
+unsigned long Environment::version() const {
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    return mVersion;
 }
 
 // Get the name of the inverse of the given function (or "" if none).
-std::string Environment::funcInverse(const std::string funcName) const {
-    if (mInverseMap.find(funcName) == mInverseMap.end()) return "";
-    return mInverseMap.find(funcName)->second;
+Symbol Environment::funcInverseSymbol(const Symbol& funcName) const {
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    std::unordered_map<Symbol, Symbol>::const_iterator it
+        = mInverseMap.find(funcName);
+    if (it == mInverseMap.end()) return Symbol();
+    return it->second;
 }
 
 // Return a clone of the domain of the function.
-Set* Environment::funcDomain(const std::string funcName) const {
-    if (mUninterpFuncMap.find(funcName) == mUninterpFuncMap.end()) return NULL;
-    return new Set(*(mUninterpFuncMap.find(funcName)->second->getDomain()));
+Set* Environment::funcDomain(const Symbol& funcName) const {
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    std::unordered_map<Symbol, UninterpFunc*>::const_iterator it
+        = mUninterpFuncMap.find(funcName);
+    if (it == mUninterpFuncMap.end()) return NULL;
+    return new Set(*(it->second->getDomain()));
 }
 
 // Return a clone of the domain of the function.
-Set* Environment::funcRange(const std::string funcName) const {
-    if (mUninterpFuncMap.find(funcName) == mUninterpFuncMap.end()) return NULL;
-    return new Set(*(mUninterpFuncMap.find(funcName)->second->getRange()));
+Set* Environment::funcRange(const Symbol& funcName) const {
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    std::unordered_map<Symbol, UninterpFunc*>::const_iterator it
+        = mUninterpFuncMap.find(funcName);
+    if (it == mUninterpFuncMap.end()) return NULL;
+    return new Set(*(it->second->getRange()));
 }
 
 //! Returns whether a function is monotonistic or not and how.
-MonotonicType Environment::funcMonoType(const std::string funcName) const {
-    if (mUninterpFuncMap.find(funcName) == mUninterpFuncMap.end()) {
+MonotonicType Environment::funcMonoType(const Symbol& funcName) const {
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    std::unordered_map<Symbol, UninterpFunc*>::const_iterator it
+        = mUninterpFuncMap.find(funcName);
+    if (it == mUninterpFuncMap.end()) {
         return Monotonic_NONE;
     }
-    return mUninterpFuncMap.find(funcName)->second->getMonoType();
+    return it->second->getMonoType();
+}
+
+bool Environment::funcBijective(const Symbol& funcName) const {
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    std::unordered_map<Symbol, UninterpFunc*>::const_iterator it
+        = mUninterpFuncMap.find(funcName);
+    if (it == mUninterpFuncMap.end()) {
+        return false;
+    }
+    return it->second->isBijective();
 }
 
 
 std::string Environment::toString() const {
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
     std::stringstream ss;
     ss << "Environment:" << std::endl;
     
-    std::set<std::string> keyset;
+    std::set<Symbol> keyset;
     
     // We have to visit the entries in the same order every time for testing.
     // Therefore, will put keys into a set and then print while
     // iterating over the set.
-    for (std::map<std::string, std::string>::const_iterator     
+    for (std::unordered_map<Symbol, Symbol>::const_iterator     
             it=mInverseMap.begin(); it!=mInverseMap.end(); it++) {
         keyset.insert(it->first);
     }
     // iterating over the set
-    for (std::set<std::string>::const_iterator     
+    for (std::set<Symbol>::const_iterator     
             it=keyset.begin(); it!=keyset.end(); it++) {
         ss  << "    " << *it << " ==> " 
             << (mInverseMap.find(*it))->second << std::endl;
@@ -427,18 +511,22 @@ std::string Environment::toString() const {
 
 //! Add an universially quantified Rule to the environment
 void Environment::addUniQuantRule(UniQuantRule *uqRule){
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
     uniQuantRules.push_back (uqRule);
+    touch();
 }
 
 //! Get the No. of universially quantified Rules
 // available in the environment
 int Environment::getNoUniQuantRules(){
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
     return uniQuantRules.size();
 }
 
 //! Get the universially quantified Rule No. idx from 
 // the environment
 UniQuantRule* Environment::getUniQuantRule(int idx){
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
     return uniQuantRules[idx];
 }
 
@@ -22,12 +22,15 @@
 #define ENVIRONMENT_H_
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <set>
 #include <vector>
 #include <sstream>
 #include <iostream>
+#include <mutex>
 
 #include "UninterpFunc.h"
+#include "symbol.h"
 #include <util/util.h>
 
 namespace iegenlib{
@@ -44,6 +47,12 @@ extern Environment* parse_env(std::string set_string);
 }
 */
 
+/*! The environment the *CurrEnv functions below work on for the calling
+**  thread: the one given to the innermost EnvironmentScope alive on the
+**  thread, or the global currentEnv when there is none.
+*/
+Environment& getCurrEnv();
+
 //! Empties out the current environment.
 void setCurrEnv();
     
@@ -60,24 +69,30 @@ void appendCurrEnv(std::string funcName, Set* domain, Set* range,
                    bool bijective, MonotonicType monoType);
 
 //! search this environment for a function inverse
-std::string queryInverseCurrEnv(const std::string funcName);
+const std::string& queryInverseCurrEnv(const Symbol& funcName);
+
+//! queryInverseCurrEnv as an interned name (the empty Symbol if none)
+Symbol queryInverseSymbolCurrEnv(const Symbol& funcName);
 
 //! search this environment for a function domain
 //! returned Set escapes
-Set* queryDomainCurrEnv(const std::string funcName);
+Set* queryDomainCurrEnv(const Symbol& funcName);
 
 //! search this environment for a function range
 //! returned Set escapes
-Set* queryRangeCurrEnv(const std::string funcName);
+Set* queryRangeCurrEnv(const Symbol& funcName);
 
 //! Returns the monotonicity type of the given function.
-MonotonicType queryMonoTypeEnv(const std::string funcName);
+MonotonicType queryMonoTypeEnv(const Symbol& funcName);
+
+//! Returns true if the given function is declared bijective.
+bool queryBijectiveCurrEnv(const Symbol& funcName);
 
 //! search this environment for a function's domain arity
-unsigned int queryRangeArityCurrEnv(const std::string funcName);
+unsigned int queryRangeArityCurrEnv(const Symbol& funcName);
 
 //! search this environment for a function's range arity
-unsigned int queryDomainArityCurrEnv(const std::string funcName);
+unsigned int queryDomainArityCurrEnv(const Symbol& funcName);
 
 //! add an universially quantified Rule to environment
 //! The environment is going to own uqRule object (user should not delete it)
@@ -93,11 +108,14 @@ UniQuantRule* queryUniQuantRuleEnv(int idx);
 //! Get an UniQuantRule representing Domain and Range of an UF Symbol
 UniQuantRule* getUQRForFuncDomainRange(std::string func);
 
+//! Returns the version of the current environment, see Environment::version
+unsigned long queryVersionCurrEnv();
+
 class Environment {
 public:
 
     //! Constructs an empty environment.
-    Environment() {}
+    Environment() { touch(); }
 
     //! Construct an environment and use given UninterpFunc as first member.
     //! The Environment owns the UninterpFunc pointer.
@@ -120,23 +138,31 @@ public:
     void reset();
     
     //! Define the inverse for the given function.
-    void setInverse(std::string funcName, std::string inverseName);
+    void setInverse(const Symbol& funcName, const Symbol& inverseName);
 
     //! Get the name of the inverse of the given function (or "" if none).
-    std::string funcInverse(const std::string funcName) const;
+    const std::string& funcInverse(const Symbol& funcName) const
+        { return funcInverseSymbol(funcName).str(); }
+
+    //! funcInverse as an interned name.
+    Symbol funcInverseSymbol(const Symbol& funcName) const;
 	
     //! Check whether the given function has a known inverse.
-    bool hasInverse(const std::string funcName) const 
-		{ return not funcInverse(funcName).empty(); }
+    bool hasInverse(const Symbol& funcName) const 
+		{ return not funcInverseSymbol(funcName).empty(); }
 	
     //! Returns a clone of the function's domain Set or NULL.
-    Set* funcDomain(const std::string funcName) const;
+    Set* funcDomain(const Symbol& funcName) const;
 
     //! Returns a clone of the function's range Set or NULL.
-    Set* funcRange(const std::string funcName) const;
+    Set* funcRange(const Symbol& funcName) const;
 	
     //! Returns whether a function is monotonistic or not and how.
-    MonotonicType funcMonoType(const std::string funcName) const;
+    MonotonicType funcMonoType(const Symbol& funcName) const;
+
+    //! Returns whether a function is declared bijective, false if it is
+    //! not declared at all.
+    bool funcBijective(const Symbol& funcName) const;
 
     std::string toString() const;
 
@@ -152,14 +178,60 @@ public:
     // the environment
     UniQuantRule* getUniQuantRule(int idx);
 
+    //! Version of the environment's contents. Every change to any
+    //! environment gives it a version no environment had before, so
+    //! results derived from an environment can be keyed by it.
+    unsigned long version() const;
+
 private:
-    std::map<std::string, UninterpFunc*> mUninterpFuncMap;
-    std::map<std::string, std::string> mInverseMap;
+    //! Gives the environment a new version after a change.
+    //! Callers hold mMutex.
+    void touch();
+
+    //! Guards all members, so threads can share an environment. Recursive
+    //! because copying a domain or range Set looks up inverses in the
+    //! current environment, which may be this one.
+    mutable std::recursive_mutex mMutex;
+
+    //! Keyed by interned names, so lookups hash and compare pointers.
+    std::unordered_map<Symbol, UninterpFunc*> mUninterpFuncMap;
+    std::unordered_map<Symbol, Symbol> mInverseMap;
     std::vector<UniQuantRule*>  uniQuantRules;
+    unsigned long mVersion;
 };
 
 extern Environment currentEnv;
 
+/*!
+ * \class EnvironmentScope
+ *
+ * Makes env the current environment of the calling thread for the
+ * lifetime of the scope. Everything that queries the current environment
+ * on the thread (parsing, normalize, superAffine, detectUnsat, Compose,
+ * ...) sees env instead of the global currentEnv, so independent problems
+ * can be analyzed on separate threads, each with its own environment:
+ *
+ *   Environment env;
+ *   {
+ *     EnvironmentScope scope(env);
+ *     appendCurrEnv("rowptr", domain, range, false, Monotonic_Increasing);
+ *     Relation* result = rel->detectUnsatOrFindEqualities();
+ *   }
+ *
+ * Scopes nest; the environment must outlive the scope.
+ */
+class EnvironmentScope {
+public:
+    explicit EnvironmentScope(Environment& env);
+    ~EnvironmentScope();
+
+private:
+    EnvironmentScope(const EnvironmentScope&);
+    EnvironmentScope& operator=(const EnvironmentScope&);
+
+    Environment* mPrevious;
+};
+
 // Mahdi: FIXME: Want to have FuncConsistency to be the first
 // Monotonicity should always be the first and TheOthers the last type
 // This convention is used inside drivers 
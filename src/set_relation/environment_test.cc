@@ -23,8 +23,11 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 using iegenlib::Environment;
+using iegenlib::EnvironmentScope;
 using iegenlib::UninterpFunc;
 using iegenlib::Set;
 
@@ -98,6 +101,76 @@ TEST_F(EnvironmentTest, EnvUninterpFunc) {
     delete env;
 }
 
+// The current environment of a thread is the one of its innermost scope.
+TEST_F(EnvironmentTest, EnvScope) {
+    iegenlib::setCurrEnv();
+    iegenlib::appendCurrEnv("f", new Set("{[i]:0<=i &&i<G}"),
+        new Set("{[i]:0<=i &&i<G}"), true, iegenlib::Monotonic_NONE);
+
+    Environment outer, inner;
+    {
+        EnvironmentScope scope(outer);
+        EXPECT_EQ(&outer, &iegenlib::getCurrEnv());
+        EXPECT_EQ("", iegenlib::queryInverseCurrEnv("f"));
+        iegenlib::appendCurrEnv("g", new Set("{[i]:0<=i &&i<G}"),
+            new Set("{[i]:0<=i &&i<G}"), true, iegenlib::Monotonic_NONE);
+        {
+            EnvironmentScope nested(inner);
+            EXPECT_EQ("", iegenlib::queryInverseCurrEnv("g"));
+        }
+        EXPECT_EQ("g_inv", iegenlib::queryInverseCurrEnv("g"));
+    }
+    EXPECT_EQ(&iegenlib::currentEnv, &iegenlib::getCurrEnv());
+    EXPECT_EQ("f_inv", iegenlib::queryInverseCurrEnv("f"));
+    EXPECT_EQ("", iegenlib::queryInverseCurrEnv("g"));
+    iegenlib::setCurrEnv();
+}
+
+// Threads analyzing with their own environments do not see each other's
+// functions and rules.
+TEST_F(EnvironmentTest, EnvThreads) {
+    const int threads = 4;
+    std::vector<int> unsat(threads, -1);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.push_back(std::thread([t, &unsat]() {
+            Environment env;
+            EnvironmentScope scope(env);
+            iegenlib::appendCurrEnv("rowptr",
+                new Set("{[i]:0<=i &&i<m}"), new Set("{[j]:0<=j &&j<nnz}"),
+                false, iegenlib::Monotonic_Increasing);
+            iegenlib::appendCurrEnv("diagptr",
+                new Set("{[i]:0<=i &&i<m}"), new Set("{[j]:0<=j &&j<nnz}"),
+                false, iegenlib::Monotonic_Increasing);
+            // Only half of the threads know that row i ends before its
+            // diagonal element does in the next row.
+            if (t % 2 == 0) {
+                iegenlib::addUniQuantRule( new iegenlib::UniQuantRule(
+                    "CoMonotonicity", "[e1,e2]", "e1 = e2",
+                    "rowptr(e1) <= diagptr(e2)") );
+                iegenlib::addUniQuantRule( new iegenlib::UniQuantRule(
+                    "CoMonotonicity", "[e1,e2]", "e1 < e2",
+                    "diagptr(e1) < rowptr(e2)") );
+            }
+            iegenlib::Relation* r = new iegenlib::Relation(
+                "[m] -> {[i,k] -> [ip,kp]: i < ip"
+                " && 0 <= i && i < m && 0 <= ip && ip < m"
+                " && rowptr(i) <= k && k < diagptr(i)"
+                " && rowptr(ip) <= kp && kp < diagptr(ip) && k = kp }");
+            iegenlib::Relation* result = r->detectUnsatOrFindEqualities();
+            unsat[t] = (result == NULL);
+            delete r;
+            delete result;
+        }));
+    }
+    for (int t = 0; t < threads; t++) { pool[t].join(); }
+
+    for (int t = 0; t < threads; t++) {
+        EXPECT_EQ(t % 2 == 0, unsat[t] == 1);
+    }
+    EXPECT_EQ(0, iegenlib::queryNoUniQuantRules());
+}
+
 /*
 // Testing environment parsing.
 TEST_F(EnvironmentTest, EnvParse) {
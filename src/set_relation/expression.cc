@@ -15,6 +15,9 @@
 #include "TupleDecl.h"
 #include "set_relation.h"
 #include "Visitor.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 
 
 namespace iegenlib{
@@ -35,14 +38,23 @@ Term& Term::operator=(const Term& other) {
 **      2. within each type, in alphabetical or numeric order.
 ** @param other, object to be compared
 */
-bool Term::operator<(const Term& other) const {
+int Term::compare(const Term& other) const {
     // Compare first by type -- note that the order of the
     // enumeration should match our desired sort order.
-    if (mTermType < other.mTermType) { return true; }
-    if (mTermType > other.mTermType) { return false; }
+    int termComparison = compareTermTypes(other);
+    if (termComparison != 0) { return termComparison; }
 
     // If the types match, then compare by coefficient.
-    return (mCoeff < other.mCoeff);
+    if (mCoeff < other.mCoeff) { return -1; }
+    if (mCoeff > other.mCoeff) { return 1; }
+    return 0;
+}
+
+//! Hash of the term type and coefficient, subclasses mix in their factor.
+std::size_t Term::hash() const {
+    std::size_t seed = std::hash<int>()(mTermType);
+    hashCombine(seed, std::hash<int>()(mCoeff));
+    return seed;
 }
 
 
@@ -120,6 +132,10 @@ bool Term::factorMatches(const Term& other) const {
     return (other.mTermType == mTermType);
 }
 
+std::size_t Term::factorHash() const {
+    return std::hash<int>()(mTermType);
+}
+
 bool Term::combine(Term* other) {
     if (not factorMatches(*other)) { delete other; return false; }
     mCoeff += other->mCoeff;
@@ -152,8 +168,8 @@ Exp* Term::collapseNestedInvertibleFunctions() const {
 #pragma mark -
 /****************************************************************************/
 /******************************** UFCallTerm ********************************/
-UFCallTerm::UFCallTerm(int coeff, std::string funcName, unsigned int num_args,
-                       int tuple_index)
+UFCallTerm::UFCallTerm(int coeff, const Symbol& funcName,
+                       unsigned int num_args, int tuple_index)
 : Term(coeff), mFuncName(funcName), mNumArgs(num_args),
   mTupleIndex(tuple_index) 
 {
@@ -165,7 +181,7 @@ UFCallTerm::UFCallTerm(int coeff, std::string funcName, unsigned int num_args,
     
 }
 
-UFCallTerm::UFCallTerm(std::string funcName, unsigned int num_args,
+UFCallTerm::UFCallTerm(const Symbol& funcName, unsigned int num_args,
                        int tuple_index)
 : Term(1), mFuncName(funcName), mNumArgs(num_args),
   mTupleIndex(tuple_index)
@@ -213,41 +229,245 @@ UFCallTerm::~UFCallTerm() {
     reset();
 }
 
+/*! \class UFCallTerm::ArgsCursor
+**  Walks the argument list of a UF call in the pieces argsToStream prints
+**  it in, without building the string, so that two argument lists can be
+**  compared in the order of their printed forms. Nested calls and tuples
+**  are followed with a stack of the expressions and lists being printed.
+*/
+class UFCallTerm::ArgsCursor {
+public:
+    explicit ArgsCursor(const UFCallTerm& call)
+        : mDepth(0), mFirst(0), mCount(0), mOverflow(false) {
+        pushList(&call, NULL, false);
+    }
+
+    /*! Sets piece to the next piece of the printed form and returns true,
+    **  or returns false at its end. Pieces may be empty. The piece is
+    **  valid until the next call.
+    */
+    bool next(const char*& piece, std::size_t& length) {
+        while (mFirst == mCount) {
+            mFirst = mCount = 0;
+            if (mDepth == 0 || mOverflow) { length = 0; return false; }
+            step();
+        }
+        piece = mPieces[mFirst].text;
+        length = mPieces[mFirst].length;
+        mFirst++;
+        return true;
+    }
+
+    //! True if the calls are nested too deeply to be followed, next then
+    //! returns false before the end.
+    bool overflow() const { return mOverflow; }
+
+private:
+    // Either an expression, printed term by term, or the arguments of a
+    // call or the elements of a tuple, printed separated by commas.
+    struct Frame {
+        const Exp* exp;
+        const UFCallTerm* call;
+        const TupleExpTerm* tuple;
+        bool closes;
+        unsigned int index;
+    };
+    struct Piece {
+        const char* text;
+        std::size_t length;
+        char digits[16];
+    };
+    static const unsigned int kMaxDepth = 32;
+    static const unsigned int kMaxPieces = 4;
+
+    void push(const Exp* exp, const UFCallTerm* call,
+              const TupleExpTerm* tuple, bool closes) {
+        if (mDepth == kMaxDepth) { mOverflow = true; return; }
+        Frame f = { exp, call, tuple, closes, 0 };
+        mFrames[mDepth++] = f;
+    }
+    void pushList(const UFCallTerm* call, const TupleExpTerm* tuple,
+                  bool closes) {
+        push(NULL, call, tuple, closes);
+    }
+
+    void queue(const char* text, std::size_t length) {
+        mPieces[mCount].text = text;
+        mPieces[mCount].length = length;
+        mCount++;
+    }
+    void queue(const char* text) { queue(text, std::strlen(text)); }
+    void queueInt(const char* format, int value) {
+        Piece& p = mPieces[mCount];
+        int length = std::snprintf(p.digits, sizeof(p.digits), format, value);
+        queue(p.digits, length);
+    }
+    // Same as Term::coeffToStream.
+    void queueCoeff(int coeff, bool absValue) {
+        if (absValue) {
+            if (1 != abs(coeff)) { queueInt("%d ", abs(coeff)); }
+        } else if (-1 == coeff) {
+            queue("-");
+        } else if (1 != coeff) {
+            queueInt("%d ", coeff);
+        }
+    }
+
+    // Same as the toString of each kind of term.
+    void queueTerm(const Term* t, bool absValue) {
+        const TupleVarTerm* tupleVar;
+        const VarTerm* var;
+        const TupleExpTerm* tuple;
+        if (t->isUFCall()) {
+            const UFCallTerm* call = static_cast<const UFCallTerm*>(t);
+            queueCoeff(t->coefficient(), absValue);
+            const std::string& name = call->mFuncName.str();
+            queue(name.data(), name.size());
+            queue("(");
+            pushList(call, NULL, true);
+        } else if ((tupleVar = dynamic_cast<const TupleVarTerm*>(t))) {
+            queueCoeff(t->coefficient(), absValue);
+            queue("__tv");
+            queueInt("%d", tupleVar->tvloc());
+        } else if ((var = dynamic_cast<const VarTerm*>(t))) {
+            queueCoeff(t->coefficient(), absValue);
+            queue(var->symbol().data(), var->symbol().size());
+        } else if ((tuple = dynamic_cast<const TupleExpTerm*>(t))) {
+            queue("( ");
+            pushList(NULL, tuple, true);
+        } else {
+            queueInt("%d", absValue ? abs(t->coefficient()) : t->coefficient());
+        }
+    }
+
+    // Queues the pieces of the next term, argument or closing bracket.
+    void step() {
+        Frame& f = mFrames[mDepth - 1];
+        if (f.exp) {
+            // Same as Exp::toString.
+            const std::vector<Term*>& terms = f.exp->terms();
+            if (terms.empty()) { mDepth--; queue("0"); return; }
+            if (f.index == terms.size()) { mDepth--; return; }
+            bool absValue = (f.index > 0);
+            const Term* t = terms[f.index++];
+            if (absValue) { queue(t->coefficient() < 0 ? " - " : " + "); }
+            queueTerm(t, absValue);
+            return;
+        }
+
+        unsigned int size = f.call ? f.call->mArgs.size() : f.tuple->size();
+        if (f.index == size) {
+            mDepth--;
+            if (!f.closes) { return; }
+            if (f.tuple) { queue(" )"); return; }
+            queue(")");
+            if (f.call->isIndexed()) {
+                queue("[");
+                queueInt("%d", f.call->tupleIndex());
+                queue("]");
+            }
+            return;
+        }
+        if (f.index > 0) { queue(", "); }
+        const Exp* e = f.call ? f.call->mArgs[f.index]
+                              : f.tuple->getExpElem(f.index);
+        f.index++;
+        if (e) { push(e, NULL, NULL, false); }
+    }
+
+    Frame mFrames[kMaxDepth];
+    unsigned int mDepth;
+    Piece mPieces[kMaxPieces];
+    unsigned int mFirst;
+    unsigned int mCount;
+    bool mOverflow;
+};
+
 /*! Compare two terms in a canonical order, defined as follows:
 **      1. by term type: TupleVar, SymConst, UFCall, ConstVal
 **      2. within each type, in alphabetical or numeric order.
+**  Calls to the same function are ordered by their argument lists as
+**  strings, see compareArgs.
 */
-bool UFCallTerm::operator<(const Term& other) const {
+int UFCallTerm::compare(const Term& other) const {
     // Compare first by type -- note that the order of the
     // enumeration should match our desired sort order.
     int termComparison = compareTermTypes(other);
-    if (-1 == termComparison) { return true; }
-    if (1 == termComparison) { return false; }
+    if (termComparison != 0) { return termComparison; }
+    const UFCallTerm& otherUFC = (const UFCallTerm&)other;
 
     // Next, compare by function name
-    if (mFuncName < ((UFCallTerm&)other).mFuncName) { return true; }
-    if (mFuncName > ((UFCallTerm&)other).mFuncName) { return false; }
+    int nameComparison = mFuncName.compare(otherUFC.mFuncName);
+    if (nameComparison != 0) { return nameComparison < 0 ? -1 : 1; }
 
     // Then compare by tuple location (always -1 unless function returns tuple)
-    if (mTupleIndex < ((UFCallTerm&)other).mTupleIndex) 
-    { return true; }
-    if (mTupleIndex > ((UFCallTerm&)other).mTupleIndex) 
-    { return false; }
+    if (mTupleIndex < otherUFC.mTupleIndex) { return -1; }
+    if (mTupleIndex > otherUFC.mTupleIndex) { return 1; }
+
+    // Now compare the argument lists.
+    int argsComparison = compareArgs(otherUFC);
+    if (argsComparison != 0) { return argsComparison; }
+    
+    // If everything else matches, let the superclass compare by coefficient.
+    return Term::compare(other);
+}
+
+int UFCallTerm::compareArgs(const UFCallTerm& other) const {
+    ArgsCursor mine(*this), theirs(other);
+    const char* a = NULL;
+    const char* b = NULL;
+    std::size_t aLength = 0, bLength = 0;
+    bool aMore = true, bMore = true;
+    while (true) {
+        while (aMore && aLength == 0) { aMore = mine.next(a, aLength); }
+        while (bMore && bLength == 0) { bMore = theirs.next(b, bLength); }
+        if (mine.overflow() || theirs.overflow()) { break; }
+        if (!aMore || !bMore) {
+            if (aMore != bMore) { return aMore ? 1 : -1; }
+            return compareArgExps(other);
+        }
+        std::size_t length = std::min(aLength, bLength);
+        int comparison = std::char_traits<char>::compare(a, b, length);
+        if (comparison != 0) { return comparison < 0 ? -1 : 1; }
+        a += length;  aLength -= length;
+        b += length;  bLength -= length;
+    }
 
-    // Now compare the argument list (as one big string).
+    // Too deep to walk, print them.
     std::stringstream ss1;
     argsToStream(ss1);
-    std::string args = ss1.str();
-
     std::stringstream ss2;
-    ((UFCallTerm&)other).argsToStream(ss2);
-    std::string otherArgs = ss2.str();
-    
-    if (args < otherArgs) { return true; }
-    if (args > otherArgs) { return false; }
-    
-    // If everything else matches, let the superclass compare by coefficient.
-    return Term::operator<(other);
+    other.argsToStream(ss2);
+    int comparison = ss1.str().compare(ss2.str());
+    if (comparison != 0) { return comparison < 0 ? -1 : 1; }
+    return compareArgExps(other);
+}
+
+int UFCallTerm::compareArgExps(const UFCallTerm& other) const {
+    if (mArgs.size() < other.mArgs.size()) { return -1; }
+    if (mArgs.size() > other.mArgs.size()) { return 1; }
+    for (unsigned int i = 0; i < mArgs.size(); i++) {
+        const Exp* arg = mArgs[i];
+        const Exp* otherArg = other.mArgs[i];
+        if (!arg || !otherArg) {
+            if (arg == otherArg) { continue; }
+            return arg ? 1 : -1;
+        }
+        int argComparison = arg->compare(*otherArg);
+        if (argComparison != 0) { return argComparison; }
+    }
+    return 0;
+}
+
+std::size_t UFCallTerm::hash() const {
+    std::size_t seed = Term::hash();
+    hashCombine(seed, mFuncName.hash());
+    hashCombine(seed, std::hash<int>()(mTupleIndex));
+    for (std::vector<Exp*>::const_iterator i=mArgs.begin(); 
+            i != mArgs.end(); ++i) {
+        hashCombine(seed, *i ? (*i)->hash() : 0);
+    }
+    return seed;
 }
 
 Term* UFCallTerm::clone() const {
@@ -255,7 +475,7 @@ Term* UFCallTerm::clone() const {
 }
 
 //! Emits our argument list, as strings, to the given stream.
-//! Helper method for toString and operator<.
+//! Helper method for toString.
 void UFCallTerm::argsToStream(std::stringstream& ss, bool generic) const {
     bool firstArg = true;
     for (std::vector<Exp*>::const_iterator i=mArgs.begin(); 
@@ -387,7 +607,7 @@ void UFCallTerm::setTupleIndex(unsigned int idx) {
 // a tuple but is being indexed.
 unsigned int UFCallTerm::size() const {
     // look up the range arity of the function
-    return iegenlib::queryRangeArityCurrEnv(name());
+    return iegenlib::queryRangeArityCurrEnv(mFuncName);
 }
 
 
@@ -406,11 +626,18 @@ bool UFCallTerm::factorMatches(const Term& other) const {
     if (tupleIndex() != ufo.tupleIndex()) { return false; }
 
     // check that the argument lists match
-    std::stringstream ss1;
-    argsToStream(ss1);
-    std::stringstream ss2;
-    ufo.argsToStream(ss2);
-    return (ss1.str() == ss2.str());    
+    return compareArgExps(ufo) == 0;
+}
+
+std::size_t UFCallTerm::factorHash() const {
+    std::size_t seed = Term::factorHash();
+    hashCombine(seed, mFuncName.hash());
+    hashCombine(seed, std::hash<int>()(tupleIndex()));
+    for (std::vector<Exp*>::const_iterator i=mArgs.begin(); 
+            i != mArgs.end(); ++i) {
+        hashCombine(seed, *i ? (*i)->hash() : 0);
+    }
+    return seed;
 }
 
 
@@ -425,8 +652,7 @@ Exp* UFCallTerm::collapseNestedInvertibleFunctions() const {
     Exp* retval;
 
     // determine the name of any inverse function for this function call
-    std::string inverseFuncName;
-    inverseFuncName = iegenlib::queryInverseCurrEnv(mFuncName);
+    Symbol inverseFuncName = iegenlib::queryInverseSymbolCurrEnv(mFuncName);
 
     // Check to see if each argument for this function call
     // is a call to our inverse with the same expression passed in.
@@ -534,19 +760,24 @@ TupleVarTerm& TupleVarTerm::operator=(const TupleVarTerm& other) {
 **      1. by term type: TupleVar, SymConst, UFCall, ConstVal
 **      2. within each type, in alphabetical or numeric order.
 */
-bool TupleVarTerm::operator<(const Term& other) const {
+int TupleVarTerm::compare(const Term& other) const {
     // Compare first by type -- note that the order of the
     // enumeration should match our desired sort order.
     int termComparison = compareTermTypes(other);
-    if (-1 == termComparison) { return true; }
-    if (1 == termComparison) { return false; }
+    if (termComparison != 0) { return termComparison; }
 
     // Next, by tuple variable location.
-    if (mLocation < ((TupleVarTerm&)other).mLocation) { return true; }
-    if (mLocation > ((TupleVarTerm&)other).mLocation) { return false; }
+    if (mLocation < ((const TupleVarTerm&)other).mLocation) { return -1; }
+    if (mLocation > ((const TupleVarTerm&)other).mLocation) { return 1; }
 
     // If everything else matches, let the superclass compare by coefficient.
-    return Term::operator<(other);
+    return Term::compare(other);
+}
+
+std::size_t TupleVarTerm::hash() const {
+    std::size_t seed = Term::hash();
+    hashCombine(seed, std::hash<int>()(mLocation));
+    return seed;
 }
 
 Term* TupleVarTerm::clone() const {
@@ -587,6 +818,12 @@ bool TupleVarTerm::factorMatches(const Term& other) const {
             and mLocation == ((TupleVarTerm&)other).mLocation;
 }
 
+std::size_t TupleVarTerm::factorHash() const {
+    std::size_t seed = Term::factorHash();
+    hashCombine(seed, std::hash<int>()(mLocation));
+    return seed;
+}
+
 //! Remap our location according to the given map vector.
 //! See Exp::remapTupleVars for more detail.
 void TupleVarTerm::remapLocation(const std::vector<int>& oldToNewLocs) {
@@ -630,20 +867,24 @@ VarTerm& VarTerm::operator=(const VarTerm& other) {
 **      1. by term type: TupleVar, SymConst, UFCall, ConstVal
 **      2. within each type, in alphabetical or numeric order.
 */
-bool VarTerm::operator<(const Term& other) const {
+int VarTerm::compare(const Term& other) const {
     // Compare first by type -- note that the order of the
     // enumeration should match our desired sort order.
     int termComparison = compareTermTypes(other);
-    if (-1 == termComparison) { return true; }
-    if (1 == termComparison) { return false; }
+    if (termComparison != 0) { return termComparison; }
 
     // Next, by symbol name.
-//std::cout << "mSymbol = " << mSymbol << ", other.mSymbol = " << ((VarTerm&)other).mSymbol << std::endl;
-    if (mSymbol < ((VarTerm&)other).mSymbol) { return true; }
-    if (mSymbol > ((VarTerm&)other).mSymbol) { return false; }
+    int symComparison = mSymbol.compare(((const VarTerm&)other).mSymbol);
+    if (symComparison != 0) { return symComparison < 0 ? -1 : 1; }
 
     // If everything else matches, let the superclass compare by coefficient.
-    return Term::operator<(other);
+    return Term::compare(other);
+}
+
+std::size_t VarTerm::hash() const {
+    std::size_t seed = Term::hash();
+    hashCombine(seed, mSymbol.hash());
+    return seed;
 }
 
 Term* VarTerm::clone() const {
@@ -680,6 +921,12 @@ bool VarTerm::factorMatches(const Term& other) const {
             and mSymbol == ((VarTerm&)other).mSymbol;
 }
 
+std::size_t VarTerm::factorHash() const {
+    std::size_t seed = Term::factorHash();
+    hashCombine(seed, mSymbol.hash());
+    return seed;
+}
+
 #pragma mark -
 /****************************************************************************/
 /****************************** TupleExpTerm ********************************/
@@ -732,34 +979,43 @@ TupleExpTerm& TupleExpTerm::operator=( const TupleExpTerm& other) {
     return *this;
 }
 
-/*! Less than operator.
+/*! Three-way comparison, used by operator< and operator==.
 **      Compare two TupleExpTerm in the following order:
 **          1. by size: the number of elements
 **          2. by expressions starting with index 0
 ** @param other, object to be compared
 */
-bool TupleExpTerm::operator<( const Term& other) const {
+int TupleExpTerm::compare( const Term& other) const {
     // Compare first by type -- note that the order of the
     // enumeration should match our desired sort order.
     int termComparison = compareTermTypes(other);
-    if (-1 == termComparison) { return true; }
-    if (1 == termComparison) { return false; }
+    if (termComparison != 0) { return termComparison; }
+    const TupleExpTerm& otherTuple = (const TupleExpTerm&)other;
 
     // first compare sizes
-    if (size() < ((TupleExpTerm&)other).size()) { return true; }
-    if (((TupleExpTerm&)other).size() < size()) { return false; }
-    // then compare our elements
-    std::vector<Exp*>::const_iterator iter=mExps.begin();
-    std::vector<Exp*>::const_iterator 
-        other_iter=((TupleExpTerm&)other).mExps.begin();
-    for (; iter!=mExps.end() && other_iter!=((TupleExpTerm&)other).mExps.end(); 
-           ++iter, ++other_iter) {
-        if ( *(iter) < *(other_iter) ) { return true; }
-        else if ( *(other_iter) < *(iter) ) { return false; }
+    if (size() < otherTuple.size()) { return -1; }
+    if (otherTuple.size() < size()) { return 1; }
+    // then compare our elements (not the pointers to them)
+    for (unsigned int i = 0; i < mExps.size(); i++) {
+        if (!mExps[i] || !otherTuple.mExps[i]) {
+            if (mExps[i] == otherTuple.mExps[i]) { continue; }
+            return mExps[i] ? 1 : -1;
+        }
+        int expComparison = mExps[i]->compare(*otherTuple.mExps[i]);
+        if (expComparison != 0) { return expComparison; }
     }
 
     //all our elements are equal, so we're not less than other
-    return false;
+    return 0;
+}
+
+std::size_t TupleExpTerm::hash() const {
+    std::size_t seed = std::hash<int>()(getTermType());
+    for (std::vector<Exp*>::const_iterator i=mExps.begin(); 
+            i != mExps.end(); ++i) {
+        hashCombine(seed, *i ? (*i)->hash() : 0);
+    }
+    return seed;
 }
 
 /*! Combine another tuple expression term 
@@ -859,7 +1115,7 @@ void TupleExpTerm::setExpElem(unsigned int exp_index, Exp* exp) {
 }
 
 //! Returns pointer to individual expression.  Indexing starts at 0.
-Exp* TupleExpTerm::getExpElem(unsigned int exp_index) {
+Exp* TupleExpTerm::getExpElem(unsigned int exp_index) const {
     if (exp_index>=mSize) {
         throw assert_exception("Attempt to get expression out of tuple bounds");
     } else {
@@ -894,6 +1150,13 @@ bool TupleExpTerm::factorMatches(const Term& other) const {
     else { return true; }
 }
 
+//! Only the size is part of the factor, see factorMatches.
+std::size_t TupleExpTerm::factorHash() const {
+    std::size_t seed = Term::factorHash();
+    hashCombine(seed, std::hash<unsigned int>()(size()));
+    return seed;
+}
+
 
 #pragma mark -
 /****************************************************************************/
@@ -904,7 +1167,7 @@ Exp::Exp(const Exp& other) {
 }
 
 void Exp::reset() {
-    for (std::list<Term*>::iterator i=mTerms.begin(); i != mTerms.end(); ++i) {
+    for (std::vector<Term*>::iterator i=mTerms.begin(); i != mTerms.end(); ++i) {
         delete (*i);
     }
     mTerms.clear();
@@ -913,7 +1176,7 @@ void Exp::reset() {
 //! Copy assignment
 Exp& Exp::operator=(const Exp& other) {
     reset();
-    for (std::list<Term*>::const_iterator i=other.mTerms.begin(); 
+    for (std::vector<Term*>::const_iterator i=other.mTerms.begin(); 
                 i != other.mTerms.end(); ++i) {
         mTerms.push_back((*i)->clone());
     }
@@ -922,6 +1185,18 @@ Exp& Exp::operator=(const Exp& other) {
     return *this;
 }
 
+Exp::Exp(Exp&& other) : mExpType(other.mExpType) {
+    mTerms.swap(other.mTerms);
+}
+
+Exp& Exp::operator=(Exp&& other) {
+    if (this == &other) { return *this; }
+    reset();
+    mTerms.swap(other.mTerms);
+    mExpType = other.mExpType;
+    return *this;
+}
+
 //! Destructor
 Exp::~Exp() {
     reset();
@@ -939,7 +1214,7 @@ std::string Exp::toString(bool generic) const {
     // FIXME does the line just below go in other
     // toString() or prettyPrintString methods?
     if(mTerms.size() == 0) return "0";
-    for (std::list<Term*>::const_iterator i=mTerms.begin(); 
+    for (std::vector<Term*>::const_iterator i=mTerms.begin(); 
             i != mTerms.end(); ++i) {
         bool absValue = false;
         if (not firstTerm) {
@@ -962,7 +1237,7 @@ Exp::prettyPrintString(const TupleDecl & aTupleDecl) const
 {
     std::string result;
     bool firstTerm = true;
-    for (std::list<Term*>::const_iterator i=mTerms.begin(); 
+    for (std::vector<Term*>::const_iterator i=mTerms.begin(); 
             i != mTerms.end(); ++i) {
         bool absValue = false;
         if (not firstTerm) {
@@ -981,7 +1256,7 @@ Exp::prettyPrintString(const TupleDecl & aTupleDecl) const
     std::string result_left, result_right, result;
     result_left = result_right = std::string("0");
     bool firstTerm_left = true,firstTerm_right = true;
-    for (std::list<Term*>::const_iterator i=mTerms.begin(); 
+    for (std::vector<Term*>::const_iterator i=mTerms.begin(); 
             i != mTerms.end(); ++i) {
         if ((*i)->coefficient() < 0) {
             if (firstTerm_left) result_left = (*i)->prettyPrintString(aTupleDecl, true);
@@ -1002,6 +1277,15 @@ Exp::prettyPrintString(const TupleDecl & aTupleDecl) const
 */
 }
 
+namespace {
+
+//! Strict weak order of terms used to keep Exp terms sorted.
+bool termLess(const Term* a, const Term* b) {
+    return a->compare(*b) < 0;
+}
+
+}
+
 //! Add a term to this expression
 void Exp::addTerm(Term *term) {
 
@@ -1009,49 +1293,62 @@ void Exp::addTerm(Term *term) {
     if(term->coefficient() == 0){ delete term; return; }
 
     // Approach:
-    // Iterate over our existing items (which are already sorted).
-    // If we find one we can combine with the given term, combine them.
-    // If we find one that comes after the given term, insert it.
-    // Otherwise, append to the end.
-    for (std::list<Term*>::iterator i=mTerms.begin(); i != mTerms.end(); ++i) {
+    // Binary search our existing items (which are already sorted) for
+    // where the term belongs.  The order compares factors before
+    // coefficients, so a term we can combine with is right before or
+    // at that spot.  Otherwise insert the term there.
+    std::vector<Term*>::iterator i
+        = std::lower_bound(mTerms.begin(), mTerms.end(), term, termLess);
+    if (i != mTerms.begin() && (*(i-1))->factorMatches(*term)) { --i; }
+    if (i != mTerms.end() && (*i)->factorMatches(*term)) {
         Term *t = *i;
-        if (t->combine(term->clone())) {
-            delete term;
-            // We've successfully combined this term with an existing one,
-            // but it's possible that the resulting term has a coefficient
-            // of zero, in which case it should be removed.
-            if (0 == t->coefficient()) {
-                mTerms.erase(i);
-                delete t;
-            }
-            return;
-        }
-        if (*term < *t) {
-            // We've found a term that belongs after the new one,
-            // so insert the new term here, and we're done.
-            mTerms.insert(i, term);
-            return;
+        t->combine(term);
+        // We've successfully combined this term with an existing one,
+        // but it's possible that the resulting term has a coefficient
+        // of zero, in which case it should be removed.
+        if (0 == t->coefficient()) {
+            mTerms.erase(i);
+            delete t;
         }
+        return;
     }
-    
-    // We could neither combine this term with an existing one, nor
-    // find a term that comes after it in the sort order.  So, just
-    // append it to the end of the list.
-    mTerms.push_back(term);
+    mTerms.insert(i, term);
 }
 
 //! Add another expression to this one
+//! Both term lists are sorted, so this is a linear merge that takes
+//! over the terms of exp rather than copying them.
 void Exp::addExp(Exp *exp) {
-    for (std::list<Term*>::const_iterator i=exp->mTerms.begin(); 
-                i != exp->mTerms.end(); ++i) {
-        addTerm((*i)->clone());
+    std::vector<Term*> merged;
+    merged.reserve(mTerms.size() + exp->mTerms.size());
+    std::vector<Term*>::iterator mine = mTerms.begin();
+    std::vector<Term*>::iterator theirs = exp->mTerms.begin();
+    while (theirs != exp->mTerms.end()) {
+        Term *t = *theirs;
+        if (t->coefficient() == 0) { delete t; ++theirs; continue; }
+        if (mine != mTerms.end() && (*mine)->factorMatches(*t)) {
+            (*mine)->combine(t);
+            ++theirs;
+            if (0 == (*mine)->coefficient()) { delete *mine; }
+            else { merged.push_back(*mine); }
+            ++mine;
+        } else if (mine == mTerms.end() || termLess(t, *mine)) {
+            merged.push_back(t);
+            ++theirs;
+        } else {
+            merged.push_back(*mine);
+            ++mine;
+        }
     }
+    merged.insert(merged.end(), mine, mTerms.end());
+    mTerms.swap(merged);
+    exp->mTerms.clear();
     delete exp;
 }
 
 //! Multiply all terms in this expression by a constant
 void Exp::multiplyBy(int constant) {
-    for (std::list<Term*>::iterator i=mTerms.begin(); i != mTerms.end(); ++i) {
+    for (std::vector<Term*>::iterator i=mTerms.begin(); i != mTerms.end(); ++i) {
         (*i)->multiplyBy(constant);
     }   
 }
@@ -1059,7 +1356,7 @@ void Exp::multiplyBy(int constant) {
 //! Return whether all coefficients in this expression are
 //! evenly divisible by the given integer.
 bool Exp::isDivisible(int divisor) const {
-    for (std::list<Term*>::const_iterator i=mTerms.begin(); i != mTerms.end(); ++i) {
+    for (std::vector<Term*>::const_iterator i=mTerms.begin(); i != mTerms.end(); ++i) {
         Term* t = *i;
         if (t->coefficient() % divisor != 0) { return false; }
     }
@@ -1067,7 +1364,7 @@ bool Exp::isDivisible(int divisor) const {
 }
 
 void Exp::divideBy(int divisor) {
-    for (std::list<Term*>::iterator i=mTerms.begin(); i != mTerms.end(); ++i) {
+    for (std::vector<Term*>::iterator i=mTerms.begin(); i != mTerms.end(); ++i) {
         Term* t = *i;
         t->divideBy(divisor);
     }
@@ -1087,7 +1384,7 @@ Term* Exp::findMatchingFactor(const Term & factor) const {
     }
     
     Term* matchingFactor = NULL;
-    for (std::list<Term*>::const_iterator i=mTerms.begin(); i != mTerms.end(); ++i) {
+    for (std::vector<Term*>::const_iterator i=mTerms.begin(); i != mTerms.end(); ++i) {
         const Term* t = *i;
         if (t->factorMatches(factor) and isDivisible(t->coefficient()) ) {
             // found a simple match for this factor
@@ -1173,8 +1470,8 @@ Exp* Exp::invertFuncToExposeFactor(Term * factor_ptr) const {
     UFCallTerm* foundUFC = NULL;
     
     // Search through terms in this expression.
-    std::string inverseFuncName = "";
-    for (std::list<Term*>::const_iterator i=mTerms.begin();
+    Symbol inverseFuncName;
+    for (std::vector<Term*>::const_iterator i=mTerms.begin();
                 i != mTerms.end(); ++i) {
         Term* t = (*i);
     
@@ -1192,7 +1489,8 @@ Exp* Exp::invertFuncToExposeFactor(Term * factor_ptr) const {
         
         // Is the function invertible?  If not keep looking.
         UFCallTerm* callptr = dynamic_cast<UFCallTerm*>(t);
-        inverseFuncName = iegenlib::queryInverseCurrEnv(callptr->name());
+        inverseFuncName =
+            iegenlib::queryInverseSymbolCurrEnv(callptr->nameSymbol());
         if (inverseFuncName.empty()) { continue; }
         
         // If all of the above questions are answered yes, then
@@ -1273,10 +1571,17 @@ Exp* Exp::invertFuncToExposeFactor(Term * factor_ptr) const {
 
 //! Substitute each expression for the factor (i.e. the non-coefficient
 //! part of a term), which is its key.
-void Exp::substitute(SubMap& searchTermToSubExp) {
-    Exp *addedTerms = new Exp();
-    std::list<Term*>::iterator i=mTerms.begin();
-    while (i != mTerms.end()) {
+//! Terms that do not match are left in place rather than copied, and the
+//! expression is only rebuilt if a term or one of its arguments changed.
+bool Exp::substitute(const SubMap& searchTermToSubExp) {
+    if (searchTermToSubExp.empty()) { return false; }
+
+    Exp *addedTerms = NULL;
+    bool changed = false;
+    // Terms that stay are compacted to the front of mTerms as we go.
+    std::vector<Term*>::iterator kept=mTerms.begin();
+    for (std::vector<Term*>::iterator i=mTerms.begin(); 
+            i != mTerms.end(); ++i) {
         Term *t = *i;
         
         // Lookup term in the substitution map
@@ -1287,49 +1592,51 @@ void Exp::substitute(SubMap& searchTermToSubExp) {
             // Note the coefficient for this term and then remove 
             // it from the list for the expression.
             int foundCoefficient = t->coefficient();
-            // Note that we don't increment i here; it already points
-            // to the item after the one just erased.
-            i = mTerms.erase(i);
             delete t;
             // Put substituted expression in and multiple by coeff of term.
             Exp *product = sub->clone();
             product->multiplyBy(foundCoefficient);
+            if (addedTerms == NULL) { addedTerms = new Exp(); }
             addedTerms->addExp(product);
-            
-        } else { 
-            // clone term and remove from original expression
-            Term* term_clone = t->clone();
-            i = mTerms.erase(i);  // removing term from current exp
-            delete t;
+            changed = true;
+            continue;
+        }
 
-            // If we have a UFCallTerm
-            // below here change term_clone to callTerm
-            if (term_clone->isUFCall()) {
-                UFCallTerm *callTerm = dynamic_cast<UFCallTerm*>(term_clone);
-                // This term doesn't match, but maybe it contains other
-                // expressions that we need to search recursively.
-                for (unsigned int count=0; count<callTerm->numArgs(); count++) {
-                    Exp* arg = callTerm->getParamExp(count);
-                    arg->substitute(searchTermToSubExp);
+        // This term doesn't match, but maybe it contains other
+        // expressions that we need to search recursively.
+        if (t->isUFCall()) {
+            UFCallTerm *callTerm = dynamic_cast<UFCallTerm*>(t);
+            for (unsigned int count=0; count<callTerm->numArgs(); count++) {
+                Exp* arg = callTerm->getParamExp(count);
+                if (arg && arg->substitute(searchTermToSubExp)) {
+                    changed = true;
                 }
             }
-            if (term_clone->isTupleExp()) {
-                TupleExpTerm *tupTerm = dynamic_cast<TupleExpTerm*>(term_clone);
-                // This term doesn't match, but maybe it contains other
-                // expressions that we need to search recursively.
-                for (unsigned int count=0; count<tupTerm->size(); count++) {
-                    Exp* arg = tupTerm->getExpElem(count);
-                    arg->substitute(searchTermToSubExp);
+        }
+        if (t->isTupleExp()) {
+            TupleExpTerm *tupTerm = dynamic_cast<TupleExpTerm*>(t);
+            for (unsigned int count=0; count<tupTerm->size(); count++) {
+                Exp* arg = tupTerm->getExpElem(count);
+                if (arg && arg->substitute(searchTermToSubExp)) {
+                    changed = true;
                 }
             }
-            // We need to add the substituted factor (function call with
-            // params substituted or term that doesn't match factor) back in
-            addedTerms->addTerm(term_clone);
         }
+        *kept++ = t;
     }
+    mTerms.erase(kept, mTerms.end());
+    if (not changed) { return false; }
 
-    // put all the modifications into this Exp
-    addExp(addedTerms);
+    // Substituted arguments can change where a term sorts or let it
+    // combine with another, so put the remaining terms back in one by one
+    // along with the substituted expressions.
+    std::vector<Term*> remaining;
+    remaining.swap(mTerms);
+    for (kept=remaining.begin(); kept != remaining.end(); kept++) {
+        addTerm(*kept);
+    }
+    if (addedTerms) { addExp(addedTerms); }
+    return true;
 }
 
 // Want first coefficient to always be a positive integer.
@@ -1344,7 +1651,7 @@ void Exp::normalizeForEquality() {
     Term *lastTerm = mTerms.back();
     if(lastTerm->coefficient() == 0){
         delete lastTerm;
-        mTerms.remove(lastTerm);
+        mTerms.pop_back();
     }
 }
 
@@ -1353,7 +1660,7 @@ void Exp::normalizeForEquality() {
 //! g(g_inv(x)[0], g_inv(x)[1]) changed to x
 Exp* Exp::collapseNestedInvertibleFunctions() const {
     Exp* retval = new Exp();
-    for (std::list<Term*>::const_iterator i=mTerms.begin();
+    for (std::vector<Term*>::const_iterator i=mTerms.begin();
                 i != mTerms.end(); i++) {
         retval->addExp( (*i)->collapseNestedInvertibleFunctions() );
     }   
@@ -1364,7 +1671,7 @@ Exp* Exp::collapseNestedInvertibleFunctions() const {
 **  (including within UFCallTerm arguments, recursively).
 */
 bool Exp::dependsOn(const Term& factor) const {
-    for (std::list<Term*>::const_iterator i=mTerms.begin();
+    for (std::vector<Term*>::const_iterator i=mTerms.begin();
                 i != mTerms.end(); i++) {
         if ((*i)->factorMatches(factor)) {
             // We found the matching term.
@@ -1400,7 +1707,7 @@ bool Exp::dependsOn(const Term& factor) const {
 **  that is being indexed.
 */
 bool Exp::hasIndexedUFCall() const {
-    for (std::list<Term*>::const_iterator i=mTerms.begin();
+    for (std::vector<Term*>::const_iterator i=mTerms.begin();
                 i != mTerms.end(); i++) {
         if ( (*i)->isUFCall() ) {
             UFCallTerm* ufcallptr = dynamic_cast<UFCallTerm*>(*i);
@@ -1419,7 +1726,7 @@ UFCallTerm* Exp::cloneIndexedUFCallTerm() const {
             "no indexed UFCallTerm");
     }
     UFCallTerm* retval = NULL;
-    for (std::list<Term*>::const_iterator i=mTerms.begin();
+    for (std::vector<Term*>::const_iterator i=mTerms.begin();
                 i != mTerms.end(); i++) {
         if ( (*i)->isUFCall() ) {
             UFCallTerm* ufcallptr = dynamic_cast<UFCallTerm*>(*i);
@@ -1459,7 +1766,7 @@ bool Exp::operator==(const Term& other) const {
     }
 }
 
-/*! Less than operator.
+/*! Three-way comparison, used by operator< and operator==.
 **      Compare two Exp in the following order:
 **          1. by size: number of terms in mTerms
 **          2. by sorted term values: using Term::operator<(Term)
@@ -1467,32 +1774,36 @@ bool Exp::operator==(const Term& other) const {
 **          sorted for both Exp being compared.
 ** @param other, object to be compared
 */
-bool Exp::operator<( const Exp& other) const {
+int Exp::compare( const Exp& other) const {
     // first compare mTerms sizes
-    if (mTerms.size() < other.mTerms.size()) { return true; }
-    if (other.mTerms.size() < mTerms.size()) { return false; }
+    if (mTerms.size() < other.mTerms.size()) { return -1; }
+    if (other.mTerms.size() < mTerms.size()) { return 1; }
     // then compare our elements
-    std::list<Term*>::const_iterator otherIter = other.mTerms.begin();
-    std::list<Term*>::const_iterator myIter = mTerms.begin(); 
+    std::vector<Term*>::const_iterator otherIter = other.mTerms.begin();
+    std::vector<Term*>::const_iterator myIter = mTerms.begin(); 
     while ( myIter != mTerms.end() ) {
         //compare values
-        if (**myIter < **otherIter) { return true; }
-        if (**otherIter < **myIter) { return false; }
+        int termComparison = (*myIter)->compare(**otherIter);
+        if (termComparison != 0) { return termComparison; }
         //our values are equal, continue
         ++myIter;
         ++otherIter; 
     }
     //all our elements are equal, so we're not less than other
-    return false;
+    return 0;
 }
 
-/*! Equality operator.
-**      Compare two Exp for equality.
-**      This operator assumes operator<(Exp) is well defined.
-** @param other, object to be compared
+/*! Hash of the sorted terms, consistent with operator==.
+**      Like operator==, the expression type (equality, inequality, ...)
+**      is not part of the hash.
 */
-bool Exp::operator==( const Exp& other) const {
-    return !((*this < other) || (other < *this));
+std::size_t Exp::hash() const {
+    std::size_t seed = mTerms.size();
+    for (std::vector<Term*>::const_iterator i=mTerms.begin(); 
+            i != mTerms.end(); ++i) {
+        hashCombine(seed, (*i)->hash());
+    }
+    return seed;
 }
 
 
@@ -1531,7 +1842,7 @@ void Exp::remapTupleVars(const std::vector<int>& oldToNewLocs) {
     // themselves to a new location as specified.
     // Since we only do one pass we don't have __tv0 mapping to __tv3 and
     // then __tv3 mapping to something else later.
-    for (std::list<Term*>::iterator i=mTerms.begin();
+    for (std::vector<Term*>::iterator i=mTerms.begin();
                 i != mTerms.end(); i++) {
         TupleVarTerm *tupleVarTerm = dynamic_cast<TupleVarTerm*>(*i);
         if (tupleVarTerm) {
@@ -1560,6 +1871,10 @@ void Exp::remapTupleVars(const std::vector<int>& oldToNewLocs) {
 
         }
     }
+
+    // New locations can change the order of terms, and addTerm relies
+    // on the terms being sorted.
+    std::sort(mTerms.begin(), mTerms.end(), termLess);
 }
 
 //! Returns true if only have a constant term
@@ -1598,7 +1913,7 @@ Term* Exp::getTerm() const {
 //! Otherwise return NULL.
 //! This expression still owns the Term.
 Term* Exp::getConstTerm() const {
-    for (std::list<Term*>::const_iterator i=mTerms.begin(); 
+    for (std::vector<Term*>::const_iterator i=mTerms.begin(); 
             i != mTerms.end(); i++) {
         Term* t = (*i);
         if (t->isConst()) {
@@ -1623,7 +1938,7 @@ std::string Exp::toDotString(int & next_id) const {
 
     // Printing out children here and calling recursively
     // on grandchildren due to a function call.
-    for (std::list<Term*>::const_iterator i=mTerms.begin();
+    for (std::vector<Term*>::const_iterator i=mTerms.begin();
                 i != mTerms.end(); i++) {
         int term_id = next_id++;
         // Connect self to term child
@@ -1680,7 +1995,7 @@ StringIterator* Exp::getSymbolIterator() const {
 
     std::set<std::string> symbolSet;
 
-    for (std::list<Term*>::const_iterator i=mTerms.begin();
+    for (std::vector<Term*>::const_iterator i=mTerms.begin();
                 i != mTerms.end(); i++) {
 
         VarTerm *varTerm = dynamic_cast<VarTerm*>(*i);
@@ -1768,7 +2083,7 @@ void TupleExpTerm::acceptVisitor(Visitor *v) {
 
 void Exp::acceptVisitor(Visitor *v) {
     v->preVisitExp(this);
-    for (std::list<Term*>::iterator i=mTerms.begin(); i != mTerms.end(); ++i) {
+    for (std::vector<Term*>::iterator i=mTerms.begin(); i != mTerms.end(); ++i) {
         (*i)->acceptVisitor(v);
     }
     v->postVisitExp(this);
@@ -1780,7 +2095,7 @@ void Exp::acceptVisitor(Visitor *v) {
 //! Get a list of pointers to the terms in this expression.
 //! All pointers in this list will be owned by caller.
 std::list<Term*> Exp::getTermList() const {
-    return mTerms;
+    return std::list<Term*>(mTerms.begin(), mTerms.end());
 }
 
 
@@ -25,10 +25,13 @@
 #include <sstream>
 #include <stdlib.h>
 #include <iostream>
+#include <functional>
 
 #include "environment.h"
 #include "TupleDecl.h"
 #include "SubMap.h"
+#include "arena.h"
+#include "symbol.h"
 class Visitor;
 
 #include <util/util.h>
@@ -44,7 +47,7 @@ class Exp;
  *         other entities.
  *
  */
-class Term {
+class Term : public ArenaAllocated {
 public:
     //! Default constructor
     inline Term(int coeff) : mCoeff(coeff), mTermType(ConstVal) {}
@@ -58,13 +61,20 @@ public:
     //! Destructor
     virtual ~Term() {}
 
+    /*! Three-way comparison in the canonical order of operator<.
+    **  Returns a negative number if this term comes first, 0 if the terms
+    **  are equal and a positive number otherwise. Allocation free.
+    */
+    virtual int compare(const Term& other) const;
+
     //! Comparison operator -- lexicographic order
-    virtual bool operator<(const Term& other) const;
+    bool operator<(const Term& other) const { return compare(other) < 0; }
 
     //! equality operator
-    bool operator==(const Term& other) const {
-        return ( (((*this)<other) == false)  && ((other<(*this)) == false) );
-    }
+    bool operator==(const Term& other) const { return compare(other) == 0; }
+
+    //! Hash consistent with operator==.
+    virtual std::size_t hash() const;
 
     //! Create a copy of this Term (and of the same subclass)
     virtual Term* clone() const;
@@ -116,6 +126,10 @@ public:
 
     //! Returns true if this term can be combined with the given term.
     virtual bool factorMatches(const Term& other) const;
+
+    //! Hash of the factor, i.e. everything except the coefficient.
+    //! Terms whose factors match have the same factor hash.
+    virtual std::size_t factorHash() const;
     
     /*! Combine another term into this one, if possible, by
     **  adding coefficients of corresponding factors.
@@ -178,11 +192,12 @@ public:
     ** then the UFCallTerm type is a tuple.  size() will indicate size
     ** of tuple being returned.
     */
-    UFCallTerm(int coeff, std::string funcName, unsigned int num_args, 
+    UFCallTerm(int coeff, const Symbol& funcName, unsigned int num_args, 
                int tuple_loc=-1);
 
     //! Convenience constructor, assumes coeff = 1
-    UFCallTerm(std::string funcName, unsigned int num_args, int tuple_loc=-1);
+    UFCallTerm(const Symbol& funcName, unsigned int num_args,
+               int tuple_loc=-1);
 
     //! Copy constructor
     UFCallTerm(const UFCallTerm& other);
@@ -194,8 +209,11 @@ public:
     void reset();
     ~UFCallTerm();
 
-    //! Comparison operator -- lexicographic order
-    bool operator<(const Term& other) const;
+    //! Three-way comparison -- lexicographic order, see Term::compare
+    int compare(const Term& other) const;
+
+    //! Hash consistent with operator==.
+    std::size_t hash() const;
 
     //! Create a copy of this Term (and of the same subclass)
     Term* clone() const;
@@ -260,10 +278,13 @@ public:
     unsigned int size() const;
 
     //! Returns the function name as a string.
-    std::string name() const { return mFuncName; }
+    const std::string& name() const { return mFuncName.str(); }
+
+    //! Returns the interned function name, for environment lookups.
+    const Symbol& nameSymbol() const { return mFuncName; }
     
     //! Enables the function name to be set.
-    void setName(std::string n) { mFuncName = n; }
+    void setName(const Symbol& n) { mFuncName = n; }
 
     //! Return a new Exp with all nested functions such as
     //! f ( f_inv ( i ) ) changed to i.
@@ -273,17 +294,29 @@ public:
 
     //! Returns true if this term can be combined with the given term.
     bool factorMatches(const Term& other) const;
+
+    //! Hash of the factor, see Term::factorHash.
+    std::size_t factorHash() const;
     
     //! Visitor design pattern, see Visitor.h for usage
     void acceptVisitor(Visitor *v);
 
 
 private:
+    class ArgsCursor;
+
+    //! Three-way comparison of the argument lists in the order of their
+    //! printed forms, as argsToStream prints them, without printing them.
+    //! Lists that print the same are ordered by compareArgExps.
+    int compareArgs(const UFCallTerm& other) const;
+    //! Three-way comparison of the argument expressions, one by one.
+    int compareArgExps(const UFCallTerm& other) const;
+
     void argsToStream(std::stringstream& ss, bool generic=false) const;
     void argsToStreamPrettyPrint(const TupleDecl & aTupleDecl,
         std::stringstream& ss) const;
 
-    std::string mFuncName;
+    Symbol mFuncName;
     unsigned int mNumArgs;
     std::vector<Exp*> mArgs;
     int mTupleIndex;
@@ -310,8 +343,11 @@ public:
     //! Copy assignment
     TupleVarTerm& operator=(const TupleVarTerm& other);
 
-    //! Comparison operator -- lexicographic order
-    bool operator<(const Term& other) const;
+    //! Three-way comparison -- lexicographic order, see Term::compare
+    int compare(const Term& other) const;
+
+    //! Hash consistent with operator==.
+    std::size_t hash() const;
 
     //! Create a copy of this Term (and of the same subclass)
     Term* clone() const;
@@ -333,7 +369,7 @@ public:
     bool isConst() const { return false; }
 
     // Returns location of TV 
-    int tvloc(){return mLocation;}
+    int tvloc() const {return mLocation;}
 
     //--------------------- methods for the use in expression
 
@@ -341,6 +377,9 @@ public:
     //! except the coefficient) as the given other term.
     bool factorMatches(const Term& other) const;
 
+    //! Hash of the factor, see Term::factorHash.
+    std::size_t factorHash() const;
+
     //! Remap our location according to the given map vector.
     //! See Exp::remapTupleVars for more detail.
     void remapLocation(const std::vector<int>& oldToNewLocs);
@@ -360,11 +399,11 @@ private:
 class VarTerm : public Term {
 public:
     //! Constructor
-    inline VarTerm(int coeff, std::string symbol) 
+    inline VarTerm(int coeff, const Symbol& symbol) 
     : Term(coeff), mSymbol(symbol) { setTermType(SymConst); }
 
     //! Convenience constructor, assumes coeff = 1
-    inline VarTerm(std::string symbol) 
+    inline VarTerm(const Symbol& symbol) 
     : Term(1), mSymbol(symbol) { setTermType(SymConst); }
     
     //! Copy constructor
@@ -373,8 +412,11 @@ public:
     //! Copy assignment
     VarTerm& operator=(const VarTerm& other);
 
-    //! Comparison operator -- lexicographic order
-    bool operator<(const Term& other) const;
+    //! Three-way comparison -- lexicographic order, see Term::compare
+    int compare(const Term& other) const;
+
+    //! Hash consistent with operator==.
+    std::size_t hash() const;
 
     //! Create a copy of this Term (and of the same subclass)
     Term* clone() const;
@@ -390,7 +432,10 @@ public:
         bool absValue = false) const;
 
     //! Return the variable string
-    std::string symbol() const { return mSymbol; }
+    const std::string& symbol() const { return mSymbol.str(); }
+
+    //! Returns the interned variable string.
+    const Symbol& internedSymbol() const { return mSymbol; }
 
     //! Returns string of subclass type.
     //! Used by toDotString() only.  Might want to refactor.
@@ -404,11 +449,14 @@ public:
     //! Returns true if this term can be combined with the given term.
     bool factorMatches(const Term& other) const;
 
+    //! Hash of the factor, see Term::factorHash.
+    std::size_t factorHash() const;
+
     //! Visitor design pattern, see Visitor.h for usage
     void acceptVisitor(Visitor *v);
 
 private:
-    std::string mSymbol;
+    Symbol mSymbol;
 };
 
 /*!
@@ -449,8 +497,11 @@ public:
     //! Copy assignment operator.
     TupleExpTerm& operator=( const TupleExpTerm& other);
     
-    //! Less than operator.
-    bool operator<( const Term& other) const;
+    //! Three-way comparison, see Term::compare
+    int compare(const Term& other) const;
+
+    //! Hash consistent with operator==.
+    std::size_t hash() const;
     
     //! Equality operator.
     //bool operator==( const TupleExpTerm& other) const;
@@ -495,7 +546,7 @@ public:
     void setExpElem(unsigned int exp_index, Exp* exp);
 
     //! Returns pointer to individual expression.  Indexing starts at 0.
-    Exp* getExpElem(unsigned int exp_index);
+    Exp* getExpElem(unsigned int exp_index) const;
 
     //! Returns a clone of the specified expression.
     Exp* cloneExp(unsigned int exp_index) const;        
@@ -508,6 +559,9 @@ public:
     //! Returns true if this term can be combined with the given term.
     bool factorMatches(const Term& other) const;
 
+    //! Hash of the factor, see Term::factorHash.
+    std::size_t factorHash() const;
+
     //! Visitor design pattern, see Visitor.h for usage
     void acceptVisitor(Visitor *v);
 
@@ -526,7 +580,7 @@ private:
  *  copies those when the Exp itself is copied, and deletes them when the Exp
  *  is destroyed.
  */
-class Exp {
+class Exp : public ArenaAllocated {
 public:
     //! Default constructor
     inline Exp() {setExpression();}
@@ -537,6 +591,12 @@ public:
     //! Copy assignment
     Exp& operator=(const Exp& other);
 
+    //! Move constructor, takes over the terms of other.
+    Exp(Exp&& other);
+
+    //! Move assignment, takes over the terms of other.
+    Exp& operator=(Exp&& other);
+
     //! Destructor
     void reset();
     virtual ~Exp();
@@ -583,8 +643,8 @@ public:
 
     //! Substitute each expression for the factor (i.e. the non-coefficient
     //! part of a term), which is its key.
-    //void substitute(const std::map<Term*,Exp*>& searchTermToSubExp);
-    void substitute(SubMap& searchTermToSubExp);
+    //! Returns true if the expression changed.
+    bool substitute(const SubMap& searchTermToSubExp);
     
     /*! Normalize this expression for use in an equality expression.
     **  This is called when we know this expression is equal to zero;
@@ -623,11 +683,20 @@ public:
     //! Returns true if this expression equals the given term.
     bool operator==(const Term& other) const;
     
+    /*! Three-way comparison in the order of operator<: negative if this
+    **  expression comes first, 0 if equal, positive otherwise.
+    **  Allocation free.
+    */
+    int compare(const Exp& other) const;
+
     //! Less than operator.
-    bool operator<( const Exp& other) const;
+    bool operator<( const Exp& other) const { return compare(other) < 0; }
     
     //! Equality operator.
-    bool operator==( const Exp& other) const;
+    bool operator==( const Exp& other) const { return compare(other) == 0; }
+
+    //! Hash consistent with operator==.
+    std::size_t hash() const;
     
     /*! Find any TupleVarTerms in this expression (and subexpressions)
     **  and remap the locations according to the oldToNewLocs vector,
@@ -653,13 +722,13 @@ public:
 
     //! Returns true if the Exp is a simple expression, not a constraint
     //! Does not mean it is a UFCall param.
-    inline bool isExpression() { return (getExpType() == Expression); }
+    inline bool isExpression() const { return (getExpType() == Expression); }
 
     //! Returns true if the Exp is an inequality, ie expression >= 0
-    inline bool isInequality() { return (getExpType() == Inequality); }
+    inline bool isInequality() const { return (getExpType() == Inequality); }
 
     //! Returns true if the Exp is an equality, ie expression == 0
-    inline bool isEquality() { return (getExpType() == Equality); }
+    inline bool isEquality() const { return (getExpType() == Equality); }
 
     //! Returns true if only have a constant term
     bool isConst() const;
@@ -697,6 +766,10 @@ public:
     //! Caller should NOT modify expressions or delete them.
     std::list<Term*> getTermList() const;
 
+    //! The terms in order, without copying the list. Same ownership as
+    //! getTermList.
+    const std::vector<Term*>& terms() const { return mTerms; }
+
 protected:
 
     typedef enum {Expression, Inequality, Equality} exptype;
@@ -709,7 +782,7 @@ private:
     */
     Term* findMatchingFactor(const Term & factor) const;        
 
-    std::list<Term*> mTerms;
+    std::vector<Term*> mTerms;
     exptype mExpType; 
 
 };
@@ -718,4 +791,41 @@ private:
 
 }//end namespace iegenlib
 
+namespace iegenlib{
+
+//! Hash and equality on the expressions pointed to, for unordered
+//! containers of Exp* that should not copy the expressions.
+struct ExpPtrHash {
+    std::size_t operator()(const Exp* e) const { return e->hash(); }
+};
+struct ExpPtrEqual {
+    bool operator()(const Exp* a, const Exp* b) const {
+        return a->compare(*b) == 0;
+    }
+};
+
+}
+
+namespace std {
+
+//! Lets terms and expressions be keys of unordered containers.
+template <> struct hash<iegenlib::Term> {
+    std::size_t operator()(const iegenlib::Term& t) const { return t.hash(); }
+};
+template <> struct hash<iegenlib::UFCallTerm> {
+    std::size_t operator()(const iegenlib::UFCallTerm& t) const {
+        return t.hash();
+    }
+};
+template <> struct hash<iegenlib::VarTerm> {
+    std::size_t operator()(const iegenlib::VarTerm& t) const {
+        return t.hash();
+    }
+};
+template <> struct hash<iegenlib::Exp> {
+    std::size_t operator()(const iegenlib::Exp& e) const { return e.hash(); }
+};
+
+}
+
 #endif /* EXPRESSION_H_ */
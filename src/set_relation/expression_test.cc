@@ -23,6 +23,7 @@
 #include <utility>
 #include <iostream>
 #include <fstream>
+#include <unordered_set>
 using std::cout;
 using std::endl;
 
@@ -466,6 +467,64 @@ TEST_F(ExpTest, ExpSubstituteSwap) {
     EXPECT_EQ("9 __tv0 + 12 __tv1 + 3 foo(15 __tv0, 2 __tv1) - 21", e2.toString());
 }
 
+#pragma mark SubMapFactorLookup
+// SubMap finds terms by factor, ignoring coefficients, and substitutes
+// for many tuple variables in one pass.
+TEST_F(ExpTest, SubMapFactorLookup) {
+    SubMap subMap;
+    EXPECT_TRUE(subMap.empty());
+
+    // rowptr(__tv0 + 1) -> N
+    UFCallTerm* rowptr = new UFCallTerm("rowptr", 1);
+    Exp* arg = new Exp();
+    arg->addTerm(new TupleVarTerm(0));
+    arg->addTerm(new Term(1));
+    rowptr->setParamExp(0, arg);
+    Exp* n = new Exp();
+    n->addTerm(new VarTerm("N"));
+    subMap.insertPair(rowptr, n);
+
+    // A second expression for the same factor is dropped.
+    Exp* m = new Exp();
+    m->addTerm(new VarTerm("M"));
+    subMap.insertPair(new VarTerm(3, "M"), m);
+    Exp* other = new Exp();
+    other->addTerm(new Term(7));
+    subMap.insertPair(new VarTerm("M"), other);
+    EXPECT_EQ(2u, subMap.size());
+
+    UFCallTerm* lookup = dynamic_cast<UFCallTerm*>(rowptr->clone());
+    lookup->setCoefficient(-4);
+    EXPECT_EQ(n, subMap.subExp(lookup));
+    VarTerm varM(-2, "M");
+    EXPECT_EQ(m, subMap.subExp(&varM));
+    VarTerm varK("K");
+    EXPECT_EQ(NULL, subMap.subExp(&varK));
+    lookup->getParamExp(0)->addTerm(new Term(1));
+    EXPECT_EQ(NULL, subMap.subExp(lookup));
+    delete lookup;
+
+    // Expressions with nothing to substitute are left alone.
+    Exp e;
+    e.addTerm(new VarTerm(2, "K"));
+    EXPECT_FALSE(e.substitute(subMap));
+    EXPECT_EQ("2 K", e.toString());
+
+    // Shift every one of 200 tuple variables down by one at once.
+    SubMap shift;
+    Exp big;
+    for (int i = 0; i < 200; i++) {
+        big.addTerm(new TupleVarTerm(i + 1, i));
+        Exp* lower = new Exp();
+        if (i > 0) { lower->addTerm(new TupleVarTerm(i - 1)); }
+        shift.insertPair(new TupleVarTerm(i), lower);
+    }
+    EXPECT_TRUE(big.substitute(shift));
+    ASSERT_EQ(199u, big.getTermList().size());
+    EXPECT_EQ("2 __tv0", big.getTermList().front()->toString());
+    EXPECT_EQ("200 __tv198", big.getTermList().back()->toString());
+}
+
 #pragma mark ExpSolving
 // Test solving equality expressions
 TEST_F(ExpTest, ExpSolving) {
@@ -571,7 +630,41 @@ TEST_F(ExpTest, ExpRemapLocs) {
     map[2] = 0;
     map[3] = 2;
     e1.remapTupleVars(map);
-    EXPECT_EQ("12 __tv4 + 7 __tv2 + 5 N + g(__tv0) + 42", e1.toString());  
+    // The terms are sorted again by their new locations.
+    EXPECT_EQ("7 __tv2 + 12 __tv4 + 5 N + g(__tv0) + 42", e1.toString());  
+}
+
+#pragma mark ExpSortedMerge
+// Terms stay sorted and combined whatever order they are added in, and
+// adding expressions merges their terms.
+TEST_F(ExpTest, ExpSortedMerge) {
+    Exp e1;
+    for (int i = 9; i >= 0; i--) {
+        e1.addTerm(new TupleVarTerm(i + 1, (i * 7) % 10));
+    }
+    e1.addTerm(new VarTerm(-3, "N"));
+    e1.addTerm(new TupleVarTerm(-2, 5));
+    e1.addTerm(new Term(4));
+    EXPECT_EQ("__tv0 + 4 __tv1 + 7 __tv2 + 10 __tv3 + 3 __tv4 + 4 __tv5 "
+              "+ 9 __tv6 + 2 __tv7 + 5 __tv8 + 8 __tv9 - 3 N + 4",
+              e1.toString());
+
+    // Cancel some terms, combine others and interleave new ones.
+    Exp* e2 = new Exp();
+    e2->addTerm(new TupleVarTerm(-1, 0));
+    e2->addTerm(new TupleVarTerm(2, 3));
+    e2->addTerm(new VarTerm(3, "N"));
+    e2->addTerm(new VarTerm(1, "M"));
+    e2->addTerm(new TupleVarTerm(-8, 9));
+    e2->addTerm(new Term(-4));
+    e1.addExp(e2);
+    EXPECT_EQ("4 __tv1 + 7 __tv2 + 12 __tv3 + 3 __tv4 + 4 __tv5 "
+              "+ 9 __tv6 + 2 __tv7 + 5 __tv8 + M", e1.toString());
+
+    Exp copy(e1);
+    copy.multiplyBy(-1);
+    e1.addExp(new Exp(copy));
+    EXPECT_TRUE(e1.equalsZero());
 }
 
 #pragma mark ExpIsConst
@@ -1249,3 +1342,135 @@ TEST_F(ExpTest, HasIndexedUFCall) {
 }
 
 /******************************************/
+
+#pragma mark CompareAndHash
+// Structural comparison and hashing of terms and expressions.
+TEST_F(ExpTest, CompareAndHash) {
+    Exp* e1 = new Exp();
+    e1->addTerm(new TupleVarTerm(2, 0));
+    UFCallTerm* f = new UFCallTerm("f", 1);
+    Exp* arg = new Exp();
+    arg->addTerm(new TupleVarTerm(0));
+    arg->addTerm(new Term(1));
+    f->setParamExp(0, arg);
+    e1->addTerm(f);
+    e1->addTerm(new Term(-3));
+
+    Exp* e2 = new Exp(*e1);
+    EXPECT_EQ( 0, e1->compare(*e2) );
+    EXPECT_EQ( e1->hash(), e2->hash() );
+
+    e2->addTerm(new Term(1));
+    EXPECT_NE( 0, e1->compare(*e2) );
+    EXPECT_EQ( -e1->compare(*e2), e2->compare(*e1) );
+
+    // f(__tv0) < f(__tv0 + 1) < f(__tv1)
+    UFCallTerm a("f", 1), b("f", 1), c("f", 1);
+    Exp* argA = new Exp();  argA->addTerm(new TupleVarTerm(0));
+    Exp* argB = new Exp();  argB->addTerm(new TupleVarTerm(0));
+    argB->addTerm(new Term(1));
+    Exp* argC = new Exp();  argC->addTerm(new TupleVarTerm(1));
+    a.setParamExp(0, argA);  b.setParamExp(0, argB);  c.setParamExp(0, argC);
+    EXPECT_TRUE( a < b );
+    EXPECT_TRUE( b < c );
+    EXPECT_FALSE( c < a );
+
+    // Equal expressions collapse in unordered containers.
+    std::unordered_set<Exp> exps;
+    exps.insert(*e1);
+    exps.insert(Exp(*e1));
+    exps.insert(*e2);
+    EXPECT_EQ( 2u, exps.size() );
+
+    delete e1;
+    delete e2;
+}
+
+// TupleExpTerm compares its element expressions, not their addresses.
+TEST_F(ExpTest, CompareTupleExp) {
+    TupleExpTerm t1(2), t2(2);
+    for (int i = 0; i < 2; i++) {
+        Exp* x = new Exp();  x->addTerm(new Term(i));
+        Exp* y = new Exp();  y->addTerm(new Term(i));
+        t1.setExpElem(i, x);
+        t2.setExpElem(i, y);
+    }
+    EXPECT_TRUE( t1 == t2 );
+    EXPECT_EQ( t1.hash(), t2.hash() );
+}
+
+// UF calls with nested calls in their arguments match factors when the
+// arguments are structurally equal, whatever their coefficients.
+TEST_F(ExpTest, UFCallFactorMatchesNested) {
+    UFCallTerm* calls[3];
+    int coeffs[3] = {2, 5, 1};
+    int offsets[3] = {1, 1, 2};
+    for (int i = 0; i < 3; i++) {
+        UFCallTerm* inner = new UFCallTerm("g", 1);
+        Exp* innerArg = new Exp();
+        innerArg->addTerm(new TupleVarTerm(0));
+        inner->setParamExp(0, innerArg);
+        Exp* arg = new Exp();
+        arg->addTerm(inner);
+        arg->addTerm(new Term(offsets[i]));
+        calls[i] = new UFCallTerm(coeffs[i], "f", 1);
+        calls[i]->setParamExp(0, arg);
+    }
+    EXPECT_EQ( "2 f(g(__tv0) + 1)", calls[0]->toString() );
+    EXPECT_TRUE( calls[0]->factorMatches(*calls[1]) );
+    EXPECT_EQ( calls[0]->factorHash(), calls[1]->factorHash() );
+    EXPECT_FALSE( calls[0]->factorMatches(*calls[2]) );
+    EXPECT_FALSE( calls[2]->factorMatches(*calls[1]) );
+    EXPECT_TRUE( calls[0]->combine(calls[1]->clone()) );
+    EXPECT_EQ( 7, calls[0]->coefficient() );
+    for (int i = 0; i < 3; i++) { delete calls[i]; }
+}
+
+// Calls to the same UF are ordered by their argument lists as strings,
+// which they are compared as without being printed.
+TEST_F(ExpTest, UFCallOrderIsPrintedOrder) {
+    std::vector<UFCallTerm*> calls;
+    // f(-__tv0), f(2 __tv0), f(3)
+    int coeffs[2] = {-1, 2};
+    for (int i = 0; i < 2; i++) {
+        Exp* arg = new Exp();  arg->addTerm(new TupleVarTerm(coeffs[i], 0));
+        calls.push_back(new UFCallTerm("f", 1));
+        calls.back()->setParamExp(0, arg);
+    }
+    Exp* arg = new Exp();  arg->addTerm(new Term(3));
+    calls.push_back(new UFCallTerm("f", 1));
+    calls.back()->setParamExp(0, arg);
+    // f(__tv0 + 1, __tv1), f(__tv0, __tv1)
+    for (int i = 1; i >= 0; i--) {
+        Exp* first = new Exp();  first->addTerm(new TupleVarTerm(0));
+        if (i) { first->addTerm(new Term(i)); }
+        Exp* second = new Exp();  second->addTerm(new TupleVarTerm(1));
+        calls.push_back(new UFCallTerm("f", 2));
+        calls.back()->setParamExp(0, first);
+        calls.back()->setParamExp(1, second);
+    }
+    // f(g(__tv0)), f(g(__tv0)[1])
+    for (int index = -1; index <= 1; index += 2) {
+        UFCallTerm* g = new UFCallTerm("g", 1, index);
+        Exp* gArg = new Exp();  gArg->addTerm(new TupleVarTerm(0));
+        g->setParamExp(0, gArg);
+        Exp* fArg = new Exp();  fArg->addTerm(g);
+        calls.push_back(new UFCallTerm("f", 1));
+        calls.back()->setParamExp(0, fArg);
+    }
+    // f(n)
+    arg = new Exp();  arg->addTerm(new VarTerm("n"));
+    calls.push_back(new UFCallTerm("f", 1));
+    calls.back()->setParamExp(0, arg);
+
+    EXPECT_EQ( "f(g(__tv0)[1])", calls[6]->toString() );
+    for (size_t i = 0; i < calls.size(); i++) {
+        EXPECT_EQ( 0, calls[i]->compare(*calls[i]) );
+        for (size_t j = i + 1; j < calls.size(); j++) {
+            EXPECT_TRUE( *calls[i] < *calls[j] )
+                << calls[i]->toString() << " < " << calls[j]->toString();
+            EXPECT_FALSE( *calls[j] < *calls[i] );
+        }
+    }
+    for (size_t i = 0; i < calls.size(); i++) { delete calls[i]; }
+}
@@ -0,0 +1,763 @@
+/*!
+ * \file fourier_motzkin.cc
+ *
+ * \brief Implementation of the projection of tuple variables out of
+ *        affine conjunctions.
+ *
+ * The constraints are read into dense rows of long long coefficients:
+ * the constant first, then the symbolic constants in name order, then
+ * the tuple variables. That is the column order isl uses, so the echelon
+ * form of the equalities comes out the same as isl's.
+ *
+ * The clean up after the elimination asks whether systems of rows have
+ * rational solutions. It answers that by Fourier-Motzkin elimination of
+ * every column, which is exponential in general but cheap for the small
+ * conjunctions this is used on, and gives up, answering that there is a
+ * solution, when the rows grow too many. That answer only ever keeps a
+ * constraint that could have gone.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "fourier_motzkin.h"
+#include "compact_term.h"
+#include "set_relation.h"
+#include "symbol.h"
+#include <util/UnionFindUniverse.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace iegenlib{
+
+namespace {
+
+typedef long long Coeff;
+
+//! A constraint: the constant, then one coefficient per column.
+typedef std::vector<Coeff> Row;
+
+//! Largest coefficient we keep, so that combining two rows cannot
+//! overflow and the results fit in the int coefficients of Terms.
+const Coeff kMaxCoeff = Coeff(1) << 30;
+
+//! Most rows the rational feasibility test works with.
+const unsigned int kMaxFeasibilityRows = 512;
+
+Coeff absCoeff(Coeff a) { return a < 0 ? -a : a; }
+
+Coeff gcd(Coeff a, Coeff b) {
+    a = absCoeff(a);
+    b = absCoeff(b);
+    while (b != 0) {
+        Coeff t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+//! Rounds a/b down, for b > 0.
+Coeff floorDiv(Coeff a, Coeff b) {
+    Coeff q = a / b;
+    if (a % b != 0 && a < 0) { q--; }
+    return q;
+}
+
+//! Returns a*x + b*y.
+Row combine(Coeff a, const Row& x, Coeff b, const Row& y) {
+    Row result(x.size());
+    for (size_t i = 0; i < x.size(); i++) { result[i] = a*x[i] + b*y[i]; }
+    return result;
+}
+
+bool fits(const Row& row) {
+    for (size_t i = 0; i < row.size(); i++) {
+        if (absCoeff(row[i]) > kMaxCoeff) { return false; }
+    }
+    return true;
+}
+
+//! The coefficients of a row, without the constant.
+Row varPart(const Row& row) { return Row(row.begin()+1, row.end()); }
+
+Row negated(const Row& row) {
+    Row result(row.size());
+    for (size_t i = 0; i < row.size(); i++) { result[i] = -row[i]; }
+    return result;
+}
+
+//! What normalizing a row found out about it.
+typedef enum {Row_Keep, Row_True, Row_False} rowstate;
+
+// Divides the coefficients of row by their gcd. The constant of an
+// inequality rounds down, which keeps the same integer points. A row
+// without coefficients always holds or never does.
+rowstate normalizeRow(Row& row, bool isEquality) {
+    Coeff g = 0;
+    for (size_t i = 1; i < row.size(); i++) { g = gcd(g, row[i]); }
+    if (g == 0) {
+        if (isEquality) { return row[0] == 0 ? Row_True : Row_False; }
+        return row[0] >= 0 ? Row_True : Row_False;
+    }
+    if (isEquality && row[0] % g != 0) { return Row_False; }
+    if (g > 1) {
+        for (size_t i = 1; i < row.size(); i++) { row[i] /= g; }
+        row[0] = isEquality ? row[0] / g : floorDiv(row[0], g);
+    }
+    return Row_Keep;
+}
+
+// Makes the first coefficient of an equality positive.
+void orientEquality(Row& row) {
+    for (size_t i = 1; i < row.size(); i++) {
+        if (row[i] != 0) {
+            if (row[i] < 0) { row = negated(row); }
+            return;
+        }
+    }
+}
+
+struct AffineSystem {
+    AffineSystem() : empty(false), overflow(false) {}
+
+    unsigned int size() const
+        { return equalities.size() + inequalities.size(); }
+
+    //! = 0
+    std::vector<Row> equalities;
+    //! >= 0
+    std::vector<Row> inequalities;
+    //! No integer points.
+    bool empty;
+    //! A coefficient grew past kMaxCoeff.
+    bool overflow;
+};
+
+// Normalizes every row and drops the ones that say nothing new: repeated
+// rows, and of two inequalities that only differ in the constant the
+// weaker one. Two opposite inequalities that meet become an equality, and
+// an inequality over the same coefficients as an equality is decided by
+// it. Sets sys.empty on a contradiction.
+void pruneSystem(AffineSystem& sys) {
+    bool changed = true;
+    while (changed && !sys.empty) {
+        changed = false;
+
+        // coefficients, with the first one positive -> constant
+        std::map<Row, Coeff> equalities;
+        for (size_t i = 0; i < sys.equalities.size(); i++) {
+            Row& row = sys.equalities[i];
+            rowstate state = normalizeRow(row, true);
+            if (state == Row_False) { sys.empty = true; return; }
+            if (state == Row_True) { continue; }
+            orientEquality(row);
+            std::map<Row, Coeff>::iterator it =
+                equalities.insert(std::make_pair(varPart(row), row[0])).first;
+            if (it->second != row[0]) { sys.empty = true; return; }
+        }
+
+        // coefficients -> smallest constant
+        std::map<Row, Coeff> inequalities;
+        for (size_t i = 0; i < sys.inequalities.size(); i++) {
+            Row& row = sys.inequalities[i];
+            rowstate state = normalizeRow(row, false);
+            if (state == Row_False) { sys.empty = true; return; }
+            if (state == Row_True) { continue; }
+            Row key = varPart(row);
+            std::map<Row, Coeff>::iterator it = inequalities.find(key);
+            if (it == inequalities.end()) {
+                inequalities[key] = row[0];
+            } else if (row[0] < it->second) {
+                it->second = row[0];
+            }
+        }
+
+        sys.equalities.clear();
+        for (std::map<Row, Coeff>::const_iterator i = equalities.begin();
+                i != equalities.end(); i++) {
+            Row row(1, i->second);
+            row.insert(row.end(), i->first.begin(), i->first.end());
+            sys.equalities.push_back(row);
+        }
+
+        sys.inequalities.clear();
+        for (std::map<Row, Coeff>::const_iterator i = inequalities.begin();
+                i != inequalities.end(); i++) {
+            Row row(1, i->second);
+            row.insert(row.end(), i->first.begin(), i->first.end());
+            Row eqRow = row;
+            orientEquality(eqRow);
+            bool flipped = eqRow != row;
+
+            // Decided by an equality over the same coefficients:
+            // a + e = 0 and a + c >= 0 means c - e >= 0.
+            std::map<Row, Coeff>::const_iterator eq =
+                equalities.find(varPart(eqRow));
+            if (eq != equalities.end()) {
+                Coeff slack = flipped ? row[0] + eq->second
+                                      : row[0] - eq->second;
+                if (slack < 0) { sys.empty = true; return; }
+                continue;
+            }
+
+            // Opposite inequalities a + c1 >= 0 and -a + c2 >= 0.
+            std::map<Row, Coeff>::const_iterator opposite =
+                inequalities.find(negated(i->first));
+            if (opposite != inequalities.end()) {
+                Coeff slack = i->second + opposite->second;
+                if (slack < 0) { sys.empty = true; return; }
+                if (slack == 0) {
+                    // Both become one equality, added once.
+                    if (!flipped) {
+                        sys.equalities.push_back(row);
+                        changed = true;
+                    }
+                    continue;
+                }
+            }
+            sys.inequalities.push_back(row);
+        }
+    }
+}
+
+// Eliminates column col from every row but equality eq, in which col has
+// a coefficient of 1 or -1, and drops eq.
+void substituteEquality(AffineSystem& sys, size_t eq, size_t col) {
+    Row e = sys.equalities[eq];
+    sys.equalities.erase(sys.equalities.begin() + eq);
+    Coeff sign = e[col];
+    for (int kind = 0; kind < 2; kind++) {
+        std::vector<Row>& rows = kind ? sys.inequalities : sys.equalities;
+        for (size_t i = 0; i < rows.size(); i++) {
+            if (rows[i][col] == 0) { continue; }
+            rows[i] = combine(1, rows[i], -rows[i][col]*sign, e);
+            if (!fits(rows[i])) { sys.overflow = true; }
+        }
+    }
+}
+
+// True if eliminating column col from the inequalities by
+// Fourier-Motzkin keeps exactly the integer points: all the lower bounds
+// or all the upper bounds have a coefficient of 1. Sets cost to the
+// number of rows it adds.
+bool exactShadow(const AffineSystem& sys, size_t col, int* cost) {
+    int lower = 0, upper = 0;
+    bool unitLower = true, unitUpper = true;
+    for (size_t i = 0; i < sys.inequalities.size(); i++) {
+        Coeff c = sys.inequalities[i][col];
+        if (c > 0) { lower++; unitLower = unitLower && c == 1; }
+        if (c < 0) { upper++; unitUpper = unitUpper && c == -1; }
+    }
+    *cost = lower*upper - lower - upper;
+    return unitLower || unitUpper;
+}
+
+// Fourier-Motzkin elimination of column col from the inequalities, col
+// must not be in any equality.
+void fourierMotzkin(AffineSystem& sys, size_t col) {
+    std::vector<Row> lower, upper, rest;
+    for (size_t i = 0; i < sys.inequalities.size(); i++) {
+        const Row& row = sys.inequalities[i];
+        if (row[col] > 0) { lower.push_back(row); }
+        else if (row[col] < 0) { upper.push_back(row); }
+        else { rest.push_back(row); }
+    }
+    for (size_t l = 0; l < lower.size(); l++) {
+        for (size_t u = 0; u < upper.size(); u++) {
+            Row row = combine(-upper[u][col], lower[l],
+                              lower[l][col], upper[u]);
+            if (!fits(row)) { sys.overflow = true; }
+            rest.push_back(row);
+        }
+    }
+    sys.inequalities.swap(rest);
+}
+
+/************************ rational feasibility *****************************/
+
+struct RationalRow {
+    RationalRow(const Row& r, bool s) : row(r), strict(s) {}
+    Row row;
+    //! > 0 instead of >= 0.
+    bool strict;
+};
+
+// Divides a rational row by the gcd of all its entries, which keeps its
+// rational solutions. Returns false if it has no coefficients left and
+// does not hold.
+bool scaleRationalRow(RationalRow& r, bool* trivial) {
+    Coeff g = 0;
+    for (size_t i = 1; i < r.row.size(); i++) { g = gcd(g, r.row[i]); }
+    *trivial = g == 0;
+    if (g == 0) { return r.strict ? r.row[0] > 0 : r.row[0] >= 0; }
+    g = gcd(g, r.row[0]);
+    if (g > 1) {
+        for (size_t i = 0; i < r.row.size(); i++) { r.row[i] /= g; }
+    }
+    return true;
+}
+
+// Orders rows by coefficients, and rows with the same coefficients
+// tightest first: smaller constant, then strict.
+bool tighterFirst(const RationalRow& a, const RationalRow& b) {
+    if (!std::equal(a.row.begin()+1, a.row.end(), b.row.begin()+1)) {
+        return std::lexicographical_compare(a.row.begin()+1, a.row.end(),
+                                            b.row.begin()+1, b.row.end());
+    }
+    if (a.row[0] != b.row[0]) { return a.row[0] < b.row[0]; }
+    return a.strict && !b.strict;
+}
+
+// True if the equalities (= 0) and the rows (>= 0, or > 0 when strict)
+// have a rational solution. Also true if it gives up because the rows
+// grow too many or too large.
+bool rationallyFeasible(std::vector<Row> equalities,
+                        std::vector<RationalRow> rows) {
+    // Equalities first, each eliminating its last column.
+    for (size_t e = 0; e < equalities.size(); e++) {
+        Row eq = equalities[e];
+        size_t col = eq.size();
+        while (--col > 0 && eq[col] == 0) {}
+        if (col == 0) {
+            if (eq[0] != 0) { return false; }
+            continue;
+        }
+        if (eq[col] < 0) { eq = negated(eq); }
+        for (size_t i = e+1; i < equalities.size(); i++) {
+            if (equalities[i][col] == 0) { continue; }
+            equalities[i] = combine(eq[col], equalities[i],
+                                    -equalities[i][col], eq);
+            if (!fits(equalities[i])) { return true; }
+        }
+        for (size_t i = 0; i < rows.size(); i++) {
+            if (rows[i].row[col] == 0) { continue; }
+            rows[i].row = combine(eq[col], rows[i].row,
+                                  -rows[i].row[col], eq);
+            if (!fits(rows[i].row)) { return true; }
+        }
+    }
+
+    while (true) {
+        // Of the rows with the same coefficients only the tightest one
+        // counts, the first after sorting.
+        std::vector<RationalRow> scaled;
+        for (size_t i = 0; i < rows.size(); i++) {
+            bool trivial;
+            if (!scaleRationalRow(rows[i], &trivial)) { return false; }
+            if (!trivial) { scaled.push_back(rows[i]); }
+        }
+        std::sort(scaled.begin(), scaled.end(), tighterFirst);
+        rows.clear();
+        for (size_t i = 0; i < scaled.size(); i++) {
+            if (i == 0 || !std::equal(scaled[i].row.begin()+1,
+                                      scaled[i].row.end(),
+                                      scaled[i-1].row.begin()+1)) {
+                rows.push_back(scaled[i]);
+            }
+        }
+        if (rows.empty()) { return true; }
+
+        // The column that adds the fewest rows.
+        size_t best = 0;
+        long bestCost = 0;
+        for (size_t col = 1; col < rows[0].row.size(); col++) {
+            long lower = 0, upper = 0;
+            for (size_t i = 0; i < rows.size(); i++) {
+                if (rows[i].row[col] > 0) { lower++; }
+                if (rows[i].row[col] < 0) { upper++; }
+            }
+            if (lower + upper == 0) { continue; }
+            long cost = lower*upper - lower - upper;
+            if (best == 0 || cost < bestCost) {
+                best = col;
+                bestCost = cost;
+            }
+        }
+        if (best == 0) { return true; }
+        if (rows.size() + bestCost > kMaxFeasibilityRows) { return true; }
+
+        std::vector<RationalRow> lower, upper, rest;
+        for (size_t i = 0; i < rows.size(); i++) {
+            if (rows[i].row[best] > 0) { lower.push_back(rows[i]); }
+            else if (rows[i].row[best] < 0) { upper.push_back(rows[i]); }
+            else { rest.push_back(rows[i]); }
+        }
+        for (size_t l = 0; l < lower.size(); l++) {
+            for (size_t u = 0; u < upper.size(); u++) {
+                Row row = combine(-upper[u].row[best], lower[l].row,
+                                  lower[l].row[best], upper[u].row);
+                if (!fits(row)) { return true; }
+                rest.push_back(RationalRow(row,
+                                   lower[l].strict || upper[u].strict));
+            }
+        }
+        rows.swap(rest);
+    }
+}
+
+/******************************* clean up **********************************/
+
+// Numbers the rows of sys, equalities first, so that rows that share a
+// column, directly or through other rows, get the same number. Whether
+// a row is implied or an implicit equality only depends on the rows of
+// its component, as long as the others have a solution.
+std::vector<int> rowComponents(const AffineSystem& sys) {
+    std::vector<int> components;
+    if (sys.size() == 0) { return components; }
+    size_t numCols = sys.equalities.empty() ? sys.inequalities[0].size()
+                                            : sys.equalities[0].size();
+    OA::UnionFindUniverse columns(numCols);
+    std::vector<size_t> firstCol;
+    for (int kind = 0; kind < 2; kind++) {
+        const std::vector<Row>& rows = kind ? sys.inequalities
+                                            : sys.equalities;
+        for (size_t i = 0; i < rows.size(); i++) {
+            size_t first = 0;
+            for (size_t col = 1; col < numCols; col++) {
+                if (rows[i][col] == 0) { continue; }
+                if (first == 0) {
+                    first = col;
+                } else {
+                    columns.Union(first, col);
+                }
+            }
+            firstCol.push_back(first);
+        }
+    }
+    for (size_t i = 0; i < firstCol.size(); i++) {
+        components.push_back(columns.Find(firstCol[i]));
+    }
+    return components;
+}
+
+// The equalities of sys in component comp, and its inequalities there as
+// non-strict rational rows, except for the inequality at index skip.
+void componentRows(const AffineSystem& sys,
+                   const std::vector<int>& components, size_t skip,
+                   std::vector<Row>* equalities,
+                   std::vector<RationalRow>* rows) {
+    size_t numEqs = sys.equalities.size();
+    int comp = components[numEqs + skip];
+    for (size_t e = 0; e < numEqs; e++) {
+        if (components[e] == comp) {
+            equalities->push_back(sys.equalities[e]);
+        }
+    }
+    for (size_t i = 0; i < sys.inequalities.size(); i++) {
+        if (i != skip && components[numEqs + i] == comp) {
+            rows->push_back(RationalRow(sys.inequalities[i], false));
+        }
+    }
+}
+
+// True if inequality i has a coefficient on a column that no equality
+// uses, and no other inequality has a coefficient of the same sign there
+// (sameSign) or of the opposite sign (!sameSign). From a point of a
+// feasible system, moving along that column can then violate i while
+// only loosening the other inequalities, so i is not redundant, or make
+// i hold strictly the same way, so i is not an implicit equality.
+bool movesFreely(const AffineSystem& sys, size_t i, bool sameSign) {
+    const Row& row = sys.inequalities[i];
+    for (size_t col = 1; col < row.size(); col++) {
+        if (row[col] == 0) { continue; }
+        bool free = true;
+        for (size_t e = 0; e < sys.equalities.size() && free; e++) {
+            free = sys.equalities[e][col] == 0;
+        }
+        for (size_t k = 0; k < sys.inequalities.size() && free; k++) {
+            Coeff c = sys.inequalities[k][col];
+            bool same = (c > 0) == (row[col] > 0);
+            free = k == i || c == 0 || same != sameSign;
+        }
+        if (free) { return true; }
+    }
+    return false;
+}
+
+// Turns every inequality that can only hold with equality into an
+// equality, the way isl detects implicit equalities. sys must be
+// feasible.
+void detectImplicitEqualities(AffineSystem& sys) {
+    // If all inequalities can hold strictly at once there are none.
+    std::vector<RationalRow> strict;
+    for (size_t i = 0; i < sys.inequalities.size(); i++) {
+        strict.push_back(RationalRow(sys.inequalities[i], true));
+    }
+    if (rationallyFeasible(sys.equalities, strict)) { return; }
+
+    // An implicit equality stays an inequality until all are found, that
+    // does not change the points the others are tested against.
+    std::vector<int> components = rowComponents(sys);
+    std::vector<bool> implicit(sys.inequalities.size(), false);
+    for (size_t i = 0; i < sys.inequalities.size(); i++) {
+        if (movesFreely(sys, i, false)) { continue; }
+        std::vector<Row> equalities;
+        std::vector<RationalRow> rows;
+        componentRows(sys, components, i, &equalities, &rows);
+        rows.push_back(RationalRow(sys.inequalities[i], true));
+        implicit[i] = !rationallyFeasible(equalities, rows);
+    }
+
+    std::vector<Row> inequalities;
+    for (size_t i = 0; i < sys.inequalities.size(); i++) {
+        if (implicit[i]) { sys.equalities.push_back(sys.inequalities[i]); }
+        else { inequalities.push_back(sys.inequalities[i]); }
+    }
+    sys.inequalities.swap(inequalities);
+}
+
+// Puts the equalities in reduced echelon form, pivoting on the last
+// column first like isl, and eliminates the pivot columns from the
+// inequalities.
+void gaussianElimination(AffineSystem& sys) {
+    std::vector<Row>& eqs = sys.equalities;
+    size_t last = eqs.empty() ? 0 : eqs[0].size() - 1;
+    for (size_t done = 0; done < eqs.size() && last > 0; done++, last--) {
+        size_t k = eqs.size();
+        for (; last > 0; last--) {
+            for (k = done; k < eqs.size() && eqs[k][last] == 0; k++) {}
+            if (k < eqs.size()) { break; }
+        }
+        if (last == 0) { break; }
+        std::swap(eqs[k], eqs[done]);
+        if (eqs[done][last] < 0) { eqs[done] = negated(eqs[done]); }
+        const Row pivot = eqs[done];
+
+        for (size_t i = 0; i < eqs.size(); ) {
+            if (i == done || eqs[i][last] == 0) { i++; continue; }
+            eqs[i] = combine(pivot[last], eqs[i], -eqs[i][last], pivot);
+            if (!fits(eqs[i])) { sys.overflow = true; return; }
+            rowstate state = normalizeRow(eqs[i], true);
+            if (state == Row_False) { sys.empty = true; return; }
+            if (state == Row_True) {
+                // Only rows after done can vanish, the others have a
+                // pivot of their own.
+                eqs.erase(eqs.begin() + i);
+                continue;
+            }
+            i++;
+        }
+        for (size_t i = 0; i < sys.inequalities.size(); i++) {
+            Row& row = sys.inequalities[i];
+            if (row[last] == 0) { continue; }
+            row = combine(pivot[last], row, -row[last], pivot);
+            if (!fits(row)) { sys.overflow = true; return; }
+        }
+    }
+}
+
+// Drops the inequalities that the remaining constraints imply, one at a
+// time. sys must be feasible.
+void removeRedundancies(AffineSystem& sys) {
+    std::vector<int> components = rowComponents(sys);
+    for (size_t i = 0; i < sys.inequalities.size(); ) {
+        if (movesFreely(sys, i, true)) { i++; continue; }
+        std::vector<Row> equalities;
+        std::vector<RationalRow> rows;
+        componentRows(sys, components, i, &equalities, &rows);
+        rows.push_back(RationalRow(negated(sys.inequalities[i]), true));
+        if (rationallyFeasible(equalities, rows)) {
+            i++;
+        } else {
+            sys.inequalities.erase(sys.inequalities.begin() + i);
+            components.erase(components.begin()
+                             + sys.equalities.size() + i);
+        }
+    }
+}
+
+// Leaves the projected system in the form isl gives it.
+void cleanUp(AffineSystem& sys) {
+    std::vector<RationalRow> rows;
+    for (size_t i = 0; i < sys.inequalities.size(); i++) {
+        rows.push_back(RationalRow(sys.inequalities[i], false));
+    }
+    if (!rationallyFeasible(sys.equalities, rows)) {
+        sys.empty = true;
+        return;
+    }
+    detectImplicitEqualities(sys);
+    pruneSystem(sys);
+    if (sys.empty) { return; }
+    gaussianElimination(sys);
+    if (sys.empty || sys.overflow) { return; }
+    pruneSystem(sys);
+    if (sys.empty) { return; }
+    removeRedundancies(sys);
+}
+
+}
+
+/****************************** fmProjectOut *******************************/
+
+ProjectionPath fmProjectOut(const Conjunction& conj,
+                            const std::set<int>& tvars,
+                            Conjunction** result) {
+    TupleDecl tdecl = conj.getTupleDecl();
+    int arity = tdecl.size();
+
+    // Tuple variable names, symbolic constants with them are the same
+    // variable.
+    std::map<unsigned int, int> tupleLocs;
+    for (int i = 0; i < arity; i++) {
+        if (tdecl.elemIsConst(i)) { return Projection_NotAffine; }
+        if (!tupleLocs.insert(std::make_pair(
+                Symbol(tdecl.elemVarString(i)).id(), i)).second) {
+            return Projection_NotAffine;
+        }
+    }
+
+    CompactTermTable table;
+    CompactConjunction compact(conj, table);
+    if (compact.numConstraints() > kFMMaxConstraints) {
+        return Projection_TooLarge;
+    }
+
+    // Symbolic constants get the columns before the tuple variables, in
+    // name order.
+    std::map<std::string, unsigned int> symbols;
+    for (unsigned int c = 0; c < compact.numConstraints(); c++) {
+        for (const CompactTerm* t = compact.begin(c);
+                t != compact.end(c); t++) {
+            if (t->hasFactor()) { return Projection_NotAffine; }
+            if (t->isSymConst() && !tupleLocs.count(t->payload)) {
+                symbols[Symbol::fromId(t->payload).str()] = t->payload;
+            }
+        }
+    }
+    std::map<unsigned int, size_t> symbolCols;
+    std::vector<Symbol> colSymbols;
+    for (std::map<std::string, unsigned int>::const_iterator
+            i = symbols.begin(); i != symbols.end(); i++) {
+        symbolCols[i->second] = 1 + colSymbols.size();
+        colSymbols.push_back(Symbol::fromId(i->second));
+    }
+    size_t firstTupleCol = 1 + colSymbols.size();
+
+    AffineSystem sys;
+    for (unsigned int c = 0; c < compact.numConstraints(); c++) {
+        Row row(firstTupleCol + arity, 0);
+        for (const CompactTerm* t = compact.begin(c);
+                t != compact.end(c); t++) {
+            if (t->isConst()) {
+                row[0] += t->coeff;
+            } else if (t->isTupleVar()) {
+                row[firstTupleCol + t->payload] += t->coeff;
+            } else if (tupleLocs.count(t->payload)) {
+                row[firstTupleCol + tupleLocs[t->payload]] += t->coeff;
+            } else {
+                row[symbolCols[t->payload]] += t->coeff;
+            }
+        }
+        if (!fits(row)) { return Projection_TooLarge; }
+        if (compact.isEquality(c)) { sys.equalities.push_back(row); }
+        else { sys.inequalities.push_back(row); }
+    }
+
+    std::vector<size_t> cols;
+    for (std::set<int>::const_iterator i = tvars.begin();
+            i != tvars.end(); i++) {
+        cols.push_back(firstTupleCol + *i);
+    }
+
+    pruneSystem(sys);
+    while (!cols.empty() && !sys.empty) {
+        // Substitute an equality with a unit coefficient if there is one.
+        bool substituted = false;
+        for (size_t c = 0; c < cols.size() && !substituted; c++) {
+            for (size_t e = 0; e < sys.equalities.size(); e++) {
+                if (absCoeff(sys.equalities[e][cols[c]]) == 1) {
+                    substituteEquality(sys, e, cols[c]);
+                    cols.erase(cols.begin() + c);
+                    substituted = true;
+                    break;
+                }
+            }
+        }
+
+        if (!substituted) {
+            // Otherwise the cheapest exact Fourier-Motzkin step.
+            size_t best = cols.size();
+            int bestCost = 0;
+            for (size_t c = 0; c < cols.size(); c++) {
+                bool inEquality = false;
+                for (size_t e = 0; e < sys.equalities.size(); e++) {
+                    inEquality = inEquality || sys.equalities[e][cols[c]];
+                }
+                int cost;
+                if (inEquality || !exactShadow(sys, cols[c], &cost)) {
+                    continue;
+                }
+                if (best == cols.size() || cost < bestCost) {
+                    best = c;
+                    bestCost = cost;
+                }
+            }
+            if (best == cols.size()) { return Projection_NonUnit; }
+            fourierMotzkin(sys, cols[best]);
+            cols.erase(cols.begin() + best);
+        }
+
+        if (sys.overflow) { return Projection_TooLarge; }
+        pruneSystem(sys);
+        if (sys.size() > kFMMaxConstraints) { return Projection_TooLarge; }
+    }
+
+    if (!sys.empty) { cleanUp(sys); }
+    if (sys.overflow) { return Projection_TooLarge; }
+    if (sys.empty) {
+        *result = NULL;
+        return Projection_Native;
+    }
+
+    TupleDecl projTupleDecl(arity - tvars.size());
+    std::vector<int> newLoc(arity, -1);
+    for (int i = 0, j = 0; i < arity; i++) {
+        if (tvars.count(i)) { continue; }
+        newLoc[i] = j;
+        projTupleDecl.copyTupleElem(tdecl, i, j++);
+    }
+
+    Conjunction* projected = new Conjunction(projTupleDecl);
+    for (int kind = 0; kind < 2; kind++) {
+        const std::vector<Row>& rows = kind ? sys.inequalities
+                                            : sys.equalities;
+        for (size_t r = 0; r < rows.size(); r++) {
+            const Row& row = rows[r];
+            Exp* e = new Exp();
+            if (row[0] != 0) { e->addTerm(new Term(int(row[0]))); }
+            for (size_t col = 1; col < firstTupleCol; col++) {
+                if (row[col] == 0) { continue; }
+                e->addTerm(new VarTerm(int(row[col]), colSymbols[col-1]));
+            }
+            for (int loc = 0; loc < arity; loc++) {
+                if (row[firstTupleCol + loc] == 0) { continue; }
+                e->addTerm(new TupleVarTerm(int(row[firstTupleCol + loc]),
+                                            newLoc[loc]));
+            }
+            if (kind) { projected->addInequality(e); }
+            else { projected->addEquality(e); }
+        }
+    }
+    *result = projected;
+    return Projection_Native;
+}
+
+const char* projectionPathName(ProjectionPath path) {
+    switch (path) {
+        case Projection_Native:    return "native";
+        case Projection_NotAffine: return "not affine";
+        case Projection_NonUnit:   return "non-unit";
+        case Projection_TooLarge:  return "too large";
+    }
+    return "unknown";
+}
+
+}// iegenlib namespace
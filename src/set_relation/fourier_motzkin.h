@@ -0,0 +1,80 @@
+/*!
+ * \file fourier_motzkin.h
+ *
+ * \brief Exact projection of tuple variables out of affine conjunctions,
+ *        without going through isl.
+ *
+ * Most conjunctions that projectOut and simplifyForPartialParallel hand to
+ * isl are small, and converting them to isl and back costs more than the
+ * projection itself. fmProjectOut eliminates the tuple variables here:
+ * first by substituting equalities in which they have a coefficient of 1
+ * or -1, then by Fourier-Motzkin elimination when their lower or their
+ * upper bounds all have a coefficient of 1, which keeps the projection
+ * exact over the integers. What is left goes through the same clean up
+ * isl gives a projection: implicit equalities become equalities, the
+ * equalities are put in reduced echelon form and substituted into the
+ * inequalities, and redundant inequalities are dropped.
+ *
+ *   Conjunction* projected;
+ *   if (fmProjectOut(*conj, tvars, &projected) == Projection_Native) {
+ *       // projected is the result, or NULL if there are no points
+ *   } else {
+ *       // project through isl
+ *   }
+ *
+ * Anything else, a non-unit coefficient, a UF call, too many constraints,
+ * is left to isl.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#ifndef FOURIER_MOTZKIN_H_
+#define FOURIER_MOTZKIN_H_
+
+#include <set>
+
+namespace iegenlib{
+
+class Conjunction;
+
+//! How fmProjectOut handled a conjunction.
+typedef enum {
+    //! Projected here.
+    Projection_Native,
+    //! A UF call or tuple expression, or a constant or repeated name in
+    //! the tuple declaration.
+    Projection_NotAffine,
+    //! A variable to project only had non-unit coefficients to eliminate
+    //! it with.
+    Projection_NonUnit,
+    //! Elimination made more than kFMMaxConstraints constraints, or
+    //! coefficients that do not fit.
+    Projection_TooLarge
+} ProjectionPath;
+
+//! Most constraints fmProjectOut works with before leaving the
+//! projection to isl.
+const unsigned int kFMMaxConstraints = 64;
+
+/*! Projects the tuple variables at the locations in tvars out of conj.
+**
+**  \param result set to a new Conjunction over the remaining tuple
+**         variables, or NULL if conj has no integer points, when the
+**         return value is Projection_Native. Untouched otherwise.
+**         Caller owns it.
+**  \return Projection_Native, or why the projection is left to isl.
+*/
+ProjectionPath fmProjectOut(const Conjunction& conj,
+                            const std::set<int>& tvars,
+                            Conjunction** result);
+
+//! Name of a ProjectionPath, for reports.
+const char* projectionPathName(ProjectionPath path);
+
+}// iegenlib namespace
+
+#endif
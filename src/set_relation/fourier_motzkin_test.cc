@@ -0,0 +1,137 @@
+/*!
+ * \file fourier_motzkin_test.cc
+ *
+ * \brief Tests for projecting tuple variables out of affine conjunctions
+ *        without isl.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "fourier_motzkin.h"
+#include "set_relation.h"
+
+#include <gtest/gtest.h>
+#include <string>
+
+using iegenlib::Conjunction;
+using iegenlib::Set;
+using iegenlib::fmProjectOut;
+using iegenlib::ProjectionPath;
+
+// Projects tvars out of the only conjunction of s natively.
+static ProjectionPath projectNatively(const Set* s,
+                                      const std::set<int>& tvars,
+                                      Conjunction** projected) {
+    return fmProjectOut(**s->conjunctionBegin(), tvars, projected);
+}
+
+#pragma mark FourierMotzkinSameAsISL
+// Projections done natively come out the same as isl's.
+TEST(FourierMotzkinTest, SameAsISL) {
+    const char* sets[] = {
+        // equality substitution
+        "[n] -> {[i,j,k] : k = i + 1 && 0 <= i && i < j && j < n}",
+        // Fourier-Motzkin, with the bounds on i left redundant
+        "[n] -> {[i,j] : 0 <= i && i < j && j < n && i < n}",
+        // an implicit equality and symbolic constants
+        "[n,m] -> {[i,j,k] : i <= j && j <= i && k <= m && m <= k"
+        " && 0 <= j && j + k < n}",
+        // non-unit coefficients, but unit on one side
+        "[n] -> {[i,j,k] : 0 <= i && 2i <= j && j <= k && 3k <= n}",
+    };
+    int positions[][2] = { {1, 2}, {1, -1}, {0, 2}, {1, 2} };
+
+    for (int t = 0; t < 4; t++) {
+        Set* s = new Set(sets[t]);
+        std::set<int> tvars;
+        for (int p = 0; p < 2; p++) {
+            if (positions[t][p] >= 0) { tvars.insert(positions[t][p]); }
+        }
+
+        Conjunction* native = NULL;
+        EXPECT_EQ( iegenlib::Projection_Native,
+                   projectNatively(s, tvars, &native) ) << sets[t];
+        Set* isl = iegenlib::islSetProjectOut(s, tvars);
+        ASSERT_TRUE( native != NULL );
+        EXPECT_EQ( (*isl->conjunctionBegin())->toString(),
+                   native->toString() ) << sets[t];
+
+        delete s;
+        delete native;
+        delete isl;
+    }
+}
+
+#pragma mark FourierMotzkinEmpty
+// Conjunctions without integer points project to nothing.
+TEST(FourierMotzkinTest, Empty) {
+    Set* s = new Set("[n] -> {[i,j,k] : i < j && j < k && k < i}");
+    std::set<int> tvars;
+    tvars.insert(1);
+    // Not NULL, to see that it is set.
+    Conjunction notSet(3);
+    Conjunction* native = &notSet;
+    EXPECT_EQ( iegenlib::Projection_Native,
+               projectNatively(s, tvars, &native) );
+    EXPECT_TRUE( native == NULL );
+    delete s;
+
+    // No integer j with 2j = i + 1 and i = 2k.
+    s = new Set("{[i,j,k] : 2j = i + 1 && i = 2k}");
+    tvars.clear();
+    tvars.insert(0);
+    native = &notSet;
+    EXPECT_EQ( iegenlib::Projection_Native,
+               projectNatively(s, tvars, &native) );
+    EXPECT_TRUE( native == NULL );
+    delete s;
+}
+
+#pragma mark FourierMotzkinLeftToISL
+// Projections that would not be exact, or that involve UF calls, are
+// left to isl.
+TEST(FourierMotzkinTest, LeftToISL) {
+    std::set<int> tvars;
+    tvars.insert(1);
+    Conjunction* native = NULL;
+
+    // i = 2j only keeps the even i
+    Set* s = new Set("[n] -> {[i,j] : i = 2j && 0 <= j && j < n}");
+    EXPECT_EQ( iegenlib::Projection_NonUnit,
+               projectNatively(s, tvars, &native) );
+    delete s;
+
+    // 2j <= i + n && i <= 3j, the shadow has holes
+    s = new Set("[n] -> {[i,j] : 2j <= i + n && i <= 3j}");
+    EXPECT_EQ( iegenlib::Projection_NonUnit,
+               projectNatively(s, tvars, &native) );
+    delete s;
+
+    s = new Set("[n] -> {[i,j] : f(j) < i && 0 <= j && j < n}");
+    EXPECT_EQ( iegenlib::Projection_NotAffine,
+               projectNatively(s, tvars, &native) );
+    delete s;
+
+    s = new Set("{[i,0,j] : 0 <= i && i < j}");
+    EXPECT_EQ( iegenlib::Projection_NotAffine,
+               projectNatively(s, tvars, &native) );
+    delete s;
+
+    // One lower and one upper bound on j for each of 10 symbols, the
+    // elimination of j makes 100 constraints.
+    std::string str = "{[i,j] : ";
+    for (int k = 0; k < 10; k++) {
+        std::string n = "n" + std::to_string(k);
+        str += (k ? " && " : "") + n + " <= j && j <= i + " + n;
+    }
+    s = new Set(str + "}");
+    EXPECT_EQ( iegenlib::Projection_TooLarge,
+               projectNatively(s, tvars, &native) );
+    delete s;
+
+    EXPECT_TRUE( native == NULL );
+}
@@ -0,0 +1,192 @@
+/*!
+ * \file interned_expression.cc
+ *
+ * \brief Implementation of the hash-consed Term and Exp nodes.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "interned_expression.h"
+#include "expression.h"
+
+namespace iegenlib{
+
+/********************************* InternedTerm ******************************/
+
+Term* InternedTerm::toTerm() const {
+    switch (mKind) {
+    case TupleVar:
+        return new TupleVarTerm(mCoeff, mValue);
+    case SymConst:
+        return new VarTerm(mCoeff, mName);
+    case UFCall: {
+        UFCallTerm* call = new UFCallTerm(mCoeff, mName, mArgs.size(),
+                                          mValue);
+        for (unsigned int i = 0; i < mArgs.size(); i++) {
+            call->setParamExp(i, mArgs[i]->toExp());
+        }
+        return call;
+    }
+    case TupleExp: {
+        TupleExpTerm* tuple = new TupleExpTerm(mCoeff, mArgs.size());
+        for (unsigned int i = 0; i < mArgs.size(); i++) {
+            if (mArgs[i]) { tuple->setExpElem(i, mArgs[i]->toExp()); }
+        }
+        return tuple;
+    }
+    default:
+        return new Term(mCoeff);
+    }
+}
+
+std::string InternedTerm::toString() const {
+    Term* t = toTerm();
+    std::string str = t->toString();
+    delete t;
+    return str;
+}
+
+/********************************* InternedExp *******************************/
+
+Exp* InternedExp::toExp() const {
+    Exp* e = new Exp();
+    if (mKind == Equality) { e->setEquality(); }
+    else if (mKind == Inequality) { e->setInequality(); }
+    for (unsigned int i = 0; i < mTerms.size(); i++) {
+        e->addTerm(mTerms[i]->toTerm());
+    }
+    return e;
+}
+
+std::string InternedExp::toString() const {
+    Exp* e = toExp();
+    std::string str = e->toString();
+    delete e;
+    return str;
+}
+
+/********************************* InternContext *****************************/
+
+// Children are unique nodes, so two nodes are equal exactly when their
+// fields are equal and their children are the same pointers.
+bool InternContext::TermEqual::operator()(const InternedTerm* a,
+                                          const InternedTerm* b) const {
+    return a->mKind == b->mKind && a->mCoeff == b->mCoeff
+        && a->mValue == b->mValue && a->mName == b->mName
+        && a->mArgs == b->mArgs;
+}
+
+bool InternContext::ExpEqual::operator()(const InternedExp* a,
+                                         const InternedExp* b) const {
+    return a->mKind == b->mKind && a->mTerms == b->mTerms;
+}
+
+InternContext::~InternContext() {
+    clear();
+}
+
+const InternedTerm* InternContext::intern(const Term& t) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return internTerm(t);
+}
+
+const InternedExp* InternContext::intern(const Exp& e) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return internExp(&e);
+}
+
+unsigned int InternContext::size() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mTerms.size() + mExps.size();
+}
+
+unsigned long InternContext::hits() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mHits;
+}
+
+void InternContext::clear() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto it = mTerms.begin(); it != mTerms.end(); ++it) { delete *it; }
+    for (auto it = mExps.begin(); it != mExps.end(); ++it) { delete *it; }
+    mTerms.clear();
+    mExps.clear();
+    mHits = 0;
+}
+
+// Builds the candidate node on the stack and only allocates when it is not
+// in the table yet. Callers hold mMutex.
+const InternedTerm* InternContext::internTerm(const Term& t) {
+    InternedTerm node;
+    node.mCoeff = t.coefficient();
+    if (const UFCallTerm* call = dynamic_cast<const UFCallTerm*>(&t)) {
+        node.mKind = InternedTerm::UFCall;
+        node.mName = call->name();
+        node.mValue = call->isIndexed() ? call->tupleIndex() : -1;
+        for (unsigned int i = 0; i < call->numArgs(); i++) {
+            node.mArgs.push_back(internExp(call->getParamExp(i)));
+        }
+    } else if (const TupleVarTerm* tv = dynamic_cast<const TupleVarTerm*>(&t)) {
+        node.mKind = InternedTerm::TupleVar;
+        node.mValue = tv->tvloc();
+    } else if (const VarTerm* var = dynamic_cast<const VarTerm*>(&t)) {
+        node.mKind = InternedTerm::SymConst;
+        node.mName = var->symbol();
+    } else if (const TupleExpTerm* tuple
+                   = dynamic_cast<const TupleExpTerm*>(&t)) {
+        node.mKind = InternedTerm::TupleExp;
+        for (unsigned int i = 0; i < tuple->size(); i++) {
+            node.mArgs.push_back(internExp(tuple->getExpElem(i)));
+        }
+    }
+
+    std::size_t seed = node.mKind;
+    hashCombine(seed, std::hash<int>()(node.mCoeff));
+    hashCombine(seed, std::hash<int>()(node.mValue));
+    hashCombine(seed, std::hash<std::string>()(node.mName));
+    for (unsigned int i = 0; i < node.mArgs.size(); i++) {
+        hashCombine(seed, std::hash<const void*>()(node.mArgs[i]));
+    }
+    node.mHash = seed;
+
+    auto found = mTerms.find(&node);
+    if (found != mTerms.end()) {
+        mHits++;
+        return *found;
+    }
+    InternedTerm* unique = new InternedTerm(node);
+    mTerms.insert(unique);
+    return unique;
+}
+
+const InternedExp* InternContext::internExp(const Exp* e) {
+    if (e == NULL) { return NULL; }
+
+    InternedExp node;
+    if (e->isEquality()) { node.mKind = InternedExp::Equality; }
+    else if (e->isInequality()) { node.mKind = InternedExp::Inequality; }
+    std::list<Term*> terms = e->getTermList();
+    std::size_t seed = node.mKind;
+    for (std::list<Term*>::const_iterator it = terms.begin();
+         it != terms.end(); ++it) {
+        const InternedTerm* term = internTerm(**it);
+        node.mTerms.push_back(term);
+        hashCombine(seed, std::hash<const void*>()(term));
+    }
+    node.mHash = seed;
+
+    auto found = mExps.find(&node);
+    if (found != mExps.end()) {
+        mHits++;
+        return *found;
+    }
+    InternedExp* unique = new InternedExp(node);
+    mExps.insert(unique);
+    return unique;
+}
+
+}// iegenlib namespace
@@ -0,0 +1,184 @@
+/*!
+ * \file interned_expression.h
+ *
+ * \brief Hash-consed, immutable form of Terms and Exps.
+ *
+ * The mutable Term and Exp classes deep copy their subterms, so the same
+ * rowPtr(i) or col(k) is cloned again for every constraint it shows up
+ * in. An InternContext keeps one immutable node per distinct term and
+ * expression. Arguments of UF calls are interned too, so structurally
+ * equal nodes are the same pointer: equality is pointer comparison and
+ * copying is copying a pointer.
+ *
+ * Nodes are owned by their context and live until it is destroyed or
+ * cleared. There is no reference count per node, so a context only grows:
+ * give each operation its own context, the way each operation leases its
+ * own isl context, rather than keeping one for the whole run. Nothing in
+ * the library interns yet. Code that works on the mutable classes
+ * converts at operation boundaries:
+ *
+ *   InternContext ctx;
+ *   const InternedExp* e = ctx.intern(*exp);   // mutable -> interned
+ *   ...
+ *   Exp* copy = e->toExp();                     // interned -> mutable
+ *
+ * Contexts are safe to share between threads.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#ifndef INTERNED_EXPRESSION_H_
+#define INTERNED_EXPRESSION_H_
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <mutex>
+
+namespace iegenlib{
+
+class Term;
+class Exp;
+class InternedExp;
+class InternContext;
+
+/*!
+ * \class InternedTerm
+ *
+ * \brief Immutable counterpart of Term and its subclasses.
+ */
+class InternedTerm {
+public:
+    typedef enum {ConstVal, TupleVar, SymConst, UFCall, TupleExp} termkind;
+
+    termkind kind() const { return mKind; }
+    int coefficient() const { return mCoeff; }
+
+    //! Tuple location of a TupleVar term.
+    int location() const { return mValue; }
+
+    //! Tuple index of a UFCall term, -1 if it is not indexed.
+    int tupleIndex() const { return mValue; }
+
+    //! Symbol of a SymConst term or function name of a UFCall term.
+    const std::string& name() const { return mName; }
+
+    //! Number of arguments of a UFCall term or elements of a TupleExp term.
+    unsigned int numArgs() const { return mArgs.size(); }
+
+    //! Argument i of a UFCall term or element i of a TupleExp term.
+    const InternedExp* arg(unsigned int i) const { return mArgs[i]; }
+
+    std::size_t hash() const { return mHash; }
+
+    //! Returns a new mutable Term equal to this one, caller owns it.
+    Term* toTerm() const;
+
+    std::string toString() const;
+
+private:
+    friend class InternContext;
+    InternedTerm() : mKind(ConstVal), mCoeff(0), mValue(0), mHash(0) {}
+
+    termkind mKind;
+    int mCoeff;
+    int mValue;
+    std::string mName;
+    std::vector<const InternedExp*> mArgs;
+    std::size_t mHash;
+};
+
+/*!
+ * \class InternedExp
+ *
+ * \brief Immutable counterpart of Exp. Terms are kept in the order of the
+ *        Exp they were interned from.
+ */
+class InternedExp {
+public:
+    typedef enum {Expression, Inequality, Equality} expkind;
+
+    expkind kind() const { return mKind; }
+    bool isExpression() const { return mKind == Expression; }
+    bool isInequality() const { return mKind == Inequality; }
+    bool isEquality() const { return mKind == Equality; }
+
+    unsigned int numTerms() const { return mTerms.size(); }
+    const InternedTerm* term(unsigned int i) const { return mTerms[i]; }
+
+    std::size_t hash() const { return mHash; }
+
+    //! Returns a new mutable Exp equal to this one, caller owns it.
+    Exp* toExp() const;
+
+    std::string toString() const;
+
+private:
+    friend class InternContext;
+    InternedExp() : mKind(Expression), mHash(0) {}
+
+    expkind mKind;
+    std::vector<const InternedTerm*> mTerms;
+    std::size_t mHash;
+};
+
+/*!
+ * \class InternContext
+ *
+ * \brief Table of unique InternedTerm and InternedExp nodes.
+ */
+class InternContext {
+public:
+    InternContext() : mHits(0) {}
+    ~InternContext();
+
+    //! Returns the unique node equal to t. Throws if t is a UF call with
+    //! arguments that have not been set.
+    const InternedTerm* intern(const Term& t);
+
+    //! Returns the unique node equal to e.
+    const InternedExp* intern(const Exp& e);
+
+    //! Number of distinct terms and expressions in the table.
+    unsigned int size() const;
+
+    //! Number of intern calls, including those for subexpressions,
+    //! answered by a node that already existed.
+    unsigned long hits() const;
+
+    /*! Deletes every node. Pointers previously handed out by this
+    **  context must not be used afterwards.
+    */
+    void clear();
+
+private:
+    InternContext(const InternContext&);
+    InternContext& operator=(const InternContext&);
+
+    const InternedTerm* internTerm(const Term& t);
+    const InternedExp* internExp(const Exp* e);
+
+    struct NodeHash {
+        template <typename T>
+        std::size_t operator()(const T* n) const { return n->hash(); }
+    };
+    struct TermEqual {
+        bool operator()(const InternedTerm* a, const InternedTerm* b) const;
+    };
+    struct ExpEqual {
+        bool operator()(const InternedExp* a, const InternedExp* b) const;
+    };
+
+    mutable std::mutex mMutex;
+    std::unordered_set<const InternedTerm*, NodeHash, TermEqual> mTerms;
+    std::unordered_set<const InternedExp*, NodeHash, ExpEqual> mExps;
+    unsigned long mHits;
+};
+
+}// iegenlib namespace
+
+#endif
@@ -0,0 +1,154 @@
+/*!
+ * \file interned_expression_test.cc
+ *
+ * \brief Tests for the hash-consed Term and Exp nodes.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "interned_expression.h"
+#include "expression.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+using iegenlib::Term;
+using iegenlib::TupleVarTerm;
+using iegenlib::VarTerm;
+using iegenlib::UFCallTerm;
+using iegenlib::TupleExpTerm;
+using iegenlib::Exp;
+using iegenlib::InternContext;
+using iegenlib::InternedTerm;
+using iegenlib::InternedExp;
+
+namespace {
+
+//! Returns a new rowPtr(__tv0 + offset).
+UFCallTerm* rowPtr(int offset) {
+    UFCallTerm* call = new UFCallTerm("rowPtr", 1);
+    Exp* arg = new Exp();
+    arg->addTerm(new TupleVarTerm(0));
+    if (offset) { arg->addTerm(new Term(offset)); }
+    call->setParamExp(0, arg);
+    return call;
+}
+
+//! Returns a new inequality rowPtr(__tv0 + 1) - rowPtr(__tv0) + c >= 0.
+Exp* rowPtrIneq(int c) {
+    Exp* e = new Exp();
+    e->setInequality();
+    e->addTerm(rowPtr(1));
+    UFCallTerm* lower = rowPtr(0);
+    lower->setCoefficient(-1);
+    e->addTerm(lower);
+    e->addTerm(new Term(c));
+    return e;
+}
+
+}
+
+#pragma mark InternedExpressionUnique
+// Equal expressions, and equal subexpressions, are the same node.
+TEST(InternedExpressionTest, Unique) {
+    InternContext ctx;
+    Exp* e1 = rowPtrIneq(-1);
+    Exp* e2 = rowPtrIneq(-1);
+    Exp* e3 = rowPtrIneq(1);
+
+    const InternedExp* i1 = ctx.intern(*e1);
+    const InternedExp* i2 = ctx.intern(*e2);
+    const InternedExp* i3 = ctx.intern(*e3);
+    EXPECT_EQ( i1, i2 );
+    EXPECT_NE( i1, i3 );
+    EXPECT_TRUE( i1->isInequality() );
+
+    // Both expressions share their rowPtr calls.
+    ASSERT_EQ( 3u, i1->numTerms() );
+    ASSERT_EQ( 3u, i3->numTerms() );
+    EXPECT_EQ( i1->term(0), i3->term(0) );
+    EXPECT_EQ( i1->term(1), i3->term(1) );
+    EXPECT_NE( i1->term(2), i3->term(2) );
+    EXPECT_EQ( InternedTerm::UFCall, i1->term(0)->kind() );
+    EXPECT_EQ( "rowPtr", i1->term(0)->name() );
+
+    // The same expression as an equality is a different node.
+    Exp* eq = rowPtrIneq(-1);
+    eq->setEquality();
+    EXPECT_NE( i1, ctx.intern(*eq) );
+
+    // rowPtr(__tv0 + 1), rowPtr(__tv0), their arguments, the tuple
+    // variable and the constants are stored once.
+    unsigned int size = ctx.size();
+    Exp* e4 = rowPtrIneq(-1);
+    ctx.intern(*e4);
+    EXPECT_EQ( size, ctx.size() );
+    EXPECT_LT( 0u, ctx.hits() );
+
+    delete e1;
+    delete e2;
+    delete e3;
+    delete e4;
+    delete eq;
+}
+
+#pragma mark InternedExpressionRoundTrip
+// Converting back gives an expression equal to the original.
+TEST(InternedExpressionTest, RoundTrip) {
+    InternContext ctx;
+    Exp* e = rowPtrIneq(-1);
+    e->addTerm(new VarTerm(2, "N"));
+    TupleExpTerm* tuple = new TupleExpTerm(2);
+    Exp* first = new Exp();
+    first->addTerm(new TupleVarTerm(1));
+    tuple->setExpElem(0, first);
+    Exp* second = new Exp();
+    second->addTerm(rowPtr(0));
+    tuple->setExpElem(1, second);
+    e->addTerm(tuple);
+
+    const InternedExp* interned = ctx.intern(*e);
+    Exp* back = interned->toExp();
+    EXPECT_EQ( *e, *back );
+    EXPECT_TRUE( back->isInequality() );
+    EXPECT_EQ( e->toString(), interned->toString() );
+
+    UFCallTerm* call = rowPtr(1);
+    const InternedTerm* term = ctx.intern(*call);
+    Term* t = term->toTerm();
+    EXPECT_EQ( "rowPtr(__tv0 + 1)", t->toString() );
+    // 2 N - rowPtr(__tv0) + rowPtr(__tv0 + 1) - 1 + ( __tv1, rowPtr(__tv0) )
+    EXPECT_EQ( interned->term(2), term );
+
+    delete e;
+    delete back;
+    delete call;
+    delete t;
+}
+
+#pragma mark InternedExpressionThreads
+// Threads interning the same expressions get the same nodes.
+TEST(InternedExpressionTest, Threads) {
+    InternContext ctx;
+    const InternedExp* found[4];
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.push_back(std::thread([&ctx, &found, t]() {
+            for (int i = 0; i < 50; i++) {
+                Exp* e = rowPtrIneq(i % 5);
+                const InternedExp* ie = ctx.intern(*e);
+                if (i == 0) { found[t] = ie; }
+                delete e;
+            }
+        }));
+    }
+    for (unsigned int t = 0; t < threads.size(); t++) { threads[t].join(); }
+    for (int t = 1; t < 4; t++) { EXPECT_EQ( found[0], found[t] ); }
+
+    ctx.clear();
+    EXPECT_EQ( 0u, ctx.size() );
+}
@@ -0,0 +1,458 @@
+/*!
+ * \file isl_bridge.cc
+ *
+ * \brief Direct conversion between affine Sets/Relations and isl objects.
+ *
+ * \date Started: 2026-10-16
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "isl_bridge.h"
+
+#include <isl/constraint.h>
+#include <isl/local_space.h>
+#include <isl/space.h>
+#include <isl/val.h>
+
+namespace iegenlib{
+
+/************************ Set/Relation -> isl ****************************/
+
+// Returns true if e only has tuple variable, symbolic constant and
+// constant terms.
+static bool isAffineExp(const Exp* e){
+    std::list<Term*> terms = e->getTermList();
+    for (std::list<Term*>::const_iterator i=terms.begin();
+            i != terms.end(); i++) {
+        if ((*i)->isUFCall() || (*i)->isTupleExp()) { return false; }
+    }
+    return true;
+}
+
+bool isAffineForISL(const SparseConstraints* sc){
+    for (ConstConjunctionIterator c=sc->conjunctionBegin();
+            c != sc->conjunctionEnd(); c++) {
+        for (std::list<Exp*>::const_iterator i=(*c)->equalities().begin();
+                i != (*c)->equalities().end(); i++) {
+            if (!isAffineExp(*i)) { return false; }
+        }
+        for (std::list<Exp*>::const_iterator i=(*c)->inequalities().begin();
+                i != (*c)->inequalities().end(); i++) {
+            if (!isAffineExp(*i)) { return false; }
+        }
+    }
+    return true;
+}
+
+// Maps the tuple variable names of conj to their first location.
+// A symbolic constant that has the same name as a tuple variable reads
+// as that tuple variable once printed, so we treat it the same way.
+static std::map<std::string,int> tupleVarPositions(const Conjunction* conj){
+    std::map<std::string,int> tuplePos;
+    TupleDecl tdecl = conj->getTupleDecl();
+    for (unsigned int i=0; i<tdecl.size(); i++) {
+        if (!tdecl.elemIsConst(i) &&
+            tuplePos.find(tdecl.elemVarString(i)) == tuplePos.end()) {
+            tuplePos[tdecl.elemVarString(i)] = i;
+        }
+    }
+    return tuplePos;
+}
+
+// Sorted symbolic constants of sc, the order gives the isl parameter
+// positions.
+static std::vector<std::string> islParams(const SparseConstraints* sc){
+    std::set<std::string> syms;
+    for (ConstConjunctionIterator c=sc->conjunctionBegin();
+            c != sc->conjunctionEnd(); c++) {
+        std::map<std::string,int> tuplePos = tupleVarPositions(*c);
+        StringIterator* symIter = (*c)->getSymbolIterator();
+        while (symIter->hasNext()) {
+            std::string sym = symIter->next();
+            if (tuplePos.find(sym) == tuplePos.end()) { syms.insert(sym); }
+        }
+        delete symIter;
+    }
+    return std::vector<std::string>(syms.begin(), syms.end());
+}
+
+// Names the parameters and the variable tuple elements of space, so isl
+// prints the same names as toISLString would have used.
+static isl_space* nameISLSpace(isl_space* space,
+                               const std::vector<std::string>& params,
+                               const TupleDecl& tdecl, bool isSet,
+                               int inArity){
+    for (unsigned int i=0; i<params.size(); i++) {
+        space = isl_space_set_dim_name(space, isl_dim_param, i,
+                                       params[i].c_str());
+    }
+    for (unsigned int i=0; i<tdecl.size(); i++) {
+        if (tdecl.elemIsConst(i)) { continue; }
+        if (isSet) {
+            space = isl_space_set_dim_name(space, isl_dim_set, i,
+                                           tdecl.elemVarString(i).c_str());
+        } else if ((int)i < inArity) {
+            space = isl_space_set_dim_name(space, isl_dim_in, i,
+                                           tdecl.elemVarString(i).c_str());
+        } else {
+            space = isl_space_set_dim_name(space, isl_dim_out, i-inArity,
+                                           tdecl.elemVarString(i).c_str());
+        }
+    }
+    return space;
+}
+
+// Maps tuple location loc onto an isl dimension.
+static void islDimOf(int loc, bool isSet, int inArity,
+                     enum isl_dim_type* type, int* pos){
+    if (isSet) {
+        *type = isl_dim_set;  *pos = loc;
+    } else if (loc < inArity) {
+        *type = isl_dim_in;   *pos = loc;
+    } else {
+        *type = isl_dim_out;  *pos = loc - inArity;
+    }
+}
+
+// Builds the isl constraint for e (= 0 or >= 0) over local space ls.
+// ls is kept.
+static isl_constraint* islConstraintFromExp(const Exp* e, bool isEquality,
+                    isl_local_space* ls,
+                    const std::map<std::string,int>& paramPos,
+                    const std::map<std::string,int>& tuplePos,
+                    bool isSet, int inArity){
+    isl_constraint* c = isEquality ?
+                        isl_constraint_alloc_equality(
+                            isl_local_space_copy(ls)) :
+                        isl_constraint_alloc_inequality(
+                            isl_local_space_copy(ls));
+    std::list<Term*> terms = e->getTermList();
+    for (std::list<Term*>::const_iterator i=terms.begin();
+            i != terms.end(); i++) {
+        Term* t = *i;
+        if (t->isConst()) {
+            c = isl_constraint_set_constant_si(c, t->coefficient());
+        } else {
+            int loc;
+            VarTerm* vt = dynamic_cast<VarTerm*>(t);
+            if (vt && tuplePos.find(vt->symbol()) == tuplePos.end()) {
+                // Terms are combined, so this is the only term for vt.
+                c = isl_constraint_set_coefficient_si(c, isl_dim_param,
+                        paramPos.find(vt->symbol())->second,
+                        t->coefficient());
+                continue;
+            } else if (vt) {
+                loc = tuplePos.find(vt->symbol())->second;
+            } else {
+                loc = dynamic_cast<TupleVarTerm*>(t)->tvloc();
+            }
+            // A tuple variable can show up as both a TupleVarTerm and a
+            // VarTerm, so add to whatever coefficient it already has.
+            enum isl_dim_type type;
+            int pos;
+            islDimOf(loc, isSet, inArity, &type, &pos);
+            isl_val* v = isl_constraint_get_coefficient_val(c, type, pos);
+            v = isl_val_add(v, isl_val_int_from_si(
+                                   isl_constraint_get_ctx(c),
+                                   t->coefficient()));
+            c = isl_constraint_set_coefficient_val(c, type, pos, v);
+        }
+    }
+    return c;
+}
+
+// Collects the isl constraints for conjunction conj, including an
+// equality for every constant element in its tuple declaration.
+static std::vector<isl_constraint*> islConstraintsFromConjunction(
+                    const Conjunction* conj, isl_local_space* ls,
+                    const std::map<std::string,int>& paramPos,
+                    bool isSet, int inArity){
+    std::vector<isl_constraint*> cons;
+    std::map<std::string,int> tuplePos = tupleVarPositions(conj);
+    TupleDecl tdecl = conj->getTupleDecl();
+    for (unsigned int i=0; i<tdecl.size(); i++) {
+        if (!tdecl.elemIsConst(i)) { continue; }
+        enum isl_dim_type type;
+        int pos;
+        islDimOf(i, isSet, inArity, &type, &pos);
+        isl_constraint* c = isl_constraint_alloc_equality(
+                                isl_local_space_copy(ls));
+        c = isl_constraint_set_coefficient_si(c, type, pos, 1);
+        c = isl_constraint_set_constant_si(c, -tdecl.elemConstVal(i));
+        cons.push_back(c);
+    }
+    for (std::list<Exp*>::const_iterator i=conj->equalities().begin();
+            i != conj->equalities().end(); i++) {
+        cons.push_back(islConstraintFromExp(*i, true, ls, paramPos,
+                                            tuplePos, isSet, inArity));
+    }
+    for (std::list<Exp*>::const_iterator i=conj->inequalities().begin();
+            i != conj->inequalities().end(); i++) {
+        cons.push_back(islConstraintFromExp(*i, false, ls, paramPos,
+                                            tuplePos, isSet, inArity));
+    }
+    return cons;
+}
+
+static std::map<std::string,int> islParamPositions(
+                                    const std::vector<std::string>& params){
+    std::map<std::string,int> paramPos;
+    for (unsigned int i=0; i<params.size(); i++) { paramPos[params[i]] = i; }
+    return paramPos;
+}
+
+isl_set* islSetFromSet(const Set* s, isl_ctx* ctx){
+    if (!isAffineForISL(s)) { return NULL; }
+
+    std::vector<std::string> params = islParams(s);
+    std::map<std::string,int> paramPos = islParamPositions(params);
+    isl_space* space = isl_space_set_alloc(ctx, params.size(), s->arity());
+    if (s->conjunctionBegin() != s->conjunctionEnd()) {
+        space = nameISLSpace(space, params, s->getTupleDecl(), true, 0);
+    }
+    isl_local_space* ls = isl_local_space_from_space(isl_space_copy(space));
+
+    isl_set* result = isl_set_empty(isl_space_copy(space));
+    for (ConstConjunctionIterator c=s->conjunctionBegin();
+            c != s->conjunctionEnd(); c++) {
+        isl_basic_set* bset;
+        if ((*c)->isUnsat()) {
+            bset = isl_basic_set_empty(isl_space_copy(space));
+        } else {
+            bset = isl_basic_set_universe(isl_space_copy(space));
+            std::vector<isl_constraint*> cons =
+                    islConstraintsFromConjunction(*c, ls, paramPos, true, 0);
+            for (unsigned int i=0; i<cons.size(); i++) {
+                bset = isl_basic_set_add_constraint(bset, cons[i]);
+            }
+        }
+        result = isl_set_union(result, isl_set_from_basic_set(bset));
+    }
+
+    isl_local_space_free(ls);
+    isl_space_free(space);
+    return result;
+}
+
+isl_map* islMapFromRelation(const Relation* r, isl_ctx* ctx){
+    if (!isAffineForISL(r)) { return NULL; }
+
+    std::vector<std::string> params = islParams(r);
+    std::map<std::string,int> paramPos = islParamPositions(params);
+    isl_space* space = isl_space_alloc(ctx, params.size(), r->inArity(),
+                                       r->outArity());
+    if (r->conjunctionBegin() != r->conjunctionEnd()) {
+        space = nameISLSpace(space, params, r->getTupleDecl(), false,
+                              r->inArity());
+    }
+    isl_local_space* ls = isl_local_space_from_space(isl_space_copy(space));
+
+    isl_map* result = isl_map_empty(isl_space_copy(space));
+    for (ConstConjunctionIterator c=r->conjunctionBegin();
+            c != r->conjunctionEnd(); c++) {
+        isl_basic_map* bmap;
+        if ((*c)->isUnsat()) {
+            bmap = isl_basic_map_empty(isl_space_copy(space));
+        } else {
+            bmap = isl_basic_map_universe(isl_space_copy(space));
+            std::vector<isl_constraint*> cons =
+                    islConstraintsFromConjunction(*c, ls, paramPos, false,
+                                                  r->inArity());
+            for (unsigned int i=0; i<cons.size(); i++) {
+                bmap = isl_basic_map_add_constraint(bmap, cons[i]);
+            }
+        }
+        result = isl_map_union(result, isl_map_from_basic_map(bmap));
+    }
+
+    isl_local_space_free(ls);
+    isl_space_free(space);
+    return result;
+}
+
+/************************ isl -> Set/Relation ****************************/
+
+// State shared by the isl foreach callbacks below.
+typedef struct ISLWalkState{
+    ISLWalkState(const TupleDecl& td, bool set, int in)
+        : tdecl(td), isSet(set), inArity(in), conj(NULL), sc(NULL),
+          ok(true) {
+        // Tuple variables that share a name are the same variable, and
+        // the parser refers to all of them by the first one. Do the same
+        // so we build the constraints the string route would have parsed.
+        for (unsigned int i=0; i<tdecl.size(); i++) {
+            rep.push_back(i);
+            if (tdecl.elemIsConst(i)) { continue; }
+            for (unsigned int j=0; j<i; j++) {
+                if (!tdecl.elemIsConst(j) &&
+                    tdecl.elemVarString(j) == tdecl.elemVarString(i)) {
+                    rep[i] = j;
+                    break;
+                }
+            }
+        }
+    }
+    TupleDecl tdecl;
+    std::vector<int> rep; // first tuple location with the same name
+    bool isSet;
+    int inArity;
+    Conjunction* conj;    // Conjunction being built
+    SparseConstraints* sc;// Result being built
+    bool ok;              // false once something can't be represented
+} ISLWalkState;
+
+// Reads the integer value of v and frees it. Returns false if v is not an
+// integer that fits in an int.
+static bool islValToInt(isl_val* v, int* result){
+    bool ok = isl_val_is_int(v);
+    if (ok) {
+        long n = isl_val_get_num_si(v);
+        ok = ((long)(int)n == n);
+        *result = (int)n;
+    }
+    isl_val_free(v);
+    return ok;
+}
+
+// Adds the coefficient * tuple element loc term to e.
+static void addTupleTerm(Exp* e, const ISLWalkState* state, int loc,
+                         int coeff){
+    if (state->tdecl.elemIsConst(loc)) {
+        e->addTerm(new Term(coeff * state->tdecl.elemConstVal(loc)));
+    } else {
+        e->addTerm(new TupleVarTerm(coeff, state->rep[loc]));
+    }
+}
+
+static isl_stat addISLConstraint(isl_constraint* c, void* user){
+    ISLWalkState* state = (ISLWalkState*)user;
+    Exp* e = new Exp();
+    int coeff;
+
+    if (!islValToInt(isl_constraint_get_constant_val(c), &coeff)) {
+        state->ok = false;
+    } else if (coeff != 0) {
+        e->addTerm(new Term(coeff));
+    }
+
+    int nparam = isl_constraint_dim(c, isl_dim_param);
+    for (int i=0; i<nparam && state->ok; i++) {
+        if (!islValToInt(isl_constraint_get_coefficient_val(c,
+                             isl_dim_param, i), &coeff)) {
+            state->ok = false;
+        } else if (coeff != 0) {
+            e->addTerm(new VarTerm(coeff,
+                          isl_constraint_get_dim_name(c, isl_dim_param, i)));
+        }
+    }
+
+    for (int loc=0; loc<(int)state->tdecl.size() && state->ok; loc++) {
+        enum isl_dim_type type;
+        int pos;
+        islDimOf(loc, state->isSet, state->inArity, &type, &pos);
+        if (!islValToInt(isl_constraint_get_coefficient_val(c, type, pos),
+                         &coeff)) {
+            state->ok = false;
+        } else if (coeff != 0) {
+            addTupleTerm(e, state, loc, coeff);
+        }
+    }
+
+    if (!state->ok) {
+        delete e;
+    } else if (isl_constraint_is_equality(c)) {
+        // Equalities between constant tuple elements fold away.
+        if (e->equalsZero()) { delete e; }
+        else { state->conj->addEquality(e); }
+    } else {
+        // So do inequalities that are constant and hold.
+        Term* ct = e->getConstTerm();
+        if (e->equalsZero() || (e->isConst() && ct->coefficient() >= 0)) {
+            delete e;
+        } else {
+            state->conj->addInequality(e);
+        }
+    }
+
+    isl_constraint_free(c);
+    return state->ok ? isl_stat_ok : isl_stat_error;
+}
+
+static isl_stat addISLBasicMap(isl_basic_map* bmap, void* user){
+    ISLWalkState* state = (ISLWalkState*)user;
+    if (isl_basic_map_dim(bmap, isl_dim_div) != 0) {
+        state->ok = false;
+        isl_basic_map_free(bmap);
+        return isl_stat_error;
+    }
+    state->conj = new Conjunction(state->tdecl);
+    if (!state->isSet) { state->conj->setInArity(state->inArity); }
+    for (unsigned int i=0; i<state->rep.size(); i++) {
+        if (state->rep[i] == (int)i) { continue; }
+        Exp* e = new Exp();
+        e->addTerm(new TupleVarTerm(state->rep[i]));
+        e->addTerm(new TupleVarTerm(-1, i));
+        state->conj->addEquality(e);
+    }
+    isl_basic_map_foreach_constraint(bmap, &addISLConstraint, state);
+    isl_basic_map_free(bmap);
+    if (!state->ok) {
+        delete state->conj;
+        return isl_stat_error;
+    }
+    state->sc->addConjunction(state->conj);
+    state->conj = NULL;
+    return isl_stat_ok;
+}
+
+static isl_stat addISLBasicSet(isl_basic_set* bset, void* user){
+    return addISLBasicMap(isl_basic_map_from_range(bset), user);
+}
+
+Set* setFromISLSet(isl_set* iset, const TupleDecl& tdecl){
+    if (isl_set_plain_is_empty(iset) != isl_bool_false) {
+        isl_set_free(iset);
+        return NULL;
+    }
+
+    Set* result = new Set(tdecl);
+    ISLWalkState state(tdecl, true, 0);
+    state.sc = result;
+    isl_set_foreach_basic_set(iset, &addISLBasicSet, &state);
+    isl_set_free(iset);
+
+    if (!state.ok) {
+        delete result;
+        return NULL;
+    }
+    return result;
+}
+
+Set* setFromISLBasicSet(isl_basic_set* bset, const TupleDecl& tdecl){
+    return setFromISLSet(isl_set_from_basic_set(bset), tdecl);
+}
+
+Relation* relationFromISLMap(isl_map* imap, const TupleDecl& tdecl,
+                             int inArity){
+    if (isl_map_plain_is_empty(imap) != isl_bool_false) {
+        isl_map_free(imap);
+        return NULL;
+    }
+
+    Relation* result = new Relation(inArity, tdecl.size()-inArity);
+    ISLWalkState state(tdecl, false, inArity);
+    state.sc = result;
+    isl_map_foreach_basic_map(imap, &addISLBasicMap, &state);
+    isl_map_free(imap);
+
+    if (!state.ok) {
+        delete result;
+        return NULL;
+    }
+    return result;
+}
+
+}//end namespace iegenlib
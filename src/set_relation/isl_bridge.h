@@ -0,0 +1,70 @@
+/*!
+ * \file isl_bridge.h
+ *
+ * \brief Direct conversion between affine Sets/Relations and isl objects.
+ *
+ * The string route (toISLString -> isl_*_read_from_str -> isl printer ->
+ * revertISLTupDeclToOrig -> parser) works for everything, but for the
+ * affine supersets we hand to isl during normalization it spends most of
+ * its time printing and parsing. The routines here build isl_basic_set /
+ * isl_basic_map objects straight from the Conjunction constraint lists
+ * with the isl constraint API, and rebuild Conjunctions by walking the
+ * isl_constraints of the result.
+ *
+ * All routines return NULL when the input can not be represented exactly
+ * (non-affine terms going in, existentially quantified divs coming out,
+ * empty results), so callers can fall back to the string route.
+ *
+ * \date Started: 2026-10-16
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#ifndef ISL_BRIDGE_H_
+#define ISL_BRIDGE_H_
+
+#include "set_relation.h"
+
+#include <isl/set.h>
+#include <isl/map.h>
+
+namespace iegenlib{
+
+/*! Returns true if every constraint in sc only involves tuple variables,
+**  symbolic constants and constants, i.e. sc can be handed to isl
+**  without going through superAffineSet first.
+*/
+bool isAffineForISL(const SparseConstraints* sc);
+
+/*! Builds an isl_set equivalent to the affine Set s in ctx.
+**  Symbolic constants become isl parameters. Returns NULL if s is not
+**  affine. Caller owns the returned isl_set.
+*/
+isl_set* islSetFromSet(const Set* s, isl_ctx* ctx);
+
+/*! Builds an isl_map equivalent to the affine Relation r in ctx.
+**  Returns NULL if r is not affine. Caller owns the returned isl_map.
+*/
+isl_map* islMapFromRelation(const Relation* r, isl_ctx* ctx);
+
+/*! Builds a Set with tuple declaration tdecl from iset by walking its
+**  constraints. Takes ownership of iset. Returns NULL if iset is empty or
+**  has existentially quantified variables. Caller owns the result.
+*/
+Set* setFromISLSet(isl_set* iset, const TupleDecl& tdecl);
+
+//! Same as setFromISLSet for a single isl_basic_set (adopted).
+Set* setFromISLBasicSet(isl_basic_set* bset, const TupleDecl& tdecl);
+
+/*! Builds a Relation with tuple declaration tdecl from imap.
+**  Takes ownership of imap. Returns NULL in the same cases as
+**  setFromISLSet. Caller owns the result.
+*/
+Relation* relationFromISLMap(isl_map* imap, const TupleDecl& tdecl,
+                             int inArity);
+
+}//end namespace iegenlib
+
+#endif
@@ -0,0 +1,140 @@
+/*!
+ * \file isl_bridge_test.cc
+ *
+ * \brief Tests for the direct Set/Relation <-> isl conversion.
+ *
+ * \date Started: 2026-10-16
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved.
+ * See ../../COPYING for details. <br>
+ */
+
+#include "set_relation.h"
+#include "isl_bridge.h"
+
+#include <gtest/gtest.h>
+#include <string>
+
+using iegenlib::Set;
+using iegenlib::Relation;
+
+// isl may drop redundant constraints on one route and not on the other,
+// so results are compared as isl sets.
+static bool sameISLSet(std::string lhs, std::string rhs){
+    isl_ctx* ctx = isl_ctx_alloc();
+    isl_set* l = iegenlib::islStringToSet(lhs, ctx);
+    isl_set* r = iegenlib::islStringToSet(rhs, ctx);
+    bool equal = l && r && isl_set_is_equal(l, r) == isl_bool_true;
+    isl_set_free(l);
+    isl_set_free(r);
+    isl_ctx_free(ctx);
+    return equal;
+}
+
+static bool sameISLMap(std::string lhs, std::string rhs){
+    isl_ctx* ctx = isl_ctx_alloc();
+    isl_map* l = iegenlib::islStringToMap(lhs, ctx);
+    isl_map* r = iegenlib::islStringToMap(rhs, ctx);
+    bool equal = l && r && isl_map_is_equal(l, r) == isl_bool_true;
+    isl_map_free(l);
+    isl_map_free(r);
+    isl_ctx_free(ctx);
+    return equal;
+}
+
+#pragma mark ISLBridgeAffineCheck
+TEST(ISLBridgeTest, AffineCheck) {
+    Set* affine = new Set("[n] -> {[i,j] : 0 <= i && i < n && j = i + 2}");
+    Set* nonAffine = new Set("{[i,j] : 0 <= i && j = f(i)}");
+
+    EXPECT_TRUE( iegenlib::isAffineForISL(affine) );
+    EXPECT_FALSE( iegenlib::isAffineForISL(nonAffine) );
+
+    isl_ctx* ctx = isl_ctx_alloc();
+    EXPECT_TRUE( iegenlib::islSetFromSet(nonAffine, ctx) == NULL );
+    isl_ctx_free(ctx);
+
+    delete affine;
+    delete nonAffine;
+}
+
+#pragma mark ISLBridgeRoundTrip
+// The direct route must give the same set as the string route did.
+TEST(ISLBridgeTest, PassSetThruISL) {
+    const char* sets[] = {
+        "[n] -> {[i,j] : 0 <= i && i < n && j = i + 2}",
+        "[n, m] -> {[i,j,k] : 0 <= i && i < n && 0 <= j && j < m "
+            "&& k = i && i <= j}",
+        "{[0,i,j] : 0 <= i && i < 10 && i <= j && j < 10}",
+        "{[i,j] : 2i = j && 0 <= i && i <= 5 && i <= 7}",
+        "[n] -> {[i] : 0 <= i && i < n} union {[i] : n <= i}",
+        "{[i,j] : i = j && j = 3}",
+    };
+    for (unsigned int t=0; t<sizeof(sets)/sizeof(sets[0]); t++) {
+        Set* s = new Set(sets[t]);
+        Set* direct = iegenlib::passSetThruISL(s);
+        EXPECT_TRUE( sameISLSet(s->toISLString(), direct->toISLString()) )
+            << "input: " << sets[t];
+        EXPECT_EQ( s->arity(), direct->arity() );
+        delete s;
+        delete direct;
+    }
+}
+
+TEST(ISLBridgeTest, PassRelationThruISL) {
+    const char* rels[] = {
+        "[n] -> {[i,j] -> [k] : 0 <= i && i < n && k = i + j}",
+        "{[i] -> [i', j'] : i' = i && 0 <= j' && j' < i && i < 5}",
+    };
+    for (unsigned int t=0; t<sizeof(rels)/sizeof(rels[0]); t++) {
+        Relation* r = new Relation(rels[t]);
+        Relation* direct = iegenlib::passRelationThruISL(r);
+        EXPECT_TRUE( sameISLMap(r->toISLString(), direct->toISLString()) )
+            << "input: " << rels[t];
+        EXPECT_EQ( r->inArity(), direct->inArity() );
+        delete r;
+        delete direct;
+    }
+}
+
+#pragma mark ISLBridgeProjectOut
+// Projected results keep the names of the remaining tuple variables.
+TEST(ISLBridgeTest, ProjectOut) {
+    Set* s1 = new Set("[n] -> {[i,j,k] : 0 <= i && i < j && j < n "
+                      "&& k = j}");
+    Set* p1 = iegenlib::islSetProjectOut(s1, 1);
+    Set* e1 = new Set("[n] -> {[i,k] : 0 <= i && i < k && k < n}");
+    EXPECT_EQ( e1->prettyPrintString(), p1->prettyPrintString() );
+
+    Set* s2 = new Set("{[i,j] : 2j = i && 0 <= j && j < 10}");
+    Set* p2 = iegenlib::islSetProjectOut(s2, 0);
+    Set* e2 = new Set("{[j] : 0 <= j && j < 10}");
+    EXPECT_EQ( e2->prettyPrintString(), p2->prettyPrintString() );
+
+    delete s1; delete p1; delete e1;
+    delete s2; delete p2; delete e2;
+}
+
+#pragma mark ISLBridgeProjectOutBatch
+// Projecting out several positions at once gives the same set as
+// projecting them out one at a time.
+TEST(ISLBridgeTest, ProjectOutBatch) {
+    Set* s = new Set("[n] -> {[i,j,k,l,m] : 0 <= i && i < j && j < n "
+                     "&& k = j && l = i + 1 && m = 2k}");
+    std::set<int> positions;
+    positions.insert(1);
+    positions.insert(2);
+    positions.insert(4);
+    Set* batch = iegenlib::islSetProjectOut(s, positions);
+    Set* e = new Set("[n] -> {[i,l] : l = i + 1 && 0 <= i && i <= n - 2}");
+    EXPECT_EQ( e->prettyPrintString(), batch->prettyPrintString() );
+
+    Set* p4 = iegenlib::islSetProjectOut(s, 4);
+    Set* p2 = iegenlib::islSetProjectOut(p4, 2);
+    Set* p1 = iegenlib::islSetProjectOut(p2, 1);
+    EXPECT_EQ( p1->prettyPrintString(), batch->prettyPrintString() );
+
+    delete s; delete batch; delete e;
+    delete p4; delete p2; delete p1;
+}
@@ -0,0 +1,86 @@
+/*!
+ * \file isl_ctx_pool.cc
+ *
+ * \brief Implementation of the per-thread isl_ctx leases.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "isl_ctx_pool.h"
+
+namespace iegenlib{
+
+namespace {
+
+//! The isl context of one thread and its bookkeeping.
+struct ISLCtxState {
+    isl_ctx* ctx;
+    unsigned int leases;        // Leases alive right now
+    unsigned int served;        // Leases served by the current ctx
+    unsigned int recycleLimit;  // 0 means never recycle
+    bool resetPending;
+    unsigned long allocations;
+
+    ISLCtxState() : ctx(NULL), leases(0), served(0), recycleLimit(0),
+                    resetPending(false), allocations(0) {}
+    ~ISLCtxState() { release(); }
+
+    void release() {
+        if (ctx) { isl_ctx_free(ctx); }
+        ctx = NULL;
+        served = 0;
+        resetPending = false;
+    }
+
+    bool shouldRelease() const {
+        return resetPending || (recycleLimit && served >= recycleLimit);
+    }
+};
+
+thread_local ISLCtxState theISLCtxState;
+
+}
+
+ISLCtxScope::ISLCtxScope() {
+    ISLCtxState& st = theISLCtxState;
+    if (!st.ctx) {
+        st.ctx = isl_ctx_alloc();
+        st.allocations++;
+    }
+    st.leases++;
+    st.served++;
+    mCtx = st.ctx;
+}
+
+ISLCtxScope::~ISLCtxScope() {
+    ISLCtxState& st = theISLCtxState;
+    st.leases--;
+    if (st.leases == 0 && st.shouldRelease()) { st.release(); }
+}
+
+void resetISLCtx() {
+    ISLCtxState& st = theISLCtxState;
+    if (st.leases == 0) {
+        st.release();
+    } else {
+        st.resetPending = true;
+    }
+}
+
+void setISLCtxRecycleLimit(unsigned int leases) {
+    theISLCtxState.recycleLimit = leases;
+}
+
+unsigned long islCtxAllocations() {
+    return theISLCtxState.allocations;
+}
+
+unsigned int islCtxActiveLeases() {
+    return theISLCtxState.leases;
+}
+
+}// iegenlib namespace
@@ -0,0 +1,155 @@
+/*!
+ * \file isl_ctx_pool.h
+ *
+ * \brief Per-thread isl_ctx management and RAII handles for isl objects.
+ *
+ * Every isl object lives in an isl_ctx. Allocating a fresh context for
+ * each call into isl is expensive and, when the context is not freed,
+ * leaks. Instead each thread keeps one context that is handed out through
+ * ISLCtxScope leases. Between batches of work the context can be reset, or
+ * recycled automatically after a number of leases, to bound the memory
+ * isl accumulates in it (identifier tables, caches, statistics).
+ *
+ * Usage:
+ *
+ *   ISLCtxScope scope;
+ *   ISLSet iset( isl_set_read_from_str(scope.ctx(), str.c_str()) );
+ *   iset.reset( isl_set_coalesce(iset.release()) );
+ *
+ * Handles must go out of scope before the lease they were created under,
+ * which is the natural order when both are locals.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#ifndef ISL_CTX_POOL_H_
+#define ISL_CTX_POOL_H_
+
+#include <isl/ctx.h>
+#include <isl/set.h>
+#include <isl/map.h>
+#include <isl/union_set.h>
+#include <isl/union_map.h>
+#include <isl/printer.h>
+
+namespace iegenlib{
+
+/*!
+ * \class ISLCtxScope
+ *
+ * Lease on the calling thread's isl context. The context is allocated on
+ * first use and stays alive while any lease on the thread is alive. A
+ * pending reset (see resetISLCtx and setISLCtxRecycleLimit) takes effect
+ * when the last lease is released, so nested scopes share one context.
+ */
+class ISLCtxScope {
+public:
+    ISLCtxScope();
+    ~ISLCtxScope();
+
+    //! The thread's isl context, valid for the lifetime of this scope.
+    isl_ctx* ctx() const { return mCtx; }
+
+private:
+    ISLCtxScope(const ISLCtxScope&);
+    ISLCtxScope& operator=(const ISLCtxScope&);
+
+    isl_ctx* mCtx;
+};
+
+/*! Frees the calling thread's isl context, so the next lease starts with a
+**  fresh one. If leases are still alive on the thread, the reset happens
+**  when the last of them is released.
+*/
+void resetISLCtx();
+
+/*! Caps the number of leases served by one context: after that many the
+**  context is recycled (freed and reallocated) as soon as no lease is
+**  alive. 0, the default, never recycles. Applies to the calling thread.
+*/
+void setISLCtxRecycleLimit(unsigned int leases);
+
+//! Number of isl contexts allocated so far by the calling thread.
+unsigned long islCtxAllocations();
+
+//! Number of leases currently alive on the calling thread.
+unsigned int islCtxActiveLeases();
+
+
+//! How each isl object type is freed; used by ISLHandle.
+template <typename T> struct ISLFree;
+template <> struct ISLFree<isl_set> {
+    static void free(isl_set* p) { isl_set_free(p); } };
+template <> struct ISLFree<isl_basic_set> {
+    static void free(isl_basic_set* p) { isl_basic_set_free(p); } };
+template <> struct ISLFree<isl_map> {
+    static void free(isl_map* p) { isl_map_free(p); } };
+template <> struct ISLFree<isl_union_set> {
+    static void free(isl_union_set* p) { isl_union_set_free(p); } };
+template <> struct ISLFree<isl_union_map> {
+    static void free(isl_union_map* p) { isl_union_map_free(p); } };
+template <> struct ISLFree<isl_printer> {
+    static void free(isl_printer* p) { isl_printer_free(p); } };
+
+/*!
+ * \class ISLHandle
+ *
+ * Owns one isl object and frees it when it goes out of scope. isl
+ * functions that take ownership of an argument (__isl_take) are passed
+ * release(), and their result is stored back with reset():
+ *
+ *   set.reset( isl_set_coalesce(set.release()) );
+ *
+ * Functions that only look at the object (__isl_keep) are passed get().
+ */
+template <typename T>
+class ISLHandle {
+public:
+    explicit ISLHandle(T* obj = NULL) : mObj(obj) {}
+    ~ISLHandle() { reset(); }
+
+    ISLHandle(ISLHandle&& other) : mObj(other.release()) {}
+    ISLHandle& operator=(ISLHandle&& other) {
+        reset(other.release());
+        return *this;
+    }
+
+    //! The owned object; ownership is kept.
+    T* get() const { return mObj; }
+
+    //! Gives up ownership of the object and returns it.
+    T* release() {
+        T* obj = mObj;
+        mObj = NULL;
+        return obj;
+    }
+
+    //! Frees the owned object, if any, and takes ownership of obj.
+    void reset(T* obj = NULL) {
+        if (mObj && mObj != obj) { ISLFree<T>::free(mObj); }
+        mObj = obj;
+    }
+
+    explicit operator bool() const { return mObj != NULL; }
+
+private:
+    ISLHandle(const ISLHandle&);
+    ISLHandle& operator=(const ISLHandle&);
+
+    T* mObj;
+};
+
+typedef ISLHandle<isl_set> ISLSet;
+typedef ISLHandle<isl_basic_set> ISLBasicSet;
+typedef ISLHandle<isl_map> ISLMap;
+typedef ISLHandle<isl_union_set> ISLUnionSet;
+typedef ISLHandle<isl_union_map> ISLUnionMap;
+typedef ISLHandle<isl_printer> ISLPrinter;
+
+}// iegenlib namespace
+
+#endif
@@ -0,0 +1,109 @@
+/*!
+ * \file isl_ctx_pool_test.cc
+ *
+ * \brief Tests for the per-thread isl_ctx leases and isl handles.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "set_relation.h"
+#include "isl_ctx_pool.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+using iegenlib::ISLCtxScope;
+using iegenlib::ISLSet;
+
+#pragma mark ISLCtxPoolReuse
+// Consecutive and nested leases on one thread share a context.
+TEST(ISLCtxPoolTest, Reuse) {
+    iegenlib::resetISLCtx();
+    unsigned long before = iegenlib::islCtxAllocations();
+
+    isl_ctx* first;
+    {
+        ISLCtxScope outer;
+        first = outer.ctx();
+        {
+            ISLCtxScope inner;
+            EXPECT_EQ( first, inner.ctx() );
+            EXPECT_EQ( 2u, iegenlib::islCtxActiveLeases() );
+        }
+    }
+    for (int i = 0; i < 10; i++) {
+        iegenlib::Set* s =
+            new iegenlib::Set("[n] -> {[i] : 0 <= i && i < n}");
+        iegenlib::Set* r = iegenlib::passSetThruISL(s);
+        EXPECT_EQ( s->prettyPrintString(), r->prettyPrintString() );
+        delete s;
+        delete r;
+    }
+    EXPECT_EQ( 0u, iegenlib::islCtxActiveLeases() );
+    EXPECT_EQ( before + 1, iegenlib::islCtxAllocations() );
+}
+
+#pragma mark ISLCtxPoolReset
+// A reset requested while a lease is alive waits for the lease to end.
+TEST(ISLCtxPoolTest, Reset) {
+    unsigned long before = iegenlib::islCtxAllocations();
+    {
+        ISLCtxScope scope;
+        ISLSet s( isl_set_read_from_str(scope.ctx(), "{[i] : 0 <= i < 5}") );
+        iegenlib::resetISLCtx();
+        ISLCtxScope nested;
+        EXPECT_EQ( scope.ctx(), nested.ctx() );
+        EXPECT_FALSE( isl_set_is_empty(s.get()) );
+    }
+    {
+        ISLCtxScope scope;
+    }
+    EXPECT_EQ( before + 1, iegenlib::islCtxAllocations() );
+}
+
+#pragma mark ISLCtxPoolRecycleLimit
+TEST(ISLCtxPoolTest, RecycleLimit) {
+    iegenlib::resetISLCtx();
+    iegenlib::setISLCtxRecycleLimit(3);
+    unsigned long before = iegenlib::islCtxAllocations();
+    for (int i = 0; i < 7; i++) {
+        ISLCtxScope scope;
+    }
+    iegenlib::setISLCtxRecycleLimit(0);
+    EXPECT_EQ( before + 3, iegenlib::islCtxAllocations() );
+}
+
+#pragma mark ISLCtxPoolThreads
+// Every thread gets its own context.
+TEST(ISLCtxPoolTest, Threads) {
+    isl_ctx* mine;
+    isl_ctx* theirs = NULL;
+    ISLCtxScope scope;
+    mine = scope.ctx();
+    std::thread t([&theirs]() {
+        ISLCtxScope other;
+        theirs = other.ctx();
+        ISLSet s( isl_set_read_from_str(other.ctx(), "{[i] : i = 1}") );
+        EXPECT_FALSE( isl_set_is_empty(s.get()) );
+    });
+    t.join();
+    EXPECT_NE( mine, theirs );
+}
+
+#pragma mark ISLHandle
+TEST(ISLCtxPoolTest, Handles) {
+    ISLCtxScope scope;
+    ISLSet a( isl_set_read_from_str(scope.ctx(), "{[i] : 0 <= i < 5}") );
+    ISLSet b( std::move(a) );
+    EXPECT_TRUE( a.get() == NULL );
+    EXPECT_TRUE( b.get() != NULL );
+    b.reset( isl_set_coalesce(b.release()) );
+    std::string str = iegenlib::islSetToString(b.release(), scope.ctx());
+    EXPECT_EQ( "{ [i] : 0 <= i <= 4 }", str );
+    EXPECT_TRUE( b.get() == NULL );
+}
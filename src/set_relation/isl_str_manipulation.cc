@@ -233,20 +233,18 @@ isl_set* islStringToSet( std::string relstr , isl_ctx *ctx, bool doCoalesce )
 ** The function takes ownership of input argument 'iset'
 */
 std::string islSetToString ( isl_set* iset , isl_ctx *ctx ) {
+  ISLHandle<isl_set> owned(iset);
+
   // Get an isl printer and associate to an isl context
-  isl_printer * ip = isl_printer_to_str(ctx);
+  ISLPrinter ip( isl_printer_to_str(ctx) );
 
   // get string back from ISL map
-  isl_printer_set_output_format(ip, ISL_FORMAT_ISL);
-  isl_printer_print_set(ip, iset);
-  char *i_str = isl_printer_get_str(ip);
+  ip.reset( isl_printer_set_output_format(ip.release(), ISL_FORMAT_ISL) );
+  ip.reset( isl_printer_print_set(ip.release(), owned.get()) );
+  char *i_str = isl_printer_get_str(ip.get());
   std::string stringFromISL (i_str); 
   
   // clean-up
-  isl_printer_flush(ip);
-  isl_printer_free(ip);
-  isl_set_free(iset);
-  iset= NULL;
   free(i_str);
 
   return stringFromISL;
@@ -271,20 +269,18 @@ isl_map* islStringToMap( std::string relstr , isl_ctx *ctx, bool doCoalesce )
 */
 std::string islMapToString ( isl_map* imap , isl_ctx *ctx )
 {
+  ISLHandle<isl_map> owned(imap);
+
   // Get an isl printer and associate to an isl context
-  isl_printer * ip = isl_printer_to_str(ctx);
+  ISLPrinter ip( isl_printer_to_str(ctx) );
 
   // get string back from ISL map
-  isl_printer_set_output_format(ip , ISL_FORMAT_ISL);
-  isl_printer_print_map(ip ,imap);
-  char *i_str = isl_printer_get_str(ip);
+  ip.reset( isl_printer_set_output_format(ip.release(), ISL_FORMAT_ISL) );
+  ip.reset( isl_printer_print_map(ip.release(), owned.get()) );
+  char *i_str = isl_printer_get_str(ip.get());
   std::string stringFromISL (i_str); 
   
   // clean-up
-  isl_printer_flush(ip);
-  isl_printer_free(ip);
-  isl_map_free(imap);
-  imap= NULL;
   free(i_str);
 
   return stringFromISL;
@@ -307,20 +303,18 @@ isl_union_set* islStringToUnionSet( std::string relstr , isl_ctx *ctx, bool doCo
 ** The function takes ownership of input argument 'iset'
 */
 std::string islUnionSetToString ( isl_union_set* iset , isl_ctx *ctx ) {
+  ISLHandle<isl_union_set> owned(iset);
+
   // Get an isl printer and associate to an isl context
-  isl_printer * ip = isl_printer_to_str(ctx);
+  ISLPrinter ip( isl_printer_to_str(ctx) );
 
   // get string back from ISL map
-  isl_printer_set_output_format(ip, ISL_FORMAT_ISL);
-  isl_printer_print_union_set(ip, iset);
-  char *i_str = isl_printer_get_str(ip);
+  ip.reset( isl_printer_set_output_format(ip.release(), ISL_FORMAT_ISL) );
+  ip.reset( isl_printer_print_union_set(ip.release(), owned.get()) );
+  char *i_str = isl_printer_get_str(ip.get());
   std::string stringFromISL (i_str); 
   
   // clean-up
-  isl_printer_flush(ip);
-  isl_printer_free(ip);
-  isl_union_set_free(iset);
-  iset= NULL;
   free(i_str);
 
   return stringFromISL;
@@ -345,20 +339,18 @@ isl_union_map* islStringToUnionMap( std::string relstr , isl_ctx *ctx, bool doCo
 */
 std::string islUnionMapToString ( isl_union_map* imap , isl_ctx *ctx )
 {
+  ISLHandle<isl_union_map> owned(imap);
+
   // Get an isl printer and associate to an isl context
-  isl_printer * ip = isl_printer_to_str(ctx);
+  ISLPrinter ip( isl_printer_to_str(ctx) );
 
   // get string back from ISL map
-  isl_printer_set_output_format(ip , ISL_FORMAT_ISL);
-  isl_printer_print_union_map(ip ,imap);
-  char *i_str = isl_printer_get_str(ip);
+  ip.reset( isl_printer_set_output_format(ip.release(), ISL_FORMAT_ISL) );
+  ip.reset( isl_printer_print_union_map(ip.release(), owned.get()) );
+  char *i_str = isl_printer_get_str(ip.get());
   std::string stringFromISL (i_str); 
   
   // clean-up
-  isl_printer_flush(ip);
-  isl_printer_free(ip);
-  isl_union_map_free(imap);
-  imap= NULL;
   free(i_str);
 
   return stringFromISL;
@@ -468,10 +460,12 @@ std::string strAddConstraints(std::string dest, std::string src){
 **  
 */
 SetRelationshipType strISLSetRelationship(std::string setStr1, std::string setStr2){
-   isl_ctx* ctx = isl_ctx_alloc();  
+   ISLCtxScope scope;
    SetRelationshipType ret = UnKnown;
-   isl_set* set1 = isl_set_read_from_str(ctx, setStr1.c_str());
-   isl_set* set2 = isl_set_read_from_str(ctx, setStr2.c_str());
+   ISLSet iset1( isl_set_read_from_str(scope.ctx(), setStr1.c_str()) );
+   ISLSet iset2( isl_set_read_from_str(scope.ctx(), setStr2.c_str()) );
+   isl_set* set1 = iset1.get();
+   isl_set* set2 = iset2.get();
    
    if( isl_set_is_equal( set1, set2) ){
      ret = SetEqual;
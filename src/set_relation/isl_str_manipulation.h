@@ -27,6 +27,7 @@
 #include <isl/map.h>   // ISL Relations
 #include <isl/union_set.h>   // ISL Union_Sets
 #include <isl/union_map.h>   // ISL Union_Relations
+#include "isl_ctx_pool.h"
 
 namespace iegenlib{
 
@@ -0,0 +1,244 @@
+/*!
+ * \file normalize_cache.cc
+ *
+ * \brief Implementation of the normalize result cache.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "normalize_cache.h"
+#include "set_relation.h"
+#include "environment.h"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace iegenlib{
+
+namespace {
+
+// compare() and hash() leave tuple variable names out, but normalize
+// keeps them, so the cache tells inputs apart by them as well.
+std::size_t tupleNamesHash(const SparseConstraints& sc) {
+    std::size_t seed = 0;
+    for (ConstConjunctionIterator c = sc.conjunctionBegin();
+            c != sc.conjunctionEnd(); c++) {
+        TupleDecl tdecl = (*c)->getTupleDecl();
+        for (unsigned int i=0; i < tdecl.size(); i++) {
+            hashCombine(seed, std::hash<std::string>()(
+                                  tdecl.elemVarString(i)));
+        }
+    }
+    return seed;
+}
+
+bool sameTupleNames(const SparseConstraints& a, const SparseConstraints& b) {
+    ConstConjunctionIterator ca = a.conjunctionBegin();
+    ConstConjunctionIterator cb = b.conjunctionBegin();
+    for (; ca != a.conjunctionEnd() && cb != b.conjunctionEnd();
+            ca++, cb++) {
+        TupleDecl ta = (*ca)->getTupleDecl(), tb = (*cb)->getTupleDecl();
+        if (ta.size() != tb.size()) { return false; }
+        for (unsigned int i=0; i < ta.size(); i++) {
+            if (ta.elemVarString(i) != tb.elemVarString(i)) { return false; }
+        }
+    }
+    return ca == a.conjunctionEnd() && cb == b.conjunctionEnd();
+}
+
+/*!
+ * Least recently used list of normalized results. The most recently used
+ * entry is at the front of mEntries. mIndex finds entries by the hash of
+ * their key, and entries with the same hash are told apart with compare()
+ * and their tuple variable names.
+ */
+template <typename T>
+class LRUResults {
+public:
+    bool lookup(const T& input, unsigned long version, bool bdr,
+                T* result) {
+        typename Entries::iterator it =
+            find(input, version, bdr, keyHash(input, version, bdr));
+        if (it == mEntries.end()) { return false; }
+        mEntries.splice(mEntries.begin(), mEntries, it);
+        *result = it->result;
+        return true;
+    }
+
+    void insert(const T& input, unsigned long version, bool bdr,
+                const T& result, unsigned int capacity) {
+        std::size_t hash = keyHash(input, version, bdr);
+        typename Entries::iterator it = find(input, version, bdr, hash);
+        if (it != mEntries.end()) { erase(it); }
+        mEntries.push_front(Entry(input, version, bdr, hash, result));
+        mIndex.insert(std::make_pair(hash, mEntries.begin()));
+        trim(capacity);
+    }
+
+    //! Drops least recently used entries until at most capacity are left.
+    void trim(unsigned int capacity) {
+        while (mEntries.size() > capacity) {
+            erase(--mEntries.end());
+        }
+    }
+
+    unsigned int size() const { return mEntries.size(); }
+
+private:
+    //! A normalized result with the input and environment it came from.
+    struct Entry {
+        T input;
+        unsigned long version;
+        bool bdr;
+        std::size_t hash;
+        T result;
+
+        Entry(const T& in, unsigned long v, bool b, std::size_t h,
+              const T& res)
+            : input(in), version(v), bdr(b), hash(h), result(res) {}
+    };
+
+    typedef std::list<Entry> Entries;
+    typedef std::unordered_multimap<std::size_t,
+                                    typename Entries::iterator> Index;
+
+    static std::size_t keyHash(const T& input, unsigned long version,
+                               bool bdr) {
+        std::size_t seed = input.hash();
+        hashCombine(seed, tupleNamesHash(input));
+        hashCombine(seed, version);
+        hashCombine(seed, bdr);
+        return seed;
+    }
+
+    typename Entries::iterator find(const T& input, unsigned long version,
+                                    bool bdr, std::size_t hash) {
+        std::pair<typename Index::iterator, typename Index::iterator>
+            range = mIndex.equal_range(hash);
+        for (typename Index::iterator i = range.first; i != range.second;
+                i++) {
+            const Entry& entry = *i->second;
+            if (entry.version == version && entry.bdr == bdr &&
+                entry.input.compare(input) == 0 &&
+                sameTupleNames(entry.input, input)) {
+                return i->second;
+            }
+        }
+        return mEntries.end();
+    }
+
+    void erase(typename Entries::iterator it) {
+        std::pair<typename Index::iterator, typename Index::iterator>
+            range = mIndex.equal_range(it->hash);
+        for (typename Index::iterator i = range.first; i != range.second;
+                i++) {
+            if (i->second == it) {
+                mIndex.erase(i);
+                break;
+            }
+        }
+        mEntries.erase(it);
+    }
+
+    Entries mEntries;
+    Index mIndex;
+};
+
+//! State of the normalize cache, guarded by mutex.
+struct NormalizeCache {
+    std::mutex mutex;
+    unsigned int capacity;
+    unsigned long hits;
+    unsigned long misses;
+    LRUResults<Set> sets;
+    LRUResults<Relation> relations;
+
+    NormalizeCache() : capacity(0), hits(0), misses(0) {}
+};
+
+NormalizeCache theNormalizeCache;
+
+template <typename T>
+bool lookupResult(LRUResults<T>& results, const T& input, bool bdr,
+                  T* result) {
+    unsigned long version = queryVersionCurrEnv();
+    std::lock_guard<std::mutex> lock(theNormalizeCache.mutex);
+    if (theNormalizeCache.capacity == 0) { return false; }
+    if (results.lookup(input, version, bdr, result)) {
+        theNormalizeCache.hits++;
+        return true;
+    }
+    theNormalizeCache.misses++;
+    return false;
+}
+
+template <typename T>
+void insertResult(LRUResults<T>& results, const T& input, bool bdr,
+                  const T& result) {
+    unsigned long version = queryVersionCurrEnv();
+    std::lock_guard<std::mutex> lock(theNormalizeCache.mutex);
+    if (theNormalizeCache.capacity == 0) { return; }
+    results.insert(input, version, bdr, result, theNormalizeCache.capacity);
+}
+
+}
+
+void setNormalizeCacheCapacity(unsigned int capacity) {
+    std::lock_guard<std::mutex> lock(theNormalizeCache.mutex);
+    theNormalizeCache.capacity = capacity;
+    theNormalizeCache.sets.trim(capacity);
+    theNormalizeCache.relations.trim(capacity);
+}
+
+unsigned int normalizeCacheCapacity() {
+    std::lock_guard<std::mutex> lock(theNormalizeCache.mutex);
+    return theNormalizeCache.capacity;
+}
+
+void clearNormalizeCache() {
+    std::lock_guard<std::mutex> lock(theNormalizeCache.mutex);
+    theNormalizeCache.sets.trim(0);
+    theNormalizeCache.relations.trim(0);
+    theNormalizeCache.hits = 0;
+    theNormalizeCache.misses = 0;
+}
+
+unsigned long normalizeCacheHits() {
+    std::lock_guard<std::mutex> lock(theNormalizeCache.mutex);
+    return theNormalizeCache.hits;
+}
+
+unsigned long normalizeCacheMisses() {
+    std::lock_guard<std::mutex> lock(theNormalizeCache.mutex);
+    return theNormalizeCache.misses;
+}
+
+unsigned int normalizeCacheSize() {
+    std::lock_guard<std::mutex> lock(theNormalizeCache.mutex);
+    return theNormalizeCache.sets.size() + theNormalizeCache.relations.size();
+}
+
+bool normalizeCacheLookup(const Set& input, bool bdr, Set* result) {
+    return lookupResult(theNormalizeCache.sets, input, bdr, result);
+}
+
+bool normalizeCacheLookup(const Relation& input, bool bdr,
+                          Relation* result) {
+    return lookupResult(theNormalizeCache.relations, input, bdr, result);
+}
+
+void normalizeCacheInsert(const Set& input, bool bdr, const Set& result) {
+    insertResult(theNormalizeCache.sets, input, bdr, result);
+}
+
+void normalizeCacheInsert(const Relation& input, bool bdr,
+                          const Relation& result) {
+    insertResult(theNormalizeCache.relations, input, bdr, result);
+}
+
+}// iegenlib namespace
@@ -0,0 +1,71 @@
+/*!
+ * \file normalize_cache.h
+ *
+ * \brief Memoization of Set::normalize and Relation::normalize results.
+ *
+ * Analyses tend to normalize the same dependence relations over and over.
+ * When the cache is turned on (setNormalizeCacheCapacity), normalize
+ * looks its result up by the constraints it is given and the current
+ * environment version before doing any work: the UF call indexing, the
+ * affine superset and the isl pass are all determined by those. Sets and
+ * Relations each get their own least recently used list of at most
+ * capacity results. The constraints are found with their structural
+ * hash() and compared with compare() and their tuple variable names, so
+ * no string of the whole input is built.
+ *
+ * The cache is off by default.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#ifndef NORMALIZE_CACHE_H_
+#define NORMALIZE_CACHE_H_
+
+namespace iegenlib{
+
+class Set;
+class Relation;
+
+/*! Turns the normalize cache on with room for capacity Sets and capacity
+**  Relations. Least recently used results are dropped first. A capacity
+**  of 0 turns the cache off and drops everything in it.
+*/
+void setNormalizeCacheCapacity(unsigned int capacity);
+
+//! Capacity of the normalize cache, 0 if it is off.
+unsigned int normalizeCacheCapacity();
+
+//! Drops all cached results and zeroes the hit and miss counters.
+void clearNormalizeCache();
+
+//! Number of normalize calls answered from the cache.
+unsigned long normalizeCacheHits();
+
+//! Number of normalize calls that had to go through isl with the cache on.
+unsigned long normalizeCacheMisses();
+
+//! Number of results (Sets and Relations) currently cached.
+unsigned int normalizeCacheSize();
+
+/*! If the normalized form of input, normalized with bdr in the current
+**  environment, is cached, assigns it to result and returns true. result
+**  may be input. Counts a hit or a miss.
+*/
+bool normalizeCacheLookup(const Set& input, bool bdr, Set* result);
+bool normalizeCacheLookup(const Relation& input, bool bdr,
+                          Relation* result);
+
+/*! Caches a copy of result as the normalized form of input, normalized
+**  with bdr in the current environment. Does nothing if the cache is off.
+*/
+void normalizeCacheInsert(const Set& input, bool bdr, const Set& result);
+void normalizeCacheInsert(const Relation& input, bool bdr,
+                          const Relation& result);
+
+}// iegenlib namespace
+
+#endif
@@ -0,0 +1,124 @@
+/*!
+ * \file normalize_cache_test.cc
+ *
+ * \brief Tests for the normalize result cache.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "set_relation.h"
+#include "environment.h"
+
+#include <gtest/gtest.h>
+#include <string>
+
+using iegenlib::Set;
+using iegenlib::Relation;
+
+class NormalizeCacheTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        iegenlib::setCurrEnv();
+        iegenlib::clearNormalizeCache();
+        iegenlib::setNormalizeCacheCapacity(8);
+    }
+    virtual void TearDown() {
+        iegenlib::setNormalizeCacheCapacity(0);
+        iegenlib::clearNormalizeCache();
+    }
+};
+
+#pragma mark NormalizeCacheHitMiss
+// Cached results are the same as computed ones.
+TEST_F(NormalizeCacheTest, HitMiss) {
+    iegenlib::appendCurrEnv("f", new Set("{[i] : 0 <= i}"),
+                            new Set("{[j] : 0 <= j}"), false,
+                            iegenlib::Monotonic_NONE);
+    iegenlib::appendCurrEnv("g", new Set("{[i] : 0 <= i}"),
+                            new Set("{[j] : 0 <= j}"), false,
+                            iegenlib::Monotonic_NONE);
+    const char* str = "[n] -> {[i,j] : j = f(i) && 0 <= i && i < n "
+                      "&& i = j - 1}";
+
+    Set* expected = new Set(str);
+    iegenlib::setNormalizeCacheCapacity(0);
+    expected->normalize();
+    iegenlib::setNormalizeCacheCapacity(8);
+
+    Set* first = new Set(str);
+    first->normalize();
+    EXPECT_EQ( 0u, iegenlib::normalizeCacheHits() );
+    EXPECT_EQ( 1u, iegenlib::normalizeCacheMisses() );
+
+    Set* second = new Set(str);
+    second->normalize();
+    EXPECT_EQ( 1u, iegenlib::normalizeCacheHits() );
+    EXPECT_EQ( 1u, iegenlib::normalizeCacheMisses() );
+
+    EXPECT_EQ( expected->toString(), first->toString() );
+    EXPECT_EQ( expected->toString(), second->toString() );
+
+    Relation* r1 = new Relation("{[i] -> [j] : j = g(i) && i = 1 + j - 1}");
+    Relation* r2 = new Relation(*r1);
+    r1->normalize();
+    r2->normalize();
+    EXPECT_EQ( r1->toString(), r2->toString() );
+    EXPECT_EQ( 2u, iegenlib::normalizeCacheHits() );
+    EXPECT_EQ( 2u, iegenlib::normalizeCacheSize() );
+
+    delete expected; delete first; delete second;
+    delete r1; delete r2;
+}
+
+#pragma mark NormalizeCacheTupleNames
+// Sets that only differ in tuple variable names are separate entries.
+TEST_F(NormalizeCacheTest, TupleNames) {
+    Set* s1 = new Set("{[i,j] : i = j && 0 <= i}");
+    Set* s2 = new Set("{[a,b] : a = b && 0 <= a}");
+    s1->normalize();
+    s2->normalize();
+    EXPECT_EQ( 0u, iegenlib::normalizeCacheHits() );
+    EXPECT_EQ( "{ [i, j] : i - j = 0 && i >= 0 }", s1->prettyPrintString() );
+    EXPECT_EQ( "{ [a, b] : a - b = 0 && a >= 0 }", s2->prettyPrintString() );
+    delete s1;
+    delete s2;
+}
+
+#pragma mark NormalizeCacheEnvironment
+// Changing the environment makes earlier results unreachable.
+TEST_F(NormalizeCacheTest, Environment) {
+    Set* s1 = new Set("{[i] : 0 <= i && i < 5}");
+    s1->normalize();
+    iegenlib::appendCurrEnv("h", new Set("{[i] : 0 <= i}"),
+                            new Set("{[j] : 0 <= j}"), false,
+                            iegenlib::Monotonic_NONE);
+    Set* s2 = new Set("{[i] : 0 <= i && i < 5}");
+    s2->normalize();
+    EXPECT_EQ( 0u, iegenlib::normalizeCacheHits() );
+    EXPECT_EQ( 2u, iegenlib::normalizeCacheMisses() );
+    delete s1;
+    delete s2;
+}
+
+#pragma mark NormalizeCacheCapacity
+TEST_F(NormalizeCacheTest, Capacity) {
+    iegenlib::setNormalizeCacheCapacity(2);
+    const char* strs[] = { "{[i] : i = 1}", "{[i] : i = 2}",
+                           "{[i] : i = 3}", "{[i] : i = 1}" };
+    for (int t = 0; t < 4; t++) {
+        Set* s = new Set(strs[t]);
+        s->normalize();
+        delete s;
+    }
+    // "{[i] : i = 1}" was dropped to make room for "{[i] : i = 3}"
+    EXPECT_EQ( 0u, iegenlib::normalizeCacheHits() );
+    EXPECT_EQ( 2u, iegenlib::normalizeCacheSize() );
+
+    iegenlib::clearNormalizeCache();
+    EXPECT_EQ( 0u, iegenlib::normalizeCacheSize() );
+    EXPECT_EQ( 0u, iegenlib::normalizeCacheMisses() );
+}
@@ -32,25 +32,23 @@ namespace iegenlib{
 
 /**
  ** This function uses islSetProjectOut function to project out all 
- ** iterators in a given set except for the specified ones in eigenTvs 
+ ** iterators in a given set except for the specified ones in eigenTvs,
+ ** all of them in one pass through isl.
  ** Note, an important assumption is that the given set only has affine constraints.
  ** The function owns the inSet object, and it deletes it at the end
  **/
 Set* islSetProjectOutAll(Set *inSet, std::set<int> eigenTvs){
-  bool at_least_one_projected = false;
-  Set *retSet;
-  for(int tV = (inSet->arity()-1); tV >= 0; tV--){
-    if( eigenTvs.find(tV) != eigenTvs.end() ){
-      continue;
-    } else {
-       retSet = islSetProjectOut(inSet, tV);
-       delete inSet;
-       inSet = retSet;
-       at_least_one_projected = true;
+  std::set<int> tvars;
+  for(int tV = 0; tV < inSet->arity(); tV++){
+    if( eigenTvs.find(tV) == eigenTvs.end() ){
+      tvars.insert(tV);
     }
   }
-  if(at_least_one_projected)  return retSet;
-  else                        return inSet;
+  if( tvars.empty() ) return inSet;
+
+  Set *retSet = islSetProjectOut(inSet, tvars);
+  delete inSet;
+  return retSet;
 }
 
 
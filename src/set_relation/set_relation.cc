@@ -15,9 +15,23 @@
 
 #include "set_relation.h"
 #include "UFCallMap.h"
+#include "isl_bridge.h"
+#include "bound_propagation.h"
+#include "congruence_closure.h"
+#include "fourier_motzkin.h"
 #include "Visitor.h"
+#include <isl/constraint.h>
 #include <stack>
+#include <deque>
+#include <algorithm>
 #include <map>
+#include <memory>
+#include <unordered_set>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
 #include <assert.h>
 
 namespace iegenlib{
@@ -28,9 +42,8 @@ namespace iegenlib{
 //  as a string
 string passSetStrThruISL(string sstr){
 
-  isl_ctx *ctx = isl_ctx_alloc();
-  string islStr =  islSetToString ( islStringToSet(sstr,ctx), ctx );
-  isl_ctx_free(ctx);
+  ISLCtxScope scope;
+  string islStr =  islSetToString ( islStringToSet(sstr,scope.ctx()), scope.ctx() );
 
   return islStr;
 }
@@ -41,9 +54,8 @@ string passSetStrThruISL(string sstr){
 //    (may have different tuple declaration)
 string passUnionSetStrThruISL(string sstr){
 
-  isl_ctx *ctx = isl_ctx_alloc();
-  string islStr =  islUnionSetToString ( islStringToUnionSet(sstr,ctx), ctx );
-  isl_ctx_free(ctx);
+  ISLCtxScope scope;
+  string islStr =  islUnionSetToString ( islStringToUnionSet(sstr,scope.ctx()), scope.ctx() );
 
   return islStr;
 }
@@ -51,9 +63,8 @@ string passUnionSetStrThruISL(string sstr){
 //! Runs an Affine Relation through ISL and returns the normalized result
 string passRelationStrThruISL(string rstr){
 
-  isl_ctx *ctx = isl_ctx_alloc();
-  string islStr =  islMapToString ( islStringToMap(rstr,ctx), ctx );
-  isl_ctx_free(ctx);
+  ISLCtxScope scope;
+  string islStr =  islMapToString ( islStringToMap(rstr,scope.ctx()), scope.ctx() );
 
   return islStr;
 }
@@ -61,9 +72,8 @@ string passRelationStrThruISL(string rstr){
 //! Runs an Affine Union Relation through ISL and returns the normalized result
 string passUnionRelationStrThruISL(string rstr){
 
-  isl_ctx *ctx = isl_ctx_alloc();
-  string islStr =  islUnionMapToString ( islStringToUnionMap(rstr,ctx), ctx );
-  isl_ctx_free(ctx);
+  ISLCtxScope scope;
+  string islStr =  islUnionMapToString ( islStringToUnionMap(rstr,scope.ctx()), scope.ctx() );
 
   return islStr;
 }
@@ -71,11 +81,21 @@ string passUnionRelationStrThruISL(string rstr){
 //! Runs an Affine Set through ISL and returns the resulting normalized set
 Set* passSetThruISL(Set* s){
 
-  string sstr = s->toISLString();
+  ISLCtxScope scope;
+
+  // Affine sets are handed to isl directly through its constraint API,
+  // and read back the same way. Only when that is not possible (e.g. isl
+  // introduced existentials) do we go through the string representation.
+  ISLSet iset( islSetFromSet(s, scope.ctx()) );
+  if (iset) {
+    iset.reset( isl_set_coalesce(iset.release()) );
+    Set* result = setFromISLSet(isl_set_copy(iset.get()), s->getTupleDecl());
+    if (result) { return result; }
+  }
 
-  isl_ctx *ctx = isl_ctx_alloc();
-  string islStr =  islSetToString ( islStringToSet(sstr,ctx), ctx );
-  isl_ctx_free(ctx);
+  string sstr = s->toISLString();
+  if (!iset) { iset.reset( islStringToSet(sstr,scope.ctx()) ); }
+  string islStr =  islSetToString ( iset.release(), scope.ctx() );
 
   // We need to revert changes that isl applies to Tuple Declaration because of 
   // equality constrains. We do this purely using string manipulation.
@@ -94,13 +114,21 @@ Set* passSetThruISL(Set* s){
 //! Runs an Affine Relation through ISL and returns the normalized result
 Relation* passRelationThruISL(Relation* r){
 
-  string rstr = r->toISLString();
-
-  isl_ctx *ctx = isl_ctx_alloc();
-  string islStr =  islMapToString ( islStringToMap(rstr,ctx), ctx );
-  isl_ctx_free(ctx);
+  ISLCtxScope scope;
 
   // Same as passSetThruISL
+  ISLMap imap( islMapFromRelation(r, scope.ctx()) );
+  if (imap) {
+    imap.reset( isl_map_coalesce(imap.release()) );
+    Relation* result = relationFromISLMap(isl_map_copy(imap.get()),
+                                          r->getTupleDecl(), r->inArity());
+    if (result) { return result; }
+  }
+
+  string rstr = r->toISLString();
+  if (!imap) { imap.reset( islStringToMap(rstr,scope.ctx()) ); }
+  string islStr =  islMapToString ( imap.release(), scope.ctx() );
+
   int inArity = r->inArity(), outArity = r->outArity();
   string corrected = revertISLTupDeclToOrig( rstr, islStr, inArity, outArity);
   Relation* result = new Relation( corrected);
@@ -108,19 +136,68 @@ Relation* passRelationThruISL(Relation* r){
   return result;
 }
 
+Set Union(const Set& lhs, const Set& rhs) {
+  std::unique_ptr<Set> result( lhs.Union(&rhs) );
+  return std::move(*result);
+}
+
+Set Intersect(const Set& lhs, const Set& rhs) {
+  std::unique_ptr<Set> result( lhs.Intersect(&rhs) );
+  return std::move(*result);
+}
+
+Relation Union(const Relation& lhs, const Relation& rhs) {
+  std::unique_ptr<Relation> result( lhs.Union(&rhs) );
+  return std::move(*result);
+}
+
+Relation Intersect(const Relation& lhs, const Relation& rhs) {
+  std::unique_ptr<Relation> result( lhs.Intersect(&rhs) );
+  return std::move(*result);
+}
+
+Relation Compose(const Relation& lhs, const Relation& rhs) {
+  std::unique_ptr<Relation> result( lhs.Compose(&rhs) );
+  return std::move(*result);
+}
+
+Set Apply(const Relation& lhs, const Set& rhs) {
+  std::unique_ptr<Set> result( lhs.Apply(&rhs) );
+  return std::move(*result);
+}
+
+Relation Inverse(const Relation& r) {
+  std::unique_ptr<Relation> result( r.Inverse() );
+  return std::move(*result);
+}
+
 // This function can be used for Projecting out a tuple variable
 // from an affine set string using isl library
 Set* islSetProjectOut(Set* s, unsigned pos) {
 
-    string sstr = s->toISLString();
+    ISLCtxScope scope;
 
     // Using isl to project out tuple variable #pos
-    isl_ctx *ctx = isl_ctx_alloc();
-    string islStr = islSetToString ( 
-                 isl_set_project_out(islStringToSet(sstr,ctx), 
-                                     isl_dim_out, pos, 1), ctx 
-                 );
-    isl_ctx_free(ctx);
+    ISLSet iset( islSetFromSet(s, scope.ctx()) );
+    if (iset) {
+        iset.reset( isl_set_coalesce(isl_set_project_out(iset.release(),
+                                                 isl_dim_set, pos, 1)) );
+        TupleDecl projTupleDecl(s->arity()-1);
+        TupleDecl origTupleDecl = s->getTupleDecl();
+        for (unsigned int i=0, j=0; i<origTupleDecl.size(); i++) {
+            if (i == pos) { continue; }
+            projTupleDecl.copyTupleElem(origTupleDecl, i, j++);
+        }
+        Set* result = setFromISLSet(isl_set_copy(iset.get()), projTupleDecl);
+        if (result) { return result; }
+    }
+
+    string sstr = s->toISLString();
+    if (!iset) {
+        iset.reset( isl_set_project_out(islStringToSet(sstr,scope.ctx()),
+                                        isl_dim_out, pos, 1) );
+    }
+    string islStr = islSetToString ( iset.release(), scope.ctx() );
 
     // We need to revert changes that isl applies to Tuple Declaration similar
     // to passSetThruISL. However, this is different from passSetThruISL.
@@ -140,23 +217,81 @@ Set* islSetProjectOut(Set* s, unsigned pos) {
     return result;
 }
 
+// Projects out the tuple variables at all the given positions of an affine
+// set with one conversion to isl and back, instead of one per position.
+Set* islSetProjectOut(Set* s, const std::set<int>& positions) {
+    if (positions.empty()) { return new Set(*s); }
+    if (*positions.begin() < 0 || *positions.rbegin() >= s->arity()) {
+        throw assert_exception("islSetProjectOut: position out of range");
+    }
+
+    ISLCtxScope scope;
+    ISLSet iset( islSetFromSet(s, scope.ctx()) );
+    bool direct = iset.get() != NULL;
+    string sstr;
+    if (!direct) {
+        sstr = s->toISLString();
+        iset.reset( islStringToSet(sstr, scope.ctx()) );
+    }
+
+    // Highest positions first, so the lower ones keep their place, and
+    // each run of consecutive positions in one call.
+    isl_set* projected = iset.release();
+    std::set<int>::const_reverse_iterator i = positions.rbegin();
+    while (i != positions.rend()) {
+        int last = *i, first = *i;
+        for (++i; i != positions.rend() && *i == first-1; ++i) {
+            first--;
+        }
+        projected = isl_set_project_out(projected, isl_dim_set,
+                                        first, last-first+1);
+    }
+    iset.reset( projected );
+
+    if (direct) {
+        iset.reset( isl_set_coalesce(iset.release()) );
+        TupleDecl projTupleDecl(s->arity()-positions.size());
+        TupleDecl origTupleDecl = s->getTupleDecl();
+        for (unsigned int i=0, j=0; i<origTupleDecl.size(); i++) {
+            if (positions.count(i)) { continue; }
+            projTupleDecl.copyTupleElem(origTupleDecl, i, j++);
+        }
+        Set* result = setFromISLSet(isl_set_copy(iset.get()), projTupleDecl);
+        if (result) { return result; }
+        sstr = s->toISLString();
+    }
+    string islStr = islSetToString ( iset.release(), scope.ctx() );
+
+    // Same as in islSetProjectOut for one position, with the tuple
+    // declaration corrected for each position in turn.
+    string projectedStr = sstr;
+    int arity = s->arity();
+    for (std::set<int>::const_reverse_iterator i = positions.rbegin();
+            i != positions.rend(); ++i) {
+        projectedStr = projectOutStrCorrection(projectedStr, *i, arity--, 0);
+    }
+    string corrected = revertISLTupDeclToOrig( projectedStr, islStr,
+                                               arity, 0);
+    return new Set( corrected );
+}
+
 #pragma mark -
 /****************************** Conjunction *********************************/
 
 Conjunction::Conjunction(int arity) : mTupleDecl(arity), mInArity(0),
-                                      unsat(false){
+                                      unsat(false), mShares(1){
 }
 
 Conjunction::Conjunction(TupleDecl tdecl) : mTupleDecl(tdecl), mInArity(0),
-                                      unsat(false){
+                                      unsat(false), mShares(1){
 }
 
 
 Conjunction::Conjunction(int arity, int inarity)
-    : mTupleDecl(arity), mInArity(inarity), unsat(false){
+    : mTupleDecl(arity), mInArity(inarity), unsat(false), mShares(1){
 }
 
-Conjunction::Conjunction(const Conjunction& other) {
+Conjunction::Conjunction(const Conjunction& other) : mShares(1) {
     *this = other;
 }
 
@@ -179,6 +314,22 @@ Conjunction& Conjunction::operator=(const Conjunction& other) {
     return *this;
 }
 
+Conjunction::Conjunction(Conjunction&& other) : mInArity(0), unsat(false),
+                                                 mShares(1) {
+    *this = std::move(other);
+}
+
+Conjunction& Conjunction::operator=(Conjunction&& other) {
+    if (this == &other) { return *this; }
+    reset();
+    mEqualities.swap(other.mEqualities);
+    mInequalities.swap(other.mInequalities);
+    mTupleDecl = std::move(other.mTupleDecl);
+    mInArity = other.mInArity;
+    unsat = other.unsat;
+    return *this;
+}
+
 void Conjunction::reset() {
     for (std::list<Exp*>::iterator i=mEqualities.begin();
                 i != mEqualities.end(); i++) {
@@ -230,7 +381,22 @@ Conjunction* Conjunction::clone() const {
     return new Conjunction(*this);
 }
 
-/*! Less than operator.
+Conjunction* Conjunction::share() const {
+    mShares.fetch_add(1, std::memory_order_relaxed);
+    return const_cast<Conjunction*>(this);
+}
+
+void Conjunction::release() {
+    if (mShares.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
+
+bool Conjunction::isShared() const {
+    return mShares.load(std::memory_order_acquire) > 1;
+}
+
+/*! Three-way comparison, used by operator< and operator==.
 **      Compare two Conjunction in the following order:
 **          1. by tuple declaration: using TupleDecl::operator<(TupleDecl)
 **          2. by number of equalities: number of terms in mEqualities
@@ -242,18 +408,18 @@ Conjunction* Conjunction::clone() const {
 **          compared.
 ** @param other, object to be compared
 */
-bool Conjunction::operator<( const Conjunction& other) const {
+int Conjunction::compare( const Conjunction& other) const {
     // 1. compare tuple declarations
-    if (mTupleDecl < other.mTupleDecl) { return true; }
-    if (other.mTupleDecl < mTupleDecl) { return false; }
+    int tdeclComparison = mTupleDecl.compare(other.mTupleDecl);
+    if (tdeclComparison != 0) { return tdeclComparison; }
 
     // 2. compare equality sizes
-    if (mEqualities.size() < other.mEqualities.size()) { return true; }
-    if (other.mEqualities.size() < mEqualities.size()) { return false; }
+    if (mEqualities.size() < other.mEqualities.size()) { return -1; }
+    if (other.mEqualities.size() < mEqualities.size()) { return 1; }
 
     // 3. compare inequality sizes
-    if (mInequalities.size() < other.mInequalities.size()) { return true; }
-    if (other.mInequalities.size() < mInequalities.size()) { return false; }
+    if (mInequalities.size() < other.mInequalities.size()) { return -1; }
+    if (other.mInequalities.size() < mInequalities.size()) { return 1; }
 
     // 4. compare sorted equalities lists
     std::list<Exp*>::const_iterator thisIter;
@@ -262,8 +428,8 @@ bool Conjunction::operator<( const Conjunction& other) const {
     thisIter = mEqualities.begin();
     while (thisIter != mEqualities.end()) {
         //compare values
-        if (**thisIter < **otherIter) { return true; }
-        if (**otherIter < **thisIter) { return false; }
+        int expComparison = (*thisIter)->compare(**otherIter);
+        if (expComparison != 0) { return expComparison; }
         //our mEqualities[i]'s are equal, continue
         ++thisIter;
         ++otherIter;
@@ -274,15 +440,30 @@ bool Conjunction::operator<( const Conjunction& other) const {
     for (thisIter = mInequalities.begin();
             thisIter != mInequalities.end(); ++thisIter) {
         //compare values
-        if (**thisIter < **otherIter) { return true; }
-        if (**otherIter < **thisIter) { return false; }
+        int expComparison = (*thisIter)->compare(**otherIter);
+        if (expComparison != 0) { return expComparison; }
         //our mInequalities[i]'s are equal, continue
         ++otherIter;
     }
 
-    // All our elements are equal, so we are not less than other
-    return false;
+    // All our elements are equal
+    return 0;
+}
 
+//! Hash of the tuple declaration and the sorted constraint lists.
+std::size_t Conjunction::hash() const {
+    std::size_t seed = mTupleDecl.hash();
+    hashCombine(seed, mEqualities.size());
+    for (std::list<Exp*>::const_iterator i=mEqualities.begin();
+            i != mEqualities.end(); i++) {
+        hashCombine(seed, (*i)->hash());
+    }
+    hashCombine(seed, mInequalities.size());
+    for (std::list<Exp*>::const_iterator i=mInequalities.begin();
+            i != mInequalities.end(); i++) {
+        hashCombine(seed, (*i)->hash());
+    }
+    return seed;
 }
 
 //! Given inarity parameter is adopted.
@@ -342,6 +523,52 @@ void Conjunction::setTupleDecl( TupleDecl tuple_decl_in,
 }
 
 
+namespace {
+
+bool expLess(const Exp* a, const Exp* b) { return a->compare(*b) < 0; }
+
+//! Inserts exp (adopted) into the sorted constraints, or deletes it if
+//! an equal one is there already. Constraints mostly arrive in order,
+//! so the end of the list is checked first.
+void insertSortedUnique(std::list<Exp*>& constraints, Exp* exp) {
+    if (constraints.empty() || expLess(constraints.back(), exp)) {
+        constraints.push_back(exp);
+        return;
+    }
+    for (std::list<Exp*>::iterator i=constraints.begin();
+                i != constraints.end(); i++) {
+        int comparison = exp->compare(**i);
+        if (comparison == 0) {
+            delete exp;
+            return;
+        }
+        if (comparison < 0) {
+            constraints.insert(i, exp);
+            return;
+        }
+    }
+}
+
+//! Sorts the constraints and deletes the duplicates, which are found by
+//! hashing first so only the distinct ones are sorted.
+void sortUnique(std::list<Exp*>& constraints) {
+    std::unordered_set<const Exp*, ExpPtrHash, ExpPtrEqual> seen;
+    std::vector<Exp*> distinct;
+    distinct.reserve(constraints.size());
+    for (std::list<Exp*>::iterator i=constraints.begin();
+                i != constraints.end(); i++) {
+        if (seen.insert(*i).second) {
+            distinct.push_back(*i);
+        } else {
+            delete *i;
+        }
+    }
+    std::sort(distinct.begin(), distinct.end(), expLess);
+    constraints.assign(distinct.begin(), distinct.end());
+}
+
+}
+
 /*! addEquality -- add the given expression, interpreted as an
 ** equality (Exp = 0), to our list of equalities.
 ** Maintains a sorted order on the constraints.
@@ -360,23 +587,7 @@ void Conjunction::addEquality(Exp* equality) {
     // Setting the type of expression
     equality->setEquality();
 
-    for (std::list<Exp*>::iterator i=mEqualities.begin();
-                i != mEqualities.end(); i++) {
-        Exp* e = *i;
-
-        if(*equality == *e){
-            delete equality;
-            return;
-        }
-        if (*equality < *e) {
-            // We've found a term that belongs after the new one,
-            // so insert the new term here, and we're done.
-            mEqualities.insert(i, equality);
-            return;
-        }
-    }
-
-    mEqualities.push_back(equality);
+    insertSortedUnique(mEqualities, equality);
 }
 
 /*! addInequality -- add the given expression, interpreted as an
@@ -394,22 +605,7 @@ void Conjunction::addInequality(Exp* inequality) {
     // Setting the type of expression
     inequality->setInequality();
 
-    for (std::list<Exp*>::iterator i=mInequalities.begin();
-                i != mInequalities.end(); i++) {
-        Exp* e = *i;
-
-        if(*inequality == *e){
-            delete inequality;
-            return;
-        }
-        if (*inequality < *e) {
-            // We've found a term that belongs after the new one,
-            // so insert the new exp here, and we're done.
-            mInequalities.insert(i, inequality);
-            return;
-        }
-    }
-    mInequalities.push_back(inequality);
+    insertSortedUnique(mInequalities, inequality);
 }
 
 void Conjunction::substituteTupleDecl() {
@@ -442,20 +638,10 @@ void Conjunction::substituteTupleDecl() {
         }
     }
 
-    // perform the substitution on all our constraints
-    for (std::list<Exp*>::iterator expIter=mEqualities.begin();
-                expIter != mEqualities.end(); expIter++) {
-        (*expIter)->substitute(var2TupleVar);
-    }
-    for (std::list<Exp*>::iterator expIter=mInequalities.begin();
-                expIter != mInequalities.end(); expIter++) {
-        (*expIter)->substitute(var2TupleVar);
-    }
-
+    // perform the substitution on all our constraints.
     // The order of tuple locations may not match the previous alphabetical
-    // order of the symbols we've replaced.  So, we need to renormalize now.
-    this->cleanUp();
-
+    // order of the symbols we've replaced, so this renormalizes as well.
+    substituteInConstraints(var2TupleVar);
 }
 
 /*! copyConstraintsFrom -- copy all the equalities and inequalities
@@ -475,10 +661,13 @@ void Conjunction::copyConstraintsFrom(const Conjunction *source) {
 /*! Substitute each factor (i.e. the non-coefficient
 ** part of a term) with the expression mapped to that factor 
 ** in all our equalities and inequalities.
+** All substitutions are done in one pass over the constraints, each
+** term costing one lookup in the map, so substituting for many tuple
+** variables at once is linear in the size of the constraints.
 ** Calls cleanup at end to resort constraints.
 ** \param searchTermToSubExp (none of the Term* or Exp* are adopted)
 */
-void Conjunction::substituteInConstraints(SubMap& searchTermToSubExp) {
+void Conjunction::substituteInConstraints(const SubMap& searchTermToSubExp) {
 
     // straight-forward substitution into equalities
     std::list<Exp*>::iterator expIter=mEqualities.begin();
@@ -1322,23 +1511,21 @@ void Conjunction::cleanUp() {
         (*i) = temp->collapseNestedInvertibleFunctions();
         delete temp;
 
-        // remove zero expressions
+        // normalize what the collapse left and remove zero expressions
+        (*i)->normalizeForEquality();
         if((*i)->equalsZero()){
             std::list<Exp*>::iterator old = i;
             i++;
             delete *old;
             mEqualities.erase(old);
-        } else { i++; }
+        } else {
+            (*i)->setEquality();
+            i++;
+        }
     }
 
-    // copy the current list of equalities and then add then
-    // so they are added in order and duplicates are eliminated
-    std::list<Exp*> equalityListCopy = mEqualities;
-    mEqualities.clear();
-    for (std::list<Exp*>::iterator i=equalityListCopy.begin();
-            i != equalityListCopy.end(); i++) {
-        this->addEquality(*i);
-    }
+    // sort the equalities and eliminate duplicates
+    sortUnique(mEqualities);
 
     // Remove zero inequalities
     for (std::list<Exp*>::iterator i=mInequalities.begin();
@@ -1354,17 +1541,14 @@ void Conjunction::cleanUp() {
             i++;
             delete *old;
             mInequalities.erase(old);
-        } else { i++; }
+        } else {
+            (*i)->setInequality();
+            i++;
+        }
     }
 
-    // copy the current list of inequalities and then add then
-    // so they are added in order and duplicates are eliminated
-    std::list<Exp*> inequalityListCopy = mInequalities;
-    mInequalities.clear();
-    for (std::list<Exp*>::iterator i=inequalityListCopy.begin();
-            i != inequalityListCopy.end(); i++) {
-        this->addInequality(*i);
-    }
+    // sort the inequalities and eliminate duplicates
+    sortUnique(mInequalities);
 
 }
 
@@ -1462,16 +1646,31 @@ void Conjunction::groupIndexedUFCalls() {
 
 /**************************** SparseConstraints *******************************/
 
-SparseConstraints::SparseConstraints(){
+SparseConstraints::SparseConstraints() : mCleanedUp(false) {
 }
 
-SparseConstraints::SparseConstraints(const SparseConstraints& other) {
+SparseConstraints::SparseConstraints(const SparseConstraints& other)
+  : mCleanedUp(false) {
     *this = other;
 }
 
 SparseConstraints&
 SparseConstraints::operator=(const SparseConstraints& other) {
+    if (this == &other) { return *this; }
     reset();
+    if (other.mCleanedUp) {
+        // Already sorted and cleaned up, so share the conjunctions and
+        // only drop duplicates like addConjunction would.
+        for (std::list<Conjunction*>::const_iterator
+                i=other.mConjunctions.begin();
+                i != other.mConjunctions.end(); i++) {
+            if (mConjunctions.empty() || !(*mConjunctions.back() == **i)) {
+                mConjunctions.push_back((*i)->share());
+            }
+        }
+        mCleanedUp = true;
+        return *this;
+    }
     for (std::list<Conjunction*>::const_iterator i=other.mConjunctions.begin();
                 i != other.mConjunctions.end(); i++) {
         this->addConjunction(new Conjunction(**i));
@@ -1480,7 +1679,22 @@ SparseConstraints::operator=(const SparseConstraints& other) {
     return *this;
 }
 
-/*! Less than operator.
+SparseConstraints::SparseConstraints(SparseConstraints&& other)
+  : mCleanedUp(other.mCleanedUp) {
+    mConjunctions.swap(other.mConjunctions);
+    other.mCleanedUp = false;
+}
+
+SparseConstraints& SparseConstraints::operator=(SparseConstraints&& other) {
+    if (this == &other) { return *this; }
+    reset();
+    mConjunctions.swap(other.mConjunctions);
+    mCleanedUp = other.mCleanedUp;
+    other.mCleanedUp = false;
+    return *this;
+}
+
+/*! Three-way comparison, used by operator<.
 **      Compare two SparseConstraints in the following order:
 **          1. by number of conjunctions: number of Conjunctions in mConjunctions
 **          2. by sorted conjunctions list values: using Conjunction::operator<(Exp)
@@ -1488,10 +1702,10 @@ SparseConstraints::operator=(const SparseConstraints& other) {
 **          is sorted for both SparseConstraints being compared.
 ** @param other, object to be compared
 */
-bool SparseConstraints::operator<(const SparseConstraints& other) const {
+int SparseConstraints::compare(const SparseConstraints& other) const {
     // 1. compare equality sizes
-    if (mConjunctions.size() < other.mConjunctions.size()) { return true; }
-    if (other.mConjunctions.size() < mConjunctions.size()) { return false; }
+    if (mConjunctions.size() < other.mConjunctions.size()) { return -1; }
+    if (other.mConjunctions.size() < mConjunctions.size()) { return 1; }
 
     // 2. compare sorted conjunctions list values
     std::list<Conjunction*>::const_iterator thisIter;
@@ -1501,23 +1715,45 @@ bool SparseConstraints::operator<(const SparseConstraints& other) const {
     
     while ( thisIter != mConjunctions.end() ) {
         //compare values
-        if (**thisIter < **otherIter) { return true; }
-        if (**otherIter < **thisIter) { return false; }
+        int conjComparison = (*thisIter)->compare(**otherIter);
+        if (conjComparison != 0) { return conjComparison; }
         //our mEqualities[i]'s are equal, continue
         ++thisIter;
         ++otherIter;
     }
 
-    // All our elements are equal, so we are not less than other
-    return false;
+    // All our elements are equal
+    return 0;
+}
+
+std::size_t SparseConstraints::hash() const {
+    std::size_t seed = mConjunctions.size();
+    for (std::list<Conjunction*>::const_iterator i=mConjunctions.begin();
+            i != mConjunctions.end(); i++) {
+        hashCombine(seed, (*i)->hash());
+    }
+    return seed;
 }
 
 void SparseConstraints::reset() {
     for (std::list<Conjunction*>::iterator i=mConjunctions.begin();
                 i != mConjunctions.end(); i++) {
-        delete (*i);
+        (*i)->release();
     }
     mConjunctions.clear();
+    mCleanedUp = false;
+}
+
+void SparseConstraints::unshareConjunctions() {
+    for (std::list<Conjunction*>::iterator i=mConjunctions.begin();
+                i != mConjunctions.end(); i++) {
+        if ((*i)->isShared()) {
+            Conjunction* shared = *i;
+            *i = shared->clone();
+            shared->release();
+        }
+    }
+    mCleanedUp = false;
 }
 
 SparseConstraints::~SparseConstraints() {
@@ -1529,6 +1765,7 @@ SparseConstraints::~SparseConstraints() {
 //! If replacing a constant with a variable ignores the substitution
 //! in that conjunction.
 void SparseConstraints::setTupleDecl( TupleDecl tuple_decl ) {
+    unshareConjunctions();
     for (std::list<Conjunction*>::iterator i=mConjunctions.begin();
             i != mConjunctions.end(); i++) {
         Conjunction* c = *i;
@@ -1547,7 +1784,7 @@ TupleDecl SparseConstraints::getTupleDecl(  ) const {
 //! in that conjunction.
 void SparseConstraints::setTupleDecl( TupleDecl tuple_decl_in, 
                                       TupleDecl tuple_decl_out ) {
-
+    unshareConjunctions();
     for (std::list<Conjunction*>::iterator i=mConjunctions.begin();
             i != mConjunctions.end(); i++) {
         Conjunction* c = *i;
@@ -1562,8 +1799,9 @@ void SparseConstraints::addConjunction(Conjunction *adoptedConjunction) {
     // If the Set/Relation was created with only an arity or TupleDecl
     // then there will be a single empty conjunction to indicate TRUE.
     // No Conjunction indicates FALSE.  Remove the empty Conjunction.
+    mCleanedUp = false;
     if (mConjunctions.size()==1 && ! mConjunctions.front()->hasConstraints()) {
-        delete mConjunctions.front();
+        mConjunctions.front()->release();
         mConjunctions.clear();
     }
 
@@ -1575,7 +1813,7 @@ void SparseConstraints::addConjunction(Conjunction *adoptedConjunction) {
 
         if (!(*adoptedConjunction < *c) && !(*c < *adoptedConjunction)) {
             //This conjunction already exists, no need to add it
-            delete adoptedConjunction;
+            adoptedConjunction->release();
             return;
         }
 
@@ -1648,23 +1886,27 @@ std::string SparseConstraints::toISLString(int aritySplit) const {
 
     // collect all symbolic/parameter variable names
     // and print the declaration for the symbolics
+    // (conjunctions of a union can share symbols, isl wants each once)
     std::stringstream ss;
     StringIterator * symIter;
+    std::set<std::string> declared;
     bool foundSymbols = false;
     for (std::list<Conjunction*>::const_iterator i=mConjunctions.begin();
             i != mConjunctions.end(); i++) {
         symIter = (*i)->getSymbolIterator();
         while (symIter->hasNext()) {
+            std::string sym = symIter->next();
+            if (!declared.insert(sym).second) { continue; }
             // print out start of symbol declaration at first symbol
             if (foundSymbols == false) {
                 ss << "[ ";
                 foundSymbols = true;
                 // print the symbol declaration itself
-                ss << symIter->next();
+                ss << sym;
 
             // later symbols will have a comma and then var name
             } else {
-                ss << ", " << symIter->next();
+                ss << ", " << sym;
             }
         }
         delete symIter;
@@ -1725,6 +1967,7 @@ SparseConstraints::substituteInConstraints(SubMap& searchTermToSubExp) {
     }
 
     // Each conjunction should do it's own substitution.
+    unshareConjunctions();
     for (std::list<Conjunction*>::const_iterator i=mConjunctions.begin();
                 i != mConjunctions.end(); i++) {
         (*i)->substituteInConstraints(searchTermToSubExp);
@@ -1742,6 +1985,10 @@ bool _compareConjunctions( Conjunction* first, Conjunction* second ) {
 // make the conjunction unsatisfiable.  Should deal with this in release 2
 // and use ISL.
 void SparseConstraints::cleanUp(){
+    // Nothing changed since the last cleanUp, and the conjunctions stay
+    // shared with the copies.
+    if (mCleanedUp) { return; }
+    unshareConjunctions();
     // removes duplicate constraints, FIXME: does it also resort constraints?
     for (std::list<Conjunction*>::const_iterator i=mConjunctions.begin();
                 i != mConjunctions.end(); i++) {
@@ -1751,7 +1998,7 @@ void SparseConstraints::cleanUp(){
     for (std::list<Conjunction*>::iterator i=mConjunctions.begin();
                 i != mConjunctions.end(); ) {
         if (not (*i)->satisfiable()) {
-            delete (*i);
+            (*i)->release();
             mConjunctions.erase(i++);
         } else {
             i++;
@@ -1760,6 +2007,7 @@ void SparseConstraints::cleanUp(){
 
     //sort the list of conjunctions
     mConjunctions.sort(_compareConjunctions);
+    mCleanedUp = true;
 }
 
 /*! Find any TupleVarTerms in this expression (and subexpressions)
@@ -1771,6 +2019,7 @@ void SparseConstraints::cleanUp(){
 **  remapped.  For example some might be constants in the TupleDecl.
 */
 void SparseConstraints::remapTupleVars(const std::vector<int>& oldToNewLocs) {
+    unshareConjunctions();
     for (std::list<Conjunction*>::iterator iter=mConjunctions.begin();
             iter != mConjunctions.end(); iter++) {
         (*iter)->remapTupleVars(oldToNewLocs);
@@ -1797,29 +2046,18 @@ std::set<Exp> SparseConstraints::constraintsDifference(SparseConstraints* A){
   const std::list<Exp*> eqA = conjA->equalities();
   const std::list<Exp*> ineqA = conjA->inequalities();
 
-  int found = 0;
+  // Hash A's constraints once instead of scanning them for each of ours
+  std::unordered_set<const Exp*, ExpPtrHash, ExpPtrEqual>
+      eqASet(eqA.begin(), eqA.end()), ineqASet(ineqA.begin(), ineqA.end());
+
   for (std::list<Exp*>::const_iterator it=eqB.begin(); it != eqB.end(); it++){
-    found = 0;
-    for (std::list<Exp*>::const_iterator jt=eqA.begin(); jt != eqA.end(); jt++){
-      if( (*(*it)) == (*(*jt)) ){ 
-        found = 1;
-        break;
-      }
-    }
-    if(!found){
+    if( eqASet.find(*it) == eqASet.end() ){
       diffSet.insert( *(*it) );
     }  
   }
 
   for (std::list<Exp*>::const_iterator it=ineqB.begin(); it != ineqB.end(); it++){
-    found = 0;
-    for (std::list<Exp*>::const_iterator jt=ineqA.begin(); jt != ineqA.end(); jt++){
-      if( (*(*it)) == (*(*jt)) ){ 
-        found = 1;
-        break;
-      }
-    }
-    if(!found){
+    if( ineqASet.find(*it) == ineqASet.end() ){
       diffSet.insert( *(*it) );
     }  
   }
@@ -1835,7 +2073,8 @@ std::set<Exp> SparseConstraints::constraintsDifference(SparseConstraints* A){
 /********************************** Set ***************************************/
 Set::Set(std::string str) {
     Set* s = parser::parse_set(str); // parse string
-    *this = *s; // copy created Set
+    *this = std::move(*s); // take over created Set
+    cleanUp();
     delete s;
 }
 
@@ -1859,26 +2098,30 @@ Set& Set::operator=(const Set& other) {
     mArity = other.mArity;
     return *this;
 }
-/*! Equal operator.
-** 
-** @param other, object to be compared
-*/
-bool Set::operator==( const Set& other) const {
-    if ((*this) < other){ return false; }
-    if ( other < (*this)){ return false; }
-    return true;
+Set::Set(Set&& other) : SparseConstraints(std::move(other)),
+                        mArity(other.mArity) {
 }
-
-/*! Less than operator.
+Set& Set::operator=(Set&& other) {
+    SparseConstraints::operator=(std::move(other));
+    mArity = other.mArity;
+    return *this;
+}
+/*! Three-way comparison, used by operator< and operator==.
 **      Compare two Set in the following order:
 **          1. by arity: mArity
-**          2. by Conjunctions: using SparseConstraints::operator<(Exp)
+**          2. by Conjunctions: using SparseConstraints::compare
 ** @param other, object to be compared
 */
-bool Set::operator<( const Set& other) const {
-    if ((*this).mArity < other.mArity){ return true; }
-    if ((*this).mArity > other.mArity){ return false; }
-    return (static_cast<SparseConstraints>(*this) < static_cast<SparseConstraints>(other));
+int Set::compare( const Set& other) const {
+    if ((*this).mArity < other.mArity){ return -1; }
+    if ((*this).mArity > other.mArity){ return 1; }
+    return SparseConstraints::compare(other);
+}
+
+std::size_t Set::hash() const {
+    std::size_t seed = mArity;
+    hashCombine(seed, SparseConstraints::hash());
+    return seed;
 }
 
 Set::~Set() {
@@ -1921,20 +2164,20 @@ Set* Set::Union(const Set* rhs) const{
     // conjunction before adding in conjunctions of other sets.
     if (result->mConjunctions.size()==1 
             && ! result->mConjunctions.front()->hasConstraints()) {
-        delete result->mConjunctions.front();
+        result->mConjunctions.front()->release();
         result->mConjunctions.clear();
     }
     
     // Add in conjunctions from lhs/this set.
     for (std::list<Conjunction*>::const_iterator i=mConjunctions.begin();
         i != mConjunctions.end(); i++) {
-        result->addConjunction(new Conjunction(**i));
+        result->addConjunction((*i)->share());
     }
 
     // Add in conjunctions from other set.
     for (std::list<Conjunction*>::const_iterator i=rhs->mConjunctions.begin();
         i != rhs->mConjunctions.end(); i++) {
-        result->addConjunction(new Conjunction(**i));
+        result->addConjunction((*i)->share());
     }
 
     return result;
@@ -1992,6 +2235,13 @@ Set* Set::boundTupleExp(const TupleExpTerm& tuple_exp) const {
 // Replace UFs with vars, pass to ISL, and then reverse substitution.
 void Set::normalize(bool bdr) {
 
+    // Reuse an earlier result for the same constraints if we are caching.
+    std::unique_ptr<Set> cache_input;
+    if (normalizeCacheCapacity() > 0) {
+        if (normalizeCacheLookup(*this, bdr, this)) { return; }
+        cache_input.reset(new Set(*this));
+    }
+
     // Sometimes to provide arguments of an UFC like sigma(a1, a2, ...)
     // we use another UFC that is not indexed like left(f). Here, the
     // expanded form would look like this: 
@@ -2012,8 +2262,10 @@ void Set::normalize(bool bdr) {
     Set* normalized_copy 
         = superset_normalized->reverseAffineSubstitution(uf_call_map);
    
-    // Replace self with the normalized copy.
-    *this = *normalized_copy;
+    // Take over the normalized copy.
+    *this = std::move(*normalized_copy);
+    cleanUp();
+    if (cache_input) { normalizeCacheInsert(*cache_input, bdr, *this); }
         
     // Cleanup
     delete normalized_copy;
@@ -2028,7 +2280,8 @@ void Set::normalize(bool bdr) {
 /******************************** Relation ************************************/
 Relation::Relation(std::string str) {
     Relation* r = parser::parse_relation(str); // parse relation
-    *this = *r; // copy created Relation
+    *this = std::move(*r); // take over created Relation
+    cleanUp();
     delete r;
 }
 
@@ -2047,6 +2300,18 @@ Relation& Relation::operator=(const Relation& other) {
     return *this;
 }
 
+Relation::Relation(Relation&& other)
+  : SparseConstraints(std::move(other)), mInArity(other.mInArity),
+    mOutArity(other.mOutArity) {
+}
+
+Relation& Relation::operator=(Relation&& other) {
+    mInArity = other.mInArity;
+    mOutArity = other.mOutArity;
+    SparseConstraints::operator=(std::move(other));
+    return *this;
+}
+
 // copies conjunctions from the Set, but keeps *this's mInArity
 // Checks for feasibility of mInArity in relation to other's mTupleDecl.size()
 Relation& Relation::operator=(const Set& other) {
@@ -2058,8 +2323,8 @@ Relation& Relation::operator=(const Set& other) {
 	mOutArity = other.arity() - mInArity;
 	
     reset();
-    for (std::list<Conjunction*>::const_iterator i=other.mConjunctions.begin();
-                i != other.mConjunctions.end(); i++) {
+    for (ConstConjunctionIterator i=other.conjunctionBegin();
+                i != other.conjunctionEnd(); i++) {
         // copy Set's conjunction with Relation's inArity     
         Conjunction* c = new Conjunction((*i)->arity(), mInArity);
         c->setTupleDecl((*i)->getTupleDecl());
@@ -2072,41 +2337,29 @@ Relation& Relation::operator=(const Set& other) {
     return *this;
 }
 
-/*! Equals operator.
-**      if self < other return false
-**      if other < self return false
-**      return true
-**   
-** @param other, object to be compared
-*/   
-bool Relation::operator==( const Relation& other) const {
-
-    if( (*this) < other){
-        return false;
-    }
-    if( other < (*this)){
-        return false;
-    }
-    return true;
-}
-
-/*! Less than operator.
+/*! Three-way comparison, used by operator< and operator==.
 **      Compare two Relation in the following order:
 **          1. by in arity: mInArity
 **          2. by out arity: mOutArity
-**          2. by Conjunctions: using SparseConstraints::operator<(Exp)
+**          2. by Conjunctions: using SparseConstraints::compare
 ** @param other, object to be compared
 */
-bool Relation::operator<( const Relation& other) const {
+int Relation::compare( const Relation& other) const {
     //In arity
-    if ((*this).mInArity < other.mInArity){ return true; }
-    if ((*this).mInArity > other.mInArity){ return false; }
+    if ((*this).mInArity < other.mInArity){ return -1; }
+    if ((*this).mInArity > other.mInArity){ return 1; }
     //Out arity
-    if ((*this).mOutArity < other.mOutArity){ return true; }
-    if ((*this).mOutArity > other.mOutArity){ return false; }
+    if ((*this).mOutArity < other.mOutArity){ return -1; }
+    if ((*this).mOutArity > other.mOutArity){ return 1; }
     //Conjunctions
-    return (static_cast<SparseConstraints>(*this) < 
-            static_cast<SparseConstraints>(other));
+    return SparseConstraints::compare(other);
+}
+
+std::size_t Relation::hash() const {
+    std::size_t seed = mInArity;
+    hashCombine(seed, mOutArity);
+    hashCombine(seed, SparseConstraints::hash());
+    return seed;
 }
 
 Relation::~Relation() {
@@ -2190,7 +2443,7 @@ Set *Relation::Apply(const Set* rhs) const {
     // Find all combinations of LHS relation and RHS set conjunctions.
     for (std::list<Conjunction*>::const_iterator lhsIter=mConjunctions.begin();
                 lhsIter != mConjunctions.end(); lhsIter++) {
-        for (std::list<Conjunction*>::const_iterator
+        for (ConstConjunctionIterator
                 rhsIter=rhs->conjunctionBegin();
                 rhsIter != rhs->conjunctionEnd(); rhsIter++) {
             Conjunction *combo = (*lhsIter)->Apply(*rhsIter);
@@ -2218,12 +2471,12 @@ Relation* Relation::Union(const Relation* rhs) const{
 
     for (std::list<Conjunction*>::const_iterator i=mConjunctions.begin();
         i != mConjunctions.end(); i++) {
-        result->addConjunction(new Conjunction(**i));
+        result->addConjunction((*i)->share());
     }
 
     for (std::list<Conjunction*>::const_iterator i=rhs->mConjunctions.begin();
         i != rhs->mConjunctions.end(); i++) {
-        result->addConjunction(new Conjunction(**i));
+        result->addConjunction((*i)->share());
     }
     //result->cleanUp();  FIXME: might want later when cleanup can merge
     //constraints that have adjacent constraints
@@ -2285,9 +2538,9 @@ Relation * Relation::Restrict(const Set *rhs) const {
 
 
     // Have to do cross product restrict in both sets.
-    for(std::list<Conjunction*>::const_iterator it =
+    for(ConstConjunctionIterator it =
             this->conjunctionBegin(); it != this->conjunctionEnd(); it++){
-        for(std::list<Conjunction*>::const_iterator it2 =
+        for(ConstConjunctionIterator it2 =
                 rhs->conjunctionBegin(); it2 != rhs->conjunctionEnd(); it2++) {
             Conjunction * conj = (*it)->Restrict(*it2);
             if (conj){
@@ -2374,6 +2627,13 @@ void Relation::addConjunction(Conjunction *adoptedConjunction) {
 // Replace UFs with vars, pass to ISL, and then reverse substitution.
 void Relation::normalize(bool bdr) {
 
+    // Reuse an earlier result for the same constraints if we are caching.
+    std::unique_ptr<Relation> cache_input;
+    if (normalizeCacheCapacity() > 0) {
+        if (normalizeCacheLookup(*this, bdr, this)) { return; }
+        cache_input.reset(new Relation(*this));
+    }
+
     // Sometimes to provide arguments of an UFC like sigma(a1, a2, ...)
     // we use another UFC that is not indexed like left(f). Here, the
     // expanded form would look like this: 
@@ -2394,8 +2654,10 @@ void Relation::normalize(bool bdr) {
     Relation* normalized_copy 
         = superset_normalized->reverseAffineSubstitution(uf_call_map);
 
-    // Replace self with the normalized copy.
-    *this = *normalized_copy;
+    // Take over the normalized copy.
+    *this = std::move(*normalized_copy);
+    cleanUp();
+    if (cache_input) { normalizeCacheInsert(*cache_input, bdr, *this); }
         
     // Cleanup
     delete normalized_copy;
@@ -2434,6 +2696,7 @@ void Conjunction::acceptVisitor(Visitor *v) {
 
 //! Visitor design pattern, see Visitor.h for usage
 void SparseConstraints::acceptVisitor(Visitor *v) {
+    unshareConjunctions();
     v->preVisitSparseConstraints(this);
     for (std::list<Conjunction*>::iterator i=mConjunctions.begin();
                 i != mConjunctions.end(); i++) {
@@ -2473,7 +2736,7 @@ class VisitorIndexUFC : public Visitor {
     //! For each UFC adds Domain & Range constraints to addedConstSet
     void postVisitUFCallTerm(UFCallTerm * t){
            
-        Set * s = queryDomainCurrEnv( t->name() );
+        Set * s = queryDomainCurrEnv( t->nameSymbol() );
         int act_nArg = s->arity();
         int cur_nArg = t->numArgs();
  
@@ -2579,8 +2842,8 @@ class VisitorBoundDomainRange : public Visitor {
          }
          //! Adds in all of the gathered constraints in addedConstSet for c
          void postVisitConjunction(iegenlib::Conjunction * c){
-             Conjunction *ct = c->Intersect(addedConstSet->mConjunctions.front());
-             *c = *ct;
+             Conjunction *ct = c->Intersect(*addedConstSet->conjunctionBegin());
+             *c = std::move(*ct);
              c->setInArity( in_ar );
              delete addedConstSet;
              delete ct;
@@ -2602,7 +2865,7 @@ void VisitorBoundDomainRange::preVisitUFCallTerm(UFCallTerm * t){
     }
 
     // look up bound for uninterpreted function
-    Set* domain = iegenlib::queryDomainCurrEnv(uf_call->name());
+    Set* domain = iegenlib::queryDomainCurrEnv(uf_call->nameSymbol());
 
     // have the domain create the constraints and store those constraints
     Set* constraintSet = domain->boundTupleExp(tuple_exp);
@@ -2624,7 +2887,7 @@ void VisitorBoundDomainRange::preVisitUFCallTerm(UFCallTerm * t){
    // and adding them as inequalities to constraints set
    {
     // look up range for uninterpreted function
-    Set* range = iegenlib::queryRangeCurrEnv(uf_call->name());
+    Set* range = iegenlib::queryRangeCurrEnv(uf_call->nameSymbol());
     
     // Assuming that uf call and its range align.
     if (! uf_call->isIndexed() 
@@ -3029,38 +3292,49 @@ Relation* Relation::reverseAffineSubstitution(UFCallMap* ufcmap)
 //! Vistor Classes used in projection process
 
 /*! The main class for projecting out tuple variables from affine Set/Relation
-**  We use ISL library to project out tvar from each conjunction
+**  We use fmProjectOut, or ISL library where it cannot, to project out tvars
+**  from each conjunction, all of them in one pass.
 */
 class VisitorProjectOut : public Visitor {
   private:
-    int tvar;
+    std::set<int> tvars;
+    // Number of tvars that are input tuple variables
+    int inProjected;
     int inArity;
     Set* newSet;
     Relation* newRelation;
     std::list<Conjunction*> mNewConj;
   public:
-    VisitorProjectOut(int itvar, int ia=0){
-        tvar = itvar;
+    VisitorProjectOut(const std::set<int>& itvars, int ia=0){
+        tvars = itvars;
         // Adjust inArity for after projection
-        if( tvar < ia && ia != 0 ){
-            ia--;
-        } 
-        inArity = ia;
+        inProjected = std::distance(tvars.begin(), tvars.lower_bound(ia));
+        inArity = ia - inProjected;
     }
-    // Projects out tuple varrable No. tvar from current conjunction
+    // Projects out tuple varrables tvars from current conjunction
     // And adds it to mNewConj
     void postVisitConjunction(iegenlib::Conjunction* c){
+        // Small affine conjunctions are projected without isl.
+        Conjunction* projected;
+        if (fmProjectOut(*c, tvars, &projected) == Projection_Native) {
+            if (projected) {
+                projected->setInArity( inArity );
+                mNewConj.push_back( projected );
+            }
+            return;
+        }
+
         Conjunction* cc = new Conjunction( *c );
         
         cc->setInArity(0);
         Set * cs = new Set(cc->arity() );
         cs->addConjunction(cc);
 
-        // Send through ISL to project out desired tuple variable
-        Set* islSet = islSetProjectOut(cs, tvar);
+        // Send through ISL to project out desired tuple variables
+        Set* islSet = islSetProjectOut(cs, tvars);
 
-        if( !(islSet->mConjunctions.empty()) ){
-            Conjunction* crc = new Conjunction ( *(islSet->mConjunctions.front()) );
+        if( islSet->conjunctionBegin() != islSet->conjunctionEnd() ){
+            Conjunction* crc = new Conjunction ( **islSet->conjunctionBegin() );
             crc->setInArity( inArity );
 
             // Storing the result so we could add it to new Set\Relation later
@@ -3072,7 +3346,7 @@ class VisitorProjectOut : public Visitor {
     }
     //! Add Conjunctions in mnewConj to newSet
     void postVisitSet(iegenlib::Set * s){
-        newSet = new Set( (s->arity()-1) );
+        newSet = new Set( (s->arity()-tvars.size()) );
 
         for(std::list<Conjunction*>::const_iterator i=mNewConj.begin();
                       i != mNewConj.end(); i++) {
@@ -3081,13 +3355,9 @@ class VisitorProjectOut : public Visitor {
     }
     //! Add Conjunctions in mnewConj to newRelation
     void postVisitRelation(iegenlib::Relation * r){
-        // Adjusting new in and out arity depending projected tvar 
-        int ia = r->inArity(), oa = r->outArity();
-        if( tvar < ia ){
-            ia--;
-        } else {
-            oa--;
-        }
+        // Adjusting new in and out arity depending projected tvars
+        int ia = r->inArity() - inProjected;
+        int oa = r->outArity() - (tvars.size() - inProjected);
         newRelation = new Relation( ia , oa );
 
         for(std::list<Conjunction*>::const_iterator i=mNewConj.begin();
@@ -3106,11 +3376,13 @@ class VisitorProjectOut : public Visitor {
 */
 class VisitorProjectOutCleanUp : public Visitor {
   private:
-    int tvar;
+    std::set<int> tvars;
     int nc_ufc;     // nested UFCallTerm count
 
   public:
-    VisitorProjectOutCleanUp(int itvar){ tvar = itvar;  nc_ufc = 0;}
+    VisitorProjectOutCleanUp(const std::set<int>& itvars){
+        tvars = itvars;  nc_ufc = 0;
+    }
     void preVisitUFCallTerm(iegenlib::UFCallTerm * t){
         nc_ufc++;
     }
@@ -3118,9 +3390,14 @@ class VisitorProjectOutCleanUp : public Visitor {
         nc_ufc--;
     }
     void preVisitTupleVarTerm(iegenlib::TupleVarTerm * t){
-        if( nc_ufc && t->tvloc() > tvar){
-            TupleVarTerm newT( t->coefficient() , t->tvloc()-1 );
-            *t = newT;
+        if( nc_ufc ){
+            // Shift down by the number of projected tvars before it
+            int shift = std::distance(tvars.begin(),
+                                      tvars.lower_bound(t->tvloc()));
+            if( shift ){
+                TupleVarTerm newT( t->coefficient() , t->tvloc()-shift );
+                *t = newT;
+            }
         }
     }
 };
@@ -3136,17 +3413,34 @@ class VisitorProjectOutCleanUp : public Visitor {
 */
 Set* Set::projectOut(int tvar)
 {
-    if (isUFCallParam(tvar)){
-      return NULL;
+    std::set<int> tvars;
+    tvars.insert(tvar);
+    return projectOut(tvars);
+}
+
+/*! Projects out all tuple varrables in tvars at once, if none of them is
+**  argument to any UFCall. Tuple variables are numbered as in
+**  projectOut(int), before any of them is projected out.
+**  Consequently, to project out j and jp from S: tvars = {1, 4}
+**     S = {[i,j,k,ip,jp,kp] : ...}
+*/
+Set* Set::projectOut(const std::set<int>& tvars)
+{
+    for (std::set<int>::const_iterator i = tvars.begin();
+            i != tvars.end(); i++) {
+        if (isUFCallParam(*i)){
+          return NULL;
+        }
     }
-    
+    if (tvars.empty()) { return new Set(*this); }
+
     // Geting a map of UFCalls 
-    iegenlib::UFCallMap *ufcmap = new UFCallMap();;
+    iegenlib::UFCallMap *ufcmap = new UFCallMap();
     // Getting the super affine set of constraints with no UFCallTerms
     Set* sup_s = this->superAffineSet(ufcmap, false);
 
-    // Projecting out tvar using ISL library
-    VisitorProjectOut* pv = new VisitorProjectOut(tvar, 0);
+    // Projecting out tvars using ISL library
+    VisitorProjectOut* pv = new VisitorProjectOut(tvars, 0);
     sup_s->acceptVisitor(pv);
     delete sup_s;
     sup_s = pv->getSet();
@@ -3154,13 +3448,14 @@ Set* Set::projectOut(int tvar)
     // Getting the reverseAffineSubstitution
     Set* result = sup_s->reverseAffineSubstitution(ufcmap);
 
-    // Adjusting changes in UFCTerms due to projection: _tvN -> _tvN-1
-    VisitorProjectOutCleanUp* cv = new VisitorProjectOutCleanUp(tvar);
+    // Adjusting changes in UFCTerms due to projection: _tvN -> _tvN-k
+    VisitorProjectOutCleanUp* cv = new VisitorProjectOutCleanUp(tvars);
     result->acceptVisitor(cv);
 
     delete sup_s;
     delete cv;
     delete pv;
+    delete ufcmap;
    
     return result;
 }
@@ -3176,17 +3471,31 @@ Set* Set::projectOut(int tvar)
 */
 Relation* Relation::projectOut(int tvar)
 {
-    if (isUFCallParam(tvar)){
-      return NULL;
+    std::set<int> tvars;
+    tvars.insert(tvar);
+    return projectOut(tvars);
+}
+
+/*! Same as Set::projectOut(const std::set<int>&), tvars are numbered
+**  based on total ariety (in+out).
+*/
+Relation* Relation::projectOut(const std::set<int>& tvars)
+{
+    for (std::set<int>::const_iterator i = tvars.begin();
+            i != tvars.end(); i++) {
+        if (isUFCallParam(*i)){
+          return NULL;
+        }
     }
-    
+    if (tvars.empty()) { return new Relation(*this); }
+
     // Geting a map of UFCalls 
     iegenlib::UFCallMap *ufcmap = new UFCallMap();
     // Getting the super affine set of constraints with no UFCallTerms
     Relation* sup_r = this->superAffineRelation(ufcmap, false);
 
-    // Projecting out tvar using ISL library
-    VisitorProjectOut* pv = new VisitorProjectOut(tvar, sup_r->inArity());
+    // Projecting out tvars using ISL library
+    VisitorProjectOut* pv = new VisitorProjectOut(tvars, sup_r->inArity());
     sup_r->acceptVisitor(pv);
     delete sup_r;
     sup_r = pv->getRelation();
@@ -3194,13 +3503,14 @@ Relation* Relation::projectOut(int tvar)
     // Getting the reverseAffineSubstitution
     Relation* result = sup_r->reverseAffineSubstitution(ufcmap);
 
-    // Adjusting changes in UFCTerms due to projection: _tvN -> _tvN-1
-    VisitorProjectOutCleanUp* cv = new VisitorProjectOutCleanUp(tvar);
+    // Adjusting changes in UFCTerms due to projection: _tvN -> _tvN-k
+    VisitorProjectOutCleanUp* cv = new VisitorProjectOutCleanUp(tvars);
     result->acceptVisitor(cv);
 
     delete sup_r;
     delete cv;
     delete pv;
+    delete ufcmap;
    
     return result;
 }
@@ -3352,7 +3662,8 @@ void SparseConstraints::removeUFCallConsts(int i)
 
     SparseConstraints* result = v->getSparseConstraints();
 
-    *this = *result;
+    *this = std::move(*result);
+    cleanUp();
 
     delete result;
 }
@@ -3485,18 +3796,30 @@ Relation* Relation::simplifyForPartialParallel(std::set<int> parallelTvs)
 */
 class VisitorGatherAllParameters : public Visitor {
   private:
-    std::set<Exp> instExps; 
+    // Most parameters are seen many times, hashing keeps the
+    // duplicate checks cheap.
+    std::unordered_map<Exp, std::set<std::string> > instExps; 
 
   public:
     VisitorGatherAllParameters(){}
     virtual ~VisitorGatherAllParameters(){}
 
     void preVisitUFCallTerm(UFCallTerm * t){
-        instExps.insert( *(t->getParamExp(0)) );
+        instExps[ *(t->getParamExp(0)) ].insert( t->name() );
     }
 
     std::set<Exp> getExps() { 
-        return instExps;
+        std::set<Exp> exps;
+        for (auto it = instExps.begin(); it != instExps.end(); ++it) {
+            exps.insert( it->first );
+        }
+        return exps;
+    }
+
+    //! Each parameter with the names of the UFs it is passed to.
+    std::map<Exp, std::set<std::string> > getArgumentUFs() { 
+        return std::map<Exp, std::set<std::string> >(instExps.begin(),
+                                                      instExps.end());
     }
 };
 
@@ -3514,68 +3837,61 @@ class VisitorGatherAllParameters : public Visitor {
    we want to return:
       < i <= col(j) , f(i) <= g(col(j)) >
 */
+namespace {
+
+// Substitutes the rule variables in one side of a rule and returns the
+// constraints of its super affine set: "true", "false" or the constraints.
+std::string instantiateSide(Set* ruleSide, SubMap& subMap,
+                            UFCallMap *ufcmap, TupleDecl origTupleDecl){
+  Set *side = new Set( *ruleSide );
+  side->substituteInConstraints( subMap );
+  // make rule's tuple declaration to match original constraints 
+  side->setTupleDecl(origTupleDecl);
+
+  // create superAffine set of the side
+  Set *supAff = side->superAffineSet(ufcmap, false);
+  delete side;
+
+  // we only need the constraint part of the side
+  srParts parts = getPartsFromStr(supAff->prettyPrintString());
+  delete supAff;
+  parts.constraints = trim(parts.constraints);
+  if(parts.constraints == ""){ return "true"; }
+  if(parts.constraints == "FALSE"){ return "false"; }
+  return parts.constraints;
+}
+
+// Map for substituting uni. quant. vars. in a rule with x1 and x2.
+void ruleSubMap(SubMap& subMap, const Exp& x1, const Exp& x2){
+  subMap.insertPair( new TupleVarTerm( 0 ), new Exp( x1 ) );
+  subMap.insertPair( new TupleVarTerm( 1 ), new Exp( x2 ) );
+}
+
+}
+
 std::pair <std::string,std::string> instantiate(
           UniQuantRule* uqRule, Exp x1, Exp x2, 
           UFCallMap *ufcmap, TupleDecl origTupleDecl){
-  
-  Set *leftSideOfTheRule, *rightSideOfTheRule;
-
-  // Create map for substituting uni. quant. vars. in a rule
-  //  with expressions from our list. 
   SubMap subMap;
-  TupleVarTerm *uQV = new TupleVarTerm( 0 );
-  Exp *subExp = new Exp( x1 ); 
-  subMap.insertPair( uQV , subExp );
-  uQV = new TupleVarTerm( 1 );
-  subExp = new Exp( x2 ); 
-  subMap.insertPair( uQV , subExp );
-
-  // Substitute universially quantified variables 
-  // with terms from list of terms
-  leftSideOfTheRule = new Set ( *(uqRule->getLeftSide()) );
-  rightSideOfTheRule = new Set ( *(uqRule->getRightSide()) );
-  leftSideOfTheRule->substituteInConstraints( subMap );
-  rightSideOfTheRule->substituteInConstraints( subMap );
-
-  // make rule's tuple declaration to match original constraints 
-  leftSideOfTheRule->setTupleDecl(origTupleDecl); 
-  rightSideOfTheRule->setTupleDecl(origTupleDecl);
-
-  // create superAffine sets of left/right sides
-  Set *supAffLeft, *supAffRight;
-  supAffLeft  = leftSideOfTheRule->superAffineSet(ufcmap, false);
-  supAffRight = rightSideOfTheRule->superAffineSet(ufcmap, false);
-  delete leftSideOfTheRule;
-  delete rightSideOfTheRule;
-
-  // we only need the constraint part of left/right sides 
-  // that are stored as separate sets.
-  srParts subLeftSideParts, subRightSideParts;
-  subLeftSideParts = getPartsFromStr(supAffLeft->prettyPrintString());
-  subRightSideParts = getPartsFromStr(supAffRight->prettyPrintString());
-  subLeftSideParts.constraints = trim(subLeftSideParts.constraints);
-  subRightSideParts.constraints = trim(subRightSideParts.constraints);
-  std::string leftStr = "false", rightStr = "false";
-  if(subLeftSideParts.constraints == ""){  leftStr = "true"; } 
-  else if(subLeftSideParts.constraints == "FALSE"){  leftStr = "false";}
-  else { leftStr = subLeftSideParts.constraints; }
-  if(subRightSideParts.constraints == ""){ rightStr = "true"; }
-  else if(subRightSideParts.constraints == "FALSE"){ rightStr = "false";}
-  else { rightStr = subRightSideParts.constraints; }
-
+  ruleSubMap(subMap, x1, x2);
+  std::string leftStr = instantiateSide(uqRule->getLeftSide(), subMap,
+                                        ufcmap, origTupleDecl);
+  std::string rightStr = instantiateSide(uqRule->getRightSide(), subMap,
+                                         ufcmap, origTupleDecl);
   return (std::make_pair( leftStr, rightStr));
 }
 
 
 // Builds list of symbolic constants from original constraints,
 // super affine set, and instantiations, so we can use it for isl input. 
-//  drOrigSet = original set with domain/range constraints
+//  drOrigSet = original set or relation with domain/range constraints
 //  ufcmap    = list of UFCs from super super affine set, and instantiations
-string symsForInstantiationSet(Set *drOrigSet, UFCallMap *ufcmap ){
+string symsForInstantiationSet(SparseConstraints *drOrigSet,
+                               UFCallMap *ufcmap ){
   std::stringstream ss;
   StringIterator * symIter;
   bool foundSymbols = false;
-  symIter = (*(drOrigSet->mConjunctions.begin()))->getSymbolIterator();
+  symIter = (*drOrigSet->conjunctionBegin())->getSymbolIterator();
   while (symIter->hasNext()) {
     if (foundSymbols == false) {
       foundSymbols = true;
@@ -3583,85 +3899,483 @@ string symsForInstantiationSet(Set *drOrigSet, UFCallMap *ufcmap ){
     } else { ss << ", " << symIter->next(); }
   }
   delete drOrigSet;
+  const std::string& ufcSyms = ufcmap->varTermStrList();
   std::string syms = "";
-  if( !((ss.str()).empty()) && !((ufcmap->varTermStrList()).empty()) ){
-    syms = "[" + ss.str() + ", " 
-                           + ufcmap->varTermStrList() + "] -> ";    
-  } else if ( (ufcmap->varTermStrList()).empty() ) {
+  if( !((ss.str()).empty()) && !(ufcSyms.empty()) ){
+    syms = "[" + ss.str() + ", " + ufcSyms + "] -> ";    
+  } else if ( ufcSyms.empty() ) {
     syms = "[" + ss.str() + "] -> ";   
   } else if ( (ss.str()).empty() ){
-    syms = "[" + ufcmap->varTermStrList() + "] -> "; 
+    syms = "[" + ufcSyms + "] -> "; 
   }
 
   return syms;
 }
 
+namespace {
+
+//! What an instantiation p -> q can add to a set.
+typedef enum {AddNothing, AddConsequent, AddComplementOfAntecedent}
+        InstantiationUse;
+
+std::mutex theInstantiationSetStatsMutex;
+InstantiationSetStats theInstantiationSetStats;
+
+void addInstantiationSetStats(const InstantiationSetStats& stats){
+  std::lock_guard<std::mutex> lock(theInstantiationSetStatsMutex);
+  theInstantiationSetStats.rounds += stats.rounds;
+  theInstantiationSetStats.gists += stats.gists;
+  theInstantiationSetStats.additions += stats.additions;
+  theInstantiationSetStats.calls += stats.calls;
+  theInstantiationSetStats.boundsUnsat += stats.boundsUnsat;
+}
+
+// Counts a detectUnsatOrFindEqualities call, and returns true if the
+// filter is on and bound propagation proves the constraints, bounded by
+// the domains and ranges of their UF calls, unsat.
+bool boundsDecideUnsat(const SparseConstraints& bounded){
+  InstantiationSetStats stats;
+  stats.calls = 1;
+  stats.boundsUnsat = boundsUnsatFilter() && boundsProveUnsat(bounded);
+  addInstantiationSetStats(stats);
+  return stats.boundsUnsat;
+}
+
+// If the antecedent is true in set the consequent can be added, if the
+// complement of the consequent is true the complement of the antecedent
+// can be added. None of the sets is consumed.
+InstantiationUse useOfInstantiation(isl_set* set, isl_set* antecedent,
+                                    isl_set* consequent,
+                                    unsigned long& gists){
+  gists++;
+  ISLSet ant_set( isl_set_gist(isl_set_copy(antecedent),
+                               isl_set_copy(set)) );
+  if (isl_set_plain_is_universe(ant_set.get())) {
+    return AddConsequent;
+  }
+  gists++;
+  ISLSet con_set( isl_set_complement(isl_set_copy(consequent)) );
+  con_set.reset( isl_set_gist(con_set.release(), isl_set_copy(set)) );
+  if (isl_set_plain_is_universe(con_set.get())) {
+    return AddComplementOfAntecedent;
+  }
+  return AddNothing;
+}
+
+// Same as above, reading the instantiation in ctx.
+InstantiationUse useOfInstantiation(isl_set* set,
+                                    const string& antecedentStr,
+                                    const string& consequentStr,
+                                    isl_ctx* ctx, unsigned long& gists){
+  ISLSet ant_set( isl_set_read_from_str(ctx, antecedentStr.c_str()) );
+  ISLSet con_set( isl_set_read_from_str(ctx, consequentStr.c_str()) );
+  return useOfInstantiation(set, ant_set.get(), con_set.get(), gists);
+}
+
+// Which parameters and set dimensions, in that order, s has constraints on.
+std::vector<bool> involvedDims(isl_set* s){
+  unsigned int params = isl_set_dim(s, isl_dim_param);
+  unsigned int dims = isl_set_dim(s, isl_dim_set);
+  std::vector<bool> involved(params + dims, false);
+  for (unsigned int i = 0; i < params; i++) {
+    involved[i] = isl_set_involves_dims(s, isl_dim_param, i, 1)
+                  == isl_bool_true;
+  }
+  for (unsigned int i = 0; i < dims; i++) {
+    involved[params + i] = isl_set_involves_dims(s, isl_dim_set, i, 1)
+                           == isl_bool_true;
+  }
+  return involved;
+}
+
+bool sharesDim(const std::vector<bool>& a, const std::vector<bool>& b){
+  // Instantiations are all read with the same parameters and tuple
+  // declaration, if the spaces differ anyway assume they overlap.
+  if (a.size() != b.size()) { return true; }
+  for (unsigned int i = 0; i < a.size(); i++) {
+    if (a[i] && b[i]) { return true; }
+  }
+  return false;
+}
+
+// Union-find over the parameters and set dimensions of a set, in the
+// order of involvedDims, followed by the existentials of each disjunct.
+struct DimLinks {
+  std::vector<unsigned int> parent;
+  unsigned int params;
+  unsigned int dims;
+  unsigned int divs;
+
+  unsigned int find(unsigned int i){
+    while (parent[i] != i) {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  }
+  void link(unsigned int a, unsigned int b){ parent[find(a)] = find(b); }
+};
+
+// Links every parameter, set dimension and existential c is on.
+isl_stat linkConstraintDims(isl_constraint* c, void* user){
+  DimLinks* links = (DimLinks*)user;
+  const enum isl_dim_type types[3] = {isl_dim_param, isl_dim_set,
+                                      isl_dim_div};
+  const unsigned int offsets[3] = {0, links->params, links->divs};
+  int first = -1;
+  for (unsigned int t = 0; t < 3; t++) {
+    int n = isl_constraint_dim(c, types[t]);
+    for (int i = 0; i < n; i++) {
+      if (isl_constraint_involves_dims(c, types[t], i, 1) != isl_bool_true){
+        continue;
+      }
+      unsigned int node = offsets[t] + i;
+      if (first < 0) { first = node; }
+      else { links->link(node, first); }
+    }
+  }
+  isl_constraint_free(c);
+  return isl_stat_ok;
+}
+
+isl_stat linkBasicSetDims(isl_basic_set* bset, void* user){
+  DimLinks* links = (DimLinks*)user;
+  links->divs = links->parent.size();
+  int divs = isl_basic_set_dim(bset, isl_dim_div);
+  for (int i = 0; i < divs; i++) {
+    links->parent.push_back(links->parent.size());
+  }
+  isl_basic_set_foreach_constraint(bset, &linkConstraintDims, links);
+  isl_basic_set_free(bset);
+  return isl_stat_ok;
+}
+
+// Which parameters and set dimensions, in the order of involvedDims, a
+// change to the dims in from can reach through the constraints of s.
+// With more than one disjunct, a change in one disjunct can leave
+// another as the only one left, so all constrained dims are linked.
+std::vector<bool> linkedDims(isl_set* s, const std::vector<bool>& from){
+  DimLinks links;
+  links.params = isl_set_dim(s, isl_dim_param);
+  links.dims = isl_set_dim(s, isl_dim_set);
+  unsigned int n = links.params + links.dims;
+  for (unsigned int i = 0; i < n; i++) { links.parent.push_back(i); }
+  isl_set_foreach_basic_set(s, &linkBasicSetDims, &links);
+
+  std::vector<bool> linked(n, false);
+  if (from.size() != n) { linked.assign(n, true); return linked; }
+  if (isl_set_n_basic_set(s) > 1) {
+    std::vector<bool> involved = involvedDims(s);
+    for (unsigned int i = 0; i < n; i++) {
+      if (involved[i]) { links.link(i, 0); }
+    }
+  }
+  std::vector<bool> reached(links.parent.size(), false);
+  for (unsigned int i = 0; i < n; i++) {
+    if (from[i]) { reached[links.find(i)] = true; }
+  }
+  for (unsigned int i = 0; i < n; i++) {
+    linked[i] = reached[links.find(i)];
+  }
+  return linked;
+}
+
+// Number of additions intersected with the set before it is coalesced.
+const unsigned int kInstantiationCoalesceBatch = 8;
+
+// Serial version of the loop in instantiationSet. Every instantiation is
+// read once. After an addition, only the instantiations that share a
+// dimension with the added part are looked at again, and the set is
+// coalesced every kInstantiationCoalesceBatch additions. An addition can
+// also tighten other dimensions through the constraints of the set, so
+// when the work list runs dry the instantiations not added yet that are
+// on a dimension the round's additions reach through the set (see
+// linkedDims) are queued for another round. The loop stops when a round
+// adds nothing or queues nothing, which makes the result a fixed point.
+void addInstantiationsWithWorkList(ISLSet& set,
+           const std::vector<std::pair <string,string> >& insts,
+           isl_ctx* ctx, InstantiationSetStats& stats){
+  std::vector<ISLSet> antecedents, consequents;
+  std::vector<std::vector<bool> > antDims, conDims;
+  antecedents.reserve(insts.size());
+  consequents.reserve(insts.size());
+  for (unsigned int i = 0; i < insts.size(); i++) {
+    antecedents.push_back(
+        ISLSet( isl_set_read_from_str(ctx, insts[i].first.c_str()) ));
+    consequents.push_back(
+        ISLSet( isl_set_read_from_str(ctx, insts[i].second.c_str()) ));
+    antDims.push_back( involvedDims(antecedents[i].get()) );
+    conDims.push_back( involvedDims(consequents[i].get()) );
+  }
+
+  std::vector<bool> added(insts.size(), false);
+  std::vector<bool> queued(insts.size(), true);
+  std::deque<unsigned int> work;
+  for (unsigned int i = 0; i < insts.size(); i++) { work.push_back(i); }
+
+  unsigned int uncoalesced = 0;
+  bool empty = false;
+  while (!empty) {
+    stats.rounds++;
+    bool changed = false;
+    std::vector<bool> roundTightened;
+    while (!work.empty() && !empty) {
+      unsigned int i = work.front();
+      work.pop_front();
+      queued[i] = false;
+      InstantiationUse use = useOfInstantiation(set.get(),
+                               antecedents[i].get(), consequents[i].get(),
+                               stats.gists);
+      if (use == AddNothing) { continue; }
+
+      isl_set* part = (use == AddConsequent)
+                    ? isl_set_copy(consequents[i].get())
+                    : isl_set_complement(isl_set_copy(antecedents[i].get()));
+      set.reset( isl_set_intersect(set.release(), part) );
+      added[i] = true;
+      changed = true;
+      stats.additions++;
+      if (++uncoalesced == kInstantiationCoalesceBatch) {
+        set.reset( isl_set_coalesce(set.release()) );
+        uncoalesced = 0;
+        empty = isl_set_is_empty(set.get());
+      }
+
+      const std::vector<bool>& tightened =
+          (use == AddConsequent) ? conDims[i] : antDims[i];
+      if (roundTightened.size() != tightened.size()) {
+        roundTightened.resize(tightened.size(), false);
+      }
+      for (unsigned int d = 0; d < tightened.size(); d++) {
+        if (tightened[d]) { roundTightened[d] = true; }
+      }
+      for (unsigned int j = 0; j < insts.size(); j++) {
+        if (added[j] || queued[j]) { continue; }
+        if (sharesDim(antDims[j], tightened) ||
+            sharesDim(conDims[j], tightened)) {
+          queued[j] = true;
+          work.push_back(j);
+        }
+      }
+    }
+    if (uncoalesced > 0) {
+      set.reset( isl_set_coalesce(set.release()) );
+      uncoalesced = 0;
+    }
+    empty = empty || isl_set_is_empty(set.get());
+    if (!changed || empty) { break; }
+
+    std::vector<bool> reached = linkedDims(set.get(), roundTightened);
+    for (unsigned int j = 0; j < insts.size(); j++) {
+      if (added[j] || queued[j]) { continue; }
+      if (sharesDim(antDims[j], reached) || sharesDim(conDims[j], reached)) {
+        queued[j] = true;
+        work.push_back(j);
+      }
+    }
+    if (work.empty()) { break; }
+  }
+}
+
+// An instantiation as isl sets in one isl context, read the first time a
+// thread looks at it.
+struct InstantiationSets {
+  ISLSet antecedent;
+  ISLSet consequent;
+
+  void read(const std::pair<string,string>& inst, isl_ctx* ctx){
+    if (antecedent) { return; }
+    antecedent.reset( isl_set_read_from_str(ctx, inst.first.c_str()) );
+    consequent.reset( isl_set_read_from_str(ctx, inst.second.c_str()) );
+  }
+};
+
+// What the threads of addInstantiationsInParallel share. The set is
+// handed to the workers as a string each round, all else stays on the
+// threads.
+struct InstantiationRounds {
+  InstantiationRounds(unsigned int size)
+      : uses(size, AddNothing), added(size, false), round(0),
+        finished(false), running(0), next(0) {}
+
+  std::vector<InstantiationUse> uses;
+  std::vector<bool> added;
+
+  std::mutex mutex;
+  std::condition_variable started;
+  std::condition_variable done;
+  unsigned int round;
+  bool finished;
+  unsigned int running;
+  string snapshot;
+  std::atomic<unsigned int> next;
+};
+
+// Decides for the instantiations not added yet that the thread claims
+// what they can add to set.
+void decideInstantiations(isl_set* set,
+           const std::vector<std::pair <string,string> >& insts,
+           std::vector<InstantiationSets>& sets, isl_ctx* ctx,
+           InstantiationRounds& rounds, unsigned long& gists){
+  for (unsigned int i = rounds.next++; i < insts.size();
+       i = rounds.next++) {
+    if (rounds.added[i]) { continue; }
+    sets[i].read(insts[i], ctx);
+    rounds.uses[i] = useOfInstantiation(set, sets[i].antecedent.get(),
+                                        sets[i].consequent.get(), gists);
+  }
+}
+
+// A worker thread of addInstantiationsInParallel, for all of its rounds.
+void instantiationWorker(
+           const std::vector<std::pair <string,string> >& insts,
+           InstantiationRounds& rounds, std::atomic<unsigned long>& gists){
+  ISLCtxScope scope;
+  std::vector<InstantiationSets> sets(insts.size());
+  unsigned int round = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(rounds.mutex);
+      rounds.started.wait(lock, [&]() {
+        return rounds.finished || rounds.round != round;
+      });
+      if (rounds.finished) { break; }
+      round = rounds.round;
+    }
+    ISLSet local( isl_set_read_from_str(scope.ctx(),
+                                        rounds.snapshot.c_str()) );
+    unsigned long localGists = 0;
+    decideInstantiations(local.get(), insts, sets, scope.ctx(), rounds,
+                         localGists);
+    gists += localGists;
+
+    std::lock_guard<std::mutex> lock(rounds.mutex);
+    if (--rounds.running == 0) { rounds.done.notify_one(); }
+  }
+}
+
+// Parallel version of the loop in instantiationSet. The calling thread
+// and threads - 1 workers, each on its own isl context, decide every
+// round for all instantiations not added yet what they can add to the
+// set. The workers are started once, read each instantiation once, and
+// only get the set, as a string, from round to round. The parts found are
+// then intersected with the set in instantiation order. Rounds are
+// repeated until one adds nothing, so the result only depends on the
+// instantiations, not on the threads.
+void addInstantiationsInParallel(ISLSet& set,
+           const std::vector<std::pair <string,string> >& insts,
+           unsigned int threads, isl_ctx* ctx,
+           InstantiationSetStats& stats){
+  InstantiationRounds rounds(insts.size());
+  std::atomic<unsigned long> gists(0);
+  std::vector<std::thread> pool;
+  for (unsigned int t = 1; t < threads; t++) {
+    pool.push_back(std::thread(instantiationWorker, std::cref(insts),
+                               std::ref(rounds), std::ref(gists)));
+  }
+  std::vector<InstantiationSets> sets(insts.size());
+
+  while (!isl_set_is_empty(set.get())) {
+    stats.rounds++;
+    char* snapshotStr = isl_set_to_str(set.get());
+    {
+      std::lock_guard<std::mutex> lock(rounds.mutex);
+      rounds.snapshot = snapshotStr;
+      rounds.next = 0;
+      rounds.running = pool.size();
+      rounds.round++;
+    }
+    free(snapshotStr);
+    rounds.started.notify_all();
+
+    unsigned long localGists = 0;
+    decideInstantiations(set.get(), insts, sets, ctx, rounds, localGists);
+    stats.gists += localGists;
+    {
+      std::unique_lock<std::mutex> lock(rounds.mutex);
+      rounds.done.wait(lock, [&]() { return rounds.running == 0; });
+    }
+
+    bool changed = false;
+    for (unsigned int i = 0; i < insts.size(); i++) {
+      if (rounds.added[i] || rounds.uses[i] == AddNothing) { continue; }
+      sets[i].read(insts[i], ctx);
+      isl_set* part = (rounds.uses[i] == AddConsequent)
+          ? isl_set_copy(sets[i].consequent.get())
+          : isl_set_complement(isl_set_copy(sets[i].antecedent.get()));
+      set.reset( isl_set_intersect(set.release(), part) );
+      rounds.added[i] = true;
+      changed = true;
+      stats.additions++;
+    }
+    if (!changed) { break; }
+    set.reset( isl_set_coalesce(set.release()) );
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(rounds.mutex);
+    rounds.finished = true;
+  }
+  rounds.started.notify_all();
+  for (unsigned int t = 0; t < pool.size(); t++) { pool[t].join(); }
+  stats.gists += gists;
+}
+
+}
+
 // This function creates a isl set from instantiations. The naive way to 
 // do this would be to put all the instantiation inside one Set 
 // and feed it isl. However, that would create a performance bottleneck,
 // since isl has to try to colasce and simplify 
 // lots of disjunctions at the same time. Instead of the naive way 
 // this function iteratively adds the useful instantiation.
-isl_set* instantiationSet( srParts supSetParts, 
+// See addInstantiationsWithWorkList, and addInstantiationsInParallel for
+// more than one thread.
+isl_set* instantiationSet( Set* supAffSet, srParts supSetParts, 
            std::set<std::pair <std::string,std::string>> instantiations,
-                               string syms , isl_ctx* ctx){
+                               string syms , isl_ctx* ctx,
+                               unsigned int threads = 1){
+
+  // Build original Set with all symbolic constants from instantiations.
+  // The super affine set goes to isl directly, we only need to line its
+  // parameters up with the ones the instantiations are read with.
+  // Intersecting with the universe read from the same declarations also
+  // keeps isl's reading of a tuple variable that has the same name as a
+  // symbolic constant (they are equal).
+  ISLSet set( islSetFromSet(supAffSet, ctx) );
+  if (set) {
+    string symsUniverse = syms + "{" + supSetParts.tupDecl + "}";
+    isl_set* universe = isl_set_read_from_str(ctx, symsUniverse.c_str());
+    set.reset( isl_set_align_params(set.release(),
+                                    isl_set_get_space(universe)) );
+    set.reset( isl_set_intersect(set.release(), universe) );
+  } else {
+    string origRel = syms + "{" + supSetParts.tupDecl + " : " + 
+                     supSetParts.constraints + "}";
+    set.reset( isl_set_read_from_str(ctx, origRel.c_str()) );
+  }
 
-  // Build original Set with all symbolic constants from instantiations
-  string origRel = syms + "{" + supSetParts.tupDecl + " : " + 
-                   supSetParts.constraints + "}";
+  // The instantiations as isl sets: {antecedent} and {consequent}
+  std::vector<std::pair <string,string> > insts;
+  for (std::set<std::pair <std::string,std::string>>::iterator 
+        it=instantiations.begin(); it!=instantiations.end(); it++){ 
+    insts.push_back( std::make_pair(
+        syms + "{" + supSetParts.tupDecl + " : " + (*it).first + "}",
+        syms + "{" + supSetParts.tupDecl + " : " + (*it).second + "}") );
+  }
 
   // Iteratively add useful instantiation utilizing isl functions
-  // We want to iterate until there is nothing useful to add.
-  // This condition is checked at the end of the loop. For most examples
-  // visiting everything 2 times must be enough. However, since
-  // there might be some unusual example, we put a cap (up to 2 times), so
-  // we would never end up looping many times even in rare occasions. 
-  isl_set* set = isl_set_read_from_str(ctx, origRel.c_str() );
-  isl_set* old_set = isl_set_copy(set);
-  for (int i = 0; i < 2; i++) {
-    for (std::set<std::pair <std::string,std::string>>::iterator 
-          it=instantiations.begin(); it!=instantiations.end(); it++){ 
-      string antecedentStr = syms + "{" + supSetParts.tupDecl + 
-                             " : " + (*it).first + "}";
-      string consequentStr = syms + "{" + supSetParts.tupDecl + 
-                             " : " + (*it).second + "}";
-      // If antecedent is true add the consequent of the instantiation
-      int added = 0;
-      {
-        isl_set* ant_set = isl_set_read_from_str(ctx, antecedentStr.c_str());
-        ant_set = isl_set_gist(ant_set, isl_set_copy(set));
-        if (isl_set_plain_is_universe(ant_set)) {
-          isl_set* con_set = isl_set_read_from_str(ctx, consequentStr.c_str());
-          set = isl_set_intersect(set, con_set);
-          set = isl_set_coalesce(set);
-          added = 1;
-        }
-        isl_set_free(ant_set);
-      }
-      // If complement of consequent is true add the complement of antecedent 
-      if (!added) {
-        isl_set* con_set = isl_set_read_from_str(ctx, consequentStr.c_str());
-        con_set = isl_set_complement(con_set);
-        con_set = isl_set_gist(con_set, isl_set_copy(set));
-        if (isl_set_plain_is_universe(con_set)) {
-          isl_set* ant_set = isl_set_read_from_str(ctx, antecedentStr.c_str());
-          ant_set = isl_set_complement(ant_set);
-          set = isl_set_intersect(set, ant_set);
-          set = isl_set_coalesce(set);
-          added = 1;
-        }
-        isl_set_free(con_set);
-      }
-    }
-    if( isl_set_is_empty(set) ) break;             // Set is UnSat
-    if ( isl_set_is_equal( old_set, set ) ){ break; // We have converged
-    } else {
-      isl_set_free(old_set);
-      old_set = isl_set_copy(set);
-    }
+  // until there is nothing useful to add.
+  InstantiationSetStats stats;
+  if (threads == 0) { threads = std::thread::hardware_concurrency(); }
+  if (threads > 1) {
+    addInstantiationsInParallel(set, insts, threads, ctx, stats);
+  } else {
+    addInstantiationsWithWorkList(set, insts, ctx, stats);
   }
+  addInstantiationSetStats(stats);
 
-  return set;
+  return set.release();
 }
 
 
@@ -3719,26 +4433,30 @@ class VisitorGetUsefulEqs : public Visitor {
 
 // Check to see if the isl set is empty (the original Set is UnSat)
 // or, it is not (the original Set is MaySat) in which case extract
-// new equalities and add them to original Set
+// new equalities and add them to original Set.
+// The function takes ownership of input argument 'set'.
 Set* checkIslSet(isl_set* set, isl_ctx* ctx, 
                       UFCallMap *ufcmap, Set *origSet ){
   Set *result = NULL;
-  if( isl_set_is_empty(set) ){
+  ISLSet iset(set);
+  if( isl_set_is_empty(iset.get()) ){
     result = NULL;
   } else {
-    isl_basic_set *bset = isl_set_affine_hull(set);
-    // Get an isl printer and associate to an isl context
-    isl_printer * ip = isl_printer_to_str(ctx);
-    // get string back from ISL set
-    isl_printer_set_output_format(ip , ISL_FORMAT_ISL);
-    isl_printer_print_basic_set(ip ,bset);
-    char *i_str = isl_printer_get_str(ip);
-    // clean-up
-    isl_printer_flush(ip);
-    isl_printer_free(ip);
-    isl_basic_set_free(bset);
+    ISLBasicSet bset( isl_set_affine_hull(iset.release()) );
     // Puting the newly found equalities into original constraint set.
-    Set* affineEqs = new Set(i_str);
+    // Read them straight out of the isl constraints when we can.
+    Set* affineEqs = setFromISLBasicSet(isl_basic_set_copy(bset.get()),
+                                        origSet->getTupleDecl());
+    if (!affineEqs) {
+      // Get an isl printer and associate to an isl context
+      ISLPrinter ip( isl_printer_to_str(ctx) );
+      // get string back from ISL set
+      ip.reset( isl_printer_set_output_format(ip.release(), ISL_FORMAT_ISL) );
+      ip.reset( isl_printer_print_basic_set(ip.release(), bset.get()) );
+      char *i_str = isl_printer_get_str(ip.get());
+      affineEqs = new Set(i_str);
+      free(i_str);
+    }
     Set* eQs = affineEqs->reverseAffineSubstitution(ufcmap);
 
     // Only keeping equalities that can potentially be useful. 
@@ -3753,12 +4471,107 @@ Set* checkIslSet(isl_set* set, isl_ctx* ctx,
     delete affineEqs;
     delete eQs;
     delete uEqs;
-    //free(i_str);
   }
   return result;
 }
 
 
+/*! Visitor Class used to index a universally quantified rule: the UF
+**  symbols it mentions, and for each rule variable the UFs it is passed to
+**  as a whole argument, e.g. {f} for e1 in e1 < e2 => f(e1) <= f(e2).
+*/
+class VisitorRuleShape : public Visitor {
+  private:
+    std::set<std::string> symbols;
+    std::vector<std::set<std::string> > argUFs;
+
+  public:
+    VisitorRuleShape(int arity) : argUFs(arity) {}
+
+    void preVisitUFCallTerm(UFCallTerm * t){
+        symbols.insert( t->name() );
+        for (unsigned int i = 0; i < t->numArgs(); i++) {
+            Term* arg = t->getParamExp(i)->getTerm();
+            TupleVarTerm* tv = dynamic_cast<TupleVarTerm*>(arg);
+            if (tv && tv->coefficient() == 1 && tv->tvloc() >= 0
+                   && tv->tvloc() < (int)argUFs.size()) {
+                argUFs[tv->tvloc()].insert( t->name() );
+            }
+        }
+    }
+
+    const std::set<std::string>& getSymbols() const { return symbols; }
+    const std::vector<std::set<std::string> >& getArgUFs() const {
+        return argUFs;
+    }
+};
+
+namespace {
+
+std::mutex theRuleStatsMutex;
+RuleInstantiationStats theRuleStats;
+
+bool intersects(const std::set<std::string>& a,
+                const std::set<std::string>& b){
+  for (std::set<std::string>::const_iterator it = a.begin();
+       it != a.end(); it++) {
+    if (b.count(*it)) { return true; }
+  }
+  return false;
+}
+
+// Groups the UF symbols of the rules: symbols get the same group when a
+// chain of rules links them.
+std::map<std::string, int> symbolGroups(
+        const std::vector<const std::set<std::string>*>& ruleSymbols){
+  std::map<std::string, int> group;
+  for (unsigned int r = 0; r < ruleSymbols.size(); r++) {
+    const std::set<std::string>& symbols = *ruleSymbols[r];
+    std::set<int> merged;
+    for (std::set<std::string>::const_iterator it = symbols.begin();
+         it != symbols.end(); it++) {
+      if (group.count(*it)) { merged.insert(group[*it]); }
+    }
+    for (std::map<std::string, int>::iterator it = group.begin();
+         it != group.end(); it++) {
+      if (merged.count(it->second)) { it->second = r; }
+    }
+    for (std::set<std::string>::const_iterator it = symbols.begin();
+         it != symbols.end(); it++) {
+      group[*it] = r;
+    }
+  }
+  return group;
+}
+
+// The expressions of instExps that a rule variable passed to the UFs in
+// varArgUFs may be instantiated with: those passed to a UF of the same
+// group.
+std::vector<const Exp*> compatibleExps(
+        const std::map<Exp, std::set<std::string> >& instExps,
+        const std::set<std::string>& varArgUFs,
+        std::map<std::string, int>& groups){
+  std::set<int> varGroups;
+  for (std::set<std::string>::const_iterator it = varArgUFs.begin();
+       it != varArgUFs.end(); it++) {
+    varGroups.insert(groups[*it]);
+  }
+  std::vector<const Exp*> exps;
+  for (std::map<Exp, std::set<std::string> >::const_iterator
+       it = instExps.begin(); it != instExps.end(); it++) {
+    bool compatible = varArgUFs.empty() || it->second.empty();
+    for (std::set<std::string>::const_iterator ufs = it->second.begin();
+         !compatible && ufs != it->second.end(); ufs++) {
+      std::map<std::string, int>::const_iterator g = groups.find(*ufs);
+      compatible = g != groups.end() && varGroups.count(g->second);
+    }
+    if (compatible) { exps.push_back( &(it->first) ); }
+  }
+  return exps;
+}
+
+}
+
 /*!
 ** This function takes an expression set, and instantiates 
 ** quantified rules stored in the environment using them.
@@ -3770,37 +4583,154 @@ Set* checkIslSet(isl_set* set, isl_ctx* ctx,
 std::set<std::pair <std::string,std::string>> ruleInstantiation
                           (std::set<Exp> instExps, bool *useRule, 
                            TupleDecl origTupleDecl, UFCallMap *ufcmap){
+  std::map<Exp, std::set<std::string> > unknownArgUFs;
+  for (std::set<Exp>::iterator it = instExps.begin();
+       it != instExps.end(); it++) {
+    unknownArgUFs[*it];
+  }
+  return ruleInstantiation(unknownArgUFs, useRule, origTupleDecl, ufcmap);
+}
+
+// Rules are indexed by the UF symbols they mention. Starting from the
+// symbols of the constraints, a rule is used when it shares a symbol with
+// the ones collected so far, and then adds its own symbols, until no more
+// rules qualify. Rules without UF symbols are always used.
+// Each rule variable that is passed as a whole argument to UFs is only
+// instantiated with expressions that are arguments of UFs linked to those
+// by rules. Instantiating with any other expression only relates fresh
+// calls that nothing else in the constraints mentions.
+// Rules over one variable are instantiated once per expression instead of
+// once per pair.
+// Instantiations whose antecedent is false or whose consequent is true
+// can never add anything in instantiationSet, they are dropped.
+std::set<std::pair <std::string,std::string>> ruleInstantiation
+           (const std::map<Exp, std::set<std::string> >& instExps,
+            bool *useRule, TupleDecl origTupleDecl, UFCallMap *ufcmap){
   int noAvalRules = queryNoUniQuantRules();
-  UniQuantRule* uqRule;
+  RuleInstantiationStats stats;
   std::set<std::pair <std::string,std::string>> instantiations;
   // If no rules are explicitly specified, we instantiate all of them  
+  bool allRules[ TheOthers+1 ];
   if (!useRule){
-    useRule = new bool[ TheOthers ];
-    for(int i = 0 ; i < TheOthers ; i++ ){ useRule[i] = 1; } 
+    for(int i = 0 ; i <= TheOthers ; i++ ){ allRules[i] = 1; } 
+    useRule = allRules;
   }
-  // Instantiating the universially quantified rules available 
-  // in the environment one by one, for the ones we want to check
-  for(int i = 0 ; i < noAvalRules ; i++ ){
 
-    // Query rule No. i from environment
-    uqRule = queryUniQuantRuleEnv(i);
-    // If we do not want to instantiate this rule move on to next one
+  // Index the rules we want to check
+  std::vector<UniQuantRule*> rules;
+  std::vector<VisitorRuleShape*> shapes;
+  for(int i = 0 ; i < noAvalRules ; i++ ){
+    UniQuantRule* uqRule = queryUniQuantRuleEnv(i);
     if( !(useRule[uqRule->getType()]) ) continue;
+    VisitorRuleShape* shape =
+      new VisitorRuleShape(uqRule->getLeftSide()->arity());
+    uqRule->getLeftSide()->acceptVisitor(shape);
+    uqRule->getRightSide()->acceptVisitor(shape);
+    rules.push_back(uqRule);
+    shapes.push_back(shape);
+  }
+
+  // Symbols of the constraints, none if the caller did not say
+  std::set<std::string> relevant;
+  for (std::map<Exp, std::set<std::string> >::const_iterator
+       it = instExps.begin(); it != instExps.end(); it++) {
+    relevant.insert(it->second.begin(), it->second.end());
+  }
+  std::vector<bool> used(rules.size(), relevant.empty());
+  for (bool changed = true; changed; ) {
+    changed = false;
+    for (unsigned int r = 0; r < rules.size(); r++) {
+      const std::set<std::string>& symbols = shapes[r]->getSymbols();
+      if (used[r] || !(symbols.empty() || intersects(symbols, relevant))) {
+        continue;
+      }
+      used[r] = true;
+      relevant.insert(symbols.begin(), symbols.end());
+      changed = true;
+    }
+  }
+
+  std::vector<const std::set<std::string>*> usedSymbols;
+  for (unsigned int r = 0; r < rules.size(); r++) {
+    if (used[r]) { usedSymbols.push_back( &(shapes[r]->getSymbols()) ); }
+  }
+  std::map<std::string, int> groups = symbolGroups(usedSymbols);
+
+  for (unsigned int r = 0; r < rules.size(); r++) {
+    if (!used[r]) {
+      stats.rulesPruned++;
+      delete shapes[r];
+      continue;
+    }
+    stats.rules++;
+
     // Go over our Expression Set (E), and replace uni. quant. vars.
     // in the rule with these expressions.
-    for (std::set<Exp>::iterator it1=instExps.begin(); 
-             it1!=instExps.end(); it1++){
-      for (std::set<Exp>::iterator it2=instExps.begin(); 
-               it2!=instExps.end(); it2++){
-        instantiations.insert(instantiate(uqRule,*it1,*it2,
-                              ufcmap,origTupleDecl));
+    const std::vector<std::set<std::string> >& argUFs =
+      shapes[r]->getArgUFs();
+    std::vector<const Exp*> exps1 =
+      compatibleExps(instExps, argUFs.size() > 0 ? argUFs[0]
+                                                 : std::set<std::string>(),
+                     groups);
+    std::vector<const Exp*> exps2 = exps1;
+    if (argUFs.size() > 1) {
+      exps2 = compatibleExps(instExps, argUFs[1], groups);
+    }
+    bool unary = argUFs.size() < 2;
+    unsigned long tuples = unary ? exps1.size()
+                                 : exps1.size() * exps2.size();
+    stats.tuplesPruned += (unary ? instExps.size()
+                                 : instExps.size() * instExps.size())
+                          - tuples;
+    stats.tuples += tuples;
+
+    for (unsigned int i1 = 0; i1 < exps1.size(); i1++){
+      for (unsigned int i2 = 0; i2 < (unary ? 1 : exps2.size()); i2++){
+        const Exp& x1 = *exps1[i1];
+        const Exp& x2 = unary ? x1 : *exps2[i2];
+        SubMap subMap;
+        ruleSubMap(subMap, x1, x2);
+        std::string leftStr = instantiateSide(rules[r]->getLeftSide(),
+                                  subMap, ufcmap, origTupleDecl);
+        if (leftStr == "false") { stats.trivialPruned++; continue; }
+        std::string rightStr = instantiateSide(rules[r]->getRightSide(),
+                                   subMap, ufcmap, origTupleDecl);
+        if (rightStr == "true") { stats.trivialPruned++; continue; }
+        instantiations.insert(std::make_pair(leftStr, rightStr));
       }
     }
+    delete shapes[r];
   }
 
+  std::lock_guard<std::mutex> lock(theRuleStatsMutex);
+  theRuleStats.rules += stats.rules;
+  theRuleStats.rulesPruned += stats.rulesPruned;
+  theRuleStats.tuples += stats.tuples;
+  theRuleStats.tuplesPruned += stats.tuplesPruned;
+  theRuleStats.trivialPruned += stats.trivialPruned;
   return instantiations;
 }
 
+RuleInstantiationStats ruleInstantiationStats(){
+  std::lock_guard<std::mutex> lock(theRuleStatsMutex);
+  return theRuleStats;
+}
+
+void resetRuleInstantiationStats(){
+  std::lock_guard<std::mutex> lock(theRuleStatsMutex);
+  theRuleStats = RuleInstantiationStats();
+}
+
+InstantiationSetStats instantiationSetStats(){
+  std::lock_guard<std::mutex> lock(theInstantiationSetStatsMutex);
+  return theInstantiationSetStats;
+}
+
+void resetInstantiationSetStats(){
+  std::lock_guard<std::mutex> lock(theInstantiationSetStatsMutex);
+  theInstantiationSetStats = InstantiationSetStats();
+}
+
 
 // Detect UnSat or MaySat for the set utilizing domain information 
 // that are stored as universally quantified rules in the environment.
@@ -3811,37 +4741,67 @@ std::set<std::pair <std::string,std::string>> ruleInstantiation
 // Finally, it checks to see whither the isl map is empty or not, 
 // in case it is not empty it extract the newly found equalities, 
 // adds them the original relation and returns the result.
-Set* Set::detectUnsatOrFindEqualities(bool *useRule){
+Set* Set::detectUnsatOrFindEqualities(bool *useRule, unsigned int threads){
+
+  // Trivially UnSat sets need no instantiations, refer to bound_propagation.h
+  // The bounded copy also gives the symbolic constants for isl below.
+  Set *bounded = boundDomainRange();
+  if( boundsDecideUnsat(*bounded) ){
+    delete bounded;
+    return NULL;
+  }
+
+  // Congruent UF calls become one term before anything is instantiated
+  // or handed to isl, refer to congruence_closure.h
+  Set *closed = congruenceClosure(*this);
 
   // Gather all UFCall Parameters for Expression Set (E) for rule instantiation
   VisitorGatherAllParameters *vGE = new VisitorGatherAllParameters;
-  this->acceptVisitor(vGE);
-  std::set<Exp> instExps = vGE->getExps();
+  closed->acceptVisitor(vGE);
+  std::map<Exp, std::set<std::string> > instExps = vGE->getArgumentUFs();
+  delete vGE;
   // Generate all instantiations of universialy quantified rules
   TupleDecl origTupleDecl = getTupleDecl();
   std::set<std::pair <std::string,std::string>> instantiations;
   UFCallMap *ufcmap = new UFCallMap();
   instantiations = ruleInstantiation(instExps, useRule, origTupleDecl, ufcmap);
   // Use ISL to add useful instantiations, refer to instantiationSet
-  Set *supAffSet = superAffineSet(ufcmap);
+  Set *supAffSet = closed->superAffineSet(ufcmap);
   srParts supSetParts = getPartsFromStr(supAffSet->prettyPrintString());
-  isl_ctx* ctx = isl_ctx_alloc();
-  string syms = symsForInstantiationSet(boundDomainRange(), ufcmap);
-  isl_set* set = instantiationSet(supSetParts, instantiations, syms, ctx);
-  Set *result = checkIslSet(set, ctx, ufcmap, this);
-  //isl_ctx_free(ctx);
+  ISLCtxScope scope;
+  string syms = symsForInstantiationSet(bounded, ufcmap);
+  isl_set* set = instantiationSet(supAffSet, supSetParts, instantiations,
+                                  syms, scope.ctx(), threads);
+  Set *result = checkIslSet(set, scope.ctx(), ufcmap, this);
+  delete closed;
 
   return result;
 }
 
 
 // Same as Set
-Relation* Relation::detectUnsatOrFindEqualities(bool *useRule){
+Relation* Relation::detectUnsatOrFindEqualities(bool *useRule,
+                                                unsigned int threads){
+
+  Relation *bounded = boundDomainRange();
+  if( boundsDecideUnsat(*bounded) ){
+    delete bounded;
+    return NULL;
+  }
+
+  // Here, we are going to utlize same functions that as Set class.
+  // Set::detectUnsatOrFindEqualities uses. Therefore, we temporary
+  // turn the Relation into a Set by simply changing its tuple declaration
+  // using relationStr2SetStr function found in isl_str_manipulation.
+  Set *eqSet = new Set( relationStr2SetStr(prettyPrintString(), 
+                                  inArity(), outArity()) );
+  Set *closed = congruenceClosure(*eqSet);
 
   // Gather all UFCall Parameters for Expression Set (E) for rule instantiation
   VisitorGatherAllParameters *vGE = new VisitorGatherAllParameters;
-  this->acceptVisitor(vGE);
-  std::set<Exp> instExps = vGE->getExps();
+  closed->acceptVisitor(vGE);
+  std::map<Exp, std::set<std::string> > instExps = vGE->getArgumentUFs();
+  delete vGE;
 
   // Generate all instantiations of universialy quantified rules
   TupleDecl origTupleDecl = getTupleDecl();
@@ -3849,21 +4809,16 @@ Relation* Relation::detectUnsatOrFindEqualities(bool *useRule){
   UFCallMap *ufcmap = new UFCallMap();
   instantiations = ruleInstantiation(instExps, useRule, origTupleDecl, ufcmap);
 
-  // Here, we are going to utlize same functions that as Set class.
-  // Set::detectUnsatOrFindEqualities uses. Therefore, we temporary
-  // turn the Relation into a Set by simply changing its tuple declaration
-  // using relationStr2SetStr function found in isl_str_manipulation.
-  Set *eqSet = new Set( relationStr2SetStr(prettyPrintString(), 
-                                  inArity(), outArity()) );
-  Set *supAffSet = eqSet->superAffineSet(ufcmap);
+  Set *supAffSet = closed->superAffineSet(ufcmap);
   srParts supSetParts = getPartsFromStr(supAffSet->prettyPrintString());
-  isl_ctx* ctx = isl_ctx_alloc();
-  string syms = symsForInstantiationSet(eqSet->boundDomainRange(), ufcmap);
-  isl_set* set = instantiationSet(supSetParts, instantiations, syms, ctx);
+  ISLCtxScope scope;
+  string syms = symsForInstantiationSet(bounded, ufcmap);
+  delete closed;
+  isl_set* set = instantiationSet(supAffSet, supSetParts, instantiations,
+                                  syms, scope.ctx(), threads);
 
   // Check if the relation with new information is UnSat or MaySat
-  Set *resultSet = checkIslSet(set, ctx, ufcmap, eqSet);
-  //isl_ctx_free(ctx);
+  Set *resultSet = checkIslSet(set, scope.ctx(), ufcmap, eqSet);
   Relation *result = NULL;
   // Turning results back into a Relation
   if( resultSet ){
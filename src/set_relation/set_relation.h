@@ -31,9 +31,13 @@ class Visitor;
 #include <vector>
 #include <map>
 #include <string>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
 #include <sstream>
 #include <iostream>
 #include "isl_str_manipulation.h"
+#include "normalize_cache.h"
 
 #include <isl/set.h>   // ISL Sets
 #include <isl/map.h>   // ISL Relations
@@ -60,7 +64,7 @@ extern Relation* parse_relation(std::string relation_string);
  * This class holds two sets: one for the equalities and one for the
  * inequalities.
  */
-class Conjunction {
+class Conjunction : public ArenaAllocated {
 public:
 
     Conjunction(int arity);
@@ -68,12 +72,27 @@ public:
     Conjunction(int arity, int inarity);
     Conjunction(const Conjunction& other);
     Conjunction& operator=(const Conjunction& other);
+    //! Moves take over the constraints of other, leaving it empty.
+    Conjunction(Conjunction&& other);
+    Conjunction& operator=(Conjunction&& other);
     void reset();
     virtual ~Conjunction();
     Conjunction* clone() const;
 
+    //! Three-way comparison in the order of operator<
+    //! (negative, 0 or positive). Allocation free.
+    int compare(const Conjunction& other) const;
+
     //! Comparison operator -- lexicographic order
-    bool operator<(const Conjunction& other) const;
+    bool operator<(const Conjunction& other) const
+        { return compare(other) < 0; }
+
+    //! Equality in the order of operator<
+    bool operator==(const Conjunction& other) const
+        { return compare(other) == 0; }
+
+    //! Hash consistent with operator==.
+    std::size_t hash() const;
 
     //! Given inarity parameter is adopted.
     //! If inarity parameter is outside of feasible range for the existing
@@ -125,7 +144,7 @@ public:
     ** in all our equalities and inequalities.
     ** \param searchTermToSubExp (none of the Term* or Exp* are adopted)
     */
-    void substituteInConstraints(SubMap& searchTermToSubExp);
+    void substituteInConstraints(const SubMap& searchTermToSubExp);
 
     //! Convert to a human-readable string.
     virtual std::string toString() const;
@@ -270,7 +289,7 @@ public:
     int termCount();
 
     void setUnsat(){ unsat = true;}
-    bool isUnsat(){return unsat;}
+    bool isUnsat() const {return unsat;}
 
     // 
     SetRelationshipType setRelationship(Conjunction* rightSide);
@@ -291,6 +310,61 @@ private:
 
     // When we find out that conjunction is unsatisfiable we set this true.
     bool unsat;
+
+    friend class SparseConstraints;
+    friend class Set;
+    friend class Relation;
+
+    //! Copies of a SparseConstraints share its conjunctions until they
+    //! change them. Returns this with one more owner.
+    Conjunction* share() const;
+    //! Drops one owner and deletes the conjunction with the last one.
+    void release();
+    //! Whether more than one SparseConstraints holds the conjunction.
+    bool isShared() const;
+
+    /// Number of SparseConstraints holding this conjunction.
+    mutable std::atomic<int> mShares;
+};
+
+/*!
+ * \class ConstConjunctionIterator
+ *
+ * \brief Iterates over the conjunctions of a SparseConstraints without
+ *        write access to them.
+ *
+ * Copies of a SparseConstraints share its conjunctions, so changing one
+ * through an iterator would change every copy. Only SparseConstraints
+ * members change them, after cloning the shared ones.
+ */
+class ConstConjunctionIterator {
+public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef const Conjunction* value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const Conjunction* const* pointer;
+    typedef const Conjunction* reference;
+
+    ConstConjunctionIterator() {}
+    explicit ConstConjunctionIterator(
+        std::list<Conjunction*>::const_iterator i) : mIter(i) {}
+
+    const Conjunction* operator*() const { return *mIter; }
+
+    ConstConjunctionIterator& operator++() { ++mIter; return *this; }
+    ConstConjunctionIterator operator++(int)
+        { ConstConjunctionIterator old(*this); ++mIter; return old; }
+    ConstConjunctionIterator& operator--() { --mIter; return *this; }
+    ConstConjunctionIterator operator--(int)
+        { ConstConjunctionIterator old(*this); --mIter; return old; }
+
+    bool operator==(const ConstConjunctionIterator& other) const
+        { return mIter == other.mIter; }
+    bool operator!=(const ConstConjunctionIterator& other) const
+        { return mIter != other.mIter; }
+
+private:
+    std::list<Conjunction*>::const_iterator mIter;
 };
 
 /*!
@@ -305,14 +379,28 @@ private:
 class SparseConstraints {
 public:
     SparseConstraints();
+    //! Copies share the conjunctions of other, which are cloned once
+    //! either side changes them.
     SparseConstraints(const SparseConstraints& other);
     virtual SparseConstraints& operator=(const SparseConstraints& other);
+    //! Moves take over the conjunctions of other, leaving it with none.
+    //! Unlike copies they do not clean up the conjunctions again.
+    SparseConstraints(SparseConstraints&& other);
+    SparseConstraints& operator=(SparseConstraints&& other);
 
     void reset();
     virtual ~SparseConstraints();
 
+    //! Three-way comparison of the conjunctions in the order of
+    //! operator< (negative, 0 or positive). Allocation free.
+    int compare( const SparseConstraints& other) const;
+
     //! Less than operator.
-    virtual bool operator<( const SparseConstraints& other) const;
+    virtual bool operator<( const SparseConstraints& other) const
+        { return compare(other) < 0; }
+
+    //! Hash of the conjunctions, consistent with compare.
+    std::size_t hash() const;
 
     //! For all conjunctions, sets them to the given tuple declaration.
     //! If there are some constants that don't agree then throws exception.
@@ -332,13 +420,14 @@ public:
     virtual void addConjunction(Conjunction *adoptedConjunction);
     
     //! Get an iterator to the first conjunction we contain.
-    std::list<Conjunction*>::const_iterator conjunctionBegin() const {
-    	return mConjunctions.begin();
+    //! The conjunctions may be shared with copies, so they are const.
+    ConstConjunctionIterator conjunctionBegin() const {
+    	return ConstConjunctionIterator(mConjunctions.begin());
     }
 
     //! Get an iterator pointing past the last conjunction we contain.
-    std::list<Conjunction*>::const_iterator conjunctionEnd() const {
-    	return mConjunctions.end();
+    ConstConjunctionIterator conjunctionEnd() const {
+    	return ConstConjunctionIterator(mConjunctions.end());
     }
 
     //! Get our total arity, IOW number of tuple elements.
@@ -379,7 +468,8 @@ public:
     void 
     substituteInConstraints(SubMap& searchTermToSubExp);
 
-    //! Remove duplicate constraints and trivial constraints
+    //! Remove duplicate constraints and trivial constraints.
+    //! Does nothing if nothing changed since the last cleanUp.
     void cleanUp();
     
 
@@ -468,11 +558,16 @@ public:
     std::vector<std::string> getZ3form(std::set<std::string> &UFSyms, 
                   std::set<std::string> &VarSyms, bool termDef = true);
     
-// FIXME: what methods should we have to iterate over conjunctions so
-// this can go back to protected?
-// protected:
+protected:
     std::list<Conjunction*> mConjunctions;
 
+    //! Clones the conjunctions that are shared with other
+    //! SparseConstraints, before changing them in place.
+    void unshareConjunctions();
+
+    /// True when nothing changed since the last cleanUp, so copies
+    /// can share the conjunctions without cleaning them up again.
+    bool mCleanedUp;
 
 };
 
@@ -500,14 +595,25 @@ public:
 
     //! Copy constructor
     Set(const Set& other);
+
+    //! Move constructor
+    Set(Set&& other);
     
     ~Set();
 
     Set& operator=(const Set& other);
+    Set& operator=(Set&& other);
+
+    //! Three-way comparison in the order of operator<
+    //! (negative, 0 or positive). Allocation free.
+    int compare( const Set& other) const;
 
-    bool operator==( const Set& other) const;
+    bool operator==( const Set& other) const { return compare(other) == 0; }
     //! Less than operator.
-    bool operator<( const Set& other) const;
+    bool operator<( const Set& other) const { return compare(other) < 0; }
+
+    //! Hash consistent with operator==.
+    std::size_t hash() const;
     
     std::string toDotString() const;
 
@@ -606,6 +712,10 @@ public:
     //! If tvar is an argument to some UFCall, then returns NULL.
     Set* projectOut(int tvar);
 
+    //! Projects out all tuple vars in tvars in one pass through isl, if
+    //! none of them is an argument to a UFCall, otherwise returns NULL.
+    Set* projectOut(const std::set<int>& tvars);
+
     /*! This function simplifies constraints sets of non-affine sets that
         are targeted for level set parallelism. These sets are representative
         of data access dependency relations. For level set parallelism,
@@ -628,7 +738,16 @@ public:
 
     int getArity(){ return mArity;}
 
-    Set* detectUnsatOrFindEqualities(bool *useRule=NULL);
+    /*! Detects whether the set is unsatisfiable using the universally
+    **  quantified rules of the environment, returns NULL if it is, or the
+    **  set with the equalities found otherwise. With threads > 1 the
+    **  instantiated rules are checked on that many threads, 0 means one
+    **  thread per core. Either way instantiations are added until none
+    **  of them changes the set any more, so the equalities found do not
+    **  depend on the thread count.
+    */
+    Set* detectUnsatOrFindEqualities(bool *useRule=NULL,
+                                     unsigned int threads=1);
     
     string getString(bool generic=false);
 
@@ -659,14 +778,25 @@ public:
     Relation(std::string str);
     Relation(int inArity, int outArity);
     Relation(const Relation& other);
+    Relation(Relation&& other);
     Relation& operator=(const Relation& other);
+    Relation& operator=(Relation&& other);
     Relation& operator=(const Set& other);
     
+    //! Three-way comparison in the order of operator<
+    //! (negative, 0 or positive). Allocation free.
+    int compare( const Relation& other) const;
+
     //! Equals operator
-    bool operator==( const Relation& other) const;
+    bool operator==( const Relation& other) const
+        { return compare(other) == 0; }
     
     //! Less than operator.
-    bool operator<( const Relation& other) const;
+    bool operator<( const Relation& other) const
+        { return compare(other) < 0; }
+
+    //! Hash consistent with operator==.
+    std::size_t hash() const;
     
     ~Relation();
 
@@ -821,6 +951,10 @@ public:
     //! If tvar is an argument to some UFCall, then returns NULL.
     Relation* projectOut(int tvar);
 
+    //! Projects out all tuple vars in tvars in one pass through isl, if
+    //! none of them is an argument to a UFCall, otherwise returns NULL.
+    Relation* projectOut(const std::set<int>& tvars);
+
     /*! This function simplifies constraints sets of non-affine sets that
         are targeted for level set parallelism. These sets are representative
         of data access dependency relations. For level set parallelism,
@@ -841,8 +975,9 @@ public:
         }
     }
 
-    //
-    Relation* detectUnsatOrFindEqualities(bool *useRule=NULL);
+    //! Same as Set::detectUnsatOrFindEqualities
+    Relation* detectUnsatOrFindEqualities(bool *useRule=NULL,
+                                          unsigned int threads=1);
     
     //
     string getString(bool generic=false);
@@ -865,13 +1000,105 @@ string passRelationStrThruISL(string rstr);
 string passUnionRelationStrThruISL(string rstr);
 Set* passSetThruISL(Set* s);
 Relation* passRelationThruISL(Relation* r);
+
+/*! Value returning forms of the Set and Relation operations, e.g.
+**  Set s = Union(s1, s2) for s1.Union(&s2). The result is moved out of
+**  the one the member function creates, so there is nothing to delete.
+*/
+Set Union(const Set& lhs, const Set& rhs);
+Set Intersect(const Set& lhs, const Set& rhs);
+Relation Union(const Relation& lhs, const Relation& rhs);
+Relation Intersect(const Relation& lhs, const Relation& rhs);
+Relation Compose(const Relation& lhs, const Relation& rhs);
+Set Apply(const Relation& lhs, const Set& rhs);
+Relation Inverse(const Relation& r);
+
 std::pair <std::string,std::string> instantiate(
           UniQuantRule* uqRule, Exp x1, Exp x2, 
           UFCallMap *ufcmap, TupleDecl origTupleDecl);
 std::set<std::pair <std::string,std::string>> ruleInstantiation
                           (std::set<Exp> instExps, bool *useRule, 
                            TupleDecl origTupleDecl, UFCallMap *ufcmap);
+
+/*! Same as above, but every expression comes with the names of the UFs it
+**  is an argument of in the constraints. That lets ruleInstantiation skip
+**  rules whose UF symbols are not connected to the constraints, and
+**  expressions that cannot be the argument a rule variable is passed to.
+**  Expressions with no UF names are compatible with every rule variable.
+*/
+std::set<std::pair <std::string,std::string>> ruleInstantiation
+           (const std::map<Exp, std::set<std::string> >& instExps,
+            bool *useRule, TupleDecl origTupleDecl, UFCallMap *ufcmap);
+
+//! Counters of the work ruleInstantiation did and avoided.
+struct RuleInstantiationStats {
+    //! Rules instantiated and rules skipped as unrelated to the constraints.
+    unsigned long rules, rulesPruned;
+    //! Expression tuples rules were instantiated with, and tuples skipped
+    //! because an expression could not be the argument of the rule's UF.
+    unsigned long tuples, tuplesPruned;
+    //! Instantiations dropped because their antecedent is false or their
+    //! consequent is true.
+    unsigned long trivialPruned;
+
+    RuleInstantiationStats() : rules(0), rulesPruned(0), tuples(0),
+                               tuplesPruned(0), trivialPruned(0) {}
+};
+
+//! Totals of all ruleInstantiation calls since the last reset.
+RuleInstantiationStats ruleInstantiationStats();
+void resetRuleInstantiationStats();
+
+//! Counters of the work detectUnsatOrFindEqualities did adding
+//! instantiations to the set it hands to isl, and of the calls it answered
+//! without isl.
+struct InstantiationSetStats {
+    //! Passes over the instantiations waiting to be looked at.
+    unsigned long rounds;
+    //! isl_set_gist calls deciding what an instantiation adds.
+    unsigned long gists;
+    //! Antecedents or consequents intersected with the set.
+    unsigned long additions;
+    //! detectUnsatOrFindEqualities calls.
+    unsigned long calls;
+    //! Calls found UnSat by bound propagation alone.
+    unsigned long boundsUnsat;
+
+    InstantiationSetStats() : rounds(0), gists(0), additions(0), calls(0),
+                              boundsUnsat(0) {}
+};
+
+//! Totals of all detectUnsatOrFindEqualities calls since the last reset.
+InstantiationSetStats instantiationSetStats();
+void resetInstantiationSetStats();
 Set* islSetProjectOut(Set* s, unsigned pos);
+//! Projects out the tuple variables at all the given positions of the
+//! affine set s in one pass through isl. s is not adopted.
+Set* islSetProjectOut(Set* s, const std::set<int>& positions);
 }//end namespace iegenlib
 
+namespace std {
+
+//! Lets conjunctions, sets and relations be keys of unordered containers.
+template <> struct hash<iegenlib::TupleDecl> {
+    std::size_t operator()(const iegenlib::TupleDecl& t) const {
+        return t.hash();
+    }
+};
+template <> struct hash<iegenlib::Conjunction> {
+    std::size_t operator()(const iegenlib::Conjunction& c) const {
+        return c.hash();
+    }
+};
+template <> struct hash<iegenlib::Set> {
+    std::size_t operator()(const iegenlib::Set& s) const { return s.hash(); }
+};
+template <> struct hash<iegenlib::Relation> {
+    std::size_t operator()(const iegenlib::Relation& r) const {
+        return r.hash();
+    }
+};
+
+}
+
 #endif /* SET_RELATION_H_ */
@@ -27,6 +27,7 @@
 #include <utility>
 #include <fstream>
 #include <iostream>
+#include <unordered_set>
 
 // Exp and Term classes
 using iegenlib::Exp;
@@ -4013,6 +4014,57 @@ TEST_F(SetRelationTest, projectOut) {
    delete ex_r1;
    delete ex_s1;
 }
+
+#pragma mark projectOutBatch
+// Testing projectOut of several tuple variables at once: the same as
+// projecting them out one at a time, and NULL if one is a UF argument.
+TEST_F(SetRelationTest, projectOutBatch) {
+
+    iegenlib::setCurrEnv();
+    iegenlib::appendCurrEnv("col",
+        new Set("{[i]:0<=i &&i<n}"),
+        new Set("{[j]:0<=j &&j<n}"), true, iegenlib::Monotonic_NONE);
+
+    Relation *r1 = new Relation("{ [i,k] -> [ip,kp] :  i = kp and col(i) < n"
+                                     " and i < ip and col(i)+1 <= k"
+                                     " and k < n and kp < n }");
+    std::set<int> tvars;
+    tvars.insert(1);    // k
+    tvars.insert(3);    // kp
+    Relation *batch = r1->projectOut(tvars);
+
+    Relation *r2 = r1->projectOut(3);
+    Relation *oneByOne = r2->projectOut(1);
+    ASSERT_TRUE( batch != NULL );
+    EXPECT_EQ( 1, batch->inArity() );
+    EXPECT_EQ( 1, batch->outArity() );
+    EXPECT_EQ( oneByOne->toISLString(), batch->toISLString() );
+
+    // i is an argument to col
+    tvars.insert(0);
+    EXPECT_TRUE( r1->projectOut(tvars) == NULL );
+
+    Set *s1 = new Set("{ [i,j,ip,jp] : i = col(jp)+1 and 0 <= i and i < n"
+                      " and i <= j and j < ip and ip < n }");
+    std::set<int> stvars;
+    stvars.insert(1);
+    stvars.insert(2);
+    Set *sbatch = s1->projectOut(stvars);
+    Set *s2 = s1->projectOut(2);
+    Set *sOneByOne = s2->projectOut(1);
+    ASSERT_TRUE( sbatch != NULL );
+    EXPECT_EQ( 2, sbatch->arity() );
+    EXPECT_EQ( sOneByOne->toISLString(), sbatch->toISLString() );
+
+    delete r1;
+    delete r2;
+    delete batch;
+    delete oneByOne;
+    delete s1;
+    delete s2;
+    delete sbatch;
+    delete sOneByOne;
+}
 #if 0
 #pragma mark debuggingForILU
 TEST_F(SetRelationTest, debuggingForILU){
@@ -4475,3 +4527,130 @@ TEST_F(SetRelationTest, RestrictDomainTest){
      delete restrictRel2;
      delete restrictRel3;
 }
+
+#pragma mark SetRelationCompareAndHash
+// Set, Relation and Conjunction comparisons and hashes agree with
+// operator==, so they can be used in unordered containers.
+TEST_F(SetRelationTest, CompareAndHash) {
+    Set* s1 = new Set("[n] -> {[i,j] : 0 <= i && i < n && j = f(i)}");
+    Set* s2 = new Set("[n] -> {[i,j] : j = f(i) && i < n && 0 <= i}");
+    Set* s3 = new Set("[n] -> {[i,j] : 0 <= i && i < n && j = f(i+1)}");
+
+    EXPECT_EQ( 0, s1->compare(*s2) );
+    EXPECT_TRUE( *s1 == *s2 );
+    EXPECT_EQ( s1->hash(), s2->hash() );
+    EXPECT_NE( 0, s1->compare(*s3) );
+    EXPECT_EQ( s1->compare(*s3) < 0, *s1 < *s3 );
+
+    std::unordered_set<Set> sets;
+    sets.insert(*s1);
+    sets.insert(*s2);
+    sets.insert(*s3);
+    EXPECT_EQ( 2u, sets.size() );
+
+    Relation* r1 = new Relation("{[i] -> [j] : j = i + 1}");
+    Relation* r2 = new Relation("{[a] -> [b] : b = a + 1}");
+    Relation* r3 = new Relation("{[i,j] -> [] : j = i + 1}");
+    EXPECT_TRUE( *r1 == *r2 );
+    EXPECT_EQ( r1->hash(), r2->hash() );
+    EXPECT_FALSE( *r1 == *r3 );
+
+    delete s1; delete s2; delete s3;
+    delete r1; delete r2; delete r3;
+}
+
+#pragma mark SetRelationMove
+// Moving a Set or Relation hands over its conjunctions and leaves the
+// source empty.
+TEST_F(SetRelationTest, Move) {
+    Set* s1 = new Set("[n] -> {[i,j] : 0 <= i && i < n && j = f(i)}");
+    std::string expected = s1->toString();
+
+    Set moved(std::move(*s1));
+    EXPECT_EQ( expected, moved.toString() );
+    EXPECT_EQ( 2, moved.arity() );
+    EXPECT_EQ( 0, s1->getNumConjuncts() );
+
+    Set assigned("{[k] : k = 3}");
+    assigned = std::move(moved);
+    EXPECT_EQ( expected, assigned.toString() );
+    EXPECT_EQ( 0, moved.getNumConjuncts() );
+
+    Relation r1("{[i] -> [j] : j = i + 1 && 0 <= i < n}");
+    expected = r1.toString();
+    Relation r2("{[k] -> [] : k = 2}");
+    r2 = std::move(r1);
+    EXPECT_EQ( expected, r2.toString() );
+    EXPECT_EQ( 1, r2.inArity() );
+    EXPECT_EQ( 1, r2.outArity() );
+    EXPECT_EQ( 0, r1.getNumConjuncts() );
+
+    delete s1;
+}
+
+#pragma mark SetRelationValueOperations
+// The value returning operations give the same results as the members.
+TEST_F(SetRelationTest, ValueOperations) {
+    Set s1("{[i,j] : 0 <= i && i < n}");
+    Set s2("{[i,j] : j = i + 2}");
+    Relation r1("{[i,j] -> [k] : k = i + j}");
+    Relation r2("{[k] -> [p] : p = k - 1}");
+
+    Set* su = s1.Union(&s2);
+    Set* si = s1.Intersect(&s2);
+    Set s3("{[k] : 0 <= k && k < n}");
+    Set* sa = r2.Apply(&s3);
+    Relation* rc = r2.Compose(&r1);
+    Relation* ri = r1.Inverse();
+    Relation* ru = r2.Union(&r2);
+    Relation* rn = r2.Intersect(&r2);
+
+    EXPECT_EQ( su->toString(), iegenlib::Union(s1, s2).toString() );
+    EXPECT_EQ( si->toString(), iegenlib::Intersect(s1, s2).toString() );
+    EXPECT_EQ( sa->toString(), iegenlib::Apply(r2, s3).toString() );
+    EXPECT_EQ( rc->toString(), iegenlib::Compose(r2, r1).toString() );
+    EXPECT_EQ( ri->toString(), iegenlib::Inverse(r1).toString() );
+    EXPECT_EQ( ru->toString(), iegenlib::Union(r2, r2).toString() );
+    EXPECT_EQ( rn->toString(), iegenlib::Intersect(r2, r2).toString() );
+
+    delete su; delete si; delete sa;
+    delete rc; delete ri; delete ru; delete rn;
+}
+
+#pragma mark SetRelationSharedConjunctions
+// Copies and unions share unchanged conjunctions, and changing a copy
+// leaves the original alone.
+TEST_F(SetRelationTest, SharedConjunctions) {
+    Set* s1 = new Set("{[i,j] : 0 <= i && i < n && j = f(i)}");
+    Set* s2 = new Set("{[i,j] : 0 <= i && i < m}");
+    std::string original = s1->toString();
+
+    Set copy(*s1);
+    EXPECT_EQ( *(s1->conjunctionBegin()), *(copy.conjunctionBegin()) );
+    // Nothing changed, so cleaning up again keeps them shared.
+    copy.cleanUp();
+    EXPECT_EQ( *(s1->conjunctionBegin()), *(copy.conjunctionBegin()) );
+
+    Set* both = s1->Union(s2);
+    EXPECT_EQ( 2, both->getNumConjuncts() );
+    for (iegenlib::ConstConjunctionIterator i=both->conjunctionBegin();
+            i != both->conjunctionEnd(); i++) {
+        EXPECT_TRUE( *i == *(s1->conjunctionBegin())
+                     || *i == *(s2->conjunctionBegin()) );
+    }
+
+    std::vector<int> swapTuple;
+    swapTuple.push_back(1);
+    swapTuple.push_back(0);
+    copy.remapTupleVars(swapTuple);
+    EXPECT_NE( *(s1->conjunctionBegin()), *(copy.conjunctionBegin()) );
+    EXPECT_EQ( original, s1->toString() );
+    EXPECT_NE( original, copy.toString() );
+
+    delete s1;
+    EXPECT_EQ( "{ [i, j] : __tv0 >= 0 && -__tv0 + m - 1 >= 0 } union "
+               "{ [i, j] : __tv1 - f(__tv0) = 0 && __tv0 >= 0 && "
+               "-__tv0 + n - 1 >= 0 }", both->toString() );
+    delete s2;
+    delete both;
+}
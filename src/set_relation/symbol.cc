@@ -0,0 +1,124 @@
+/*!
+ * \file symbol.cc
+ *
+ * \brief Implementation of the symbol table behind Symbol.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "symbol.h"
+#include <util/util.h>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+
+namespace iegenlib{
+
+struct Symbol::Entry {
+    std::string name;
+    std::size_t hash;
+    unsigned int id;
+};
+
+namespace {
+
+const std::string theEmptyString;
+
+/*!
+ * \class SymbolTable
+ *
+ * \brief One entry per distinct string. The deque keeps entries in
+ *        place as it grows, so Symbols can point at them.
+ */
+class SymbolTable {
+public:
+    const Symbol::Entry* intern(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::unordered_map<std::string, const Symbol::Entry*>::iterator it
+            = mIndex.find(name);
+        if (it != mIndex.end()) { return it->second; }
+        Symbol::Entry entry = { name, std::hash<std::string>()(name),
+                                (unsigned int)mEntries.size() + 1 };
+        mEntries.push_back(entry);
+        mIndex[name] = &mEntries.back();
+        return &mEntries.back();
+    }
+
+    //! The entry with the given id, NULL if there is none.
+    const Symbol::Entry* find(unsigned int id) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (id == 0 || id > mEntries.size()) { return NULL; }
+        return &mEntries[id - 1];
+    }
+
+    unsigned int size() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mEntries.size() + 1;
+    }
+
+private:
+    std::mutex mMutex;
+    std::deque<Symbol::Entry> mEntries;
+    std::unordered_map<std::string, const Symbol::Entry*> mIndex;
+};
+
+SymbolTable& theTable() {
+    static SymbolTable* table = new SymbolTable();
+    return *table;
+}
+
+}
+
+Symbol::Symbol(const std::string& name)
+    : mEntry(name.empty() ? NULL : theTable().intern(name)) {
+}
+
+// A NULL name is the empty string, as for Symbol().
+Symbol::Symbol(const char* name)
+    : mEntry(name == NULL || name[0] == '\0'
+             ? NULL : theTable().intern(name)) {
+}
+
+const std::string& Symbol::str() const {
+    return mEntry ? mEntry->name : theEmptyString;
+}
+
+unsigned int Symbol::id() const {
+    return mEntry ? mEntry->id : 0;
+}
+
+std::size_t Symbol::hash() const {
+    static const std::size_t emptyHash = std::hash<std::string>()("");
+    return mEntry ? mEntry->hash : emptyHash;
+}
+
+int Symbol::compare(const Symbol& other) const {
+    if (mEntry == other.mEntry) { return 0; }
+    int comparison = str().compare(other.str());
+    return comparison < 0 ? -1 : 1;
+}
+
+Symbol Symbol::fromId(unsigned int id) {
+    Symbol symbol;
+    if (id == 0) { return symbol; }
+    symbol.mEntry = theTable().find(id);
+    if (symbol.mEntry == NULL) {
+        throw assert_exception("Symbol::fromId: no symbol has this id");
+    }
+    return symbol;
+}
+
+unsigned int Symbol::tableSize() {
+    return theTable().size();
+}
+
+std::ostream& operator<<(std::ostream& os, const Symbol& symbol) {
+    return os << symbol.str();
+}
+
+}// iegenlib namespace
@@ -0,0 +1,93 @@
+/*!
+ * \file symbol.h
+ *
+ * \brief Interned names of UFs, symbolic constants and tuple variables.
+ *
+ * A Symbol stands for a string kept once in a process wide table. Copying
+ * a Symbol copies a pointer, and equality and hashing are integer
+ * operations. Symbols still order like their strings do, so containers
+ * sorted on them and everything printed from them keep their order.
+ *
+ *   Symbol f("rowptr");
+ *   Symbol g(std::string("row") + "ptr");
+ *   f == g;           // true, same table entry
+ *   f.str();          // "rowptr"
+ *   f.id();           // the same small integer for every "rowptr"
+ *
+ * Constructing a Symbol from a string looks it up in the table, under a
+ * lock, so threads can intern at the same time. Everything else works
+ * on the entry alone. Entries are never freed.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#ifndef SYMBOL_H_
+#define SYMBOL_H_
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+namespace iegenlib{
+
+class Symbol {
+public:
+    //! The empty string, without touching the table.
+    Symbol() : mEntry(NULL) {}
+    Symbol(const std::string& name);
+    //! A NULL name gives the empty string.
+    Symbol(const char* name);
+
+    //! The interned string.
+    const std::string& str() const;
+
+    //! Dense id of the string, 0 for the empty string.
+    unsigned int id() const;
+
+    //! Hash of the string, the same as std::hash<std::string> gives.
+    std::size_t hash() const;
+
+    bool empty() const { return mEntry == NULL; }
+
+    bool operator==(const Symbol& other) const
+        { return mEntry == other.mEntry; }
+    bool operator!=(const Symbol& other) const
+        { return mEntry != other.mEntry; }
+
+    //! Three-way comparison of the strings, 0 without looking at them
+    //! when the symbols are the same.
+    int compare(const Symbol& other) const;
+    bool operator<(const Symbol& other) const { return compare(other) < 0; }
+
+    //! The symbol with the given id. Throws if no symbol has that id.
+    static Symbol fromId(unsigned int id);
+
+    //! Number of strings interned so far, counting the empty string.
+    static unsigned int tableSize();
+
+    struct Entry;
+
+private:
+    const Entry* mEntry;
+};
+
+//! Writes the interned string.
+std::ostream& operator<<(std::ostream& os, const Symbol& symbol);
+
+}
+
+namespace std {
+
+template <> struct hash<iegenlib::Symbol> {
+    std::size_t operator()(const iegenlib::Symbol& s) const
+        { return s.hash(); }
+};
+
+}
+
+#endif
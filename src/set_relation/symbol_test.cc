@@ -0,0 +1,99 @@
+/*!
+ * \file symbol_test.cc
+ *
+ * \brief Tests for interned symbols.
+ *
+ * \date Started: 2026-10-17
+ *
+ * Copyright (c) 2016, University of Arizona <br>
+ * All rights reserved. <br>
+ * See ../../COPYING for details. <br>
+ */
+
+#include "symbol.h"
+#include "expression.h"
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using iegenlib::Symbol;
+using iegenlib::VarTerm;
+using iegenlib::UFCallTerm;
+
+#pragma mark SymbolInterning
+// Equal strings give the same symbol, with the string's hash and order.
+TEST(SymbolTest, Interning) {
+    Symbol f("rowptr");
+    Symbol g(std::string("row") + "ptr");
+    Symbol h("col");
+    EXPECT_TRUE( f == g );
+    EXPECT_TRUE( f != h );
+    EXPECT_EQ( f.id(), g.id() );
+    EXPECT_NE( f.id(), h.id() );
+    EXPECT_EQ( "rowptr", f.str() );
+    EXPECT_EQ( std::hash<std::string>()("rowptr"), f.hash() );
+    EXPECT_TRUE( h < f );
+    EXPECT_FALSE( f < g );
+    EXPECT_EQ( 0, f.compare(g) );
+    EXPECT_EQ( 1, f.compare(h) );
+
+    std::stringstream ss;
+    ss << f;
+    EXPECT_EQ( "rowptr", ss.str() );
+
+    Symbol empty;
+    EXPECT_TRUE( empty.empty() );
+    EXPECT_TRUE( empty == Symbol("") );
+    EXPECT_TRUE( empty == Symbol((const char*)NULL) );
+    EXPECT_EQ( 0u, empty.id() );
+    EXPECT_EQ( "", empty.str() );
+    EXPECT_TRUE( empty < h );
+}
+
+#pragma mark SymbolTerms
+// Terms naming the same UF or symbolic constant share the symbol.
+TEST(SymbolTest, Terms) {
+    VarTerm n1(2, "N");
+    VarTerm n2(n1);
+    EXPECT_EQ( "N", n2.symbol() );
+    EXPECT_EQ( &n1.symbol(), &n2.symbol() );
+
+    UFCallTerm f1("index", 1);
+    UFCallTerm f2(3, std::string("index"), 2);
+    EXPECT_TRUE( f1.nameSymbol() == f2.nameSymbol() );
+    f2.setName("other");
+    EXPECT_EQ( "other", f2.name() );
+    EXPECT_TRUE( f1.nameSymbol() != f2.nameSymbol() );
+}
+
+#pragma mark SymbolThreads
+// Threads interning the same strings at once agree on their symbols.
+TEST(SymbolTest, Threads) {
+    const int numThreads = 4;
+    const int numNames = 500;
+    std::vector<std::vector<Symbol> > interned(numThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; t++) {
+        threads.push_back(std::thread([t, &interned]() {
+            for (int i = 0; i < numNames; i++) {
+                std::stringstream name;
+                name << "sym_threads_" << (i + t * 7) % numNames;
+                interned[t].push_back(Symbol(name.str()));
+            }
+        }));
+    }
+    for (int t = 0; t < numThreads; t++) { threads[t].join(); }
+
+    unsigned int before = Symbol::tableSize();
+    for (int t = 0; t < numThreads; t++) {
+        for (int i = 0; i < numNames; i++) {
+            std::stringstream name;
+            name << "sym_threads_" << (i + t * 7) % numNames;
+            EXPECT_TRUE( interned[t][i] == Symbol(name.str()) );
+            EXPECT_EQ( name.str(), interned[t][i].str() );
+        }
+    }
+    EXPECT_EQ( before, Symbol::tableSize() );
+}
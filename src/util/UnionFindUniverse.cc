@@ -1,154 +1,192 @@
-/*!
- * \file UnionFindUniverse.cc
- *
- * \brief Definition for UnionFind
- *
- * \date Started: 2013-01-20
- * # $Revision:: 635                $: last committed revision
- * # $Date:: 2013-02-04 16:14:18 -0#$: date of last committed revision
- * # $Author:: heim                 $: author of last committed revision
- *
- * \authors This code was taken from the HPCVIEW system, which took it from the D system.
- *
- * \version $Id: UnionFindUniverse.cpp,v 1.2 2004/11/19 19:21:53 mstrout Exp $
- *
- * Copyright (c) 2002-2005, Rice University <br>
- * Copyright (c) 2004-2005, University of Chicago <br>
- * Copyright (c) 2006, Contributors <br>
- * All rights reserved. <br>
- * See ../../../Copyright.txt for details. <br>
- */
-
-/*! \file
-
-  UNION-FIND algorithm from Aho, Hopcroft & Ullman,
-  The Design and Analysis of Computer Algorithms, Addison Wesley 1974
-
-*/
-
-
- 
-#include "UnionFindUniverse.h"
-
-
-#define UF_NIL -1
-
-namespace OA {
-
-//***********************************************************************************************
-// internal class UnionFindElement
-//***********************************************************************************************
-
-class UnionFindElement {
-public:
-  UnionFindElement() { };
-
-  int &Count() { return count; };
-  int &Root() { return root; };
-  int &Parent() { return parent; }
-  int &Name() { return name; }
-  void Init(int i); 
-private:
-  int parent; 
-  int name;
-  int count;
-  int root;
-};
-
-
-void UnionFindElement::Init(int i) 
-{
-  name = root = i; 
-  parent = UF_NIL;
-  count = 1;
-}
-	
-
-//***********************************************************************************************
-// class UnionFindUniverse interface operations
-//***********************************************************************************************
-
-
-UnionFindUniverse::UnionFindUniverse(unsigned int highWaterMark)
-{
-  e = new UnionFindElement[highWaterMark];
-
-  for (unsigned int i = 0; i < highWaterMark; i++) {
-    e[i].Init(i);
-  }
-}
-
-UnionFindUniverse::~UnionFindUniverse()
-{
-  if (e)
-    delete [] e;
-}
-
-
-int UnionFindUniverse::Find(int v)
-{
-  if (Parent(v) == UF_NIL)
-    return Name(v);
-
-  Parent(v) = do_FIND(Parent(v));
-
-  return Name(Parent(v));
-}
-
-
-void UnionFindUniverse::Union(int i, int j, int k)
-{
-  if ((i == j) && (j == k))
-    return;
-
-  int large, small;
-  if (Count(Root(i)) > Count(Root(j))) {
-    large = Root(i);
-    small = Root(j);
-  } else {
-    large = Root(j);
-    small = Root(i);
-  }
-
-  Parent(small) = large;
-  Count(large) += Count(small);
-  Name(large) = k;
-  Root(k) = large; 
-}
-
-
-
-//***********************************************************************************************
-// class UnionFindUniverse private operations
-//***********************************************************************************************
-
-int UnionFindUniverse::do_FIND(int v)
-{
-  if (Parent(v) == UF_NIL)
-    return v;
-
-  Parent(v) = do_FIND(Parent(v));
-
-  return Parent(v);
-}
-
-int &UnionFindUniverse::Count(int i) 
-{
-  return e[i].Count();
-}
-
-int &UnionFindUniverse::Root(int i) 
-{
-  return e[i].Root();
-}
-int &UnionFindUniverse::Parent(int i) 
-{
-  return e[i].Parent();
-}
-
-int &UnionFindUniverse::Name(int i) 
-{
-  return e[i].Name();
-}
-
-} // end of namespace OA
+/*!
+ * \file UnionFindUniverse.cc
+ *
+ * \brief Definition for UnionFind
+ *
+ * \date Started: 2013-01-20
+ * # $Revision:: 635                $: last committed revision
+ * # $Date:: 2013-02-04 16:14:18 -0#$: date of last committed revision
+ * # $Author:: heim                 $: author of last committed revision
+ *
+ * \authors This code was taken from the HPCVIEW system, which took it from the D system.
+ *
+ * \version $Id: UnionFindUniverse.cpp,v 1.2 2004/11/19 19:21:53 mstrout Exp $
+ *
+ * Copyright (c) 2002-2005, Rice University <br>
+ * Copyright (c) 2004-2005, University of Chicago <br>
+ * Copyright (c) 2006, Contributors <br>
+ * All rights reserved. <br>
+ * See ../../../Copyright.txt for details. <br>
+ */
+
+/*! \file
+
+  UNION-FIND algorithm from Aho, Hopcroft & Ullman,
+  The Design and Analysis of Computer Algorithms, Addison Wesley 1974,
+  with union by rank and path halving, see Tarjan & van Leeuwen,
+  Worst-case Analysis of Set Union Algorithms, JACM 1984.
+
+*/
+
+
+ 
+#include "UnionFindUniverse.h"
+
+#include <algorithm>
+
+namespace OA {
+
+//***********************************************************************************************
+// class UnionFindUniverse interface operations
+//***********************************************************************************************
+
+
+UnionFindUniverse::UnionFindUniverse(unsigned int highWaterMark)
+{
+  if (highWaterMark > 0) {
+    Grow(highWaterMark - 1);
+  }
+}
+
+UnionFindUniverse::~UnionFindUniverse()
+{
+}
+
+
+void UnionFindUniverse::Union(int i, int j, int k)
+{
+  Grow(std::max(std::max(i, j), k));
+  int rootI = mElements[i].rootOf, rootJ = mElements[j].rootOf;
+  if (rootI == rootJ) {
+    return;
+  }
+  Link(rootI, rootJ, k);
+}
+
+
+int UnionFindUniverse::Union(int i, int j)
+{
+  Grow(std::max(i, j));
+  int rootI = Root(i), rootJ = Root(j);
+  int name = mNodes[rootI].name;
+  if (rootI != rootJ) {
+    Link(rootI, rootJ, name);
+  }
+  return name;
+}
+
+
+int UnionFindUniverse::MakeSet()
+{
+  int i = mNodes.size();
+  Grow(i);
+  return i;
+}
+
+
+unsigned int UnionFindUniverse::SetSize(int i)
+{
+  Grow(i);
+  return mElements[Root(i)].count;
+}
+
+
+std::vector<int> UnionFindUniverse::Members(int i)
+{
+  Grow(i);
+  std::vector<int> members;
+  int m = i;
+  do {
+    members.push_back(m);
+    m = mElements[m].next;
+  } while (m != i);
+  return members;
+}
+
+
+unsigned int UnionFindUniverse::Snapshot()
+{
+  mSnapshots.push_back(std::make_pair((unsigned int)mLog.size(), Size()));
+  return mSnapshots.size() - 1;
+}
+
+
+void UnionFindUniverse::Rollback(unsigned int snapshot)
+{
+  unsigned int logSize = mSnapshots[snapshot].first;
+  unsigned int size = mSnapshots[snapshot].second;
+  while (mLog.size() > logSize) {
+    const Change& c = mLog.back();
+    if (c.node) {
+      mNodes[c.index].*c.node = c.value;
+    } else {
+      mElements[c.index].*c.element = c.value;
+    }
+    mLog.pop_back();
+  }
+  mNodes.resize(size);
+  mElements.resize(size);
+  mSnapshots.resize(snapshot);
+}
+
+
+void UnionFindUniverse::Commit(unsigned int snapshot)
+{
+  mSnapshots.resize(snapshot);
+  if (mSnapshots.empty()) {
+    mLog.clear();
+  }
+}
+
+
+
+//***********************************************************************************************
+// class UnionFindUniverse private operations
+//***********************************************************************************************
+
+// Adds elements up to i, each in a set of its own named after it.
+void UnionFindUniverse::Grow(int i)
+{
+  for (int e = mNodes.size(); e <= i; e++) {
+    Node node = { e, e };
+    mNodes.push_back(node);
+    Element element = { e, 0, 1, e };
+    mElements.push_back(element);
+  }
+}
+
+// Hangs the lower ranked of two roots under the other, and names the
+// merged set.
+void UnionFindUniverse::Link(int rootI, int rootJ, int name)
+{
+  if (mElements[rootI].rank < mElements[rootJ].rank) {
+    std::swap(rootI, rootJ);
+  } else if (mElements[rootI].rank == mElements[rootJ].rank) {
+    Set(rootI, &Element::rank, mElements[rootI].rank + 1);
+  }
+  Set(rootJ, &Node::parent, rootI);
+  Set(rootI, &Element::count,
+      mElements[rootI].count + mElements[rootJ].count);
+  Set(rootI, &Node::name, name);
+  Set(name, &Element::rootOf, rootI);
+
+  // Splicing the two member cycles makes one.
+  int next = mElements[rootI].next;
+  Set(rootI, &Element::next, mElements[rootJ].next);
+  Set(rootJ, &Element::next, next);
+}
+
+// Remembers the value a field of element i has before it is set.
+void UnionFindUniverse::Log(int i, int Node::* field)
+{
+  Change c = { i, field, 0, mNodes[i].*field };
+  mLog.push_back(c);
+}
+
+void UnionFindUniverse::Log(int i, int Element::* field)
+{
+  Change c = { i, 0, field, mElements[i].*field };
+  mLog.push_back(c);
+}
+
+} // end of namespace OA
@@ -1,63 +1,171 @@
-/*!
- * \file UnionFindUniverse.h
- *
- * \brief Interface for UnionFind
- *
- * \date Started: 2013-01-20
- * # $Revision:: 635                $: last committed revision
- * # $Date:: 2013-02-04 16:14:18 -0#$: date of last committed revision
- * # $Author:: heim                 $: author of last committed revision
- *
- * \authors This code was taken from the HPCVIEW system, which took it from the D system.
- *
- * \version $Id: UnionFindUniverse.cpp,v 1.2 2004/11/19 19:21:53 mstrout Exp $
- *
- * Copyright (c) 2002-2005, Rice University <br>
- * Copyright (c) 2004-2005, University of Chicago <br>
- * Copyright (c) 2006, Contributors <br>
- * All rights reserved. <br>
- * See ../../../Copyright.txt for details. <br>
- */
-
-#ifndef UnionFindUniverse_H
-#define UnionFindUniverse_H
-
-namespace OA {
-
-class UnionFindElement;
-
-/*!
-   Here is example usage of this class:
-
-   OA::UnionFindUniverse ufset(10);
-
-   ufset.Union( ufset.Find(1), ufset.Find(5), ufset.Find(5) )
-
-*/
-
-class UnionFindUniverse {
-public:
-  UnionFindUniverse(unsigned int highWaterMark);
-  ~UnionFindUniverse();
-  //! merge set i with set j and name it k
-  //! if you want to merge the sets that a and b are in then
-  //! you need to call Union( Find(a), Find(b), ...)
-  void Union(int i, int j, int k);
-  //! returns what set i is in
-  int Find(int i);
-
-private: // methods
-  int &Count(int i);
-  int &Root(int i);
-  int &Parent(int i);
-  int &Name(int i);
-  int do_FIND(int i);
-
-private: // data
-  UnionFindElement *e;
-};
- 
-} // end of OA namespace
-
-#endif
-
+/*!
+ * \file UnionFindUniverse.h
+ *
+ * \brief Interface for UnionFind
+ *
+ * \date Started: 2013-01-20
+ * # $Revision:: 635                $: last committed revision
+ * # $Date:: 2013-02-04 16:14:18 -0#$: date of last committed revision
+ * # $Author:: heim                 $: author of last committed revision
+ *
+ * \authors This code was taken from the HPCVIEW system, which took it from the D system.
+ *
+ * \version $Id: UnionFindUniverse.cpp,v 1.2 2004/11/19 19:21:53 mstrout Exp $
+ *
+ * Copyright (c) 2002-2005, Rice University <br>
+ * Copyright (c) 2004-2005, University of Chicago <br>
+ * Copyright (c) 2006, Contributors <br>
+ * All rights reserved. <br>
+ * See ../../../Copyright.txt for details. <br>
+ */
+
+#ifndef UnionFindUniverse_H
+#define UnionFindUniverse_H
+
+#include <utility>
+#include <vector>
+
+namespace OA {
+
+/*!
+   Here is example usage of this class:
+
+   OA::UnionFindUniverse ufset(10);
+
+   ufset.Union( ufset.Find(1), ufset.Find(5), ufset.Find(5) )
+
+   or, merging the sets two elements are in and keeping the name of the
+   first one's set,
+
+   ufset.Union(1, 5);
+
+   Elements are numbered from 0. The universe grows to hold any element
+   handed to Find, Union or the member queries, or a new one from
+   MakeSet, so it can be started empty. Sets are merged by rank and Find
+   halves the paths it walks, which keeps both close to constant time.
+
+   Merges can be undone. Between Snapshot() and Rollback() every change is
+   logged, and Rollback() puts the universe back the way it was, elements
+   added since included:
+
+   unsigned int before = ufset.Snapshot();
+   ufset.Union(2, 3);
+   ufset.Rollback(before);   // 2 and 3 in sets of their own again
+
+*/
+
+class UnionFindUniverse {
+public:
+  UnionFindUniverse(unsigned int highWaterMark = 0);
+  ~UnionFindUniverse();
+
+  //! merge set i with set j and name it k
+  //! if you want to merge the sets that a and b are in then
+  //! you need to call Union( Find(a), Find(b), ...)
+  void Union(int i, int j, int k);
+  //! merge the sets elements i and j are in, the merged set keeps the
+  //! name of i's set, which is returned
+  int Union(int i, int j);
+  //! returns what set i is in
+  int Find(int i) {
+    if (i >= (int)mNodes.size()) { Grow(i); }
+    return mNodes[Root(i)].name;
+  }
+  //! true if i and j are in the same set
+  bool Same(int i, int j) { return Find(i) == Find(j); }
+
+  //! adds an element in a set of its own and returns it
+  int MakeSet();
+  //! number of elements
+  unsigned int Size() const { return mNodes.size(); }
+  //! number of elements in the set i is in
+  unsigned int SetSize(int i);
+  //! the members of i's set form a cycle, NextMember(i) is the one after
+  //! i, and i again once all of them have been visited
+  int NextMember(int i) {
+    if (i >= (int)mElements.size()) { Grow(i); }
+    return mElements[i].next;
+  }
+  //! returns the members of the set i is in, starting with i
+  std::vector<int> Members(int i);
+
+  //! starts logging changes, Rollback(snapshot) undoes them
+  unsigned int Snapshot();
+  //! undoes every change since snapshot was taken, and drops it and any
+  //! later snapshot
+  void Rollback(unsigned int snapshot);
+  //! keeps the changes since snapshot, and drops it and any later
+  //! snapshot
+  void Commit(unsigned int snapshot);
+
+private: // types
+  //! What Find reads, kept apart so that it touches one small node per
+  //! tree level.
+  struct Node {
+    //! parent, the element itself for a root
+    int parent;
+    //! for a root: the set name
+    int name;
+  };
+
+  //! What only Union and the member cycles need.
+  struct Element {
+    //! next member of its set
+    int next;
+    //! for a root: rank and number of members
+    int rank;
+    int count;
+    //! for a set name: its root
+    int rootOf;
+  };
+
+  //! old value of one field of one node or element, while there are
+  //! snapshots
+  struct Change {
+    int index;
+    int Node::* node;
+    int Element::* element;
+    int value;
+  };
+
+private: // methods
+  void Grow(int i);
+  void Link(int rootI, int rootJ, int name);
+  void Log(int i, int Node::* field);
+  void Log(int i, int Element::* field);
+
+  //! root of i's tree, pointing every other node on the way at its
+  //! grandparent
+  int Root(int i) {
+    int parent = mNodes[i].parent;
+    while (parent != i) {
+      int grandparent = mNodes[parent].parent;
+      if (grandparent != parent) { Set(i, &Node::parent, grandparent); }
+      i = grandparent;
+      parent = mNodes[i].parent;
+    }
+    return i;
+  }
+
+  void Set(int i, int Node::* field, int value) {
+    if (!mSnapshots.empty()) { Log(i, field); }
+    mNodes[i].*field = value;
+  }
+
+  void Set(int i, int Element::* field, int value) {
+    if (!mSnapshots.empty()) { Log(i, field); }
+    mElements[i].*field = value;
+  }
+
+private: // data
+  std::vector<Node> mNodes;
+  std::vector<Element> mElements;
+
+  std::vector<Change> mLog;
+  //! log length and size of the universe at each snapshot
+  std::vector<std::pair<unsigned int, unsigned int> > mSnapshots;
+};
+ 
+} // end of OA namespace
+
+#endif
@@ -45,6 +45,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <iostream>
+#include <chrono>
 #include <iegenlib.h>
 #include <gtest/gtest.h>
 #include "UnionFindUniverse.h"
@@ -116,3 +117,140 @@ TEST(UnionFind, UnionFindUniverse){
   // Implicitly test the destructor
 }
 
+// Test the additions to UnionFindUniverse
+// -Growth: elements past the high water mark are added as they are used.
+// -Members: the members of a set can be walked.
+// -Snapshot/Rollback: merges can be undone.
+
+TEST(UnionFind, Growth){
+
+  OA::UnionFindUniverse u;
+  EXPECT_EQ(0u, u.Size());
+
+  EXPECT_EQ(0, u.MakeSet());
+  EXPECT_EQ(1, u.MakeSet());
+  EXPECT_EQ(2u, u.Size());
+
+  // Union keeps the name of the first element's set.
+  EXPECT_EQ(9, u.Union(9, 1));
+  EXPECT_EQ(10u, u.Size());
+  EXPECT_EQ(9, u.Find(1));
+  EXPECT_TRUE(u.Same(1, 9));
+  EXPECT_FALSE(u.Same(0, 9));
+  EXPECT_EQ(2u, u.SetSize(1));
+  EXPECT_EQ(1u, u.SetSize(200));
+  EXPECT_EQ(201u, u.Size());
+}
+
+TEST(UnionFind, Members){
+
+  OA::UnionFindUniverse u(10);
+  u.Union(1, 3);
+  u.Union(5, 7);
+  u.Union(3, 7);
+
+  std::vector<int> members = u.Members(5);
+  std::sort(members.begin(), members.end());
+  std::vector<int> expected = {1, 3, 5, 7};
+  EXPECT_EQ(expected, members);
+
+  // NextMember cycles through the same members.
+  int m = 3;
+  unsigned int count = 0;
+  do {
+    EXPECT_TRUE(u.Same(m, 3));
+    m = u.NextMember(m);
+    count++;
+  } while (m != 3);
+  EXPECT_EQ(4u, count);
+
+  EXPECT_EQ(std::vector<int>(1, 4), u.Members(4));
+
+  // Like Find, they grow the universe to hold a new element.
+  EXPECT_EQ(std::vector<int>(1, 12), u.Members(12));
+  EXPECT_EQ(15, u.NextMember(15));
+  EXPECT_EQ(16u, u.Size());
+}
+
+TEST(UnionFind, Rollback){
+
+  OA::UnionFindUniverse u(6);
+  u.Union(0, 1);
+
+  unsigned int outer = u.Snapshot();
+  u.Union(2, 3);
+  unsigned int inner = u.Snapshot();
+  u.Union(1, 2);
+  u.Union(4, 12);
+  EXPECT_TRUE(u.Same(0, 3));
+  EXPECT_EQ(13u, u.Size());
+
+  u.Rollback(inner);
+  EXPECT_EQ(6u, u.Size());
+  EXPECT_FALSE(u.Same(1, 2));
+  EXPECT_FALSE(u.Same(4, 5));
+  EXPECT_TRUE(u.Same(2, 3));
+  EXPECT_EQ(2u, u.Members(2).size());
+
+  u.Rollback(outer);
+  EXPECT_FALSE(u.Same(2, 3));
+  EXPECT_TRUE(u.Same(0, 1));
+  EXPECT_EQ(1u, u.Members(3).size());
+
+  // Committed changes stay.
+  unsigned int kept = u.Snapshot();
+  u.Union(4, 5);
+  u.Commit(kept);
+  EXPECT_TRUE(u.Same(4, 5));
+}
+
+// Times millions of random unions and finds, and undoing a million merges.
+TEST(UnionFind, Benchmark){
+
+  const int elements = 1 << 20;
+  const int operations = 1 << 22;
+  OA::UnionFindUniverse u;
+  unsigned int seed = 12345;
+
+  std::chrono::steady_clock::time_point start
+      = std::chrono::steady_clock::now();
+  int merges = 0;
+  for (int op = 0; op < operations; op++) {
+    seed = seed * 1103515245u + 12345u;
+    int i = (seed >> 8) % elements;
+    seed = seed * 1103515245u + 12345u;
+    int j = (seed >> 8) % elements;
+    if (op % 2 == 0) {
+      if (!u.Same(i, j)) { merges++; }
+      u.Union(i, j);
+    } else {
+      u.Find(i);
+    }
+  }
+  double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  std::cout << "  " << operations << " unions and finds over " << elements
+            << " elements: " << seconds << "s\n";
+
+  unsigned int sets = 0;
+  for (int i = 0; i < elements; i++) {
+    if (u.Find(i) == i && u.Members(i).size() == u.SetSize(i)) { sets++; }
+  }
+  // Each set is named after one of its members.
+  EXPECT_EQ((unsigned int)(elements - merges), sets);
+
+  OA::UnionFindUniverse v(elements);
+  start = std::chrono::steady_clock::now();
+  unsigned int snapshot = v.Snapshot();
+  for (int i = 1; i < elements; i++) {
+    v.Union(i - 1, i);
+  }
+  EXPECT_EQ((unsigned int)elements, v.SetSize(0));
+  v.Rollback(snapshot);
+  seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  std::cout << "  " << elements - 1 << " unions rolled back: "
+            << seconds << "s\n";
+  EXPECT_EQ(1u, v.SetSize(elements / 2));
+  EXPECT_FALSE(v.Same(0, elements - 1));
+}
@@ -45,6 +45,14 @@ bool compareFileContentsToString(string file, string contents);
  */
 string createUniqueName(string name, set<string>& taken);
 
+/*!
+ * Mixes value into the running hash seed, so hashes of composite objects
+ * can be built from the hashes of their parts (as boost::hash_combine).
+ */
+inline void hashCombine(std::size_t& seed, std::size_t value) {
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
 
 /*!
  * Exception used when we would normally use an assert.  We expect